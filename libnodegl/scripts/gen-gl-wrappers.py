@@ -57,6 +57,10 @@ cmds_optional = [
     "glGetProgramResourceiv",
     "glGetProgramInterfaceiv",
     "glGetProgramResourceName",
+    # Program binary
+    "glGetProgramBinary",
+    "glProgramBinary",
+    "glProgramParameteri",
     # Polygon
     "glPolygonMode",
     # Internal format
@@ -92,6 +96,7 @@ cmds_optional = [
     "glFenceSync",
     "glWaitSync",
     "glClientWaitSync",
+    "glDeleteSync",
     # Read/Draw Buffer
     "glReadBuffer",
     "glDrawBuffer",
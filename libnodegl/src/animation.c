@@ -26,26 +26,60 @@
 #include "nodegl.h"
 #include "internal.h"
 
-static int get_kf_id(struct ngl_node * const *animkf, int nb_animkf, int start, double t)
+static double get_kf_time(const void *user_arg, int id)
 {
-    int ret = -1;
+    struct ngl_node * const *animkf = user_arg;
+    const struct animkeyframe_opts *kf = animkf[id]->opts;
+    return kf->time;
+}
 
-    for (int i = start; i < nb_animkf; i++) {
-        const struct animkeyframe_opts *kf = animkf[i]->opts;
-        if (kf->time > t)
-            break;
-        ret = i;
-    }
-    return ret;
+/*
+ * Lookup shared by the double and int64 variants, GET_TIME(i) being the time
+ * of the item i; the times are compared in their own type so that large int64
+ * timestamps are not rounded
+ */
+#define FIND_INDEX(GET_TIME) do {                                               \
+    for (int i = NGLI_MAX(cur, 0); i < NGLI_MIN(cur + 2, nb_items); i++) {      \
+        if (GET_TIME(i) <= t && (i == nb_items - 1 || GET_TIME(i + 1) > t))     \
+            return i;                                                           \
+    }                                                                           \
+                                                                                \
+    int lo = 0, hi = nb_items;                                                  \
+    while (lo < hi) {                                                           \
+        const int mid = lo + (hi - lo) / 2;                                     \
+        if (GET_TIME(mid) > t)                                                  \
+            hi = mid;                                                           \
+        else                                                                    \
+            lo = mid + 1;                                                       \
+    }                                                                           \
+    return lo - 1;                                                              \
+} while (0)
+
+int ngli_animation_find_index(const void *user_arg, ngli_animation_get_time_func_type get_time,
+                              int nb_items, int cur, double t)
+{
+#define GET_TIME(i) get_time(user_arg, i)
+    FIND_INDEX(GET_TIME);
+#undef GET_TIME
+}
+
+int ngli_animation_find_index_i64(const int64_t *times, int nb_items, int cur, int64_t t)
+{
+#define GET_TIME(i) times[i]
+    FIND_INDEX(GET_TIME);
+#undef GET_TIME
+}
+
+static int get_kf_id(struct ngl_node * const *animkf, int nb_animkf, int cur, double t)
+{
+    return ngli_animation_find_index(animkf, get_kf_time, nb_animkf, cur, t);
 }
 
 int ngli_animation_evaluate(struct animation *s, void *dst, double t)
 {
     struct ngl_node * const *animkf = s->kfs;
     const int nb_animkf = s->nb_kfs;
-    int kf_id = get_kf_id(animkf, nb_animkf, s->current_kf, t);
-    if (kf_id < 0)
-        kf_id = get_kf_id(animkf, nb_animkf, 0, t);
+    const int kf_id = get_kf_id(animkf, nb_animkf, s->current_kf, t);
     if (kf_id >= 0 && kf_id < nb_animkf - 1) {
         const struct animkeyframe_priv *kf1_priv = animkf[kf_id + 1]->priv_data;
         const struct animkeyframe_opts *kf0 = animkf[kf_id    ]->opts;
@@ -75,9 +109,7 @@ int ngli_animation_derivate(struct animation *s, void *dst, double t)
 {
     struct ngl_node * const *animkf = s->kfs;
     const int nb_animkf = s->nb_kfs;
-    int kf_id = get_kf_id(animkf, nb_animkf, s->current_kf, t);
-    if (kf_id < 0)
-        kf_id = get_kf_id(animkf, nb_animkf, 0, t);
+    const int kf_id = get_kf_id(animkf, nb_animkf, s->current_kf, t);
     if (kf_id >= 0 && kf_id < nb_animkf - 1) {
         const struct animkeyframe_priv *kf1_priv = animkf[kf_id + 1]->priv_data;
         const struct animkeyframe_opts *kf0 = animkf[kf_id    ]->opts;
@@ -22,6 +22,8 @@
 #ifndef ANIMATION_H
 #define ANIMATION_H
 
+#include <stdint.h>
+
 #include "nodegl.h"
 
 struct animkeyframe_opts;
@@ -34,6 +36,8 @@ typedef void (*ngli_animation_mix_func_type)(void *user_arg, void *dst,
 typedef void (*ngli_animation_cpy_func_type)(void *user_arg, void *dst,
                                              const struct animkeyframe_opts *kf);
 
+typedef double (*ngli_animation_get_time_func_type)(const void *user_arg, int index);
+
 struct animation {
     struct ngl_node * const *kfs;
     int nb_kfs;
@@ -48,6 +52,19 @@ int ngli_animation_init(struct animation *s, void *user_arg,
                         ngli_animation_mix_func_type mix_func,
                         ngli_animation_cpy_func_type cpy_func);
 
+/*
+ * Return the index of the last of the nb_items time sorted items with a time
+ * lower or equal to t, or -1 if t is before the first item. Consecutive
+ * lookups are usually close in time so the cached index cur and its successor
+ * are checked first, any other lookup (seek, backward scrubbing) falls back on
+ * a binary search.
+ */
+int ngli_animation_find_index(const void *user_arg, ngli_animation_get_time_func_type get_time,
+                              int nb_items, int cur, double t);
+
+/* Same as ngli_animation_find_index() for an array of int64 times */
+int ngli_animation_find_index_i64(const int64_t *times, int nb_items, int cur, int64_t t);
+
 int ngli_animation_evaluate(struct animation *s, void *dst, double t);
 int ngli_animation_derivate(struct animation *s, void *dst, double t);
 
@@ -54,6 +54,8 @@
 # define DEFAULT_BACKEND NGL_BACKEND_OPENGL
 #endif
 
+#define DEFAULT_DRAW_QUEUE_DEPTH 2
+
 extern const struct api_impl api_gl;
 extern const struct api_impl api_vk;
 
@@ -122,11 +124,13 @@ static int cmd_stop(struct ngl_ctx *s, void *arg)
 static void reset_scene(struct ngl_ctx *s, int action)
 {
     ngli_hud_freep(&s->hud);
+    ngli_updatesched_reset(&s->updatesched);
     if (s->scene) {
         ngli_node_detach_ctx(s->scene, s);
         if (action == NGLI_ACTION_UNREF_SCENE)
             ngl_node_unrefp(&s->scene);
     }
+    ngli_rtpool_collect(&s->rtpool);
     ngli_rnode_reset(&s->rnode);
 }
 
@@ -143,12 +147,16 @@ int ngli_ctx_set_scene(struct ngl_ctx *s, struct ngl_node *scene)
     s->rnode_pos->rendertarget_desc = *ngli_gpu_ctx_get_default_rendertarget_desc(s->gpu_ctx);
 
     if (scene) {
-        int ret = ngli_node_attach_ctx(scene, s);
+        ret = ngli_node_attach_ctx(scene, s);
         if (ret < 0) {
             ngli_node_detach_ctx(scene, s);
             return ret;
         }
         s->scene = ngl_node_ref(scene);
+
+        ret = ngli_updatesched_init(&s->updatesched, scene);
+        if (ret < 0)
+            goto fail;
     }
 
     const struct ngl_config *config = &s->config;
@@ -176,6 +184,7 @@ void ngli_ctx_reset(struct ngl_ctx *s, int action)
     if (s->gpu_ctx)
         ngli_gpu_ctx_wait_idle(s->gpu_ctx);
     reset_scene(s, action);
+    ngli_profiler_reset(&s->profiler);
 #if defined(HAVE_VAAPI)
     ngli_vaapi_ctx_reset(&s->vaapi_ctx);
 #endif
@@ -184,6 +193,8 @@ void ngli_ctx_reset(struct ngl_ctx *s, int action)
 #endif
     ngli_texture_freep(&s->font_atlas); // allocated by the first node text
     ngli_pgcache_reset(&s->pgcache);
+    ngli_rtpool_reset(&s->rtpool);
+    ngli_drawbatch_reset(&s->drawbatch);
     ngli_gpu_ctx_freep(&s->gpu_ctx);
     ngli_config_reset(&s->config);
 }
@@ -214,6 +225,16 @@ int ngli_ctx_configure(struct ngl_ctx *s, const struct ngl_config *config)
     if (ret < 0)
         goto fail;
 
+    ret = ngli_rtpool_init(&s->rtpool, s->gpu_ctx);
+    if (ret < 0)
+        goto fail;
+
+    ngli_drawbatch_init(&s->drawbatch);
+
+    ret = ngli_profiler_init(&s->profiler, s->gpu_ctx, config);
+    if (ret < 0)
+        goto fail;
+
 #if defined(HAVE_VAAPI)
     ret = ngli_vaapi_ctx_init(s->gpu_ctx, &s->vaapi_ctx);
     if (ret < 0)
@@ -271,6 +292,17 @@ int ngli_ctx_set_capture_buffer(struct ngl_ctx *s, void *capture_buffer)
     return 0;
 }
 
+int ngli_ctx_capture_acquire(struct ngl_ctx *s, double *t)
+{
+    const struct ngl_config *config = &s->config;
+    if (!config->capture_buffer) {
+        LOG(ERROR, "a capture buffer must be set to acquire a captured frame");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    return ngli_gpu_ctx_capture_acquire(s->gpu_ctx, t);
+}
+
 int ngli_ctx_prepare_draw(struct ngl_ctx *s, double t)
 {
     const int64_t start_time = s->hud ? ngli_gettime_relative() : 0;
@@ -290,6 +322,14 @@ int ngli_ctx_prepare_draw(struct ngl_ctx *s, double t)
     if (ret < 0)
         return ret;
 
+    /* Free the transient attachments left unused by the released nodes */
+    ngli_rtpool_collect(&s->rtpool);
+
+    /* Update the CPU-only nodes first so the regular pass can skip them */
+    ret = ngli_updatesched_run(&s->updatesched, t);
+    if (ret < 0)
+        return ret;
+
     ret = ngli_node_update(scene, t);
     if (ret < 0)
         return ret;
@@ -313,6 +353,9 @@ int ngli_ctx_draw(struct ngl_ctx *s, double t)
     if (ret < 0)
         return ret;
 
+    if (s->profiler.enabled)
+        ngli_profiler_begin_frame(&s->profiler);
+
     const int64_t cpu_start_time = s->hud ? ngli_gettime_relative() : 0;
 
     struct rendertarget *rt = ngli_gpu_ctx_get_default_rendertarget(s->gpu_ctx, NGLI_LOAD_OP_CLEAR);
@@ -341,7 +384,8 @@ int ngli_ctx_draw(struct ngl_ctx *s, double t)
             s->current_rendertarget = s->available_rendertargets[1];
             s->render_pass_started = 0;
         }
-        ngli_gpu_ctx_query_draw_time(s->gpu_ctx, &s->gpu_draw_time);
+        ret = ngli_gpu_ctx_query_draw_time(s->gpu_ctx, &s->gpu_draw_time);
+        s->gpu_draw_time_latency = NGLI_MAX(ret, 0);
 
         ngli_hud_draw(s->hud);
         LOG(DEBUG, "draw scene %s time (ms) cpu %f gpu %f",
@@ -355,7 +399,56 @@ int ngli_ctx_draw(struct ngl_ctx *s, double t)
         s->render_pass_started = 0;
     }
 
-    return ngli_gpu_ctx_end_draw(s->gpu_ctx, t);
+    ret = ngli_gpu_ctx_end_draw(s->gpu_ctx, t);
+    if (ret < 0)
+        return ret;
+
+    if (s->profiler.enabled)
+        ngli_profiler_end_frame(&s->profiler);
+
+    return 0;
+}
+
+int ngli_ctx_queue_draw(struct ngl_ctx *s, double t)
+{
+    pthread_mutex_lock(&s->lock);
+    while (s->nb_queued_draws == s->draw_queue_depth)
+        pthread_cond_wait(&s->cond_ctl, &s->lock);
+    const int index = (s->draw_queue_head + s->nb_queued_draws) % s->draw_queue_depth;
+    s->draw_queue[index] = t;
+    s->nb_queued_draws++;
+    pthread_cond_signal(&s->cond_wkr);
+    pthread_mutex_unlock(&s->lock);
+
+    return 0;
+}
+
+void ngli_ctx_wait_draws(struct ngl_ctx *s)
+{
+    pthread_mutex_lock(&s->lock);
+    while (s->nb_queued_draws)
+        pthread_cond_wait(&s->cond_ctl, &s->lock);
+    pthread_mutex_unlock(&s->lock);
+}
+
+static void run_queued_draw(struct ngl_ctx *s)
+{
+    const double t = s->draw_queue[s->draw_queue_head];
+
+    pthread_mutex_unlock(&s->lock);
+    const int ret = ngli_ctx_draw(s, t);
+    if (ret < 0)
+        LOG(ERROR, "queued draw @ t=%f failed: %s", t, NGLI_RET_STR(ret));
+    const struct ngl_config *config = &s->config;
+    if (config->draw_callback)
+        config->draw_callback(config->draw_callback_arg, t, ret);
+    pthread_mutex_lock(&s->lock);
+
+    if (ret < 0 && !s->draw_ret)
+        s->draw_ret = ret;
+    s->draw_queue_head = (s->draw_queue_head + 1) % s->draw_queue_depth;
+    s->nb_queued_draws--;
+    pthread_cond_signal(&s->cond_ctl);
 }
 
 int ngli_ctx_dispatch_cmd(struct ngl_ctx *s, cmd_func_type cmd_func, void *arg)
@@ -379,8 +472,13 @@ static void *worker_thread(void *arg)
 
     pthread_mutex_lock(&s->lock);
     for (;;) {
-        while (!s->cmd_func)
+        while (!s->cmd_func && !s->nb_queued_draws)
             pthread_cond_wait(&s->cond_wkr, &s->lock);
+        /* Queued draws always precede the pending command */
+        if (s->nb_queued_draws) {
+            run_queued_draw(s);
+            continue;
+        }
         s->cmd_ret = s->cmd_func(s, s->cmd_arg);
         int need_stop = s->cmd_func == cmd_stop;
         s->cmd_func = s->cmd_arg = NULL;
@@ -590,6 +688,8 @@ struct ngl_ctx *ngl_create(void)
     if (!s)
         return NULL;
 
+    ngli_simd_init(&s->simd, ngli_cpu_get_flags());
+
     if (pthread_mutex_init(&s->lock, NULL) ||
         pthread_cond_init(&s->cond_ctl, NULL) ||
         pthread_cond_init(&s->cond_wkr, NULL) ||
@@ -622,6 +722,8 @@ fail:
 
 int ngl_configure(struct ngl_ctx *s, struct ngl_config *config)
 {
+    ngli_ctx_wait_draws(s);
+
     if (s->configured) {
         s->api_impl->reset(s, NGLI_ACTION_KEEP_SCENE);
         s->configured = 0;
@@ -653,6 +755,23 @@ int ngl_configure(struct ngl_ctx *s, struct ngl_config *config)
         return NGL_ERROR_INVALID_ARG;
     }
 
+    if (config->draw_queue_depth < 0 ||
+        config->draw_queue_depth > NGL_MAX_DRAW_QUEUE_DEPTH) {
+        LOG(ERROR, "draw queue depth must be in [0,%d]", NGL_MAX_DRAW_QUEUE_DEPTH);
+        return NGL_ERROR_INVALID_ARG;
+    }
+
+    /*
+     * The queue is drained at this point, but its head may point anywhere in
+     * the previous ring, possibly beyond the new depth
+     */
+    pthread_mutex_lock(&s->lock);
+    s->draw_queue_depth = config->draw_queue_depth ? config->draw_queue_depth : DEFAULT_DRAW_QUEUE_DEPTH;
+    s->draw_queue_head = 0;
+    s->nb_queued_draws = 0;
+    s->draw_ret = 0;
+    pthread_mutex_unlock(&s->lock);
+
     s->api_impl = api_map[config->backend].api_impl;
     if (!s->api_impl) {
         LOG(ERROR, "backend \"%s\" not available with this build",
@@ -675,6 +794,8 @@ int ngl_resize(struct ngl_ctx *s, int width, int height, const int *viewport)
         return NGL_ERROR_INVALID_USAGE;
     }
 
+    ngli_ctx_wait_draws(s);
+
     return s->api_impl->resize(s, width, height, viewport);
 }
 
@@ -685,6 +806,8 @@ int ngl_set_capture_buffer(struct ngl_ctx *s, void *capture_buffer)
         return NGL_ERROR_INVALID_USAGE;
     }
 
+    ngli_ctx_wait_draws(s);
+
     int ret = s->api_impl->set_capture_buffer(s, capture_buffer);
     if (ret < 0) {
         s->configured = 0;
@@ -693,6 +816,18 @@ int ngl_set_capture_buffer(struct ngl_ctx *s, void *capture_buffer)
     return ret;
 }
 
+int ngl_capture_acquire(struct ngl_ctx *s, double *t)
+{
+    if (!s->configured) {
+        LOG(ERROR, "context must be configured before acquiring a captured frame");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    ngli_ctx_wait_draws(s);
+
+    return s->api_impl->capture_acquire(s, t);
+}
+
 int ngl_set_scene(struct ngl_ctx *s, struct ngl_node *scene)
 {
     if (!s->configured) {
@@ -700,6 +835,8 @@ int ngl_set_scene(struct ngl_ctx *s, struct ngl_node *scene)
         return NGL_ERROR_INVALID_USAGE;
     }
 
+    ngli_ctx_wait_draws(s);
+
     return s->api_impl->set_scene(s, scene);
 }
 
@@ -710,6 +847,8 @@ int ngli_prepare_draw(struct ngl_ctx *s, double t)
         return NGL_ERROR_INVALID_USAGE;
     }
 
+    ngli_ctx_wait_draws(s);
+
     return s->api_impl->prepare_draw(s, t);
 }
 
@@ -720,9 +859,47 @@ int ngl_draw(struct ngl_ctx *s, double t)
         return NGL_ERROR_INVALID_USAGE;
     }
 
+    ngli_ctx_wait_draws(s);
+
     return s->api_impl->draw(s, t);
 }
 
+int ngl_draw_async(struct ngl_ctx *s, double t)
+{
+    if (!s->configured) {
+        LOG(ERROR, "context must be configured before drawing");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    return s->api_impl->draw_async(s, t);
+}
+
+int ngl_wait(struct ngl_ctx *s)
+{
+    ngli_ctx_wait_draws(s);
+
+    const int ret = s->draw_ret;
+    s->draw_ret = 0;
+    return ret;
+}
+
+char *ngl_profiler_get_trace(struct ngl_ctx *s)
+{
+    if (!s->configured) {
+        LOG(ERROR, "context must be configured before retrieving the profiler trace");
+        return NULL;
+    }
+
+    ngli_ctx_wait_draws(s);
+
+    if (!s->profiler.enabled) {
+        LOG(ERROR, "the profiler must be enabled in the context configuration");
+        return NULL;
+    }
+
+    return ngli_profiler_get_trace(&s->profiler);
+}
+
 int ngl_gl_wrap_framebuffer(struct ngl_ctx *s, uint32_t framebuffer)
 {
     if (!s->configured) {
@@ -730,6 +907,8 @@ int ngl_gl_wrap_framebuffer(struct ngl_ctx *s, uint32_t framebuffer)
         return NGL_ERROR_INVALID_USAGE;
     }
 
+    ngli_ctx_wait_draws(s);
+
     if (!s->api_impl->gl_wrap_framebuffer) {
         LOG(ERROR, "wrapping external OpenGL framebuffer is not supported by context");
         return NGL_ERROR_UNSUPPORTED;
@@ -760,6 +939,8 @@ void ngl_freep(struct ngl_ctx **ss)
     if (!s)
         return;
 
+    ngli_ctx_wait_draws(s);
+
     if (s->configured) {
         s->api_impl->reset(s, NGLI_ACTION_UNREF_SCENE);
         s->configured = 0;
@@ -127,6 +127,22 @@ static int glw_set_capture_buffer(struct ngl_ctx *s, void *capture_buffer)
     return NGL_ERROR_UNSUPPORTED;
 }
 
+static int cmd_capture_acquire(struct ngl_ctx *s, void *t)
+{
+    return ngli_ctx_capture_acquire(s, t);
+}
+
+static int gl_capture_acquire(struct ngl_ctx *s, double *t)
+{
+    return ngli_ctx_dispatch_cmd(s, cmd_capture_acquire, t);
+}
+
+static int glw_capture_acquire(struct ngl_ctx *s, double *t)
+{
+    LOG(ERROR, "capture is not supported by external OpenGL context");
+    return NGL_ERROR_UNSUPPORTED;
+}
+
 static int cmd_set_scene(struct ngl_ctx *s, void *arg)
 {
     struct ngl_node *node = arg;
@@ -184,6 +200,16 @@ static int glw_draw(struct ngl_ctx *s, double t)
     return ret;
 }
 
+static int glw_draw_async(struct ngl_ctx *s, double t)
+{
+    /* External contexts are bound to the user thread so the draw can not be deferred */
+    const int ret = glw_draw(s, t);
+    const struct ngl_config *config = &s->config;
+    if (config->draw_callback)
+        config->draw_callback(config->draw_callback_arg, t, ret);
+    return ret;
+}
+
 static int cmd_reset(struct ngl_ctx *s, void *arg)
 {
     const int action = *(int *)arg;
@@ -243,6 +269,11 @@ static int glv_set_capture_buffer(struct ngl_ctx *s, void *capture_buffer)
     return is_glw(&s->config) ? glw_set_capture_buffer(s, capture_buffer) : gl_set_capture_buffer(s, capture_buffer);
 }
 
+static int glv_capture_acquire(struct ngl_ctx *s, double *t)
+{
+    return is_glw(&s->config) ? glw_capture_acquire(s, t) : gl_capture_acquire(s, t);
+}
+
 static int glv_set_scene(struct ngl_ctx *s, struct ngl_node *node)
 {
     return is_glw(&s->config) ? glw_set_scene(s, node) : gl_set_scene(s, node);
@@ -258,6 +289,11 @@ static int glv_draw(struct ngl_ctx *s, double t)
     return is_glw(&s->config) ? glw_draw(s, t) : gl_draw(s, t);
 }
 
+static int glv_draw_async(struct ngl_ctx *s, double t)
+{
+    return is_glw(&s->config) ? glw_draw_async(s, t) : ngli_ctx_queue_draw(s, t);
+}
+
 static void glv_reset(struct ngl_ctx *s, int action)
 {
     is_glw(&s->config) ? glw_reset(s, action) : gl_reset(s, action);
@@ -272,9 +308,11 @@ const struct api_impl api_gl = {
     .configure           = glv_configure,
     .resize              = glv_resize,
     .set_capture_buffer  = glv_set_capture_buffer,
+    .capture_acquire     = glv_capture_acquire,
     .set_scene           = glv_set_scene,
     .prepare_draw        = glv_prepare_draw,
     .draw                = glv_draw,
+    .draw_async          = glv_draw_async,
     .reset               = glv_reset,
     .gl_wrap_framebuffer = glv_wrap_framebuffer,
 };
@@ -250,6 +250,17 @@ typedef void (NGLI_GL_APIENTRY *GLDEBUGPROC)(GLenum source, GLenum type, GLuint
 # define GL_FRAMEBUFFER_ATTACHMENT_ALPHA_SIZE  0x8215
 # define GL_FRAMEBUFFER_ATTACHMENT_DEPTH_SIZE  0x8216
 # define GL_FRAMEBUFFER_ATTACHMENT_STENCIL_SIZE 0x8217
+# define GL_PIXEL_UNPACK_BUFFER                0x88EC
+# define GL_MAP_WRITE_BIT                      0x0002
+# define GL_MAP_INVALIDATE_BUFFER_BIT          0x0008
+# define GL_MAP_UNSYNCHRONIZED_BIT             0x0020
+# define GL_SYNC_FLUSH_COMMANDS_BIT            0x00000001
+# define GL_WAIT_FAILED                        0x911D
+#endif
+
+#ifndef GL_MAP_PERSISTENT_BIT
+# define GL_MAP_PERSISTENT_BIT                 0x0040
+# define GL_MAP_COHERENT_BIT                   0x0080
 #endif
 
 #if NGL_CS_COMPAT_INCLUDES
@@ -265,6 +276,7 @@ typedef void (NGLI_GL_APIENTRY *GLDEBUGPROC)(GLenum source, GLenum type, GLuint
 # define GL_SHADER_STORAGE_BUFFER_SIZE         0x90D5
 # define GL_UNIFORM_BLOCK                      0x92E2
 # define GL_SHADER_STORAGE_BLOCK               0x92E6
+# define GL_MAX_SHADER_STORAGE_BLOCK_SIZE      0x90DE
 # define GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT 0x90DF
 # define GL_BUFFER_BINDING                     0x9302
 # define GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT    0x00000001
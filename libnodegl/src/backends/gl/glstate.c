@@ -25,6 +25,7 @@
 #include "glcontext.h"
 #include "glincludes.h"
 #include "glstate.h"
+#include "gpu_ctx.h"
 #include "graphicstate.h"
 #include "internal.h"
 
@@ -104,7 +105,9 @@ static GLenum get_gl_cull_mode(int cull_mode)
 
 void ngli_glstate_reset(const struct glcontext *gl, struct glstate *glstate)
 {
+    uint64_t *stats = glstate->stats;
     memset(glstate, 0, sizeof(*glstate));
+    glstate->stats = stats;
 
     /* Blending */
     ngli_glDisable(gl, GL_BLEND);
@@ -174,6 +177,19 @@ void ngli_glstate_reset(const struct glcontext *gl, struct glstate *glstate)
     /* VAO */
     if (gl->features & NGLI_FEATURE_GL_VERTEX_ARRAY_OBJECT)
         ngli_glBindVertexArray(gl, 0);
+    glstate->vertex_array_id = 0;
+
+    /* Textures and buffers, left untouched as there are too many of them */
+    ngli_glActiveTexture(gl, GL_TEXTURE0);
+    glstate->active_texture_unit = 0;
+
+    for (int i = 0; i < NGLI_GLSTATE_MAX_TEXTURE_UNITS; i++)
+        for (int j = 0; j < NGLI_GLSTATE_TEXTURE_NB; j++)
+            glstate->textures[i][j] = NGLI_GLSTATE_UNKNOWN_ID;
+
+    for (int i = 0; i < NGLI_GLSTATE_BUFFER_NB; i++)
+        for (int j = 0; j < NGLI_GLSTATE_MAX_BUFFER_BINDINGS; j++)
+            glstate->buffers[i][j].id = NGLI_GLSTATE_UNKNOWN_ID;
 }
 
 void ngli_glstate_update(const struct glcontext *gl, struct glstate *glstate, const struct graphicstate *state)
@@ -331,6 +347,9 @@ void ngli_glstate_use_program(const struct glcontext *gl, struct glstate *glstat
     if (glstate->program_id != program_id) {
         ngli_glUseProgram(gl, program_id);
         glstate->program_id = program_id;
+        ngli_glstate_count_call(glstate, 0);
+    } else {
+        ngli_glstate_count_call(glstate, 1);
     }
 }
 
@@ -349,3 +368,125 @@ void ngli_glstate_update_viewport(const struct glcontext *gl, struct glstate *gl
     memcpy(glstate->viewport, viewport, sizeof(glstate->viewport));
     ngli_glViewport(gl, viewport[0], viewport[1], viewport[2], viewport[3]);
 }
+
+void ngli_glstate_count_call(struct glstate *glstate, int skipped)
+{
+    glstate->stats[skipped ? NGLI_GPU_STAT_GL_BINDS_SKIPPED : NGLI_GPU_STAT_GL_BINDS]++;
+}
+
+static int get_texture_target_index(GLenum target)
+{
+    switch (target) {
+    case GL_TEXTURE_2D:           return NGLI_GLSTATE_TEXTURE_2D;
+    case GL_TEXTURE_3D:           return NGLI_GLSTATE_TEXTURE_3D;
+    case GL_TEXTURE_CUBE_MAP:     return NGLI_GLSTATE_TEXTURE_CUBE_MAP;
+    case GL_TEXTURE_EXTERNAL_OES: return NGLI_GLSTATE_TEXTURE_EXTERNAL_OES;
+    case GL_TEXTURE_RECTANGLE:    return NGLI_GLSTATE_TEXTURE_RECTANGLE;
+    default:                      return -1;
+    }
+}
+
+static GLuint *get_texture_binding(struct glstate *glstate, GLuint unit, GLenum target)
+{
+    const int index = get_texture_target_index(target);
+    if (unit >= NGLI_GLSTATE_MAX_TEXTURE_UNITS || index < 0)
+        return NULL;
+    return &glstate->textures[unit][index];
+}
+
+void ngli_glstate_bind_texture_unit(const struct glcontext *gl, struct glstate *glstate,
+                                    GLuint unit, GLenum target, GLuint texture_id)
+{
+    GLuint *binding = get_texture_binding(glstate, unit, target);
+    if (binding && *binding == texture_id) {
+        ngli_glstate_count_call(glstate, 1);
+        return;
+    }
+
+    if (glstate->active_texture_unit != unit) {
+        ngli_glActiveTexture(gl, GL_TEXTURE0 + unit);
+        glstate->active_texture_unit = unit;
+        ngli_glstate_count_call(glstate, 0);
+    }
+
+    ngli_glBindTexture(gl, target, texture_id);
+    if (binding)
+        *binding = texture_id;
+    ngli_glstate_count_call(glstate, 0);
+}
+
+void ngli_glstate_bind_texture(const struct glcontext *gl, struct glstate *glstate,
+                               GLenum target, GLuint texture_id)
+{
+    ngli_glstate_bind_texture_unit(gl, glstate, glstate->active_texture_unit, target, texture_id);
+}
+
+static struct glstate_buffer_binding *get_buffer_binding(struct glstate *glstate, GLenum target, GLuint binding)
+{
+    if (binding >= NGLI_GLSTATE_MAX_BUFFER_BINDINGS)
+        return NULL;
+    if (target == GL_UNIFORM_BUFFER)
+        return &glstate->buffers[NGLI_GLSTATE_BUFFER_UNIFORM][binding];
+    if (target == GL_SHADER_STORAGE_BUFFER)
+        return &glstate->buffers[NGLI_GLSTATE_BUFFER_STORAGE][binding];
+    return NULL;
+}
+
+void ngli_glstate_bind_buffer_range(const struct glcontext *gl, struct glstate *glstate,
+                                    GLenum target, GLuint binding, GLuint buffer_id,
+                                    GLintptr offset, GLsizeiptr size)
+{
+    struct glstate_buffer_binding *buffer_binding = get_buffer_binding(glstate, target, binding);
+    if (buffer_binding &&
+        buffer_binding->id     == buffer_id &&
+        buffer_binding->offset == offset &&
+        buffer_binding->size   == size) {
+        ngli_glstate_count_call(glstate, 1);
+        return;
+    }
+
+    ngli_glBindBufferRange(gl, target, binding, buffer_id, offset, size);
+    if (buffer_binding) {
+        buffer_binding->id     = buffer_id;
+        buffer_binding->offset = offset;
+        buffer_binding->size   = size;
+    }
+    ngli_glstate_count_call(glstate, 0);
+}
+
+void ngli_glstate_bind_vertex_array(const struct glcontext *gl, struct glstate *glstate, GLuint vertex_array_id)
+{
+    if (glstate->vertex_array_id == vertex_array_id) {
+        ngli_glstate_count_call(glstate, 1);
+        return;
+    }
+
+    ngli_glBindVertexArray(gl, vertex_array_id);
+    glstate->vertex_array_id = vertex_array_id;
+    ngli_glstate_count_call(glstate, 0);
+}
+
+void ngli_glstate_forget_texture(struct glstate *glstate, GLuint texture_id)
+{
+    for (int i = 0; i < NGLI_GLSTATE_MAX_TEXTURE_UNITS; i++)
+        for (int j = 0; j < NGLI_GLSTATE_TEXTURE_NB; j++)
+            if (glstate->textures[i][j] == texture_id)
+                glstate->textures[i][j] = NGLI_GLSTATE_UNKNOWN_ID;
+}
+
+void ngli_glstate_forget_buffer(struct glstate *glstate, GLuint buffer_id)
+{
+    for (int i = 0; i < NGLI_GLSTATE_BUFFER_NB; i++) {
+        for (int j = 0; j < NGLI_GLSTATE_MAX_BUFFER_BINDINGS; j++) {
+            struct glstate_buffer_binding *binding = &glstate->buffers[i][j];
+            if (binding->id == buffer_id)
+                binding->id = NGLI_GLSTATE_UNKNOWN_ID;
+        }
+    }
+}
+
+void ngli_glstate_forget_vertex_array(struct glstate *glstate, GLuint vertex_array_id)
+{
+    if (glstate->vertex_array_id == vertex_array_id)
+        glstate->vertex_array_id = NGLI_GLSTATE_UNKNOWN_ID;
+}
@@ -22,11 +22,38 @@
 #ifndef GLSTATE_H
 #define GLSTATE_H
 
+#include <stdint.h>
+
 #include "glcontext.h"
 #include "glincludes.h"
 
 struct graphicstate;
 
+/* Number of texture units and indexed buffer bindings shadowed by the state */
+#define NGLI_GLSTATE_MAX_TEXTURE_UNITS   64
+#define NGLI_GLSTATE_MAX_BUFFER_BINDINGS 64
+
+enum {
+    NGLI_GLSTATE_TEXTURE_2D,
+    NGLI_GLSTATE_TEXTURE_3D,
+    NGLI_GLSTATE_TEXTURE_CUBE_MAP,
+    NGLI_GLSTATE_TEXTURE_EXTERNAL_OES,
+    NGLI_GLSTATE_TEXTURE_RECTANGLE,
+    NGLI_GLSTATE_TEXTURE_NB
+};
+
+enum {
+    NGLI_GLSTATE_BUFFER_UNIFORM,
+    NGLI_GLSTATE_BUFFER_STORAGE,
+    NGLI_GLSTATE_BUFFER_NB
+};
+
+struct glstate_buffer_binding {
+    GLuint id;
+    GLintptr offset;
+    GLsizeiptr size;
+};
+
 struct glstate {
     /* Graphics state */
     GLenum blend;
@@ -63,8 +90,25 @@ struct glstate {
 
     /* Common state */
     GLuint program_id;
+
+    /*
+     * Resource bindings. Bindings in an unknown state (after a reset) are set
+     * to NGLI_GLSTATE_UNKNOWN_ID so that the next binding is always issued.
+     */
+    GLuint active_texture_unit;
+    GLuint textures[NGLI_GLSTATE_MAX_TEXTURE_UNITS][NGLI_GLSTATE_TEXTURE_NB];
+    struct glstate_buffer_binding buffers[NGLI_GLSTATE_BUFFER_NB][NGLI_GLSTATE_MAX_BUFFER_BINDINGS];
+    GLuint vertex_array_id;
+
+    /*
+     * Backend counters (NGLI_GPU_STAT_GL_BINDS*) of the issued and skipped
+     * binding calls, preserved across resets
+     */
+    uint64_t *stats;
 };
 
+#define NGLI_GLSTATE_UNKNOWN_ID ((GLuint)-1)
+
 void ngli_glstate_reset(const struct glcontext *gl,
                         struct glstate *glstate);
 
@@ -84,4 +128,49 @@ void ngli_glstate_update_viewport(const struct glcontext *gl,
                                   struct glstate *glstate,
                                   const int *viewport);
 
+/* Bind a texture to the given unit, activating the unit if needed */
+void ngli_glstate_bind_texture_unit(const struct glcontext *gl,
+                                    struct glstate *glstate,
+                                    GLuint unit,
+                                    GLenum target,
+                                    GLuint texture_id);
+
+/*
+ * Bind a texture to the currently active unit. Any texture binding done
+ * outside of the pipelines (uploads, hardware mapping, ...) must go through
+ * this function to keep the state in sync.
+ */
+void ngli_glstate_bind_texture(const struct glcontext *gl,
+                               struct glstate *glstate,
+                               GLenum target,
+                               GLuint texture_id);
+
+void ngli_glstate_bind_buffer_range(const struct glcontext *gl,
+                                    struct glstate *glstate,
+                                    GLenum target,
+                                    GLuint binding,
+                                    GLuint buffer_id,
+                                    GLintptr offset,
+                                    GLsizeiptr size);
+
+void ngli_glstate_bind_vertex_array(const struct glcontext *gl,
+                                    struct glstate *glstate,
+                                    GLuint vertex_array_id);
+
+/*
+ * Account for a binding call issued (skipped=0) or skipped (skipped=1) by a
+ * cache living outside of the state, such as the program uniform values
+ */
+void ngli_glstate_count_call(struct glstate *glstate, int skipped);
+
+/*
+ * Mark the bindings of an object as unknown. These functions must be called
+ * when the corresponding objects are deleted (or stop being managed by the
+ * texture and buffer wrappers) since OpenGL resets their bindings and may
+ * recycle their names.
+ */
+void ngli_glstate_forget_texture(struct glstate *glstate, GLuint texture_id);
+void ngli_glstate_forget_buffer(struct glstate *glstate, GLuint buffer_id);
+void ngli_glstate_forget_vertex_array(struct glstate *glstate, GLuint vertex_array_id);
+
 #endif
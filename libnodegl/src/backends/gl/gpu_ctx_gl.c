@@ -56,6 +56,31 @@ static void capture_cpu(struct gpu_ctx *s)
     ngli_glReadPixels(gl, 0, 0, rt->width, rt->height, GL_RGBA, GL_UNSIGNED_BYTE, config->capture_buffer);
 }
 
+static void capture_cpu_async(struct gpu_ctx *s)
+{
+    struct gpu_ctx_gl *s_priv = (struct gpu_ctx_gl *)s;
+    struct glcontext *gl = s_priv->glcontext;
+    const struct ngl_config *config = &s->config;
+    struct rendertarget *rt = s_priv->default_rt;
+    struct rendertarget_gl *rt_gl = (struct rendertarget_gl *)rt;
+
+    const int index = (s_priv->async_capture_index + s_priv->nb_pending_captures) % config->capture_async_depth;
+    struct async_capture_gl *capture = &s_priv->async_captures[index];
+
+    const GLuint fbo_id = rt_gl->resolve_id ? rt_gl->resolve_id : rt_gl->id;
+    ngli_glBindFramebuffer(gl, GL_FRAMEBUFFER, fbo_id);
+    ngli_glBindBuffer(gl, GL_PIXEL_PACK_BUFFER, capture->pbo);
+    ngli_glReadPixels(gl, 0, 0, rt->width, rt->height, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    ngli_glBindBuffer(gl, GL_PIXEL_PACK_BUFFER, 0);
+
+    capture->fence = ngli_glFenceSync(gl, GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    capture->t = s_priv->capture_time;
+    s_priv->nb_pending_captures++;
+
+    /* Kick off the transfer without waiting for it */
+    ngli_glFlush(gl);
+}
+
 static void capture_corevideo(struct gpu_ctx *s)
 {
     struct gpu_ctx_gl *s_priv = (struct gpu_ctx_gl *)s;
@@ -96,10 +121,10 @@ static int wrap_capture_cvpixelbuffer(struct gpu_ctx *s,
     }
 
     GLuint id = CVOpenGLESTextureGetName(cv_texture);
-    ngli_glBindTexture(gl, GL_TEXTURE_2D, id);
+    ngli_glstate_bind_texture(gl, &s_priv->glstate, GL_TEXTURE_2D, id);
     ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    ngli_glBindTexture(gl, GL_TEXTURE_2D, 0);
+    ngli_glstate_bind_texture(gl, &s_priv->glstate, GL_TEXTURE_2D, 0);
 
     struct texture *texture = ngli_texture_create(s);
     if (!texture) {
@@ -157,10 +182,10 @@ static int wrap_capture_cvpixelbuffer(struct gpu_ctx *s,
     }
 
     GLuint fbName = CVOpenGLTextureGetName(cv_texture);
-    ngli_glBindTexture(gl, GL_TEXTURE_RECTANGLE, fbName);
+    ngli_glstate_bind_texture(gl, &s_priv->glstate, GL_TEXTURE_RECTANGLE, fbName);
     ngli_glTexParameteri(gl, GL_TEXTURE_RECTANGLE, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     ngli_glTexParameteri(gl, GL_TEXTURE_RECTANGLE, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    ngli_glBindTexture(gl, GL_TEXTURE_RECTANGLE, 0);
+    ngli_glstate_bind_texture(gl, &s_priv->glstate, GL_TEXTURE_RECTANGLE, 0);
 
     struct texture *texture = ngli_texture_create(s);
     if (!texture) {
@@ -311,6 +336,54 @@ static int create_rendertarget(struct gpu_ctx *s,
     return 0;
 }
 
+static int async_capture_init(struct gpu_ctx *s)
+{
+    struct gpu_ctx_gl *s_priv = (struct gpu_ctx_gl *)s;
+    struct glcontext *gl = s_priv->glcontext;
+    const struct ngl_config *config = &s->config;
+
+    const uint64_t features = NGLI_FEATURE_GL_SYNC | NGLI_FEATURE_GL_MAP_BUFFER_RANGE;
+    if ((gl->features & features) != features) {
+        LOG(ERROR, "context does not support asynchronous capture");
+        return NGL_ERROR_GRAPHICS_UNSUPPORTED;
+    }
+
+    s_priv->async_captures = ngli_calloc(config->capture_async_depth, sizeof(*s_priv->async_captures));
+    if (!s_priv->async_captures)
+        return NGL_ERROR_MEMORY;
+
+    const GLsizeiptr size = (GLsizeiptr)config->width * config->height * 4;
+    for (int i = 0; i < config->capture_async_depth; i++) {
+        struct async_capture_gl *capture = &s_priv->async_captures[i];
+        ngli_glGenBuffers(gl, 1, &capture->pbo);
+        ngli_glBindBuffer(gl, GL_PIXEL_PACK_BUFFER, capture->pbo);
+        ngli_glBufferData(gl, GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ);
+    }
+    ngli_glBindBuffer(gl, GL_PIXEL_PACK_BUFFER, 0);
+
+    return 0;
+}
+
+static void async_capture_reset(struct gpu_ctx *s)
+{
+    struct gpu_ctx_gl *s_priv = (struct gpu_ctx_gl *)s;
+    struct glcontext *gl = s_priv->glcontext;
+    const struct ngl_config *config = &s->config;
+
+    if (!s_priv->async_captures)
+        return;
+
+    for (int i = 0; i < config->capture_async_depth; i++) {
+        struct async_capture_gl *capture = &s_priv->async_captures[i];
+        if (capture->fence)
+            ngli_glDeleteSync(gl, capture->fence);
+        ngli_glDeleteBuffers(gl, 1, &capture->pbo);
+    }
+    ngli_freep(&s_priv->async_captures);
+    s_priv->async_capture_index = 0;
+    s_priv->nb_pending_captures = 0;
+}
+
 static int offscreen_rendertarget_init(struct gpu_ctx *s)
 {
     struct gpu_ctx_gl *s_priv = (struct gpu_ctx_gl *)s;
@@ -344,6 +417,12 @@ static int offscreen_rendertarget_init(struct gpu_ctx *s)
         int ret = create_texture(s, NGLI_FORMAT_R8G8B8A8_UNORM, 0, &s_priv->color);
         if (ret < 0)
             return ret;
+
+        if (config->capture_async_depth) {
+            ret = async_capture_init(s);
+            if (ret < 0)
+                return ret;
+        }
     } else {
         LOG(ERROR, "unsupported capture buffer type: %d", config->capture_buffer_type);
         return NGL_ERROR_UNSUPPORTED;
@@ -374,6 +453,8 @@ static int offscreen_rendertarget_init(struct gpu_ctx *s)
         [NGL_CAPTURE_BUFFER_TYPE_COREVIDEO] = capture_corevideo,
     };
     s_priv->capture_func = capture_func_map[config->capture_buffer_type];
+    if (s_priv->async_captures)
+        s_priv->capture_func = capture_cpu_async;
 
     return 0;
 }
@@ -403,6 +484,7 @@ static void rendertarget_reset(struct gpu_ctx *s)
 #if defined(TARGET_IPHONE) || defined(TARGET_DARWIN)
     reset_capture_cvpixelbuffer(s);
 #endif
+    async_capture_reset(s);
     s_priv->capture_func = NULL;
 }
 
@@ -437,7 +519,21 @@ static int timer_init(struct gpu_ctx *s)
         s_priv->glQueryCounter        = (void *)noop;
         s_priv->glGetQueryObjectui64v = (void *)noop;
     }
-    s_priv->glGenQueries(gl, 2, s_priv->queries);
+    s_priv->glGenQueries(gl, 2 * NGLI_GPU_NB_QUERY_FRAMES, &s_priv->queries[0][0]);
+    s_priv->query_frame = -1;
+    s_priv->draw_time_frame = -1;
+
+#if !defined(TARGET_DARWIN)
+    const struct ngl_config *config = &s->config;
+    const uint64_t timer_features = NGLI_FEATURE_GL_TIMER_QUERY | NGLI_FEATURE_GL_EXT_DISJOINT_TIMER_QUERY;
+    if (config->profiler && (gl->features & timer_features)) {
+        const int nb_queries = NGLI_GPU_NB_QUERY_FRAMES * NGLI_GPU_MAX_TIMESTAMPS;
+        s_priv->timestamp_queries = ngli_calloc(nb_queries, sizeof(*s_priv->timestamp_queries));
+        if (!s_priv->timestamp_queries)
+            return NGL_ERROR_MEMORY;
+        s_priv->glGenQueries(gl, nb_queries, s_priv->timestamp_queries);
+    }
+#endif
 
     return 0;
 }
@@ -448,7 +544,10 @@ static void timer_reset(struct gpu_ctx *s)
     struct glcontext *gl = s_priv->glcontext;
 
     if (s_priv->glDeleteQueries)
-        s_priv->glDeleteQueries(gl, 2, s_priv->queries);
+        s_priv->glDeleteQueries(gl, 2 * NGLI_GPU_NB_QUERY_FRAMES, &s_priv->queries[0][0]);
+    if (s_priv->timestamp_queries)
+        s_priv->glDeleteQueries(gl, NGLI_GPU_NB_QUERY_FRAMES * NGLI_GPU_MAX_TIMESTAMPS, s_priv->timestamp_queries);
+    ngli_freep(&s_priv->timestamp_queries);
 }
 
 static struct gpu_ctx *gl_create(const struct ngl_config *config)
@@ -519,6 +618,8 @@ static int gl_init(struct gpu_ctx *s)
     const struct ngl_config_gl *config_gl = config->backend_config;
     struct gpu_ctx_gl *s_priv = (struct gpu_ctx_gl *)s;
 
+    s_priv->glstate.stats = s->stats;
+
     const int external = config_gl ? config_gl->external : 0;
     if (external) {
         if (config->width <= 0 || config->height <= 0) {
@@ -526,7 +627,7 @@ static int gl_init(struct gpu_ctx *s)
                 config->width, config->height);
             return NGL_ERROR_INVALID_ARG;
         }
-        if (config->capture_buffer) {
+        if (config->capture_buffer || config->capture_async_depth) {
             LOG(ERROR, "capture_buffer is not supported by external context");
             return NGL_ERROR_INVALID_ARG;
         }
@@ -873,11 +974,20 @@ static int gl_begin_draw(struct gpu_ctx *s, double t)
     struct glcontext *gl = s_priv->glcontext;
     const struct ngl_config *config = &s->config;
 
+    if (s_priv->async_captures && config->capture_buffer &&
+        s_priv->nb_pending_captures == config->capture_async_depth) {
+        LOG(ERROR, "all the asynchronous captures are pending, ngl_capture_acquire() must be called first");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+    s_priv->capture_time = t;
+
+    s_priv->query_frame++;
+    const int query_index = s_priv->query_frame % NGLI_GPU_NB_QUERY_FRAMES;
     if (config->hud)
 #if defined(TARGET_DARWIN)
-        s_priv->glBeginQuery(gl, GL_TIME_ELAPSED, s_priv->queries[0]);
+        s_priv->glBeginQuery(gl, GL_TIME_ELAPSED, s_priv->queries[query_index][0]);
 #else
-        s_priv->glQueryCounter(gl, s_priv->queries[0], GL_TIMESTAMP);
+        s_priv->glQueryCounter(gl, s_priv->queries[query_index][0], GL_TIMESTAMP);
 #endif
 
     return 0;
@@ -906,6 +1016,57 @@ static int gl_end_draw(struct gpu_ctx *s, double t)
     return ret;
 }
 
+static int gl_capture_acquire(struct gpu_ctx *s, double *t)
+{
+    struct gpu_ctx_gl *s_priv = (struct gpu_ctx_gl *)s;
+    struct glcontext *gl = s_priv->glcontext;
+    const struct ngl_config *config = &s->config;
+
+    if (!s_priv->nb_pending_captures)
+        return 0;
+
+    struct async_capture_gl *capture = &s_priv->async_captures[s_priv->async_capture_index];
+    s_priv->async_capture_index = (s_priv->async_capture_index + 1) % config->capture_async_depth;
+    s_priv->nb_pending_captures--;
+
+    GLenum status;
+    do {
+        status = ngli_glClientWaitSync(gl, capture->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+    } while (status == GL_TIMEOUT_EXPIRED);
+    ngli_glDeleteSync(gl, capture->fence);
+    capture->fence = NULL;
+    if (status == GL_WAIT_FAILED) {
+        LOG(ERROR, "failed to wait for the capture readback");
+        return NGL_ERROR_GRAPHICS_GENERIC;
+    }
+
+    const GLsizeiptr size = (GLsizeiptr)config->width * config->height * 4;
+    ngli_glBindBuffer(gl, GL_PIXEL_PACK_BUFFER, capture->pbo);
+    const void *data = ngli_glMapBufferRange(gl, GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+    if (!data) {
+        ngli_glBindBuffer(gl, GL_PIXEL_PACK_BUFFER, 0);
+        return NGL_ERROR_GRAPHICS_GENERIC;
+    }
+    memcpy(config->capture_buffer, data, size);
+    ngli_glUnmapBuffer(gl, GL_PIXEL_PACK_BUFFER);
+    ngli_glBindBuffer(gl, GL_PIXEL_PACK_BUFFER, 0);
+
+    if (t)
+        *t = capture->t;
+
+    return 1;
+}
+
+static int query_available(struct gpu_ctx *s, GLuint query)
+{
+    struct gpu_ctx_gl *s_priv = (struct gpu_ctx_gl *)s;
+    struct glcontext *gl = s_priv->glcontext;
+
+    GLuint64 available = 0;
+    s_priv->glGetQueryObjectui64v(gl, query, GL_QUERY_RESULT_AVAILABLE, &available);
+    return available != 0;
+}
+
 static int gl_query_draw_time(struct gpu_ctx *s, int64_t *time)
 {
     struct gpu_ctx_gl *s_priv = (struct gpu_ctx_gl *)s;
@@ -915,25 +1076,90 @@ static int gl_query_draw_time(struct gpu_ctx *s, int64_t *time)
     if (!config->hud)
         return NGL_ERROR_INVALID_USAGE;
 
+    const int query_index = s_priv->query_frame % NGLI_GPU_NB_QUERY_FRAMES;
 #if defined(TARGET_DARWIN)
-    GLuint64 time_elapsed = 0;
     s_priv->glEndQuery(gl, GL_TIME_ELAPSED);
-    s_priv->glGetQueryObjectui64v(gl, s_priv->queries[0], GL_QUERY_RESULT, &time_elapsed);
-    *time = time_elapsed;
 #else
-    s_priv->glQueryCounter(gl, s_priv->queries[1], GL_TIMESTAMP);
+    s_priv->glQueryCounter(gl, s_priv->queries[query_index][1], GL_TIMESTAMP);
+#endif
+
+    /* Pick the most recent frame whose results are available, without waiting */
+    const int64_t max_latency = NGLI_MIN(NGLI_GPU_NB_QUERY_FRAMES - 1, s_priv->query_frame);
+    for (int latency = 1; latency <= max_latency; latency++) {
+        const int64_t frame = s_priv->query_frame - latency;
+        if (frame <= s_priv->draw_time_frame)
+            break;
+
+        const GLuint *queries = s_priv->queries[frame % NGLI_GPU_NB_QUERY_FRAMES];
+#if defined(TARGET_DARWIN)
+        if (!query_available(s, queries[0]))
+            continue;
+
+        GLuint64 time_elapsed = 0;
+        s_priv->glGetQueryObjectui64v(gl, queries[0], GL_QUERY_RESULT, &time_elapsed);
+        *time = time_elapsed;
+#else
+        if (!query_available(s, queries[1]))
+            continue;
 
-    GLuint64 start_time = 0;
-    s_priv->glGetQueryObjectui64v(gl, s_priv->queries[0], GL_QUERY_RESULT, &start_time);
+        GLuint64 start_time = 0;
+        s_priv->glGetQueryObjectui64v(gl, queries[0], GL_QUERY_RESULT, &start_time);
 
-    GLuint64 end_time = 0;
-    s_priv->glGetQueryObjectui64v(gl, s_priv->queries[1], GL_QUERY_RESULT, &end_time);
+        GLuint64 end_time = 0;
+        s_priv->glGetQueryObjectui64v(gl, queries[1], GL_QUERY_RESULT, &end_time);
 
-    *time = end_time - start_time;
+        *time = end_time - start_time;
 #endif
+        s_priv->draw_time_frame = frame;
+        return latency;
+    }
+
     return 0;
 }
 
+static int gl_write_timestamp(struct gpu_ctx *s, int index)
+{
+    struct gpu_ctx_gl *s_priv = (struct gpu_ctx_gl *)s;
+    struct glcontext *gl = s_priv->glcontext;
+
+    if (!s_priv->timestamp_queries)
+        return NGL_ERROR_UNSUPPORTED;
+
+    const int query_index = s_priv->query_frame % NGLI_GPU_NB_QUERY_FRAMES;
+    const GLuint *queries = s_priv->timestamp_queries + query_index * NGLI_GPU_MAX_TIMESTAMPS;
+    s_priv->glQueryCounter(gl, queries[index], GL_TIMESTAMP);
+    return 0;
+}
+
+static int gl_get_timestamps(struct gpu_ctx *s, int latency, int64_t *timestamps, int nb_timestamps)
+{
+    struct gpu_ctx_gl *s_priv = (struct gpu_ctx_gl *)s;
+    struct glcontext *gl = s_priv->glcontext;
+
+    if (!s_priv->timestamp_queries)
+        return NGL_ERROR_UNSUPPORTED;
+
+    if (latency > s_priv->query_frame)
+        return NGL_ERROR_INVALID_USAGE;
+
+    if (!nb_timestamps)
+        return 1;
+
+    const int query_index = (s_priv->query_frame - latency) % NGLI_GPU_NB_QUERY_FRAMES;
+    const GLuint *queries = s_priv->timestamp_queries + query_index * NGLI_GPU_MAX_TIMESTAMPS;
+
+    /* Queries complete in order: the last one being available implies all the others are */
+    if (!query_available(s, queries[nb_timestamps - 1]))
+        return 0;
+
+    for (int i = 0; i < nb_timestamps; i++) {
+        GLuint64 timestamp = 0;
+        s_priv->glGetQueryObjectui64v(gl, queries[i], GL_QUERY_RESULT, &timestamp);
+        timestamps[i] = timestamp;
+    }
+    return 1;
+}
+
 static void gl_wait_idle(struct gpu_ctx *s)
 {
     struct gpu_ctx_gl *s_priv = (struct gpu_ctx_gl *)s;
@@ -1050,11 +1276,14 @@ const struct gpu_ctx_class ngli_gpu_ctx_##cls_suffix = {
     .init                               = gl_init,                               \
     .resize                             = gl_resize,                             \
     .set_capture_buffer                 = gl_set_capture_buffer,                 \
+    .capture_acquire                    = gl_capture_acquire,                    \
     .begin_update                       = gl_begin_update,                       \
     .end_update                         = gl_end_update,                         \
     .begin_draw                         = gl_begin_draw,                         \
     .end_draw                           = gl_end_draw,                           \
     .query_draw_time                    = gl_query_draw_time,                    \
+    .write_timestamp                    = gl_write_timestamp,                    \
+    .get_timestamps                     = gl_get_timestamps,                     \
     .wait_idle                          = gl_wait_idle,                          \
     .destroy                            = gl_destroy,                            \
                                                                                  \
@@ -1089,6 +1318,7 @@ const struct gpu_ctx_class ngli_gpu_ctx_##cls_suffix = {
     .pipeline_update_uniform            = ngli_pipeline_gl_update_uniform,       \
     .pipeline_update_texture            = ngli_pipeline_gl_update_texture,       \
     .pipeline_update_buffer             = ngli_pipeline_gl_update_buffer,        \
+    .pipeline_update_dynamic_offsets    = ngli_pipeline_gl_update_dynamic_offsets,\
     .pipeline_draw                      = ngli_pipeline_gl_draw,                 \
     .pipeline_draw_indexed              = ngli_pipeline_gl_draw_indexed,         \
     .pipeline_dispatch                  = ngli_pipeline_gl_dispatch,             \
@@ -1096,6 +1326,8 @@ const struct gpu_ctx_class ngli_gpu_ctx_##cls_suffix = {
                                                                                  \
     .program_create                     = ngli_program_gl_create,                \
     .program_init                       = ngli_program_gl_init,                  \
+    .program_init_from_binary           = ngli_program_gl_init_from_binary,      \
+    .program_get_binary                 = ngli_program_gl_get_binary,            \
     .program_freep                      = ngli_program_gl_freep,                 \
                                                                                  \
     .rendertarget_create                = ngli_rendertarget_gl_create,           \
@@ -41,6 +41,12 @@ struct rendertarget;
 
 typedef void (*capture_func_type)(struct gpu_ctx *s);
 
+struct async_capture_gl {
+    GLuint pbo;
+    GLsync fence;
+    double t;
+};
+
 #define NGLI_CFRELEASE(ref) do { \
     if (ref) {                   \
         CFRelease(ref);          \
@@ -75,8 +81,16 @@ struct gpu_ctx_gl {
 #elif defined(TARGET_DARWIN)
     CVOpenGLTextureRef capture_cvtexture;
 #endif
-    /* Timer */
-    GLuint queries[2];
+    /* Asynchronous capture ring (PBOs), see ngl_config.capture_async_depth */
+    struct async_capture_gl *async_captures;
+    int async_capture_index; /* Index of the oldest pending capture */
+    int nb_pending_captures;
+    double capture_time;
+    /* Timer queries, one set per frame of the NGLI_GPU_NB_QUERY_FRAMES ring */
+    GLuint queries[NGLI_GPU_NB_QUERY_FRAMES][2];
+    GLuint *timestamp_queries; /* Profiler timestamps, NGLI_GPU_MAX_TIMESTAMPS entries per frame */
+    int64_t query_frame;       /* Index of the current frame, -1 before the first draw */
+    int64_t draw_time_frame;   /* Index of the last frame whose draw time was returned */
     void (*glGenQueries)(const struct glcontext *gl, GLsizei n, GLuint * ids);
     void (*glDeleteQueries)(const struct glcontext *gl, GLsizei n, const GLuint *ids);
     void (*glBeginQuery)(const struct glcontext *gl, GLenum target, GLuint id);
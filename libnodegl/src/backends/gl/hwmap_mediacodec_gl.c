@@ -85,12 +85,12 @@ static int mc_init(struct hwmap *hwmap, struct sxplayer_frame *frame)
     const GLint min_filter = ngli_texture_get_gl_min_filter(params->texture_min_filter, NGLI_MIPMAP_FILTER_NONE);
     const GLint mag_filter = ngli_texture_get_gl_mag_filter(params->texture_mag_filter);
 
-    ngli_glBindTexture(gl, GL_TEXTURE_EXTERNAL_OES, mc->gl_texture);
+    ngli_glstate_bind_texture(gl, &gpu_ctx_gl->glstate, GL_TEXTURE_EXTERNAL_OES, mc->gl_texture);
     ngli_glTexParameteri(gl, GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_MIN_FILTER, min_filter);
     ngli_glTexParameteri(gl, GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_MAG_FILTER, mag_filter);
     ngli_glTexParameteri(gl, GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     ngli_glTexParameteri(gl, GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    ngli_glBindTexture(gl, GL_TEXTURE_EXTERNAL_OES, 0);
+    ngli_glstate_bind_texture(gl, &gpu_ctx_gl->glstate, GL_TEXTURE_EXTERNAL_OES, 0);
 
     struct texture_params texture_params = {
         .type         = NGLI_TEXTURE_TYPE_2D,
@@ -221,7 +221,7 @@ static int mc_map_frame_imagereader(struct hwmap *hwmap, struct sxplayer_frame *
         return NGL_ERROR_EXTERNAL;
     }
 
-    ngli_glBindTexture(gl, GL_TEXTURE_EXTERNAL_OES, id);
+    ngli_glstate_bind_texture(gl, &gpu_ctx_gl->glstate, GL_TEXTURE_EXTERNAL_OES, id);
     ngli_glEGLImageTargetTexture2DOES(gl, GL_TEXTURE_EXTERNAL_OES, mc->egl_image);
 
     ngli_texture_gl_set_dimensions(mc->texture, frame->width, frame->height, 0);
@@ -41,17 +41,21 @@ struct uniform_binding {
     set_uniform_func set;
     struct pipeline_uniform_desc desc;
     const void *data;
+    int value_index;
 };
 
 struct texture_binding {
     struct pipeline_texture_desc desc;
     const struct texture *texture;
+    int value_index;
 };
 
 struct buffer_binding {
     GLuint type;
     struct pipeline_buffer_desc desc;
     const struct buffer *buffer;
+    int dynamic;
+    uint32_t dynamic_offset;
 };
 
 struct attribute_binding {
@@ -147,6 +151,24 @@ static const set_uniform_func set_uniform_func_map[NGLI_TYPE_NB] = {
     [NGLI_TYPE_MAT4]   = set_uniform_mat4fv,
 };
 
+static const int uniform_size_map[NGLI_TYPE_NB] = {
+    [NGLI_TYPE_BOOL]   = sizeof(GLint),
+    [NGLI_TYPE_INT]    = sizeof(GLint),
+    [NGLI_TYPE_IVEC2]  = sizeof(GLint) * 2,
+    [NGLI_TYPE_IVEC3]  = sizeof(GLint) * 3,
+    [NGLI_TYPE_IVEC4]  = sizeof(GLint) * 4,
+    [NGLI_TYPE_UINT]   = sizeof(GLuint),
+    [NGLI_TYPE_UIVEC2] = sizeof(GLuint) * 2,
+    [NGLI_TYPE_UIVEC3] = sizeof(GLuint) * 3,
+    [NGLI_TYPE_UIVEC4] = sizeof(GLuint) * 4,
+    [NGLI_TYPE_FLOAT]  = sizeof(GLfloat),
+    [NGLI_TYPE_VEC2]   = sizeof(GLfloat) * 2,
+    [NGLI_TYPE_VEC3]   = sizeof(GLfloat) * 3,
+    [NGLI_TYPE_VEC4]   = sizeof(GLfloat) * 4,
+    [NGLI_TYPE_MAT3]   = sizeof(GLfloat) * 3 * 3,
+    [NGLI_TYPE_MAT4]   = sizeof(GLfloat) * 4 * 4,
+};
+
 static int build_uniform_bindings(struct pipeline *s, const struct pipeline_params *params)
 {
     struct pipeline_gl *s_priv = (struct pipeline_gl *)s;
@@ -176,10 +198,15 @@ static int build_uniform_bindings(struct pipeline *s, const struct pipeline_para
 
         const set_uniform_func set_func = set_uniform_func_map[uniform_desc->type];
         ngli_assert(set_func);
+        const int size = uniform_size_map[uniform_desc->type] * uniform_desc->count;
+        const int value_index = ngli_program_gl_get_uniform_index((struct program *)program, info->location, size);
+        if (value_index < 0)
+            return value_index;
         struct uniform_binding binding = {
             .location = info->location,
             .set = set_func,
             .desc = *uniform_desc,
+            .value_index = value_index,
         };
         if (!ngli_darray_push(&s_priv->uniform_bindings, &binding))
             return NGL_ERROR_MEMORY;
@@ -188,7 +215,20 @@ static int build_uniform_bindings(struct pipeline *s, const struct pipeline_para
     return 0;
 }
 
-static void set_uniforms(struct pipeline *s, struct glcontext *gl)
+/* Must be called with the program of the pipeline in use */
+static void set_uniform(struct pipeline *s, struct glcontext *gl, struct glstate *glstate,
+                        const struct uniform_binding *uniform_binding, const void *data)
+{
+    struct program *program = (struct program *)s->program;
+    if (!ngli_program_gl_update_uniform_value(program, uniform_binding->value_index, data)) {
+        ngli_glstate_count_call(glstate, 1);
+        return;
+    }
+    uniform_binding->set(gl, uniform_binding->location, uniform_binding->desc.count, data);
+    ngli_glstate_count_call(glstate, 0);
+}
+
+static void set_uniforms(struct pipeline *s, struct glcontext *gl, struct glstate *glstate)
 {
     struct pipeline_gl *s_priv = (struct pipeline_gl *)s;
 
@@ -196,7 +236,7 @@ static void set_uniforms(struct pipeline *s, struct glcontext *gl)
     for (int i = 0; i < ngli_darray_count(&s_priv->uniform_bindings); i++) {
         const struct uniform_binding *uniform_binding = &bindings[i];
         if (uniform_binding->data)
-            uniform_binding->set(gl, uniform_binding->location, uniform_binding->desc.count, uniform_binding->data);
+            set_uniform(s, gl, glstate, uniform_binding, uniform_binding->data);
     }
 }
 
@@ -238,7 +278,19 @@ static int build_texture_bindings(struct pipeline *s, const struct pipeline_para
 
         struct texture_binding binding = {
             .desc = *texture_desc,
+            .value_index = -1,
         };
+
+        if (texture_desc->type != NGLI_TYPE_IMAGE_2D &&
+            texture_desc->type != NGLI_TYPE_IMAGE_2D_ARRAY &&
+            texture_desc->type != NGLI_TYPE_IMAGE_CUBE &&
+            texture_desc->type != NGLI_TYPE_IMAGE_3D) {
+            struct program *program = (struct program *)params->program;
+            binding.value_index = ngli_program_gl_get_uniform_index(program, texture_desc->location, sizeof(GLint));
+            if (binding.value_index < 0)
+                return binding.value_index;
+        }
+
         if (!ngli_darray_push(&s_priv->texture_bindings, &binding))
             return NGL_ERROR_MEMORY;
     }
@@ -269,7 +321,7 @@ static GLenum get_gl_access(int access)
     return gl_access_map[access];
 }
 
-static void set_textures(struct pipeline *s, struct glcontext *gl)
+static void set_textures(struct pipeline *s, struct glcontext *gl, struct glstate *glstate)
 {
     struct pipeline_gl *s_priv = (struct pipeline_gl *)s;
     uint64_t texture_units = s_priv->used_texture_units;
@@ -298,22 +350,26 @@ static void set_textures(struct pipeline *s, struct glcontext *gl)
             const int texture_index = acquire_next_available_texture_unit(&texture_units);
             if (texture_index < 0)
                 return;
-            ngli_glUniform1i(gl, texture_binding->desc.location, texture_index);
-            ngli_glActiveTexture(gl, GL_TEXTURE0 + texture_index);
+            if (ngli_program_gl_update_uniform_value((struct program *)s->program, texture_binding->value_index, &texture_index)) {
+                ngli_glUniform1i(gl, texture_binding->desc.location, texture_index);
+                ngli_glstate_count_call(glstate, 0);
+            } else {
+                ngli_glstate_count_call(glstate, 1);
+            }
             if (texture) {
-                ngli_glBindTexture(gl, texture_gl->target, texture_gl->id);
+                ngli_glstate_bind_texture_unit(gl, glstate, texture_index, texture_gl->target, texture_gl->id);
             } else {
-                ngli_glBindTexture(gl, GL_TEXTURE_2D, 0);
+                ngli_glstate_bind_texture_unit(gl, glstate, texture_index, GL_TEXTURE_2D, 0);
                 if (gl->features & NGLI_FEATURE_GL_TEXTURE_3D)
-                    ngli_glBindTexture(gl, GL_TEXTURE_3D, 0);
+                    ngli_glstate_bind_texture_unit(gl, glstate, texture_index, GL_TEXTURE_3D, 0);
                 if (gl->features & NGLI_FEATURE_GL_OES_EGL_EXTERNAL_IMAGE)
-                    ngli_glBindTexture(gl, GL_TEXTURE_EXTERNAL_OES, 0);
+                    ngli_glstate_bind_texture_unit(gl, glstate, texture_index, GL_TEXTURE_EXTERNAL_OES, 0);
             }
         }
     }
 }
 
-static void set_buffers(struct pipeline *s, struct glcontext *gl)
+static void set_buffers(struct pipeline *s, struct glcontext *gl, struct glstate *glstate)
 {
     struct pipeline_gl *s_priv = (struct pipeline_gl *)s;
 
@@ -323,9 +379,9 @@ static void set_buffers(struct pipeline *s, struct glcontext *gl)
         const struct buffer *buffer = buffer_binding->buffer;
         const struct buffer_gl *buffer_gl = (const struct buffer_gl *)buffer;
         const struct pipeline_buffer_desc *buffer_desc = &buffer_binding->desc;
-        const int offset = buffer_desc->offset;
-        const int size = buffer_desc->size ? buffer_desc->size : buffer->size;
-        ngli_glBindBufferRange(gl, buffer_binding->type, buffer_desc->binding, buffer_gl->id, offset, size);
+        const int offset = buffer_desc->offset + buffer_binding->dynamic_offset;
+        const size_t size = buffer_desc->size ? buffer_desc->size : buffer->size;
+        ngli_glstate_bind_buffer_range(gl, glstate, buffer_binding->type, buffer_desc->binding, buffer_gl->id, offset, size);
     }
 }
 
@@ -339,7 +395,8 @@ static int build_buffer_bindings(struct pipeline *s, const struct pipeline_param
     for (int i = 0; i < layout->nb_buffers; i++) {
         const struct pipeline_buffer_desc *pipeline_buffer_desc = &layout->buffers_desc[i];
 
-        if (pipeline_buffer_desc->type == NGLI_TYPE_UNIFORM_BUFFER &&
+        if ((pipeline_buffer_desc->type == NGLI_TYPE_UNIFORM_BUFFER ||
+             pipeline_buffer_desc->type == NGLI_TYPE_UNIFORM_BUFFER_DYNAMIC) &&
             !(gl->features & NGLI_FEATURE_GL_UNIFORM_BUFFER_OBJECT)) {
             LOG(ERROR, "context does not support uniform buffer objects");
             return NGL_ERROR_GRAPHICS_UNSUPPORTED;
@@ -355,8 +412,9 @@ static int build_buffer_bindings(struct pipeline *s, const struct pipeline_param
             s_priv->barriers |= GL_ALL_BARRIER_BITS;
 
         struct buffer_binding binding = {
-            .type = ngli_type_get_gl_type(pipeline_buffer_desc->type),
-            .desc = *pipeline_buffer_desc,
+            .type    = ngli_type_get_gl_type(pipeline_buffer_desc->type),
+            .desc    = *pipeline_buffer_desc,
+            .dynamic = pipeline_buffer_desc->type == NGLI_TYPE_UNIFORM_BUFFER_DYNAMIC,
         };
         if (!ngli_darray_push(&s_priv->buffer_bindings, &binding))
             return NGL_ERROR_MEMORY;
@@ -453,11 +511,11 @@ static void init_vertex_attribs(const struct pipeline *s, struct glcontext *gl)
     }
 }
 
-static void bind_vertex_attribs(const struct pipeline *s, struct glcontext *gl)
+static void bind_vertex_attribs(const struct pipeline *s, struct glcontext *gl, struct glstate *glstate)
 {
     const struct pipeline_gl *s_priv = (const struct pipeline_gl *)s;
     if (gl->features & NGLI_FEATURE_GL_VERTEX_ARRAY_OBJECT)
-        ngli_glBindVertexArray(gl, s_priv->vao_id);
+        ngli_glstate_bind_vertex_array(gl, glstate, s_priv->vao_id);
     else
         set_vertex_attribs(s, gl);
 }
@@ -480,7 +538,7 @@ static int pipeline_graphics_init(struct pipeline *s, const struct pipeline_para
 
     if (gl->features & NGLI_FEATURE_GL_VERTEX_ARRAY_OBJECT) {
         ngli_glGenVertexArrays(gl, 1, &s_priv->vao_id);
-        ngli_glBindVertexArray(gl, s_priv->vao_id);
+        ngli_glstate_bind_vertex_array(gl, &gpu_ctx_gl->glstate, s_priv->vao_id);
         init_vertex_attribs(s, gl);
     }
 
@@ -625,7 +683,7 @@ int ngli_pipeline_gl_update_attribute(struct pipeline *s, int index, const struc
         const GLuint size = ngli_format_get_nb_comp(attribute_binding->desc.format);
         const GLint stride = attribute_binding->desc.stride;
         const struct buffer_gl *buffer_gl = (const struct buffer_gl *)buffer;
-        ngli_glBindVertexArray(gl, s_priv->vao_id);
+        ngli_glstate_bind_vertex_array(gl, &gpu_ctx_gl->glstate, s_priv->vao_id);
         ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, buffer_gl->id);
         ngli_glVertexAttribPointer(gl, location, size, GL_FLOAT, GL_FALSE, stride, (void*)(uintptr_t)(attribute_binding->desc.offset));
     }
@@ -649,7 +707,7 @@ int ngli_pipeline_gl_update_uniform(struct pipeline *s, int index, const void *d
         struct glstate *glstate = &gpu_ctx_gl->glstate;
         struct program_gl *program_gl = (struct program_gl *)s->program;
         ngli_glstate_use_program(gl, glstate, program_gl->id);
-        uniform_binding->set(gl, uniform_binding->location, uniform_binding->desc.count, data);
+        set_uniform(s, gl, glstate, uniform_binding, data);
     }
     uniform_binding->data = NULL;
 
@@ -682,10 +740,11 @@ int ngli_pipeline_gl_update_buffer(struct pipeline *s, int index, const struct b
         struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
         struct glcontext *gl = gpu_ctx_gl->glcontext;
         const struct gpu_limits *limits = &gl->limits;
-        if (buffer_binding->desc.type == NGLI_TYPE_UNIFORM_BUFFER) {
+        if (buffer_binding->desc.type == NGLI_TYPE_UNIFORM_BUFFER ||
+            buffer_binding->desc.type == NGLI_TYPE_UNIFORM_BUFFER_DYNAMIC) {
             ngli_assert(buffer->usage & NGLI_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
             if (buffer->size > limits->max_uniform_block_size) {
-                LOG(ERROR, "buffer %s size (%d) exceeds max uniform block size (%d)",
+                LOG(ERROR, "buffer %s size (%zu) exceeds max uniform block size (%d)",
                     buffer_binding->desc.name, buffer->size, limits->max_uniform_block_size);
                 return NGL_ERROR_GRAPHICS_LIMIT_EXCEEDED;
             }
@@ -701,6 +760,24 @@ int ngli_pipeline_gl_update_buffer(struct pipeline *s, int index, const struct b
     return 0;
 }
 
+int ngli_pipeline_gl_update_dynamic_offsets(struct pipeline *s, const uint32_t *offsets, int nb_offsets)
+{
+    struct pipeline_gl *s_priv = (struct pipeline_gl *)s;
+
+    int nb_dynamic_offsets = 0;
+    struct buffer_binding *bindings = ngli_darray_data(&s_priv->buffer_bindings);
+    for (int i = 0; i < ngli_darray_count(&s_priv->buffer_bindings); i++) {
+        struct buffer_binding *buffer_binding = &bindings[i];
+        if (!buffer_binding->dynamic)
+            continue;
+        ngli_assert(nb_dynamic_offsets < nb_offsets);
+        buffer_binding->dynamic_offset = offsets[nb_dynamic_offsets++];
+    }
+    ngli_assert(nb_dynamic_offsets == nb_offsets);
+
+    return 0;
+}
+
 static void get_scissor(struct pipeline *s, int *scissor)
 {
     struct gpu_ctx *gpu_ctx = s->gpu_ctx;
@@ -731,10 +808,10 @@ void ngli_pipeline_gl_draw(struct pipeline *s, int nb_vertices, int nb_instances
     ngli_glstate_update_scissor(gl, glstate, scissor);
     ngli_glstate_use_program(gl, glstate, program_gl->id);
 
-    set_uniforms(s, gl);
-    set_buffers(s, gl);
-    set_textures(s, gl);
-    bind_vertex_attribs(s, gl);
+    set_uniforms(s, gl, glstate);
+    set_buffers(s, gl, glstate);
+    set_textures(s, gl, glstate);
+    bind_vertex_attribs(s, gl, glstate);
 
     if (s_priv->nb_unbound_attributes) {
         LOG(ERROR, "pipeline has unbound vertex attributes");
@@ -774,10 +851,10 @@ void ngli_pipeline_gl_draw_indexed(struct pipeline *s, const struct buffer *indi
     ngli_glstate_update_scissor(gl, glstate, scissor);
     ngli_glstate_use_program(gl, glstate, program_gl->id);
 
-    set_uniforms(s, gl);
-    set_buffers(s, gl);
-    set_textures(s, gl);
-    bind_vertex_attribs(s, gl);
+    set_uniforms(s, gl, glstate);
+    set_buffers(s, gl, glstate);
+    set_textures(s, gl, glstate);
+    bind_vertex_attribs(s, gl, glstate);
 
     if (s_priv->nb_unbound_attributes) {
         LOG(ERROR, "pipeline has unbound vertex attributes");
@@ -814,9 +891,9 @@ void ngli_pipeline_gl_dispatch(struct pipeline *s, int nb_group_x, int nb_group_
     struct program_gl *program_gl = (struct program_gl *)s->program;
 
     ngli_glstate_use_program(gl, glstate, program_gl->id);
-    set_uniforms(s, gl);
-    set_buffers(s, gl);
-    set_textures(s, gl);
+    set_uniforms(s, gl, glstate);
+    set_buffers(s, gl, glstate);
+    set_textures(s, gl, glstate);
 
     ngli_glDispatchCompute(gl, nb_group_x, nb_group_y, nb_group_z);
 
@@ -839,6 +916,7 @@ void ngli_pipeline_gl_freep(struct pipeline **sp)
     struct gpu_ctx *gpu_ctx = s->gpu_ctx;
     struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)gpu_ctx;
     struct glcontext *gl = gpu_ctx_gl->glcontext;
+    ngli_glstate_forget_vertex_array(&gpu_ctx_gl->glstate, s_priv->vao_id);
     ngli_glDeleteVertexArrays(gl, 1, &s_priv->vao_id);
 
     ngli_freep(sp);
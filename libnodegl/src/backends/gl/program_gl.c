@@ -19,6 +19,7 @@
  * under the License.
  */
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -244,12 +245,49 @@ static struct hmap *program_probe_buffer_blocks(struct glcontext *gl, GLuint pid
     return bmap;
 }
 
+static int program_probe(struct program *s)
+{
+    struct program_gl *s_priv = (struct program_gl *)s;
+    struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
+    struct glcontext *gl = gpu_ctx_gl->glcontext;
+
+    s->uniforms = program_probe_uniforms(gl, s_priv->id);
+    s->attributes = program_probe_attributes(gl, s_priv->id);
+    s->buffer_blocks = program_probe_buffer_blocks(gl, s_priv->id);
+    if (!s->uniforms || !s->attributes || !s->buffer_blocks)
+        return NGL_ERROR_MEMORY;
+
+    return 0;
+}
+
+/*
+ * Program binaries are only usable if the program never needs to be relinked
+ * after its creation, which is the case only when the attribute locations are
+ * explicit in the shaders (see ngli_program_gl_set_locations_and_bindings()).
+ */
+static int support_program_binary(const struct gpu_ctx *gpu_ctx)
+{
+    const struct gpu_ctx_gl *gpu_ctx_gl = (const struct gpu_ctx_gl *)gpu_ctx;
+    const struct glcontext *gl = gpu_ctx_gl->glcontext;
+
+    if (!gpu_ctx->config.program_cache_dir)
+        return 0;
+
+    if (!(gl->features & NGLI_FEATURE_GL_GET_PROGRAM_BINARY))
+        return 0;
+
+    if (gl->backend == NGL_BACKEND_OPENGLES)
+        return gpu_ctx->language_version >= 310;
+    return gpu_ctx->language_version >= 410;
+}
+
 struct program *ngli_program_gl_create(struct gpu_ctx *gpu_ctx)
 {
     struct program_gl *s = ngli_calloc(1, sizeof(*s));
     if (!s)
         return NULL;
     s->parent.gpu_ctx = gpu_ctx;
+    ngli_darray_init(&s->uniforms, sizeof(struct program_gl_uniform), 0);
     return (struct program *)s;
 }
 
@@ -300,6 +338,9 @@ int ngli_program_gl_init(struct program *s, const struct program_params *params)
         ngli_glAttachShader(gl, s_priv->id, shader);
     }
 
+    if (support_program_binary(s->gpu_ctx))
+        ngli_glProgramParameteri(gl, s_priv->id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
     ngli_glLinkProgram(gl, s_priv->id);
     ret = program_check_status(gl, s_priv->id, GL_LINK_STATUS);
     if (ret < 0) {
@@ -325,13 +366,9 @@ int ngli_program_gl_init(struct program *s, const struct program_params *params)
     for (int i = 0; i < NGLI_ARRAY_NB(shaders); i++)
         ngli_glDeleteShader(gl, shaders[i].id);
 
-    s->uniforms = program_probe_uniforms(gl, s_priv->id);
-    s->attributes = program_probe_attributes(gl, s_priv->id);
-    s->buffer_blocks = program_probe_buffer_blocks(gl, s_priv->id);
-    if (!s->uniforms || !s->attributes || !s->buffer_blocks) {
-        ret = NGL_ERROR_MEMORY;
+    ret = program_probe(s);
+    if (ret < 0)
         goto fail;
-    }
 
     return 0;
 
@@ -342,12 +379,131 @@ fail:
     return ret;
 }
 
+int ngli_program_gl_init_from_binary(struct program *s, const struct program_params *params,
+                                     const void *data, size_t size)
+{
+    struct program_gl *s_priv = (struct program_gl *)s;
+    struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
+    struct glcontext *gl = gpu_ctx_gl->glcontext;
+
+    if (!support_program_binary(s->gpu_ctx))
+        return NGL_ERROR_GRAPHICS_UNSUPPORTED;
+
+    uint32_t format;
+    if (size <= sizeof(format) || size - sizeof(format) > INT32_MAX)
+        return NGL_ERROR_INVALID_DATA;
+    memcpy(&format, data, sizeof(format));
+
+    const uint8_t *binary = (const uint8_t *)data + sizeof(format);
+    const GLsizei length = (GLsizei)(size - sizeof(format));
+
+    s_priv->id = ngli_glCreateProgram(gl);
+    ngli_glProgramBinary(gl, s_priv->id, format, binary, length);
+
+    /*
+     * The driver is allowed to reject any binary (driver update, different
+     * GPU, ...), in which case the program is not linked and the caller is
+     * expected to fallback on a regular compilation.
+     */
+    GLint status = GL_FALSE;
+    ngli_glGetProgramiv(gl, s_priv->id, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        LOG(DEBUG, "program binary of \"%s\" rejected by the driver",
+            params->label ? params->label : "");
+        return NGL_ERROR_INVALID_DATA;
+    }
+
+    return program_probe(s);
+}
+
+int ngli_program_gl_get_binary(struct program *s, void **datap, size_t *sizep)
+{
+    struct program_gl *s_priv = (struct program_gl *)s;
+    struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
+    struct glcontext *gl = gpu_ctx_gl->glcontext;
+
+    if (!support_program_binary(s->gpu_ctx))
+        return NGL_ERROR_GRAPHICS_UNSUPPORTED;
+
+    GLint length = 0;
+    ngli_glGetProgramiv(gl, s_priv->id, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return NGL_ERROR_GRAPHICS_UNSUPPORTED;
+
+    uint32_t format = 0;
+    const size_t size = sizeof(format) + length;
+    uint8_t *data = ngli_malloc(size);
+    if (!data)
+        return NGL_ERROR_MEMORY;
+
+    GLenum binary_format = 0;
+    GLsizei written = 0;
+    ngli_glGetProgramBinary(gl, s_priv->id, length, &written, &binary_format, data + sizeof(format));
+    if (written != length) {
+        ngli_free(data);
+        return NGL_ERROR_GRAPHICS_GENERIC;
+    }
+
+    format = binary_format;
+    memcpy(data, &format, sizeof(format));
+
+    *datap = data;
+    *sizep = size;
+    return 0;
+}
+
+int ngli_program_gl_get_uniform_index(struct program *s, GLint location, int size)
+{
+    struct program_gl *s_priv = (struct program_gl *)s;
+
+    struct program_gl_uniform *uniforms = ngli_darray_data(&s_priv->uniforms);
+    for (int i = 0; i < ngli_darray_count(&s_priv->uniforms); i++) {
+        if (uniforms[i].location == location) {
+            /* Pipelines sharing a program declare the same uniforms */
+            ngli_assert(uniforms[i].size == size);
+            return i;
+        }
+    }
+
+    struct program_gl_uniform uniform = {
+        .location = location,
+        .size     = size,
+        .data     = ngli_calloc(1, size),
+    };
+    if (!uniform.data)
+        return NGL_ERROR_MEMORY;
+
+    if (!ngli_darray_push(&s_priv->uniforms, &uniform)) {
+        ngli_free(uniform.data);
+        return NGL_ERROR_MEMORY;
+    }
+
+    return ngli_darray_count(&s_priv->uniforms) - 1;
+}
+
+int ngli_program_gl_update_uniform_value(struct program *s, int index, const void *data)
+{
+    struct program_gl *s_priv = (struct program_gl *)s;
+    struct program_gl_uniform *uniform = ngli_darray_get(&s_priv->uniforms, index);
+
+    if (uniform->initialized && !memcmp(uniform->data, data, uniform->size))
+        return 0;
+
+    memcpy(uniform->data, data, uniform->size);
+    uniform->initialized = 1;
+    return 1;
+}
+
 void ngli_program_gl_freep(struct program **sp)
 {
     if (!*sp)
         return;
     struct program *s = *sp;
     struct program_gl *s_priv = (struct program_gl *)s;
+    struct program_gl_uniform *uniforms = ngli_darray_data(&s_priv->uniforms);
+    for (int i = 0; i < ngli_darray_count(&s_priv->uniforms); i++)
+        ngli_free(uniforms[i].data);
+    ngli_darray_reset(&s_priv->uniforms);
     ngli_hmap_freep(&s->uniforms);
     ngli_hmap_freep(&s->attributes);
     ngli_hmap_freep(&s->buffer_blocks);
@@ -22,18 +22,50 @@
 #ifndef PROGRAM_GL_H
 #define PROGRAM_GL_H
 
+#include "darray.h"
 #include "glincludes.h"
 #include "program.h"
 
 struct gpu_ctx;
 
+struct program_gl_uniform {
+    GLint location;
+    int size;
+    int initialized;
+    uint8_t *data;
+};
+
 struct program_gl {
     struct program parent;
     GLuint id;
+
+    /*
+     * Values last set on the uniforms of the program (uniforms are program
+     * state): they are shared by all the pipelines using the program so that
+     * redundant glUniform*() calls can be skipped
+     */
+    struct darray uniforms; // array of struct program_gl_uniform
 };
 
 struct program *ngli_program_gl_create(struct gpu_ctx *gpu_ctx);
 int ngli_program_gl_init(struct program *s, const struct program_params *params);
+int ngli_program_gl_init_from_binary(struct program *s, const struct program_params *params,
+                                     const void *data, size_t size);
+int ngli_program_gl_get_binary(struct program *s, void **datap, size_t *sizep);
+
+/*
+ * Return the index of the cached value of the uniform at the specified
+ * location, registering it if needed
+ */
+int ngli_program_gl_get_uniform_index(struct program *s, GLint location, int size);
+
+/*
+ * Store the value of a uniform about to be set. Returns 0 if the value is
+ * identical to the one currently set on the program (the call can be
+ * skipped), 1 otherwise.
+ */
+int ngli_program_gl_update_uniform_value(struct program *s, int index, const void *data);
+
 void ngli_program_gl_freep(struct program **sp);
 
 #endif
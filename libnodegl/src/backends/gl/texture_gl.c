@@ -334,7 +334,7 @@ int ngli_texture_gl_init(struct texture *s, const struct texture_params *params)
         renderbuffer_set_storage(s);
     } else {
         ngli_glGenTextures(gl, 1, &s_priv->id);
-        ngli_glBindTexture(gl, s_priv->target, s_priv->id);
+        ngli_glstate_bind_texture(gl, &gpu_ctx_gl->glstate, s_priv->target, s_priv->id);
         if (s->params.mipmap_filter &&
             !(gl->features & NGLI_FEATURE_GL_TEXTURE_NPOT) &&
             (!is_pow2(params->width) || !is_pow2(params->height))) {
@@ -411,6 +411,138 @@ void ngli_texture_gl_set_dimensions(struct texture *s, int width, int height, in
     params->depth = depth;
 }
 
+#define PBO_FEATURES (NGLI_FEATURE_GL_MAP_BUFFER_RANGE | \
+                      NGLI_FEATURE_GL_SYNC             | \
+                      NGLI_FEATURE_GL_ROW_LENGTH)
+
+static int use_pbo_upload(const struct texture *s)
+{
+    const struct texture_gl *s_priv = (const struct texture_gl *)s;
+    const struct gpu_ctx_gl *gpu_ctx_gl = (const struct gpu_ctx_gl *)s->gpu_ctx;
+    const struct glcontext *gl = gpu_ctx_gl->glcontext;
+    const struct texture_params *params = &s->params;
+
+    return (params->usage & NGLI_TEXTURE_USAGE_DYNAMIC_BIT) &&
+           (gl->features & PBO_FEATURES) == PBO_FEATURES &&
+           s_priv->target == GL_TEXTURE_2D;
+}
+
+static int pbo_init(struct texture *s, struct texture_gl_pbo *pbo, GLsizeiptr size)
+{
+    struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
+    struct glcontext *gl = gpu_ctx_gl->glcontext;
+
+    if (!pbo->id)
+        ngli_glGenBuffers(gl, 1, &pbo->id);
+    ngli_glBindBuffer(gl, GL_PIXEL_UNPACK_BUFFER, pbo->id);
+
+    if (gl->features & NGLI_FEATURE_GL_BUFFER_STORAGE) {
+        /* Buffer storage is immutable so the buffer must be re-created */
+        if (pbo->size) {
+            ngli_glUnmapBuffer(gl, GL_PIXEL_UNPACK_BUFFER);
+            ngli_glBindBuffer(gl, GL_PIXEL_UNPACK_BUFFER, 0);
+            ngli_glDeleteBuffers(gl, 1, &pbo->id);
+            ngli_glGenBuffers(gl, 1, &pbo->id);
+            ngli_glBindBuffer(gl, GL_PIXEL_UNPACK_BUFFER, pbo->id);
+        }
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        ngli_glBufferStorage(gl, GL_PIXEL_UNPACK_BUFFER, size, NULL, flags);
+        pbo->mapped_data = ngli_glMapBufferRange(gl, GL_PIXEL_UNPACK_BUFFER, 0, size, flags);
+        if (!pbo->mapped_data) {
+            ngli_glBindBuffer(gl, GL_PIXEL_UNPACK_BUFFER, 0);
+            return NGL_ERROR_GRAPHICS_GENERIC;
+        }
+    } else {
+        ngli_glBufferData(gl, GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW);
+    }
+
+    pbo->size = size;
+    return 0;
+}
+
+static void pbo_reset(struct texture *s, struct texture_gl_pbo *pbo)
+{
+    struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
+    struct glcontext *gl = gpu_ctx_gl->glcontext;
+
+    if (!pbo->id)
+        return;
+
+    if (pbo->fence)
+        ngli_glDeleteSync(gl, pbo->fence);
+    if (pbo->mapped_data) {
+        ngli_glBindBuffer(gl, GL_PIXEL_UNPACK_BUFFER, pbo->id);
+        ngli_glUnmapBuffer(gl, GL_PIXEL_UNPACK_BUFFER);
+        ngli_glBindBuffer(gl, GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+    ngli_glDeleteBuffers(gl, 1, &pbo->id);
+    memset(pbo, 0, sizeof(*pbo));
+}
+
+/*
+ * Copy the data into the next pixel unpack buffer of the ring and issue the
+ * texture update from it: the transfer to the texture is then performed
+ * asynchronously by the driver. The fence of each buffer makes sure we never
+ * overwrite a buffer that is still being read by a pending transfer, which
+ * can only happen if the GPU is more than NGLI_TEXTURE_GL_NB_PBOS uploads
+ * behind.
+ */
+static int pbo_upload(struct texture *s, const uint8_t *data, int linesize)
+{
+    struct texture_gl *s_priv = (struct texture_gl *)s;
+    struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
+    struct glcontext *gl = gpu_ctx_gl->glcontext;
+    const struct texture_params *params = &s->params;
+
+    struct texture_gl_pbo *pbo = &s_priv->pbos[s_priv->pbo_index];
+    s_priv->pbo_index = (s_priv->pbo_index + 1) % NGLI_TEXTURE_GL_NB_PBOS;
+
+    if (!linesize)
+        linesize = params->width;
+    /* The padding of the last row is not guaranteed to be readable */
+    const GLsizeiptr size = ((GLsizeiptr)linesize * (params->height - 1) + params->width) * s_priv->bytes_per_pixel;
+
+    if (pbo->fence) {
+        const GLenum status = ngli_glClientWaitSync(gl, pbo->fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX);
+        ngli_glDeleteSync(gl, pbo->fence);
+        pbo->fence = NULL;
+        if (status == GL_WAIT_FAILED) {
+            LOG(ERROR, "could not wait for the previous upload to complete");
+            return NGL_ERROR_GRAPHICS_GENERIC;
+        }
+    }
+
+    if (size > pbo->size) {
+        int ret = pbo_init(s, pbo, size);
+        if (ret < 0)
+            return ret;
+    } else {
+        ngli_glBindBuffer(gl, GL_PIXEL_UNPACK_BUFFER, pbo->id);
+    }
+
+    if (pbo->mapped_data) {
+        memcpy(pbo->mapped_data, data, size);
+    } else {
+        /* The buffer is not in use anymore thanks to the fence */
+        const GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+        void *mapped_data = ngli_glMapBufferRange(gl, GL_PIXEL_UNPACK_BUFFER, 0, size, access);
+        if (!mapped_data) {
+            ngli_glBindBuffer(gl, GL_PIXEL_UNPACK_BUFFER, 0);
+            return NGL_ERROR_GRAPHICS_GENERIC;
+        }
+        memcpy(mapped_data, data, size);
+        ngli_glUnmapBuffer(gl, GL_PIXEL_UNPACK_BUFFER);
+    }
+
+    /* With a pixel unpack buffer bound, the data pointer is an offset in the buffer */
+    texture_set_sub_image(s, NULL, linesize);
+    ngli_glBindBuffer(gl, GL_PIXEL_UNPACK_BUFFER, 0);
+
+    pbo->fence = ngli_glFenceSync(gl, GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    return 0;
+}
+
 int ngli_texture_gl_upload(struct texture *s, const uint8_t *data, int linesize)
 {
     struct texture_gl *s_priv = (struct texture_gl *)s;
@@ -423,15 +555,19 @@ int ngli_texture_gl_upload(struct texture *s, const uint8_t *data, int linesize)
     ngli_assert(!s_priv->wrapped);
     ngli_assert(params->usage & NGLI_TEXTURE_USAGE_TRANSFER_DST_BIT);
 
-    ngli_glBindTexture(gl, s_priv->target, s_priv->id);
+    int ret = 0;
+    ngli_glstate_bind_texture(gl, &gpu_ctx_gl->glstate, s_priv->target, s_priv->id);
     if (data) {
-        texture_set_sub_image(s, data, linesize);
-        if (params->mipmap_filter != NGLI_MIPMAP_FILTER_NONE)
+        if (use_pbo_upload(s))
+            ret = pbo_upload(s, data, linesize);
+        else
+            texture_set_sub_image(s, data, linesize);
+        if (ret >= 0 && params->mipmap_filter != NGLI_MIPMAP_FILTER_NONE)
             ngli_glGenerateMipmap(gl, s_priv->target);
     }
-    ngli_glBindTexture(gl, s_priv->target, 0);
+    ngli_glstate_bind_texture(gl, &gpu_ctx_gl->glstate, s_priv->target, 0);
 
-    return 0;
+    return ret;
 }
 
 int ngli_texture_gl_generate_mipmap(struct texture *s)
@@ -444,7 +580,7 @@ int ngli_texture_gl_generate_mipmap(struct texture *s)
     ngli_assert(params->usage & NGLI_TEXTURE_USAGE_TRANSFER_SRC_BIT);
     ngli_assert(params->usage & NGLI_TEXTURE_USAGE_TRANSFER_DST_BIT);
 
-    ngli_glBindTexture(gl, s_priv->target, s_priv->id);
+    ngli_glstate_bind_texture(gl, &gpu_ctx_gl->glstate, s_priv->target, s_priv->id);
     ngli_glGenerateMipmap(gl, s_priv->target);
     return 0;
 }
@@ -459,6 +595,12 @@ void ngli_texture_gl_freep(struct texture **sp)
     struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
     struct glcontext *gl = gpu_ctx_gl->glcontext;
 
+    for (int i = 0; i < NGLI_ARRAY_NB(s_priv->pbos); i++)
+        pbo_reset(s, &s_priv->pbos[i]);
+
+    if (s_priv->target != GL_RENDERBUFFER)
+        ngli_glstate_forget_texture(&gpu_ctx_gl->glstate, s_priv->id);
+
     if (!s_priv->wrapped) {
         if (s_priv->target == GL_RENDERBUFFER)
             ngli_glDeleteRenderbuffers(gl, 1, &s_priv->id);
@@ -22,6 +22,8 @@
 #ifndef TEXTURE_GL_H
 #define TEXTURE_GL_H
 
+#include <stdint.h>
+
 #include "glincludes.h"
 #include "texture.h"
 
@@ -35,6 +37,19 @@ struct texture_gl_wrap_params {
     GLuint target;
 };
 
+#define NGLI_TEXTURE_GL_NB_PBOS 3
+
+/*
+ * Pixel unpack buffer used to upload the content of dynamic textures without
+ * stalling on the client memory copy
+ */
+struct texture_gl_pbo {
+    GLuint id;
+    GLsizeiptr size;
+    uint8_t *mapped_data; // persistent mapping, if supported
+    GLsync fence;         // signaled once the upload reading from the buffer is done
+};
+
 struct texture_gl {
     struct texture parent;
     GLenum target;
@@ -44,6 +59,8 @@ struct texture_gl {
     GLenum format_type;
     int wrapped;
     int bytes_per_pixel;
+    struct texture_gl_pbo pbos[NGLI_TEXTURE_GL_NB_PBOS];
+    int pbo_index;
 };
 
 struct texture *ngli_texture_gl_create(struct gpu_ctx *gpu_ctx);
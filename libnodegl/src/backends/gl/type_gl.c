@@ -45,6 +45,7 @@ static int gl_type_map[] = {
     [NGLI_TYPE_SAMPLER_EXTERNAL_2D_Y2Y_EXT] = GL_SAMPLER_EXTERNAL_2D_Y2Y_EXT,
     [NGLI_TYPE_IMAGE_2D]                    = GL_IMAGE_2D,
     [NGLI_TYPE_UNIFORM_BUFFER]              = GL_UNIFORM_BUFFER,
+    [NGLI_TYPE_UNIFORM_BUFFER_DYNAMIC]      = GL_UNIFORM_BUFFER,
     [NGLI_TYPE_STORAGE_BUFFER]              = GL_SHADER_STORAGE_BUFFER,
 };
 
@@ -25,8 +25,10 @@ const struct api_impl api_vk = {
     .configure          = ngli_ctx_configure,
     .resize             = ngli_ctx_resize,
     .set_capture_buffer = ngli_ctx_set_capture_buffer,
+    .capture_acquire    = ngli_ctx_capture_acquire,
     .set_scene          = ngli_ctx_set_scene,
     .prepare_draw       = ngli_ctx_prepare_draw,
     .draw               = ngli_ctx_draw,
+    .draw_async         = ngli_ctx_queue_draw,
     .reset              = ngli_ctx_reset,
 };
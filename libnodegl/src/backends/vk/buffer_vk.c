@@ -105,7 +105,7 @@ struct buffer *ngli_buffer_vk_create(struct gpu_ctx *gpu_ctx)
     return (struct buffer *)s;
 }
 
-VkResult ngli_buffer_vk_init(struct buffer *s, int size, int usage)
+VkResult ngli_buffer_vk_init(struct buffer *s, size_t size, int usage)
 {
     struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
     struct vkcontext *vk = gpu_ctx_vk->vkcontext;
@@ -113,6 +113,7 @@ VkResult ngli_buffer_vk_init(struct buffer *s, int size, int usage)
 
     s->size = size;
     s->usage = usage;
+    s_priv->id = ++gpu_ctx_vk->resource_id;
 
     VkMemoryPropertyFlags mem_props;
     if (usage & NGLI_BUFFER_USAGE_MAP_READ) {
@@ -131,7 +132,113 @@ VkResult ngli_buffer_vk_init(struct buffer *s, int size, int usage)
     return create_vk_buffer(vk, size, flags, mem_props, &s_priv->buffer, &s_priv->memory);
 }
 
-VkResult ngli_buffer_vk_upload(struct buffer *s, const void *data, int size, int offset)
+static void record_copy(struct cmd_vk *cmd_vk, VkBuffer src, VkDeviceSize src_offset,
+                        VkBuffer dst, VkDeviceSize dst_offset, VkDeviceSize size)
+{
+    /* Wait for the previous accesses to the destination range to complete */
+    const VkBufferMemoryBarrier pre_barrier = {
+        .sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+        .srcAccessMask       = VK_ACCESS_INDEX_READ_BIT |
+                               VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT |
+                               VK_ACCESS_UNIFORM_READ_BIT |
+                               VK_ACCESS_SHADER_READ_BIT |
+                               VK_ACCESS_SHADER_WRITE_BIT |
+                               VK_ACCESS_TRANSFER_READ_BIT |
+                               VK_ACCESS_TRANSFER_WRITE_BIT,
+        .dstAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .buffer              = dst,
+        .offset              = dst_offset,
+        .size                = size,
+    };
+    vkCmdPipelineBarrier(cmd_vk->cmd_buf, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0, 0, NULL, 1, &pre_barrier, 0, NULL);
+
+    const VkBufferCopy region = {
+        .srcOffset = src_offset,
+        .dstOffset = dst_offset,
+        .size      = size,
+    };
+    vkCmdCopyBuffer(cmd_vk->cmd_buf, src, dst, 1, &region);
+
+    /* Make the copy visible to the subsequent transfers and shader accesses */
+    const VkBufferMemoryBarrier barrier = {
+        .sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+        .srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .dstAccessMask       = VK_ACCESS_INDEX_READ_BIT |
+                               VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT |
+                               VK_ACCESS_UNIFORM_READ_BIT |
+                               VK_ACCESS_SHADER_READ_BIT |
+                               VK_ACCESS_SHADER_WRITE_BIT |
+                               VK_ACCESS_TRANSFER_READ_BIT |
+                               VK_ACCESS_TRANSFER_WRITE_BIT,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .buffer              = dst,
+        .offset              = dst_offset,
+        .size                = size,
+    };
+    const VkPipelineStageFlags src_stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    const VkPipelineStageFlags dst_stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    vkCmdPipelineBarrier(cmd_vk->cmd_buf, src_stage, dst_stage, 0, 0, NULL, 1, &barrier, 0, NULL);
+}
+
+/*
+ * Uploads that do not fit a regular staging region (such as the content of
+ * large memory mapped files) are streamed through a single host visible
+ * window of the size of a staging chunk: each piece is copied in its own
+ * transient command buffer which is waited for before the window is reused.
+ * The host visible memory used by such an upload is thus bounded by the
+ * staging chunk size, whatever the size of the buffer. Since the pieces are
+ * submitted immediately, the upload is executed before the commands already
+ * recorded in the current frame.
+ */
+static VkResult upload_streamed(struct buffer *s, const void *data, size_t size, size_t offset)
+{
+    struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
+    struct buffer_vk *s_priv = (struct buffer_vk *)s;
+
+    const size_t window_size = NGLI_MIN(size, (size_t)gpu_ctx_vk->staging->chunk_size);
+    struct buffer *window = ngli_buffer_vk_create(s->gpu_ctx);
+    if (!window)
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+
+    const int usage = NGLI_BUFFER_USAGE_TRANSFER_SRC_BIT | NGLI_BUFFER_USAGE_MAP_WRITE;
+    VkResult res = ngli_buffer_vk_init(window, window_size, usage);
+    if (res != VK_SUCCESS)
+        goto end;
+
+    uint8_t *window_data;
+    res = ngli_buffer_vk_map(window, window_size, 0, (void **)&window_data);
+    if (res != VK_SUCCESS)
+        goto end;
+
+    const struct buffer_vk *window_vk = (const struct buffer_vk *)window;
+    for (size_t pos = 0; pos < size; pos += window_size) {
+        const size_t copy_size = NGLI_MIN(size - pos, window_size);
+        memcpy(window_data, (const uint8_t *)data + pos, copy_size);
+
+        struct cmd_vk *cmd_vk;
+        res = ngli_cmd_vk_begin_transient(s->gpu_ctx, 0, &cmd_vk);
+        if (res != VK_SUCCESS)
+            break;
+        record_copy(cmd_vk, window_vk->buffer, 0, s_priv->buffer, offset + pos, copy_size);
+        res = ngli_cmd_vk_execute_transient(&cmd_vk);
+        if (res != VK_SUCCESS)
+            break;
+
+        s->gpu_ctx->stats[NGLI_GPU_STAT_STAGING_COPIES]++;
+    }
+
+    ngli_buffer_vk_unmap(window);
+
+end:
+    ngli_buffer_vk_freep(&window);
+    return res;
+}
+
+VkResult ngli_buffer_vk_upload(struct buffer *s, const void *data, size_t size, size_t offset)
 {
     if (s->usage & NGLI_BUFFER_USAGE_MAP_READ ||
         s->usage & NGLI_BUFFER_USAGE_MAP_WRITE ||
@@ -146,49 +253,49 @@ VkResult ngli_buffer_vk_upload(struct buffer *s, const void *data, int size, int
     }
 
     struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
-    struct vkcontext *vk = gpu_ctx_vk->vkcontext;
     struct buffer_vk *s_priv = (struct buffer_vk *)s;
 
-    const VkBufferUsageFlags usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-    const VkMemoryPropertyFlags mem_props = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                                            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-    VkResult res = create_vk_buffer(vk, s->size, usage, mem_props,
-                                    &s_priv->staging_buffer, &s_priv->staging_memory);
-    if (res != VK_SUCCESS)
-        return res;
-
-    uint8_t *mapped_data;
-    res = vkMapMemory(vk->device, s_priv->staging_memory, 0, s->size, 0, (void *)&mapped_data);
-    if (res != VK_SUCCESS)
-        return res;
-    memcpy(mapped_data + offset, data, size);
-    vkUnmapMemory(vk->device, s_priv->staging_memory);
+    const VkDeviceSize alignment = 4;
+    if (size > gpu_ctx_vk->staging->chunk_size - alignment + 1)
+        return upload_streamed(s, data, size, offset);
+
+    /*
+     * The copy is recorded in the current frame command buffer, unless a
+     * render pass is in progress (copies are not allowed inside a render
+     * pass) or no frame is being recorded, in which case it is submitted
+     * immediately and waited for.
+     */
+    struct cmd_vk *cmd_vk = gpu_ctx_vk->current_rt ? NULL : gpu_ctx_vk->cur_cmd;
+    const int transient = !cmd_vk;
+    if (transient) {
+        VkResult res = ngli_cmd_vk_begin_transient(s->gpu_ctx, 0, &cmd_vk);
+        if (res != VK_SUCCESS)
+            return res;
+    }
 
-    struct cmd_vk *cmd_vk;
-    res = ngli_cmd_vk_begin_transient(s->gpu_ctx, 0, &cmd_vk);
-    if (res != VK_SUCCESS)
+    struct staging_alloc_vk staging;
+    VkResult res = ngli_staging_vk_alloc(gpu_ctx_vk->staging, size, alignment, &staging);
+    if (res != VK_SUCCESS) {
+        if (transient)
+            ngli_cmd_vk_freep(&cmd_vk);
         return res;
+    }
+    memcpy(staging.data, data, size);
 
-    const VkBufferCopy region = {
-        .srcOffset = 0,
-        .dstOffset = offset,
-        .size      = size,
-    };
-    vkCmdCopyBuffer(cmd_vk->cmd_buf, s_priv->staging_buffer, s_priv->buffer, 1, &region);
-
-    res = ngli_cmd_vk_execute_transient(&cmd_vk);
-    if (res != VK_SUCCESS)
-        return res;
+    const struct buffer_vk *staging_vk = (const struct buffer_vk *)staging.buffer;
+    record_copy(cmd_vk, staging_vk->buffer, staging.offset, s_priv->buffer, offset, size);
+    s->gpu_ctx->stats[NGLI_GPU_STAT_STAGING_COPIES]++;
 
-    vkDestroyBuffer(vk->device, s_priv->staging_buffer, NULL);
-    s_priv->staging_buffer = VK_NULL_HANDLE;
-    vkFreeMemory(vk->device, s_priv->staging_memory, NULL);
-    s_priv->staging_memory = VK_NULL_HANDLE;
+    if (transient) {
+        res = ngli_cmd_vk_execute_transient(&cmd_vk);
+        if (res != VK_SUCCESS)
+            return res;
+    }
 
     return VK_SUCCESS;
 }
 
-VkResult ngli_buffer_vk_map(struct buffer *s, int size, int offset, void **data)
+VkResult ngli_buffer_vk_map(struct buffer *s, size_t size, size_t offset, void **data)
 {
     struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
     struct vkcontext *vk = gpu_ctx_vk->vkcontext;
@@ -218,7 +325,5 @@ void ngli_buffer_vk_freep(struct buffer **sp)
 
     vkDestroyBuffer(vk->device, s_priv->buffer, NULL);
     vkFreeMemory(vk->device, s_priv->memory, NULL);
-    vkDestroyBuffer(vk->device, s_priv->staging_buffer, NULL);
-    vkFreeMemory(vk->device, s_priv->staging_memory, NULL);
     ngli_freep(sp);
 }
@@ -0,0 +1,281 @@
+/*
+ * Copyright 2023 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stddef.h>
+
+#include "desc_pool_vk.h"
+#include "gpu_ctx_vk.h"
+#include "log.h"
+#include "math_utils.h"
+#include "memory.h"
+#include "utils.h"
+#include "vkutils.h"
+
+#define MIN_SETS_PER_POOL        64
+#define MAX_SETS_PER_POOL        1024
+#define DESCRIPTORS_PER_SET      4
+
+struct desc_pool_entry {
+    VkDescriptorPool pool;
+    uint32_t nb_sets;
+    int full;
+};
+
+struct desc_pool_pending_set {
+    VkDescriptorPool pool;
+    VkDescriptorSet set;
+};
+
+static const VkDescriptorType desc_types[] = {
+    VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+    VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+    VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+};
+
+struct desc_pool_vk *ngli_desc_pool_vk_create(struct gpu_ctx *gpu_ctx)
+{
+    struct desc_pool_vk *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+    s->gpu_ctx = gpu_ctx;
+    return s;
+}
+
+VkResult ngli_desc_pool_vk_init(struct desc_pool_vk *s, int nb_frames)
+{
+    ngli_darray_init(&s->pools, sizeof(struct desc_pool_entry), 0);
+
+    s->pending = ngli_calloc(nb_frames, sizeof(*s->pending));
+    if (!s->pending)
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    s->nb_frames = nb_frames;
+
+    for (int i = 0; i < nb_frames; i++)
+        ngli_darray_init(&s->pending[i], sizeof(struct desc_pool_pending_set), 0);
+
+    return VK_SUCCESS;
+}
+
+static void free_set(struct desc_pool_vk *s, VkDescriptorPool pool, VkDescriptorSet set)
+{
+    struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
+    struct vkcontext *vk = gpu_ctx_vk->vkcontext;
+
+    struct desc_pool_entry *entries = ngli_darray_data(&s->pools);
+    for (int i = 0; i < ngli_darray_count(&s->pools); i++) {
+        struct desc_pool_entry *entry = &entries[i];
+        if (entry->pool != pool)
+            continue;
+
+        vkFreeDescriptorSets(vk->device, pool, 1, &set);
+        ngli_assert(entry->nb_sets > 0);
+        entry->nb_sets--;
+        entry->full = 0;
+        s->gpu_ctx->stats[NGLI_GPU_STAT_DESC_SETS]--;
+        return;
+    }
+
+    ngli_assert(0);
+}
+
+static void free_pending_sets(struct desc_pool_vk *s, int frame_index)
+{
+    struct darray *pending = &s->pending[frame_index];
+    const struct desc_pool_pending_set *pending_sets = ngli_darray_data(pending);
+    for (int i = 0; i < ngli_darray_count(pending); i++)
+        free_set(s, pending_sets[i].pool, pending_sets[i].set);
+    ngli_darray_clear(pending);
+}
+
+void ngli_desc_pool_vk_begin_frame(struct desc_pool_vk *s, int frame_index)
+{
+    ngli_assert(frame_index >= 0 && frame_index < s->nb_frames);
+
+    s->cur_frame = frame_index;
+    free_pending_sets(s, frame_index);
+}
+
+static VkResult create_pool(struct desc_pool_vk *s, const VkDescriptorPoolSize *sizes, uint32_t nb_sizes,
+                            uint32_t min_sets, struct desc_pool_entry **entryp)
+{
+    struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
+    struct vkcontext *vk = gpu_ctx_vk->vkcontext;
+
+    const uint32_t max_sets = NGLI_MAX(s->max_sets ? NGLI_MIN(s->max_sets * 2, MAX_SETS_PER_POOL)
+                                                   : MIN_SETS_PER_POOL, min_sets);
+
+    /*
+     * Every pool is able to hold any descriptor type so that a single pool
+     * can serve all the pipelines; the pool is also guaranteed to be large
+     * enough to satisfy the allocation that triggered its creation.
+     */
+    VkDescriptorPoolSize pool_sizes[NGLI_ARRAY_NB(desc_types)];
+    for (int i = 0; i < NGLI_ARRAY_NB(desc_types); i++) {
+        uint32_t nb_required = 0;
+        for (uint32_t j = 0; j < nb_sizes; j++) {
+            if (sizes[j].type == desc_types[i])
+                nb_required += sizes[j].descriptorCount;
+        }
+        pool_sizes[i].type = desc_types[i];
+        pool_sizes[i].descriptorCount = NGLI_MAX(max_sets * DESCRIPTORS_PER_SET, nb_required);
+    }
+
+    const VkDescriptorPoolCreateInfo create_info = {
+        .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        .flags         = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT,
+        .poolSizeCount = NGLI_ARRAY_NB(pool_sizes),
+        .pPoolSizes    = pool_sizes,
+        .maxSets       = max_sets,
+    };
+
+    struct desc_pool_entry entry = {0};
+    VkResult res = vkCreateDescriptorPool(vk->device, &create_info, NULL, &entry.pool);
+    if (res != VK_SUCCESS)
+        return res;
+
+    struct desc_pool_entry *entryp_new = ngli_darray_push(&s->pools, &entry);
+    if (!entryp_new) {
+        vkDestroyDescriptorPool(vk->device, entry.pool, NULL);
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
+    s->max_sets = max_sets;
+    s->gpu_ctx->stats[NGLI_GPU_STAT_DESC_POOLS]++;
+
+    *entryp = entryp_new;
+    return VK_SUCCESS;
+}
+
+static VkResult alloc_from_pool(struct desc_pool_vk *s, struct desc_pool_entry *entry,
+                                const VkDescriptorSetLayout *layouts, uint32_t nb_sets,
+                                VkDescriptorSet *sets)
+{
+    struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
+    struct vkcontext *vk = gpu_ctx_vk->vkcontext;
+
+    const VkDescriptorSetAllocateInfo allocate_info = {
+        .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        .descriptorPool     = entry->pool,
+        .descriptorSetCount = nb_sets,
+        .pSetLayouts        = layouts,
+    };
+
+    VkResult res = vkAllocateDescriptorSets(vk->device, &allocate_info, sets);
+    if (res == VK_ERROR_OUT_OF_POOL_MEMORY || res == VK_ERROR_FRAGMENTED_POOL) {
+        entry->full = 1;
+        return res;
+    }
+    if (res != VK_SUCCESS)
+        return res;
+
+    entry->nb_sets += nb_sets;
+    s->gpu_ctx->stats[NGLI_GPU_STAT_DESC_SETS] += nb_sets;
+
+    return VK_SUCCESS;
+}
+
+VkResult ngli_desc_pool_vk_alloc(struct desc_pool_vk *s,
+                                 const VkDescriptorSetLayout *layouts, uint32_t nb_sets,
+                                 const VkDescriptorPoolSize *sizes, uint32_t nb_sizes,
+                                 VkDescriptorPool *poolp, VkDescriptorSet *sets)
+{
+    /* Most recent pools are the most likely to have room left */
+    struct desc_pool_entry *entries = ngli_darray_data(&s->pools);
+    for (int i = ngli_darray_count(&s->pools) - 1; i >= 0; i--) {
+        struct desc_pool_entry *entry = &entries[i];
+        if (entry->full)
+            continue;
+
+        VkResult res = alloc_from_pool(s, entry, layouts, nb_sets, sets);
+        if (res == VK_SUCCESS) {
+            *poolp = entry->pool;
+            return VK_SUCCESS;
+        }
+        if (res != VK_ERROR_OUT_OF_POOL_MEMORY && res != VK_ERROR_FRAGMENTED_POOL)
+            return res;
+    }
+
+    struct desc_pool_entry *entry = NULL;
+    VkResult res = create_pool(s, sizes, nb_sizes, nb_sets, &entry);
+    if (res != VK_SUCCESS)
+        return res;
+
+    res = alloc_from_pool(s, entry, layouts, nb_sets, sets);
+    if (res != VK_SUCCESS) {
+        LOG(ERROR, "could not allocate %u descriptor sets from a new pool: %s", nb_sets, ngli_vk_res2str(res));
+        return res;
+    }
+
+    *poolp = entry->pool;
+    return VK_SUCCESS;
+}
+
+void ngli_desc_pool_vk_release(struct desc_pool_vk *s, VkDescriptorPool pool,
+                               const VkDescriptorSet *sets, uint32_t nb_sets)
+{
+    if (!pool || !nb_sets)
+        return;
+
+    struct darray *pending = &s->pending[s->cur_frame];
+    for (uint32_t i = 0; i < nb_sets; i++) {
+        const struct desc_pool_pending_set pending_set = {.pool = pool, .set = sets[i]};
+        if (!ngli_darray_push(pending, &pending_set)) {
+            /*
+             * The set can not be deferred: wait for the GPU to be done with
+             * it and return it to its pool right away
+             */
+            LOG(WARNING, "could not defer the release of a descriptor set, waiting for the GPU");
+            ngli_gpu_ctx_wait_idle(s->gpu_ctx);
+            free_set(s, pool, sets[i]);
+        }
+    }
+}
+
+void ngli_desc_pool_vk_freep(struct desc_pool_vk **sp)
+{
+    struct desc_pool_vk *s = *sp;
+    if (!s)
+        return;
+
+    struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
+    struct vkcontext *vk = gpu_ctx_vk->vkcontext;
+
+    for (int i = 0; i < s->nb_frames; i++) {
+        free_pending_sets(s, i);
+        ngli_darray_reset(&s->pending[i]);
+    }
+    ngli_freep(&s->pending);
+
+    struct desc_pool_entry *entries = ngli_darray_data(&s->pools);
+    for (int i = 0; i < ngli_darray_count(&s->pools); i++) {
+        struct desc_pool_entry *entry = &entries[i];
+        if (entry->nb_sets)
+            LOG(WARNING, "descriptor pool destroyed with %u sets still allocated", entry->nb_sets);
+        vkDestroyDescriptorPool(vk->device, entry->pool, NULL);
+    }
+    s->gpu_ctx->stats[NGLI_GPU_STAT_DESC_POOLS] = 0;
+    s->gpu_ctx->stats[NGLI_GPU_STAT_DESC_SETS] = 0;
+    ngli_darray_reset(&s->pools);
+
+    ngli_freep(sp);
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2023 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef DESC_POOL_VK_H
+#define DESC_POOL_VK_H
+
+#include <stdint.h>
+#include <vulkan/vulkan.h>
+
+#include "darray.h"
+
+struct gpu_ctx;
+
+/*
+ * Growable descriptor set allocator shared by all the pipelines of a context.
+ *
+ * Descriptor sets are allocated from a list of descriptor pools: when none of
+ * them can satisfy an allocation, a new pool twice as large as the previous
+ * one (up to a limit) is appended to the list. Pools are never destroyed
+ * before the allocator itself, sets released by the pipelines are returned to
+ * their pool and reused by subsequent allocations.
+ *
+ * Released sets may still be referenced by command buffers in flight, so they
+ * are queued in the current frame slot and only returned to their pool when
+ * that slot is reused, once the GPU is done with the commands recorded during
+ * its previous use.
+ */
+struct desc_pool_vk {
+    struct gpu_ctx *gpu_ctx;
+    struct darray pools;    // array of struct desc_pool_entry
+    uint32_t max_sets;      // maxSets of the last created pool
+    struct darray *pending; // per frame array of struct desc_pool_pending_set
+    int nb_frames;
+    int cur_frame;
+};
+
+struct desc_pool_vk *ngli_desc_pool_vk_create(struct gpu_ctx *gpu_ctx);
+VkResult ngli_desc_pool_vk_init(struct desc_pool_vk *s, int nb_frames);
+
+/*
+ * Return the sets released during the previous use of the frame slot to their
+ * pool. Must only be called once the commands of that frame have completed.
+ */
+void ngli_desc_pool_vk_begin_frame(struct desc_pool_vk *s, int frame_index);
+
+/*
+ * Allocate nb_sets descriptor sets from the same pool. The sizes array
+ * describes the total number of descriptors required by the allocation for
+ * each descriptor type. The pool the sets have been allocated from is
+ * returned in poolp and must be passed back to ngli_desc_pool_vk_release().
+ */
+VkResult ngli_desc_pool_vk_alloc(struct desc_pool_vk *s,
+                                 const VkDescriptorSetLayout *layouts, uint32_t nb_sets,
+                                 const VkDescriptorPoolSize *sizes, uint32_t nb_sizes,
+                                 VkDescriptorPool *poolp, VkDescriptorSet *sets);
+void ngli_desc_pool_vk_release(struct desc_pool_vk *s, VkDescriptorPool pool,
+                               const VkDescriptorSet *sets, uint32_t nb_sets);
+
+void ngli_desc_pool_vk_freep(struct desc_pool_vk **sp);
+
+#endif
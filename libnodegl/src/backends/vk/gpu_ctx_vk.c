@@ -21,6 +21,7 @@
 
 #include <string.h>
 #include <inttypes.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <limits.h>
 
@@ -39,6 +40,7 @@
 #include "program_vk.h"
 #include "rendertarget_vk.h"
 #include "texture_vk.h"
+#include "utils.h"
 #include "vkcontext.h"
 #include "vkutils.h"
 
@@ -50,6 +52,9 @@
 #include "gpu_capture.h"
 #endif
 
+#define STAGING_CHUNK_SIZE  (4 * 1024 * 1024)
+#define UNIFORMS_CHUNK_SIZE (1024 * 1024)
+
 static VkResult create_dummy_texture(struct gpu_ctx *s)
 {
     struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
@@ -160,6 +165,63 @@ static VkResult create_rendertarget(struct gpu_ctx *s,
 #define COLOR_USAGE (NGLI_TEXTURE_USAGE_COLOR_ATTACHMENT_BIT | NGLI_TEXTURE_USAGE_TRANSFER_SRC_BIT)
 #define DEPTH_USAGE NGLI_TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT
 
+static VkResult create_capture_buffer(struct gpu_ctx *s, struct buffer **bufferp, void **mapped_datap)
+{
+    struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
+
+    struct buffer *buffer = ngli_buffer_vk_create(s);
+    if (!buffer)
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    *bufferp = buffer;
+
+    VkResult res = ngli_buffer_vk_init(buffer,
+                                       s_priv->capture_buffer_size,
+                                       NGLI_BUFFER_USAGE_MAP_READ |
+                                       NGLI_BUFFER_USAGE_TRANSFER_DST_BIT);
+    if (res != VK_SUCCESS)
+        return res;
+
+    return ngli_buffer_vk_map(buffer, s_priv->capture_buffer_size, 0, mapped_datap);
+}
+
+static VkResult create_async_captures(struct gpu_ctx *s)
+{
+    struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
+    const struct ngl_config *config = &s->config;
+
+    s_priv->async_captures = ngli_calloc(config->capture_async_depth, sizeof(*s_priv->async_captures));
+    if (!s_priv->async_captures)
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+
+    for (int i = 0; i < config->capture_async_depth; i++) {
+        struct async_capture_vk *capture = &s_priv->async_captures[i];
+        VkResult res = create_capture_buffer(s, &capture->buffer, &capture->mapped_data);
+        if (res != VK_SUCCESS)
+            return res;
+    }
+
+    return VK_SUCCESS;
+}
+
+static void destroy_async_captures(struct gpu_ctx *s)
+{
+    struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
+    const struct ngl_config *config = &s->config;
+
+    if (!s_priv->async_captures)
+        return;
+
+    for (int i = 0; i < config->capture_async_depth; i++) {
+        struct async_capture_vk *capture = &s_priv->async_captures[i];
+        if (capture->mapped_data)
+            ngli_buffer_unmap(capture->buffer);
+        ngli_buffer_vk_freep(&capture->buffer);
+    }
+    ngli_freep(&s_priv->async_captures);
+    s_priv->async_capture_index = 0;
+    s_priv->nb_pending_captures = 0;
+}
+
 static VkResult create_render_resources(struct gpu_ctx *s)
 {
     struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
@@ -259,20 +321,11 @@ static VkResult create_render_resources(struct gpu_ctx *s)
     if (config->offscreen) {
         s_priv->capture_buffer_size = s_priv->width * s_priv->height * ngli_format_get_bytes_per_pixel(color_format);
         if (config->capture_buffer_type == NGL_CAPTURE_BUFFER_TYPE_CPU) {
-            s_priv->capture_buffer = ngli_buffer_vk_create(s);
-            if (!s_priv->capture_buffer) {
-                return VK_ERROR_OUT_OF_HOST_MEMORY;
-            }
             s_priv->capture_texture = NULL;
 
-            VkResult res = ngli_buffer_vk_init(s_priv->capture_buffer,
-                                               s_priv->capture_buffer_size,
-                                               NGLI_BUFFER_USAGE_MAP_READ |
-                                               NGLI_BUFFER_USAGE_TRANSFER_DST_BIT);
-            if (res != VK_SUCCESS)
-                return res;
-
-            res = ngli_buffer_vk_map(s_priv->capture_buffer, s_priv->capture_buffer_size, 0, &s_priv->mapped_data);
+            VkResult res = config->capture_async_depth
+                         ? create_async_captures(s)
+                         : create_capture_buffer(s, &s_priv->capture_buffer, &s_priv->mapped_data);
             if (res != VK_SUCCESS)
                 return res;
         }
@@ -339,6 +392,7 @@ static void destroy_render_resources(struct gpu_ctx *s)
     }
     ngli_buffer_vk_freep(&s_priv->capture_buffer);
     s_priv->capture_buffer_ptr = NULL;
+    destroy_async_captures(s);
 #if defined(TARGET_DARWIN) || defined(TARGET_IPHONE)
     gpu_ctx_vk_cleanup(s);
 #endif
@@ -352,10 +406,39 @@ static VkResult create_query_pool(struct gpu_ctx *s)
     const VkQueryPoolCreateInfo create_info = {
         .sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
         .queryType  = VK_QUERY_TYPE_TIMESTAMP,
-        .queryCount = 2,
+        .queryCount = 2 * NGLI_GPU_NB_QUERY_FRAMES,
     };
 
-    return vkCreateQueryPool(vk->device, &create_info, NULL, &s_priv->query_pool);
+    VkResult res = vkCreateQueryPool(vk->device, &create_info, NULL, &s_priv->query_pool);
+    if (res != VK_SUCCESS)
+        return res;
+
+    s_priv->query_frame = -1;
+    s_priv->draw_time_frame = -1;
+    s_priv->completed_frame = -1;
+
+    s_priv->cmd_query_frames = ngli_calloc(s_priv->nb_in_flight_frames, sizeof(*s_priv->cmd_query_frames));
+    if (!s_priv->cmd_query_frames)
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    for (int i = 0; i < s_priv->nb_in_flight_frames; i++)
+        s_priv->cmd_query_frames[i] = -1;
+
+    const struct ngl_config *config = &s->config;
+    if (!config->profiler)
+        return VK_SUCCESS;
+
+    if (!vk->phy_device_props.limits.timestampComputeAndGraphics) {
+        LOG(WARNING, "timestamp queries are not supported, GPU profiling is disabled");
+        return VK_SUCCESS;
+    }
+
+    const VkQueryPoolCreateInfo timestamp_create_info = {
+        .sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+        .queryType  = VK_QUERY_TYPE_TIMESTAMP,
+        .queryCount = NGLI_GPU_NB_QUERY_FRAMES * NGLI_GPU_MAX_TIMESTAMPS,
+    };
+
+    return vkCreateQueryPool(vk->device, &timestamp_create_info, NULL, &s_priv->timestamp_pool);
 }
 
 static void destroy_query_pool(struct gpu_ctx *s)
@@ -364,6 +447,157 @@ static void destroy_query_pool(struct gpu_ctx *s)
     struct vkcontext *vk = s_priv->vkcontext;
 
     vkDestroyQueryPool(vk->device, s_priv->query_pool, NULL);
+    vkDestroyQueryPool(vk->device, s_priv->timestamp_pool, NULL);
+    ngli_freep(&s_priv->cmd_query_frames);
+}
+
+/*
+ * Check the pipeline cache header (VkPipelineCacheHeaderVersionOne) against
+ * the current device: a cache created by another driver or device is
+ * silently discarded.
+ */
+static int check_pipeline_cache_data(const struct vkcontext *vk, const uint8_t *data, size_t size)
+{
+    uint32_t header[4];
+    if (size < sizeof(header) + VK_UUID_SIZE)
+        return 0;
+    memcpy(header, data, sizeof(header));
+
+    const VkPhysicalDeviceProperties *props = &vk->phy_device_props;
+    return header[0] >= sizeof(header) + VK_UUID_SIZE &&
+           header[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           header[2] == props->vendorID &&
+           header[3] == props->deviceID &&
+           !memcmp(data + sizeof(header), props->pipelineCacheUUID, VK_UUID_SIZE);
+}
+
+static void *load_pipeline_cache_data(const struct vkcontext *vk, const char *filename, size_t *sizep)
+{
+    void *data = NULL;
+    FILE *fp = fopen(filename, "rb");
+    if (!fp)
+        return NULL;
+
+    if (fseek(fp, 0, SEEK_END))
+        goto end;
+    const long size = ftell(fp);
+    if (size <= 0 || fseek(fp, 0, SEEK_SET))
+        goto end;
+
+    data = ngli_malloc(size);
+    if (!data)
+        goto end;
+
+    if (fread(data, size, 1, fp) != 1 || !check_pipeline_cache_data(vk, data, size)) {
+        LOG(WARNING, "ignoring incompatible pipeline cache %s", filename);
+        ngli_freep(&data);
+        goto end;
+    }
+    *sizep = size;
+
+end:
+    fclose(fp);
+    return data;
+}
+
+static VkResult create_pipeline_cache(struct gpu_ctx *s)
+{
+    struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
+    struct vkcontext *vk = s_priv->vkcontext;
+    const char *filename = s->config.pipeline_cache_filename;
+
+    size_t size = 0;
+    void *data = filename ? load_pipeline_cache_data(vk, filename, &size) : NULL;
+
+    const VkPipelineCacheCreateInfo create_info = {
+        .sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+        .initialDataSize = size,
+        .pInitialData    = data,
+    };
+
+    s_priv->pipeline_cache_size = size;
+    s_priv->pipeline_cache_crc = data ? ngli_crc32_data(data, size) : 0;
+
+    VkResult res = vkCreatePipelineCache(vk->device, &create_info, NULL, &s_priv->pipeline_cache);
+    ngli_free(data);
+    return res;
+}
+
+static int save_pipeline_cache(struct gpu_ctx *s)
+{
+    struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
+    struct vkcontext *vk = s_priv->vkcontext;
+    const char *filename = s->config.pipeline_cache_filename;
+
+    size_t size = 0;
+    VkResult res = vkGetPipelineCacheData(vk->device, s_priv->pipeline_cache, &size, NULL);
+    if (res != VK_SUCCESS)
+        return ngli_vk_res2ret(res);
+    if (!size)
+        return 0;
+
+    void *data = ngli_malloc(size);
+    if (!data)
+        return NGL_ERROR_MEMORY;
+
+    int ret = 0;
+    char *tmp_filename = NULL;
+    res = vkGetPipelineCacheData(vk->device, s_priv->pipeline_cache, &size, data);
+    if (res != VK_SUCCESS) {
+        ret = ngli_vk_res2ret(res);
+        goto end;
+    }
+
+    /* Nothing to save if no pipeline was added to the cache loaded from disk */
+    if (size == s_priv->pipeline_cache_size &&
+        ngli_crc32_data(data, size) == s_priv->pipeline_cache_crc)
+        goto end;
+
+    /*
+     * Write then rename to never leave a truncated cache behind; the
+     * temporary file is unique to this writer since multiple contexts may
+     * save the same cache concurrently
+     */
+    tmp_filename = ngli_get_tmp_filename(filename);
+    if (!tmp_filename) {
+        ret = NGL_ERROR_MEMORY;
+        goto end;
+    }
+
+    FILE *fp = fopen(tmp_filename, "wb");
+    if (!fp) {
+        ret = NGL_ERROR_IO;
+        goto end;
+    }
+    const int written = fwrite(data, size, 1, fp) == 1;
+    if (fclose(fp) || !written || rename(tmp_filename, filename)) {
+        remove(tmp_filename);
+        ret = NGL_ERROR_IO;
+        goto end;
+    }
+
+end:
+    ngli_free(tmp_filename);
+    ngli_free(data);
+    return ret;
+}
+
+static void destroy_pipeline_cache(struct gpu_ctx *s)
+{
+    struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
+    struct vkcontext *vk = s_priv->vkcontext;
+
+    if (!s_priv->pipeline_cache)
+        return;
+
+    if (s->config.pipeline_cache_filename) {
+        int ret = save_pipeline_cache(s);
+        if (ret < 0)
+            LOG(WARNING, "unable to save pipeline cache to %s", s->config.pipeline_cache_filename);
+    }
+
+    vkDestroyPipelineCache(vk->device, s_priv->pipeline_cache, NULL);
+    s_priv->pipeline_cache = VK_NULL_HANDLE;
 }
 
 static VkResult create_command_pool_and_buffers(struct gpu_ctx *s)
@@ -948,6 +1182,9 @@ static int vk_init(struct gpu_ctx *s)
      * direct Vulkan equivalent so use a sane default value */
     s->limits.max_texture_image_units            = 32;
     s->limits.max_uniform_block_size             = limits->maxUniformBufferRange;
+    s->limits.min_uniform_block_offset_alignment = limits->minUniformBufferOffsetAlignment;
+    s->limits.max_storage_block_size             = limits->maxStorageBufferRange;
+    s->limits.min_storage_block_offset_alignment = limits->minStorageBufferOffsetAlignment;
 
     if (config->set_surface_pts &&
         !ngli_vkcontext_has_extension(vk, VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME, 1)) {
@@ -968,6 +1205,33 @@ static int vk_init(struct gpu_ctx *s)
     if (res != VK_SUCCESS)
         return ngli_vk_res2ret(res);
 
+    res = create_pipeline_cache(s);
+    if (res != VK_SUCCESS)
+        return ngli_vk_res2ret(res);
+
+    s_priv->desc_pool = ngli_desc_pool_vk_create(s);
+    if (!s_priv->desc_pool)
+        return NGL_ERROR_MEMORY;
+    res = ngli_desc_pool_vk_init(s_priv->desc_pool, s_priv->nb_in_flight_frames);
+    if (res != VK_SUCCESS)
+        return ngli_vk_res2ret(res);
+
+    s_priv->staging = ngli_staging_vk_create(s);
+    if (!s_priv->staging)
+        return NGL_ERROR_MEMORY;
+    res = ngli_staging_vk_init(s_priv->staging, s_priv->nb_in_flight_frames,
+                               NGLI_BUFFER_USAGE_TRANSFER_SRC_BIT, STAGING_CHUNK_SIZE);
+    if (res != VK_SUCCESS)
+        return ngli_vk_res2ret(res);
+
+    s_priv->uniforms = ngli_staging_vk_create(s);
+    if (!s_priv->uniforms)
+        return NGL_ERROR_MEMORY;
+    res = ngli_staging_vk_init(s_priv->uniforms, s_priv->nb_in_flight_frames,
+                               NGLI_BUFFER_USAGE_UNIFORM_BUFFER_BIT, UNIFORMS_CHUNK_SIZE);
+    if (res != VK_SUCCESS)
+        return ngli_vk_res2ret(res);
+
     res = create_semaphores(s);
     if (res != VK_SUCCESS)
         return ngli_vk_res2ret(res);
@@ -1091,8 +1355,15 @@ static int vk_begin_update(struct gpu_ctx *s, double t)
     if (res != VK_SUCCESS)
         return res;
 
+    /* The frames are executed in order on the queue */
+    s_priv->completed_frame = NGLI_MAX(s_priv->completed_frame, s_priv->cmd_query_frames[s_priv->cur_frame_index]);
+
     s_priv->cur_frame_index = (s_priv->cur_frame_index + 1) % s_priv->nb_in_flight_frames;
 
+    ngli_staging_vk_begin_frame(s_priv->staging, s_priv->cur_frame_index);
+    ngli_staging_vk_begin_frame(s_priv->uniforms, s_priv->cur_frame_index);
+    ngli_desc_pool_vk_begin_frame(s_priv->desc_pool, s_priv->cur_frame_index);
+
     s_priv->cur_cmd = s_priv->update_cmds[s_priv->cur_frame_index];
 
 #if defined(TARGET_DARWIN) || defined(TARGET_IPHONE)
@@ -1153,6 +1424,12 @@ static int vk_begin_draw(struct gpu_ctx *s, double t)
     struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
     const struct ngl_config *config = &s->config;
 
+    if (s_priv->async_captures && config->capture_buffer &&
+        s_priv->nb_pending_captures == config->capture_async_depth) {
+        LOG(ERROR, "all the asynchronous captures are pending, ngl_capture_acquire() must be called first");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
     s_priv->cur_cmd = s_priv->cmds[s_priv->cur_frame_index];
     VkResult res = ngli_cmd_vk_begin(s_priv->cur_cmd);
     if (res != VK_SUCCESS)
@@ -1194,11 +1471,23 @@ static int vk_begin_draw(struct gpu_ctx *s, double t)
         s_priv->default_rt_load->height = s_priv->height;
     }
 
+    /*
+     * The queries of the current frame reuse the ones of the frame drawn
+     * NGLI_GPU_NB_QUERY_FRAMES frames ago
+     */
+    s_priv->query_frame++;
+    s_priv->cmd_query_frames[s_priv->cur_frame_index] = s_priv->query_frame;
+    const int query_index = s_priv->query_frame % NGLI_GPU_NB_QUERY_FRAMES;
+
     if (config->hud) {
-        vkCmdResetQueryPool(s_priv->cur_cmd->cmd_buf, s_priv->query_pool, 0, 2);
-        vkCmdWriteTimestamp(s_priv->cur_cmd->cmd_buf, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, s_priv->query_pool, 0);
+        vkCmdResetQueryPool(s_priv->cur_cmd->cmd_buf, s_priv->query_pool, 2 * query_index, 2);
+        vkCmdWriteTimestamp(s_priv->cur_cmd->cmd_buf, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, s_priv->query_pool, 2 * query_index);
     }
 
+    if (s_priv->timestamp_pool)
+        vkCmdResetQueryPool(s_priv->cur_cmd->cmd_buf, s_priv->timestamp_pool,
+                            query_index * NGLI_GPU_MAX_TIMESTAMPS, NGLI_GPU_MAX_TIMESTAMPS);
+
     return 0;
 }
 
@@ -1213,29 +1502,93 @@ static int vk_query_draw_time(struct gpu_ctx *s, int64_t *time)
 
     ngli_assert(s_priv->cur_cmd->cmd_buf);
     VkCommandBuffer cmd_buf = s_priv->cur_cmd->cmd_buf;
-    vkCmdWriteTimestamp(cmd_buf, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, s_priv->query_pool, 1);
+    const int query_index = s_priv->query_frame % NGLI_GPU_NB_QUERY_FRAMES;
+    vkCmdWriteTimestamp(cmd_buf, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, s_priv->query_pool, 2 * query_index + 1);
 
-    VkResult res = ngli_cmd_vk_submit(s_priv->cur_cmd);
-    if (res != VK_SUCCESS)
-        return ngli_vk_res2ret(res);
+    /*
+     * Pick the most recent frame whose results are available, without
+     * waiting. The queries are reset by the frame command buffer, so until
+     * it has completed, the results of the previous use of the queries may
+     * still be returned.
+     */
+    const int64_t max_latency = NGLI_MIN(NGLI_GPU_NB_QUERY_FRAMES - 1, s_priv->query_frame);
+    for (int latency = 1; latency <= max_latency; latency++) {
+        const int64_t frame = s_priv->query_frame - latency;
+        if (frame <= s_priv->draw_time_frame)
+            break;
+        if (frame > s_priv->completed_frame)
+            continue;
+
+        uint64_t results[2];
+        const uint32_t first_query = 2 * (frame % NGLI_GPU_NB_QUERY_FRAMES);
+        VkResult res = vkGetQueryPoolResults(vk->device,
+                                             s_priv->query_pool, first_query, 2,
+                                             sizeof(results), results, sizeof(results[0]),
+                                             VK_QUERY_RESULT_64_BIT);
+        if (res == VK_NOT_READY)
+            continue;
+        if (res != VK_SUCCESS)
+            return ngli_vk_res2ret(res);
 
-    res = ngli_cmd_vk_wait(s_priv->cur_cmd);
-    if (res != VK_SUCCESS)
-        return ngli_vk_res2ret(res);
+        *time = results[1] - results[0];
+        s_priv->draw_time_frame = frame;
+        return latency;
+    }
+
+    return 0;
+}
 
-    uint64_t results[2];
-    vkGetQueryPoolResults(vk->device,
-                          s_priv->query_pool, 0, 2,
-                          sizeof(results), results, sizeof(results[0]),
-                          VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+static int vk_write_timestamp(struct gpu_ctx *s, int index)
+{
+    struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
 
-    *time = results[1] - results[0];
+    if (!s_priv->timestamp_pool)
+        return NGL_ERROR_UNSUPPORTED;
 
-    res = ngli_cmd_vk_begin(s_priv->cur_cmd);
+    ngli_assert(s_priv->cur_cmd);
+    const int query_index = s_priv->query_frame % NGLI_GPU_NB_QUERY_FRAMES;
+    vkCmdWriteTimestamp(s_priv->cur_cmd->cmd_buf, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                        s_priv->timestamp_pool, query_index * NGLI_GPU_MAX_TIMESTAMPS + index);
+    return 0;
+}
+
+static int vk_get_timestamps(struct gpu_ctx *s, int latency, int64_t *timestamps, int nb_timestamps)
+{
+    struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
+    struct vkcontext *vk = s_priv->vkcontext;
+
+    if (!s_priv->timestamp_pool)
+        return NGL_ERROR_UNSUPPORTED;
+
+    if (latency > s_priv->query_frame)
+        return NGL_ERROR_INVALID_USAGE;
+
+    if (!nb_timestamps)
+        return 1;
+
+    /*
+     * The queries are reset and written by the frame command buffer: the
+     * results are only relevant once it has completed
+     */
+    const int64_t frame = s_priv->query_frame - latency;
+    if (frame > s_priv->completed_frame)
+        return 0;
+
+    const int query_index = frame % NGLI_GPU_NB_QUERY_FRAMES;
+    uint64_t results[NGLI_GPU_MAX_TIMESTAMPS];
+    VkResult res = vkGetQueryPoolResults(vk->device,
+                                         s_priv->timestamp_pool, query_index * NGLI_GPU_MAX_TIMESTAMPS, nb_timestamps,
+                                         nb_timestamps * sizeof(results[0]), results, sizeof(results[0]),
+                                         VK_QUERY_RESULT_64_BIT);
+    if (res == VK_NOT_READY)
+        return 0;
     if (res != VK_SUCCESS)
         return ngli_vk_res2ret(res);
 
-    return 0;
+    const double period = vk->phy_device_props.limits.timestampPeriod;
+    for (int i = 0; i < nb_timestamps; i++)
+        timestamps[i] = (int64_t)(results[i] * period);
+    return 1;
 }
 
 static int vk_end_draw(struct gpu_ctx *s, double t)
@@ -1244,7 +1597,23 @@ static int vk_end_draw(struct gpu_ctx *s, double t)
     struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
 
     if (config->offscreen) {
-        if (config->capture_buffer) {
+        if (config->capture_buffer && s_priv->async_captures) {
+            const int index = (s_priv->async_capture_index + s_priv->nb_pending_captures) % config->capture_async_depth;
+            struct async_capture_vk *capture = &s_priv->async_captures[index];
+
+            struct texture **colors = ngli_darray_data(&s_priv->colors);
+            struct texture *color = colors[s_priv->cur_frame_index];
+            ngli_texture_vk_copy_to_buffer(color, capture->buffer);
+
+            VkResult res = ngli_cmd_vk_submit(s_priv->cur_cmd);
+            if (res != VK_SUCCESS)
+                return ngli_vk_res2ret(res);
+
+            /* The readback is only waited for in vk_capture_acquire() */
+            capture->cmd = s_priv->cur_cmd;
+            capture->t = t;
+            s_priv->nb_pending_captures++;
+        } else if (config->capture_buffer) {
             struct texture **colors = ngli_darray_data(&s_priv->colors);
             struct texture *color = colors[s_priv->cur_frame_index];
             if (s_priv->capture_buffer) {
@@ -1286,6 +1655,35 @@ static int vk_end_draw(struct gpu_ctx *s, double t)
     return 0;
 }
 
+static int vk_capture_acquire(struct gpu_ctx *s, double *t)
+{
+    struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
+    const struct ngl_config *config = &s->config;
+
+    if (!s_priv->nb_pending_captures)
+        return 0;
+
+    struct async_capture_vk *capture = &s_priv->async_captures[s_priv->async_capture_index];
+    s_priv->async_capture_index = (s_priv->async_capture_index + 1) % config->capture_async_depth;
+    s_priv->nb_pending_captures--;
+
+    /*
+     * The command buffer may have been reused by a later frame since then,
+     * in which case waiting on it is still correct (submissions to the
+     * queue complete in order) but possibly longer than needed.
+     */
+    VkResult res = ngli_cmd_vk_wait(capture->cmd);
+    if (res != VK_SUCCESS)
+        return ngli_vk_res2ret(res);
+
+    memcpy(config->capture_buffer, capture->mapped_data, s_priv->capture_buffer_size);
+
+    if (t)
+        *t = capture->t;
+
+    return 1;
+}
+
 static void vk_destroy(struct gpu_ctx *s)
 {
     struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
@@ -1308,6 +1706,10 @@ static void vk_destroy(struct gpu_ctx *s)
     destroy_render_resources(s);
     destroy_swapchain(s);
     destroy_query_pool(s);
+    ngli_staging_vk_freep(&s_priv->uniforms);
+    ngli_staging_vk_freep(&s_priv->staging);
+    ngli_desc_pool_vk_freep(&s_priv->desc_pool);
+    destroy_pipeline_cache(s);
 
     ngli_glslang_uninit();
 
@@ -1319,6 +1721,28 @@ static void vk_wait_idle(struct gpu_ctx *s)
     struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
     struct vkcontext *vk = s_priv->vkcontext;
     vkDeviceWaitIdle(vk->device);
+
+    /* All the submitted frames have completed, so are their queries */
+    if (s_priv->cmd_query_frames) {
+        for (int i = 0; i < s_priv->nb_in_flight_frames; i++)
+            s_priv->completed_frame = NGLI_MAX(s_priv->completed_frame, s_priv->cmd_query_frames[i]);
+    }
+}
+
+static int vk_alloc_uniform_data(struct gpu_ctx *s, size_t size, struct buffer **bufferp, size_t *offsetp, void **datap)
+{
+    struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
+    const VkDeviceSize alignment = NGLI_MAX(s->limits.min_uniform_block_offset_alignment, 1);
+
+    struct staging_alloc_vk alloc;
+    VkResult res = ngli_staging_vk_alloc(s_priv->uniforms, size, alignment, &alloc);
+    if (res != VK_SUCCESS)
+        return ngli_vk_res2ret(res);
+
+    *bufferp = alloc.buffer;
+    *offsetp = alloc.offset;
+    *datap = alloc.data;
+    return 0;
 }
 
 static int vk_transform_cull_mode(struct gpu_ctx *s, int cull_mode)
@@ -1492,7 +1916,7 @@ static int vk_get_preferred_depth_stencil_format(struct gpu_ctx *s)
     return vk->preferred_depth_stencil_format;
 }
 
-static int vk_buffer_init(struct buffer *s, int size, int usage)
+static int vk_buffer_init(struct buffer *s, size_t size, int usage)
 {
     VkResult res = ngli_buffer_vk_init(s, size, usage);
     if (res != VK_SUCCESS)
@@ -1500,7 +1924,7 @@ static int vk_buffer_init(struct buffer *s, int size, int usage)
     return ngli_vk_res2ret(res);
 }
 
-static int vk_buffer_upload(struct buffer *s, const void *data, int size, int offset)
+static int vk_buffer_upload(struct buffer *s, const void *data, size_t size, size_t offset)
 {
     VkResult res = ngli_buffer_vk_upload(s, data, size, offset);
     if (res != VK_SUCCESS)
@@ -1508,7 +1932,7 @@ static int vk_buffer_upload(struct buffer *s, const void *data, int size, int of
     return ngli_vk_res2ret(res);
 }
 
-static int vk_buffer_map(struct buffer *s, int size, int offset, void **data)
+static int vk_buffer_map(struct buffer *s, size_t size, size_t offset, void **data)
 {
     VkResult res = ngli_buffer_vk_map(s, size, offset, data);
     if (res != VK_SUCCESS)
@@ -1567,14 +1991,19 @@ const struct gpu_ctx_class ngli_gpu_ctx_vk = {
     .init                               = vk_init,
     .resize                             = vk_resize,
     .set_capture_buffer                 = vk_set_capture_buffer,
+    .capture_acquire                    = vk_capture_acquire,
     .begin_update                       = vk_begin_update,
     .end_update                         = vk_end_update,
     .begin_draw                         = vk_begin_draw,
     .query_draw_time                    = vk_query_draw_time,
+    .write_timestamp                    = vk_write_timestamp,
+    .get_timestamps                     = vk_get_timestamps,
     .end_draw                           = vk_end_draw,
     .wait_idle                          = vk_wait_idle,
     .destroy                            = vk_destroy,
 
+    .alloc_uniform_data                 = vk_alloc_uniform_data,
+
     .transform_cull_mode                = vk_transform_cull_mode,
     .transform_projection_matrix        = vk_transform_projection_matrix,
     .get_rendertarget_uvcoord_matrix    = vk_get_rendertarget_uvcoord_matrix,
@@ -1607,6 +2036,7 @@ const struct gpu_ctx_class ngli_gpu_ctx_vk = {
     .pipeline_update_uniform            = ngli_pipeline_vk_update_uniform,
     .pipeline_update_texture            = ngli_pipeline_vk_update_texture,
     .pipeline_update_buffer             = ngli_pipeline_vk_update_buffer,
+    .pipeline_update_dynamic_offsets    = ngli_pipeline_vk_update_dynamic_offsets,
     .pipeline_draw                      = ngli_pipeline_vk_draw,
     .pipeline_draw_indexed              = ngli_pipeline_vk_draw_indexed,
     .pipeline_dispatch                  = ngli_pipeline_vk_dispatch,
@@ -1614,6 +2044,8 @@ const struct gpu_ctx_class ngli_gpu_ctx_vk = {
 
     .program_create                     = ngli_program_vk_create,
     .program_init                       = ngli_program_vk_init,
+    .program_init_from_binary           = ngli_program_vk_init_from_binary,
+    .program_get_binary                 = ngli_program_vk_get_binary,
     .program_freep                      = ngli_program_vk_freep,
 
     .rendertarget_create                = ngli_rendertarget_vk_create,
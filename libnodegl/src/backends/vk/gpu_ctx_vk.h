@@ -25,6 +25,15 @@
 #include "gpu_ctx.h"
 #include "vkcontext.h"
 #include "command_vk.h"
+#include "desc_pool_vk.h"
+#include "staging_vk.h"
+
+struct async_capture_vk {
+    struct buffer *buffer;
+    void *mapped_data;
+    struct cmd_vk *cmd;
+    double t;
+};
 
 struct gpu_ctx_vk {
     struct gpu_ctx parent;
@@ -43,7 +52,33 @@ struct gpu_ctx_vk {
     struct cmd_vk *cur_cmd;
     int cur_cmd_is_transient;
 
+    /* Timer queries, one set per frame of the NGLI_GPU_NB_QUERY_FRAMES ring */
     VkQueryPool query_pool;
+    VkQueryPool timestamp_pool; /* Profiler timestamps, NGLI_GPU_MAX_TIMESTAMPS entries per frame */
+    int64_t query_frame;        /* Index of the current frame, -1 before the first draw */
+    int64_t draw_time_frame;    /* Index of the last frame whose draw time was returned */
+    int64_t *cmd_query_frames;  /* Index of the frame recorded by each frame command buffer */
+    int64_t completed_frame;    /* Index of the last frame whose command buffer has completed */
+
+    VkPipelineCache pipeline_cache;
+    size_t pipeline_cache_size;     /* Size of the cache data loaded from disk */
+    uint32_t pipeline_cache_crc;    /* Checksum of the cache data loaded from disk */
+
+    /* Descriptor sets allocator shared by all the pipelines */
+    struct desc_pool_vk *desc_pool;
+
+    /* Staging memory ring used by the buffer and texture uploads */
+    struct staging_vk *staging;
+
+    /* Uniform buffer ring shared by all the pipelines */
+    struct staging_vk *uniforms;
+
+    /*
+     * Last identifier given to a buffer or a texture. Identifiers are never
+     * reused, unlike the Vulkan handles, which makes them suitable to detect
+     * redundant resource bindings.
+     */
+    uint64_t resource_id;
 
     VkSurfaceCapabilitiesKHR surface_caps;
     VkSurfaceFormatKHR surface_format;
@@ -72,6 +107,11 @@ struct gpu_ctx_vk {
     void *mapped_data;
     struct texture *capture_texture;
 
+    /* Asynchronous capture ring, see ngl_config.capture_async_depth */
+    struct async_capture_vk *async_captures;
+    int async_capture_index; /* Index of the oldest pending capture */
+    int nb_pending_captures;
+
     struct rendertarget *default_rt;
     struct rendertarget *default_rt_load;
     struct rendertarget_desc default_rt_desc;
@@ -25,6 +25,7 @@
 #include <limits.h>
 
 #include "darray.h"
+#include "desc_pool_vk.h"
 #include "format.h"
 #include "gpu_ctx_vk.h"
 #include "hmap.h"
@@ -56,13 +57,16 @@ struct attribute_binding {
 struct buffer_binding {
     struct pipeline_buffer_desc desc;
     const struct buffer *buffer;
+    uint64_t buffer_id;
     uint32_t update_desc_flags;
+    int dynamic_offset_index;
 };
 
 struct texture_binding {
     struct pipeline_texture_desc desc;
     uint32_t desc_binding_index;
     const struct texture *texture;
+    uint64_t texture_id;
     uint32_t update_desc_flags;
     int use_ycbcr_sampler;
     struct ycbcr_sampler_vk *ycbcr_sampler;
@@ -355,7 +359,7 @@ static VkResult pipeline_graphics_init(struct pipeline *s)
         .renderPass          = render_pass,
         .subpass             = 0,
     };
-    res = vkCreateGraphicsPipelines(vk->device, VK_NULL_HANDLE, 1, &pipeline_create_info, NULL, &s_priv->pipeline);
+    res = vkCreateGraphicsPipelines(vk->device, gpu_ctx_vk->pipeline_cache, 1, &pipeline_create_info, NULL, &s_priv->pipeline);
 
     vkDestroyRenderPass(vk->device, render_pass, NULL);
 
@@ -382,7 +386,7 @@ static VkResult pipeline_compute_init(struct pipeline *s)
         .layout = s_priv->pipeline_layout,
     };
 
-    return vkCreateComputePipelines(vk->device, VK_NULL_HANDLE, 1, &pipeline_create_info, NULL, &s_priv->pipeline);
+    return vkCreateComputePipelines(vk->device, gpu_ctx_vk->pipeline_cache, 1, &pipeline_create_info, NULL, &s_priv->pipeline);
 }
 
 static const VkShaderStageFlags stage_flag_map[NGLI_PROGRAM_SHADER_NB] = {
@@ -397,15 +401,16 @@ static VkShaderStageFlags get_vk_stage_flags(int stage)
 }
 
 static const VkDescriptorType descriptor_type_map[NGLI_TYPE_NB] = {
-    [NGLI_TYPE_UNIFORM_BUFFER] = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-    [NGLI_TYPE_STORAGE_BUFFER] = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-    [NGLI_TYPE_SAMPLER_2D]     = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-    [NGLI_TYPE_SAMPLER_3D]     = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-    [NGLI_TYPE_SAMPLER_CUBE]   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-    [NGLI_TYPE_IMAGE_2D]       = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
-    [NGLI_TYPE_IMAGE_3D]       = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
-    [NGLI_TYPE_IMAGE_2D_ARRAY] = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
-    [NGLI_TYPE_IMAGE_CUBE]     = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+    [NGLI_TYPE_UNIFORM_BUFFER]         = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+    [NGLI_TYPE_UNIFORM_BUFFER_DYNAMIC] = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+    [NGLI_TYPE_STORAGE_BUFFER]         = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    [NGLI_TYPE_SAMPLER_2D]             = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+    [NGLI_TYPE_SAMPLER_3D]             = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+    [NGLI_TYPE_SAMPLER_CUBE]           = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+    [NGLI_TYPE_IMAGE_2D]               = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+    [NGLI_TYPE_IMAGE_3D]               = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+    [NGLI_TYPE_IMAGE_2D_ARRAY]         = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+    [NGLI_TYPE_IMAGE_CUBE]             = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
 };
 
 static VkDescriptorType get_vk_descriptor_type(int type)
@@ -418,21 +423,21 @@ static VkDescriptorType get_vk_descriptor_type(int type)
 static VkResult create_desc_set_layout_bindings(struct pipeline *s, const struct pipeline_params *params)
 {
     const struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
-    const struct vkcontext *vk = gpu_ctx_vk->vkcontext;
     struct pipeline_vk *s_priv = (struct pipeline_vk *)s;
 
     ngli_darray_init(&s_priv->desc_set_layout_bindings, sizeof(VkDescriptorSetLayoutBinding), 0);
 
     VkDescriptorPoolSize desc_pool_size_map[NGLI_TYPE_NB] = {
-        [NGLI_TYPE_UNIFORM_BUFFER] = {.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER},
-        [NGLI_TYPE_STORAGE_BUFFER] = {.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER},
-        [NGLI_TYPE_SAMPLER_2D]     = {.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER},
-        [NGLI_TYPE_SAMPLER_3D]     = {.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER},
-        [NGLI_TYPE_SAMPLER_CUBE]   = {.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER},
-        [NGLI_TYPE_IMAGE_2D]       = {.type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE},
-        [NGLI_TYPE_IMAGE_3D]       = {.type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE},
-        [NGLI_TYPE_IMAGE_2D_ARRAY] = {.type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE},
-        [NGLI_TYPE_IMAGE_CUBE]     = {.type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE},
+        [NGLI_TYPE_UNIFORM_BUFFER]         = {.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER},
+        [NGLI_TYPE_UNIFORM_BUFFER_DYNAMIC] = {.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC},
+        [NGLI_TYPE_STORAGE_BUFFER]         = {.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER},
+        [NGLI_TYPE_SAMPLER_2D]             = {.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER},
+        [NGLI_TYPE_SAMPLER_3D]             = {.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER},
+        [NGLI_TYPE_SAMPLER_CUBE]           = {.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER},
+        [NGLI_TYPE_IMAGE_2D]               = {.type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE},
+        [NGLI_TYPE_IMAGE_3D]               = {.type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE},
+        [NGLI_TYPE_IMAGE_2D_ARRAY]         = {.type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE},
+        [NGLI_TYPE_IMAGE_CUBE]             = {.type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE},
     };
 
     const struct pipeline_layout *layout = &params->layout;
@@ -449,8 +454,24 @@ static VkResult create_desc_set_layout_bindings(struct pipeline *s, const struct
         if (!ngli_darray_push(&s_priv->desc_set_layout_bindings, &binding))
             return VK_ERROR_OUT_OF_HOST_MEMORY;
 
+        /*
+         * Vulkan expects the dynamic offsets to be ordered by binding number,
+         * which is not necessarily the order of the buffers in the layout
+         */
+        int dynamic_offset_index = -1;
+        if (desc->type == NGLI_TYPE_UNIFORM_BUFFER_DYNAMIC) {
+            dynamic_offset_index = 0;
+            for (int j = 0; j < layout->nb_buffers; j++) {
+                const struct pipeline_buffer_desc *other_desc = &layout->buffers_desc[j];
+                if (other_desc->type == NGLI_TYPE_UNIFORM_BUFFER_DYNAMIC && other_desc->binding < desc->binding)
+                    dynamic_offset_index++;
+            }
+            s_priv->nb_dynamic_offsets++;
+        }
+
         const struct buffer_binding buffer_binding = {
-            .desc = *desc,
+            .desc                 = *desc,
+            .dynamic_offset_index = dynamic_offset_index,
         };
         if (!ngli_darray_push(&s_priv->buffer_bindings, &buffer_binding))
             return VK_ERROR_OUT_OF_HOST_MEMORY;
@@ -483,25 +504,40 @@ static VkResult create_desc_set_layout_bindings(struct pipeline *s, const struct
         desc_pool_size_map[desc->type].descriptorCount += gpu_ctx_vk->nb_in_flight_frames;
     }
 
-    uint32_t nb_desc_pool_sizes = 0;
-    VkDescriptorPoolSize desc_pool_sizes[NGLI_TYPE_NB];
+    /*
+     * The descriptor sets are allocated from the allocator shared by all the
+     * pipelines, only keep track of the number of descriptors they require.
+     */
     for (int i = 0; i < NGLI_ARRAY_NB(desc_pool_size_map); i++) {
         if (desc_pool_size_map[i].descriptorCount)
-            desc_pool_sizes[nb_desc_pool_sizes++] = desc_pool_size_map[i];
+            s_priv->desc_pool_sizes[s_priv->nb_desc_pool_sizes++] = desc_pool_size_map[i];
     }
-    if (!nb_desc_pool_sizes)
+    if (!s_priv->nb_desc_pool_sizes)
         return VK_SUCCESS;
 
-    const VkDescriptorPoolCreateInfo descriptor_pool_create_info = {
-        .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
-        .poolSizeCount = nb_desc_pool_sizes,
-        .pPoolSizes    = desc_pool_sizes,
-        .maxSets       = gpu_ctx_vk->nb_in_flight_frames,
-    };
+    /* Scratch storage used to batch the descriptor set updates */
+    const int nb_bindings = layout->nb_buffers + layout->nb_textures;
+    s_priv->desc_writes = ngli_calloc(nb_bindings, sizeof(*s_priv->desc_writes));
+    if (!s_priv->desc_writes)
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
 
-    VkResult res = vkCreateDescriptorPool(vk->device, &descriptor_pool_create_info, NULL, &s_priv->desc_pool);
-    if (res != VK_SUCCESS)
-        return res;
+    if (layout->nb_textures) {
+        s_priv->desc_image_infos = ngli_calloc(layout->nb_textures, sizeof(*s_priv->desc_image_infos));
+        if (!s_priv->desc_image_infos)
+            return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
+    if (layout->nb_buffers) {
+        s_priv->desc_buffer_infos = ngli_calloc(layout->nb_buffers, sizeof(*s_priv->desc_buffer_infos));
+        if (!s_priv->desc_buffer_infos)
+            return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
+    if (s_priv->nb_dynamic_offsets) {
+        s_priv->dynamic_offsets = ngli_calloc(s_priv->nb_dynamic_offsets, sizeof(*s_priv->dynamic_offsets));
+        if (!s_priv->dynamic_offsets)
+            return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
 
     return VK_SUCCESS;
 }
@@ -528,9 +564,11 @@ static VkResult create_desc_layout(struct pipeline *s)
 static VkResult create_desc_sets(struct pipeline *s)
 {
     const struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
-    const struct vkcontext *vk = gpu_ctx_vk->vkcontext;
     struct pipeline_vk *s_priv = (struct pipeline_vk *)s;
 
+    if (!s_priv->nb_desc_pool_sizes)
+        return VK_SUCCESS;
+
     VkDescriptorSetLayout *desc_set_layouts = ngli_calloc(gpu_ctx_vk->nb_in_flight_frames, sizeof(*desc_set_layouts));
     if (!desc_set_layouts)
         return VK_ERROR_OUT_OF_HOST_MEMORY;
@@ -538,26 +576,22 @@ static VkResult create_desc_sets(struct pipeline *s)
     for (int i = 0; i < gpu_ctx_vk->nb_in_flight_frames; i++)
         desc_set_layouts[i] = s_priv->desc_set_layout;
 
-    const VkDescriptorSetAllocateInfo descriptor_set_allocate_info = {
-        .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
-        .descriptorPool     = s_priv->desc_pool,
-        .descriptorSetCount = gpu_ctx_vk->nb_in_flight_frames,
-        .pSetLayouts        = desc_set_layouts
-    };
-
     s_priv->desc_sets = ngli_calloc(gpu_ctx_vk->nb_in_flight_frames, sizeof(*s_priv->desc_sets));
     if (!s_priv->desc_sets) {
         ngli_free(desc_set_layouts);
         return VK_ERROR_OUT_OF_HOST_MEMORY;
     }
 
-    VkResult res = vkAllocateDescriptorSets(vk->device, &descriptor_set_allocate_info, s_priv->desc_sets);
+    VkResult res = ngli_desc_pool_vk_alloc(gpu_ctx_vk->desc_pool,
+                                           desc_set_layouts, gpu_ctx_vk->nb_in_flight_frames,
+                                           s_priv->desc_pool_sizes, s_priv->nb_desc_pool_sizes,
+                                           &s_priv->desc_pool, s_priv->desc_sets);
+    ngli_free(desc_set_layouts);
     if (res != VK_SUCCESS) {
-        ngli_free(desc_set_layouts);
+        ngli_freep(&s_priv->desc_sets);
         return res;
     }
 
-    ngli_free(desc_set_layouts);
     return VK_SUCCESS;
 }
 
@@ -600,7 +634,7 @@ static VkResult create_pipeline(struct pipeline *s)
     return VK_SUCCESS;
 }
 
-static void destroy_pipeline_keep_pool(struct pipeline *s)
+static void destroy_pipeline(struct pipeline *s)
 {
     struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
     struct vkcontext *vk = gpu_ctx_vk->vkcontext;
@@ -614,17 +648,10 @@ static void destroy_pipeline_keep_pool(struct pipeline *s)
 
     vkDestroyDescriptorSetLayout(vk->device, s_priv->desc_set_layout, NULL);
     s_priv->desc_set_layout = VK_NULL_HANDLE;
-}
-
-static void destroy_pipeline(struct pipeline *s)
-{
-    struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
-    struct vkcontext *vk = gpu_ctx_vk->vkcontext;
-    struct pipeline_vk *s_priv = (struct pipeline_vk *)s;
-
-    destroy_pipeline_keep_pool(s);
 
-    vkDestroyDescriptorPool(vk->device, s_priv->desc_pool, NULL);
+    if (s_priv->desc_sets)
+        ngli_desc_pool_vk_release(gpu_ctx_vk->desc_pool, s_priv->desc_pool,
+                                  s_priv->desc_sets, gpu_ctx_vk->nb_in_flight_frames);
     s_priv->desc_pool = VK_NULL_HANDLE;
     ngli_freep(&s_priv->desc_sets);
 }
@@ -648,29 +675,21 @@ static void request_desc_sets_update(struct pipeline *s)
 
 static VkResult recreate_pipeline(struct pipeline *s)
 {
-    struct pipeline_vk *s_priv = (struct pipeline_vk *)s;
-    struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
-    struct vkcontext *vk = gpu_ctx_vk->vkcontext;
-
     /*
-     * Destroy the current pipeline but keep the descriptor pool to avoid
-     * re-allocating the descriptor sets.
+     * The descriptor sets are released to the shared allocator along with
+     * the pipeline (which only recycles them once the frames in flight are
+     * done with them) and new ones are allocated with the updated layout.
      */
-    destroy_pipeline_keep_pool(s);
-
-    VkResult res = vkResetDescriptorPool(vk->device, s_priv->desc_pool, 0);
-    if (res != VK_SUCCESS)
-        return res;
-    ngli_freep(&s_priv->desc_sets);
+    destroy_pipeline(s);
 
-    res = create_pipeline(s);
+    VkResult res = create_pipeline(s);
     if (res != VK_SUCCESS)
         return res;
 
     /*
-     * The descriptor sets have been reset during pipeline re-creation, thus,
-     * we need to ensure they are properly updated before the next pipeline
-     * execution.
+     * The descriptor sets have been re-allocated during pipeline re-creation,
+     * thus, we need to ensure they are properly updated before the next
+     * pipeline execution.
      */
     request_desc_sets_update(s);
 
@@ -804,7 +823,18 @@ int ngli_pipeline_vk_update_texture(struct pipeline *s, int index, const struct
     ngli_assert(texture_binding);
 
     texture_binding->texture = texture ? texture : gpu_ctx_vk->dummy_texture;
-    texture_binding->update_desc_flags = ~0;
+
+    /*
+     * The descriptor sets already reference (or are pending an update
+     * referencing) the same texture: no descriptor write is necessary.
+     */
+    const struct texture_vk *bound_texture_vk = (const struct texture_vk *)texture_binding->texture;
+    if (texture_binding->texture_id == bound_texture_vk->id) {
+        s->gpu_ctx->stats[NGLI_GPU_STAT_DESC_WRITES_SKIPPED]++;
+    } else {
+        texture_binding->texture_id = bound_texture_vk->id;
+        texture_binding->update_desc_flags = ~0;
+    }
 
     if (texture) {
         struct texture_vk *texture_vk = (struct texture_vk *)texture;
@@ -850,7 +880,16 @@ int ngli_pipeline_vk_update_buffer(struct pipeline *s, int index, const struct b
     struct buffer_binding *buffer_binding = ngli_darray_get(&s_priv->buffer_bindings, index);
     ngli_assert(buffer_binding);
 
+    const uint64_t buffer_id = buffer ? ((const struct buffer_vk *)buffer)->id : 0;
+    if (buffer_binding->buffer_id == buffer_id &&
+        buffer_binding->desc.offset == offset &&
+        buffer_binding->desc.size == size) {
+        s->gpu_ctx->stats[NGLI_GPU_STAT_DESC_WRITES_SKIPPED]++;
+        return 0;
+    }
+
     buffer_binding->buffer = buffer;
+    buffer_binding->buffer_id = buffer_id;
     buffer_binding->desc.offset = offset;
     buffer_binding->desc.size = size;
     buffer_binding->update_desc_flags = ~0;
@@ -858,6 +897,24 @@ int ngli_pipeline_vk_update_buffer(struct pipeline *s, int index, const struct b
     return 0;
 }
 
+int ngli_pipeline_vk_update_dynamic_offsets(struct pipeline *s, const uint32_t *offsets, int nb_offsets)
+{
+    struct pipeline_vk *s_priv = (struct pipeline_vk *)s;
+
+    ngli_assert(nb_offsets == s_priv->nb_dynamic_offsets);
+
+    int nb_dynamic_offsets = 0;
+    const struct buffer_binding *buffer_bindings = ngli_darray_data(&s_priv->buffer_bindings);
+    for (int i = 0; i < ngli_darray_count(&s_priv->buffer_bindings); i++) {
+        const struct buffer_binding *binding = &buffer_bindings[i];
+        if (binding->dynamic_offset_index < 0)
+            continue;
+        s_priv->dynamic_offsets[binding->dynamic_offset_index] = offsets[nb_dynamic_offsets++];
+    }
+
+    return 0;
+}
+
 static const VkIndexType vk_indices_type_map[NGLI_FORMAT_NB] = {
     [NGLI_FORMAT_R16_UNORM] = VK_INDEX_TYPE_UINT16,
     [NGLI_FORMAT_R32_UINT]  = VK_INDEX_TYPE_UINT32,
@@ -876,27 +933,34 @@ static int update_descriptor_set(struct pipeline *s)
     const uint32_t update_desc_flags = (1 << gpu_ctx_vk->cur_frame_index);
     const uint32_t update_desc_mask = ~update_desc_flags;
 
+    if (!s_priv->desc_sets)
+        return 0;
+
+    /* Gather all the pending descriptor writes and submit them at once */
+    const VkDescriptorSet desc_set = s_priv->desc_sets[gpu_ctx_vk->cur_frame_index];
+    uint32_t nb_writes = 0;
+
     struct texture_binding *texture_bindings = ngli_darray_data(&s_priv->texture_bindings);
     for (int i = 0; i < ngli_darray_count(&s_priv->texture_bindings); i++) {
         struct texture_binding *binding = &texture_bindings[i];
         if (binding->update_desc_flags & update_desc_flags) {
             const struct texture_vk *texture_vk = (struct texture_vk *)binding->texture;
-            const VkDescriptorImageInfo image_info = {
+            VkDescriptorImageInfo *image_info = &s_priv->desc_image_infos[i];
+            *image_info = (VkDescriptorImageInfo) {
                 .imageLayout = texture_vk->default_image_layout,
                 .imageView   = texture_vk->image_view,
                 .sampler     = texture_vk->sampler,
             };
             const struct pipeline_texture_desc *desc = &binding->desc;
-            const VkWriteDescriptorSet write_descriptor_set = {
+            s_priv->desc_writes[nb_writes++] = (VkWriteDescriptorSet) {
                 .sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-                .dstSet           = s_priv->desc_sets[gpu_ctx_vk->cur_frame_index],
+                .dstSet           = desc_set,
                 .dstBinding       = desc->binding,
                 .dstArrayElement  = 0,
                 .descriptorType   = get_vk_descriptor_type(desc->type),
                 .descriptorCount  = 1,
-                .pImageInfo       = &image_info,
+                .pImageInfo       = image_info,
             };
-            vkUpdateDescriptorSets(vk->device, 1, &write_descriptor_set, 0, NULL);
             binding->update_desc_flags &= update_desc_mask;
         }
     }
@@ -907,27 +971,32 @@ static int update_descriptor_set(struct pipeline *s)
         if (binding->update_desc_flags & update_desc_flags) {
             const struct pipeline_buffer_desc *desc = &binding->desc;
             const struct buffer_vk *buffer_vk = (struct buffer_vk *)(binding->buffer);
-            const VkDescriptorBufferInfo descriptor_buffer_info = {
+            VkDescriptorBufferInfo *buffer_info = &s_priv->desc_buffer_infos[i];
+            *buffer_info = (VkDescriptorBufferInfo) {
                 .buffer = buffer_vk->buffer,
                 .offset = desc->offset,
                 .range  = desc->size ? desc->size : binding->buffer->size,
             };
-            const VkWriteDescriptorSet write_descriptor_set = {
+            s_priv->desc_writes[nb_writes++] = (VkWriteDescriptorSet) {
                 .sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-                .dstSet           = s_priv->desc_sets[gpu_ctx_vk->cur_frame_index],
+                .dstSet           = desc_set,
                 .dstBinding       = desc->binding,
                 .dstArrayElement  = 0,
                 .descriptorType   = get_vk_descriptor_type(desc->type),
                 .descriptorCount  = 1,
-                .pBufferInfo      = &descriptor_buffer_info,
+                .pBufferInfo      = buffer_info,
                 .pImageInfo       = NULL,
                 .pTexelBufferView = NULL,
             };
-            vkUpdateDescriptorSets(vk->device, 1, &write_descriptor_set, 0, NULL);
             binding->update_desc_flags &= update_desc_mask;
         }
     }
 
+    if (nb_writes) {
+        vkUpdateDescriptorSets(vk->device, nb_writes, s_priv->desc_writes, 0, NULL);
+        s->gpu_ctx->stats[NGLI_GPU_STAT_DESC_WRITES] += nb_writes;
+    }
+
     return 0;
 }
 
@@ -971,7 +1040,8 @@ static int prepare_pipeline(struct pipeline *s, VkCommandBuffer cmd_buf)
 
     if (s_priv->desc_sets)
         vkCmdBindDescriptorSets(cmd_buf, VK_PIPELINE_BIND_POINT_GRAPHICS, s_priv->pipeline_layout,
-                                0, 1, &s_priv->desc_sets[gpu_ctx_vk->cur_frame_index], 0, NULL);
+                                0, 1, &s_priv->desc_sets[gpu_ctx_vk->cur_frame_index],
+                                s_priv->nb_dynamic_offsets, s_priv->dynamic_offsets);
 
     const int nb_vertex_buffers = ngli_darray_count(&s_priv->vertex_buffers);
     const VkBuffer *vertex_buffers = ngli_darray_data(&s_priv->vertex_buffers);
@@ -1030,7 +1100,8 @@ void ngli_pipeline_vk_dispatch(struct pipeline *s, int nb_group_x, int nb_group_
 
     if (s_priv->desc_sets)
         vkCmdBindDescriptorSets(cmd_buf, VK_PIPELINE_BIND_POINT_COMPUTE, s_priv->pipeline_layout,
-                                0, 1, &s_priv->desc_sets[gpu_ctx_vk->cur_frame_index], 0, NULL);
+                                0, 1, &s_priv->desc_sets[gpu_ctx_vk->cur_frame_index],
+                                s_priv->nb_dynamic_offsets, s_priv->dynamic_offsets);
 
     vkCmdDispatch(cmd_buf, nb_group_x, nb_group_y, nb_group_z);
 
@@ -1082,5 +1153,10 @@ void ngli_pipeline_vk_freep(struct pipeline **sp)
     ngli_darray_reset(&s_priv->vertex_offsets);
     ngli_darray_reset(&s_priv->desc_set_layout_bindings);
 
+    ngli_freep(&s_priv->desc_writes);
+    ngli_freep(&s_priv->desc_image_infos);
+    ngli_freep(&s_priv->desc_buffer_infos);
+    ngli_freep(&s_priv->dynamic_offsets);
+
     ngli_freep(sp);
 }
@@ -26,6 +26,7 @@
 
 #include "pipeline.h"
 #include "darray.h"
+#include "type.h"
 
 struct gpu_ctx;
 
@@ -41,10 +42,17 @@ struct pipeline_vk {
     struct darray vertex_buffers;           // array of VkBuffer
     struct darray vertex_offsets;           // array of VkDeviceSize
 
-    VkDescriptorPool desc_pool;
     struct darray desc_set_layout_bindings; // array of VkDescriptorSetLayoutBinding
     VkDescriptorSetLayout desc_set_layout;
+    VkDescriptorPoolSize desc_pool_sizes[NGLI_TYPE_NB];
+    uint32_t nb_desc_pool_sizes;
+    VkDescriptorPool desc_pool;             // pool of the shared allocator the sets belong to
     VkDescriptorSet *desc_sets;
+    VkWriteDescriptorSet *desc_writes;
+    VkDescriptorImageInfo *desc_image_infos;
+    VkDescriptorBufferInfo *desc_buffer_infos;
+    uint32_t *dynamic_offsets;              // ordered by binding number
+    uint32_t nb_dynamic_offsets;
     VkPipelineLayout pipeline_layout;
     VkPipeline pipeline;
 };
@@ -56,6 +64,7 @@ int ngli_pipeline_vk_update_attribute(struct pipeline *s, int index, const struc
 int ngli_pipeline_vk_update_uniform(struct pipeline *s, int index, const void *value);
 int ngli_pipeline_vk_update_texture(struct pipeline *s, int index, const struct texture *texture);
 int ngli_pipeline_vk_update_buffer(struct pipeline *s, int index, const struct buffer *buffer, int offset, int size);
+int ngli_pipeline_vk_update_dynamic_offsets(struct pipeline *s, const uint32_t *offsets, int nb_offsets);
 void ngli_pipeline_vk_draw(struct pipeline *s, int nb_vertices, int nb_instances);
 void ngli_pipeline_vk_draw_indexed(struct pipeline *s, const struct buffer *indices, int indices_format, int nb_vertices, int nb_instances);
 void ngli_pipeline_vk_dispatch(struct pipeline *s, int nb_group_x, int nb_group_y, int nb_group_z);
@@ -40,12 +40,43 @@ struct program *ngli_program_vk_create(struct gpu_ctx *gpu_ctx)
     return (struct program *)s;
 }
 
-int ngli_program_vk_init(struct program *s, const struct program_params *params)
+static int create_shader_module(struct program *s, int stage, const void *data, size_t size)
 {
     struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
     struct vkcontext *vk = gpu_ctx_vk->vkcontext;
     struct program_vk *s_priv = (struct program_vk *)s;
 
+    const VkShaderModuleCreateInfo shader_module_create_info = {
+        .sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+        .codeSize = size,
+        .pCode    = data,
+    };
+    VkResult res = vkCreateShaderModule(vk->device, &shader_module_create_info, NULL, &s_priv->shaders[stage]);
+    return ngli_vk_res2ret(res);
+}
+
+/*
+ * The program binary is a sequence of records, one per stage:
+ * [u32 stage][u32 size][SPIR-V words]
+ */
+static int append_binary_record(struct program_vk *s_priv, int stage, const void *data, size_t size)
+{
+    const uint32_t header[] = {stage, (uint32_t)size};
+    const size_t new_size = s_priv->binary_size + sizeof(header) + size;
+    uint8_t *binary = ngli_realloc(s_priv->binary, new_size);
+    if (!binary)
+        return NGL_ERROR_MEMORY;
+    memcpy(binary + s_priv->binary_size, header, sizeof(header));
+    memcpy(binary + s_priv->binary_size + sizeof(header), data, size);
+    s_priv->binary = binary;
+    s_priv->binary_size = new_size;
+    return 0;
+}
+
+int ngli_program_vk_init(struct program *s, const struct program_params *params)
+{
+    struct program_vk *s_priv = (struct program_vk *)s;
+
     const struct {
         int stage;
         const char *src;
@@ -55,6 +86,8 @@ int ngli_program_vk_init(struct program *s, const struct program_params *params)
         {NGLI_PROGRAM_SHADER_COMP, params->compute},
     };
 
+    const int keep_binary = s->gpu_ctx->config.program_cache_dir != NULL;
+
     for (int i = 0; i < NGLI_ARRAY_NB(shaders); i++) {
         if (!shaders[i].src)
             continue;
@@ -72,27 +105,92 @@ int ngli_program_vk_init(struct program *s, const struct program_params *params)
             return ret;
         }
 
-        const VkShaderModuleCreateInfo shader_module_create_info = {
-            .sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
-            .codeSize = size,
-            .pCode    = data,
-        };
-        VkResult res = vkCreateShaderModule(vk->device, &shader_module_create_info, NULL, &s_priv->shaders[i]);
-        ngli_freep(&data);
-        if (res != VK_SUCCESS) {
+        ret = create_shader_module(s, shaders[i].stage, data, size);
+        if (ret < 0) {
+            ngli_freep(&data);
             char *s_with_numbers = ngli_numbered_lines(shaders[i].src);
             if (s_with_numbers) {
                 LOG(ERROR, "failed to compile shader \"%s\":\n%s",
                     params->label ? params->label : "", s_with_numbers);
                 ngli_free(s_with_numbers);
             }
-            return ngli_vk_res2ret(res);
+            return ret;
         }
+
+        if (keep_binary) {
+            ret = append_binary_record(s_priv, shaders[i].stage, data, size);
+            if (ret < 0) {
+                ngli_freep(&data);
+                return ret;
+            }
+        }
+        ngli_freep(&data);
     }
 
     return 0;
 }
 
+int ngli_program_vk_init_from_binary(struct program *s, const struct program_params *params,
+                                     const void *data, size_t size)
+{
+    const char *srcs[] = {
+        [NGLI_PROGRAM_SHADER_VERT] = params->vertex,
+        [NGLI_PROGRAM_SHADER_FRAG] = params->fragment,
+        [NGLI_PROGRAM_SHADER_COMP] = params->compute,
+    };
+
+    const uint8_t *p = data;
+    const uint8_t *end = p + size;
+    int stages = 0;
+    while (p < end) {
+        uint32_t header[2];
+        if ((size_t)(end - p) < sizeof(header))
+            return NGL_ERROR_INVALID_DATA;
+        memcpy(header, p, sizeof(header));
+        p += sizeof(header);
+
+        const uint32_t stage = header[0];
+        const uint32_t stage_size = header[1];
+        if (stage >= NGLI_PROGRAM_SHADER_NB || !srcs[stage] || (stages & (1 << stage)) ||
+            !stage_size || stage_size % sizeof(uint32_t) || (size_t)(end - p) < stage_size)
+            return NGL_ERROR_INVALID_DATA;
+
+        /* Copy to honor the SPIR-V words alignment required by Vulkan */
+        void *code = ngli_memdup(p, stage_size);
+        if (!code)
+            return NGL_ERROR_MEMORY;
+        int ret = create_shader_module(s, stage, code, stage_size);
+        ngli_freep(&code);
+        if (ret < 0)
+            return ret;
+
+        stages |= 1 << stage;
+        p += stage_size;
+    }
+
+    for (int i = 0; i < NGLI_ARRAY_NB(srcs); i++)
+        if (srcs[i] && !(stages & (1 << i)))
+            return NGL_ERROR_INVALID_DATA;
+
+    return 0;
+}
+
+int ngli_program_vk_get_binary(struct program *s, void **datap, size_t *sizep)
+{
+    struct program_vk *s_priv = (struct program_vk *)s;
+
+    if (!s_priv->binary)
+        return NGL_ERROR_GRAPHICS_UNSUPPORTED;
+
+    void *data = ngli_memdup(s_priv->binary, s_priv->binary_size);
+    if (!data)
+        return NGL_ERROR_MEMORY;
+
+    *datap = data;
+    *sizep = s_priv->binary_size;
+    return 0;
+}
+
 void ngli_program_vk_freep(struct program **sp)
 {
     struct program *s = *sp;
@@ -105,5 +203,6 @@ void ngli_program_vk_freep(struct program **sp)
 
     for (int i = 0; i < NGLI_ARRAY_NB(s_priv->shaders); i++)
         vkDestroyShaderModule(vk->device, s_priv->shaders[i], NULL);
+    ngli_freep(&s_priv->binary);
     ngli_freep(sp);
 }
@@ -22,6 +22,7 @@
 #ifndef PROGRAM_VK_H
 #define PROGRAM_VK_H
 
+#include <stdint.h>
 #include <vulkan/vulkan.h>
 
 #include "program.h"
@@ -31,10 +32,15 @@ struct gpu_ctx;
 struct program_vk {
     struct program parent;
     VkShaderModule shaders[NGLI_PROGRAM_SHADER_NB];
+    uint8_t *binary; /* SPIR-V of all the stages, only kept for the program cache */
+    size_t binary_size;
 };
 
 struct program *ngli_program_vk_create(struct gpu_ctx *gpu_ctx);
 int ngli_program_vk_init(struct program *s, const struct program_params *params);
+int ngli_program_vk_init_from_binary(struct program *s, const struct program_params *params,
+                                     const void *data, size_t size);
+int ngli_program_vk_get_binary(struct program *s, void **datap, size_t *sizep);
 void ngli_program_vk_freep(struct program **sp);
 
 #endif
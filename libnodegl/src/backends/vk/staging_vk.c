@@ -0,0 +1,189 @@
+/*
+ * Copyright 2023 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stddef.h>
+
+#include "buffer_vk.h"
+#include "gpu_ctx_vk.h"
+#include "log.h"
+#include "math_utils.h"
+#include "memory.h"
+#include "staging_vk.h"
+#include "utils.h"
+
+struct staging_chunk_vk {
+    struct buffer *buffer;
+    uint8_t *mapped_data;
+    VkDeviceSize region_size; // size of the region of each frame
+    VkDeviceSize offset;      // allocation offset in the region of the current frame
+    int64_t last_frame;       // last frame the chunk has been allocated from
+};
+
+struct staging_vk *ngli_staging_vk_create(struct gpu_ctx *gpu_ctx)
+{
+    struct staging_vk *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+    s->gpu_ctx = gpu_ctx;
+    return s;
+}
+
+VkResult ngli_staging_vk_init(struct staging_vk *s, int nb_frames, int usage, int chunk_size)
+{
+    ngli_darray_init(&s->chunks, sizeof(struct staging_chunk_vk), 0);
+    s->nb_frames = nb_frames;
+    s->usage = usage;
+    s->chunk_size = chunk_size;
+    return VK_SUCCESS;
+}
+
+static void destroy_chunk(struct staging_vk *s, struct staging_chunk_vk *chunk)
+{
+    if (chunk->mapped_data)
+        ngli_buffer_vk_unmap(chunk->buffer);
+    ngli_buffer_vk_freep(&chunk->buffer);
+    s->gpu_ctx->stats[NGLI_GPU_STAT_STAGING_CHUNKS]--;
+}
+
+static VkResult create_chunk(struct staging_vk *s, VkDeviceSize region_size, struct staging_chunk_vk *chunk)
+{
+    *chunk = (struct staging_chunk_vk){.region_size = region_size};
+    s->gpu_ctx->stats[NGLI_GPU_STAT_STAGING_CHUNKS]++;
+
+    chunk->buffer = ngli_buffer_vk_create(s->gpu_ctx);
+    if (!chunk->buffer) {
+        s->gpu_ctx->stats[NGLI_GPU_STAT_STAGING_CHUNKS]--;
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
+    const VkDeviceSize size = region_size * s->nb_frames;
+    const int usage = s->usage | NGLI_BUFFER_USAGE_DYNAMIC_BIT | NGLI_BUFFER_USAGE_MAP_WRITE;
+    VkResult res = ngli_buffer_vk_init(chunk->buffer, size, usage);
+    if (res != VK_SUCCESS)
+        goto fail;
+
+    res = ngli_buffer_vk_map(chunk->buffer, size, 0, (void **)&chunk->mapped_data);
+    if (res != VK_SUCCESS)
+        goto fail;
+
+    return VK_SUCCESS;
+
+fail:
+    destroy_chunk(s, chunk);
+    return res;
+}
+
+void ngli_staging_vk_begin_frame(struct staging_vk *s, int frame_index)
+{
+    ngli_assert(frame_index >= 0 && frame_index < s->nb_frames);
+
+    s->cur_frame = frame_index;
+    s->frame_count++;
+
+    /*
+     * Only keep the first chunk and the regular sized chunks that have been
+     * used during the last cycle of the ring, so that a burst of uploads
+     * (typically at initialization) does not pin its staging memory forever.
+     * A chunk can only be destroyed once none of the frames in flight
+     * reference it anymore.
+     */
+    struct staging_chunk_vk *chunks = ngli_darray_data(&s->chunks);
+    for (int i = ngli_darray_count(&s->chunks) - 1; i >= 0; i--) {
+        struct staging_chunk_vk *chunk = &chunks[i];
+        const int64_t age = s->frame_count - chunk->last_frame;
+        const int oversized = chunk->region_size > s->chunk_size;
+        if ((oversized && age >= s->nb_frames) || (i > 0 && age > s->nb_frames)) {
+            destroy_chunk(s, chunk);
+            ngli_darray_remove(&s->chunks, i);
+            continue;
+        }
+        chunk->offset = 0;
+    }
+    s->cur_chunk = 0;
+}
+
+static int alloc_from_chunk(struct staging_vk *s, struct staging_chunk_vk *chunk,
+                            VkDeviceSize size, VkDeviceSize alignment,
+                            struct staging_alloc_vk *alloc)
+{
+    const VkDeviceSize region_offset = chunk->region_size * s->cur_frame;
+    const VkDeviceSize offset = (region_offset + chunk->offset + alignment - 1) / alignment * alignment;
+    if (offset + size > region_offset + chunk->region_size)
+        return 0;
+
+    chunk->offset = offset + size - region_offset;
+    chunk->last_frame = s->frame_count;
+    *alloc = (struct staging_alloc_vk){
+        .buffer = chunk->buffer,
+        .offset = offset,
+        .data   = chunk->mapped_data + offset,
+    };
+    return 1;
+}
+
+VkResult ngli_staging_vk_alloc(struct staging_vk *s, VkDeviceSize size, VkDeviceSize alignment,
+                               struct staging_alloc_vk *alloc)
+{
+    /* Chunks are filled in order, free space left in previous chunks is lost */
+    struct staging_chunk_vk *chunks = ngli_darray_data(&s->chunks);
+    for (int i = s->cur_chunk; i < ngli_darray_count(&s->chunks); i++) {
+        if (alloc_from_chunk(s, &chunks[i], size, alignment, alloc)) {
+            s->cur_chunk = i;
+            return VK_SUCCESS;
+        }
+    }
+
+    /*
+     * The regions are not necessarily aligned, leave enough room for the
+     * allocation to be aligned anywhere in the region
+     */
+    const VkDeviceSize region_size = NGLI_MAX(size + alignment - 1, (VkDeviceSize)s->chunk_size);
+
+    struct staging_chunk_vk chunk;
+    VkResult res = create_chunk(s, region_size, &chunk);
+    if (res != VK_SUCCESS)
+        return res;
+
+    struct staging_chunk_vk *chunkp = ngli_darray_push(&s->chunks, &chunk);
+    if (!chunkp) {
+        destroy_chunk(s, &chunk);
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
+    s->cur_chunk = ngli_darray_count(&s->chunks) - 1;
+    const int ret = alloc_from_chunk(s, chunkp, size, alignment, alloc);
+    ngli_assert(ret);
+    return VK_SUCCESS;
+}
+
+void ngli_staging_vk_freep(struct staging_vk **sp)
+{
+    struct staging_vk *s = *sp;
+    if (!s)
+        return;
+
+    struct staging_chunk_vk *chunks = ngli_darray_data(&s->chunks);
+    for (int i = 0; i < ngli_darray_count(&s->chunks); i++)
+        destroy_chunk(s, &chunks[i]);
+    ngli_darray_reset(&s->chunks);
+
+    ngli_freep(sp);
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2023 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef STAGING_VK_H
+#define STAGING_VK_H
+
+#include <stdint.h>
+#include <vulkan/vulkan.h>
+
+#include "darray.h"
+
+struct buffer;
+struct gpu_ctx;
+
+/*
+ * Host visible memory ring, used to upload data to device local buffers and
+ * images, and to hold the transient uniform data of the pipelines.
+ *
+ * The ring sub-allocates from a list of persistently mapped host visible
+ * buffers (chunks). Every chunk is split in one region per in-flight frame,
+ * and each region is used as a linear allocator which is reset when its frame
+ * slot is reused, which is only done once the GPU is done with the commands
+ * recorded during the previous use of that slot. This allows the data to be
+ * consumed by the frame command buffer without waiting for its completion,
+ * and without creating a buffer for every allocation.
+ *
+ * Since all the frames share the same chunks, the buffer backing a given
+ * allocation is usually the same from one frame to another: only the offset
+ * changes, which allows the uniform data to be bound with dynamic offsets
+ * without updating any descriptor set.
+ */
+struct staging_vk {
+    struct gpu_ctx *gpu_ctx;
+    struct darray chunks; // array of struct staging_chunk_vk
+    int cur_chunk;
+    int nb_frames;
+    int cur_frame;
+    int64_t frame_count;  // number of frames started, used to track the chunks usage
+    int usage;
+    int chunk_size;
+};
+
+struct staging_alloc_vk {
+    struct buffer *buffer;
+    VkDeviceSize offset;
+    void *data;
+};
+
+struct staging_vk *ngli_staging_vk_create(struct gpu_ctx *gpu_ctx);
+
+/*
+ * Initialize a ring of nb_frames slots. The chunks are created with the
+ * specified buffer usage (NGLI_BUFFER_USAGE_*) and hold at least chunk_size
+ * bytes.
+ */
+VkResult ngli_staging_vk_init(struct staging_vk *s, int nb_frames, int usage, int chunk_size);
+
+/*
+ * Select and reset the regions of the specified frame slot. The caller must
+ * guarantee that the commands previously recorded with this slot have
+ * completed.
+ */
+void ngli_staging_vk_begin_frame(struct staging_vk *s, int frame_index);
+
+/*
+ * Allocate size bytes of staging memory from the current frame slot. The
+ * returned offset is a multiple of alignment, which does not need to be a
+ * power of two. The allocation remains valid until the slot is reset.
+ */
+VkResult ngli_staging_vk_alloc(struct staging_vk *s, VkDeviceSize size, VkDeviceSize alignment,
+                               struct staging_alloc_vk *alloc);
+
+void ngli_staging_vk_freep(struct staging_vk **sp);
+
+#endif
@@ -221,9 +221,11 @@ static int get_mipmap_levels(int width, int height)
 
 static int init_fields(struct texture *s, const struct texture_params *params)
 {
+    struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
     struct texture_vk *s_priv = (struct texture_vk *)s;
 
     s->params = *params;
+    s_priv->id = ++gpu_ctx_vk->resource_id;
 
     uint32_t depth = 1;
     if (params->type == NGLI_TEXTURE_TYPE_3D) {
@@ -554,39 +556,25 @@ VkResult ngli_texture_vk_upload(struct texture *s, const uint8_t *data, int line
     if (!data)
         return VK_SUCCESS;
 
-    if (!s_priv->staging_buffer || s_priv->staging_buffer_row_length != linesize) {
-        const int32_t width = linesize ? linesize : s->params.width;
-        const int32_t staging_buffer_size = width * s->params.height * s->params.depth * s_priv->bytes_per_pixel * s_priv->array_layers;
-
-        if (s_priv->staging_buffer_ptr) {
-            ngli_buffer_vk_unmap(s_priv->staging_buffer);
-            s_priv->staging_buffer_ptr = NULL;
-        }
-        ngli_buffer_vk_freep(&s_priv->staging_buffer);
-
-        s_priv->staging_buffer = ngli_buffer_vk_create(s->gpu_ctx);
-        if (!s_priv->staging_buffer)
-            return VK_ERROR_OUT_OF_HOST_MEMORY;
-
-        const int usage = NGLI_BUFFER_USAGE_DYNAMIC_BIT |
-                          NGLI_BUFFER_USAGE_TRANSFER_SRC_BIT |
-                          NGLI_BUFFER_USAGE_MAP_WRITE;
-        VkResult res = ngli_buffer_vk_init(s_priv->staging_buffer, staging_buffer_size, usage);
-        if (res != VK_SUCCESS)
-            return res;
-
-        s_priv->staging_buffer_row_length = linesize;
+    const int32_t width = linesize ? linesize : s->params.width;
+    const VkDeviceSize staging_size = width * s->params.height * s->params.depth * s_priv->bytes_per_pixel * s_priv->array_layers;
 
-        res = ngli_buffer_vk_map(s_priv->staging_buffer, staging_buffer_size, 0, &s_priv->staging_buffer_ptr);
-        if (res != VK_SUCCESS)
-            return res;
-    }
+    /*
+     * The buffer offset of a buffer to image copy must be a multiple of both
+     * 4 and the texel size
+     */
+    const int bpp = s_priv->bytes_per_pixel;
+    const VkDeviceSize alignment = bpp % 4 == 0 ? bpp : bpp % 2 == 0 ? bpp * 2 : bpp * 4;
 
-    memcpy(s_priv->staging_buffer_ptr, data, s_priv->staging_buffer->size);
+    struct staging_alloc_vk staging;
+    VkResult res = ngli_staging_vk_alloc(gpu_ctx_vk->staging, staging_size, alignment, &staging);
+    if (res != VK_SUCCESS)
+        return res;
+    memcpy(staging.data, data, staging_size);
 
     struct cmd_vk *cmd_vk = gpu_ctx_vk->cur_cmd;
     if (!cmd_vk) {
-        VkResult res = ngli_cmd_vk_begin_transient(s->gpu_ctx, 0, &cmd_vk);
+        res = ngli_cmd_vk_begin_transient(s->gpu_ctx, 0, &cmd_vk);
         if (res != VK_SUCCESS)
             return res;
     }
@@ -610,7 +598,7 @@ VkResult ngli_texture_vk_upload(struct texture *s, const uint8_t *data, int line
 
     const VkDeviceSize layer_size = s->params.width * s->params.height * s_priv->bytes_per_pixel;
     for (int32_t i = 0; i < s_priv->array_layers; i++) {
-        const VkDeviceSize offset = i * layer_size;
+        const VkDeviceSize offset = staging.offset + i * layer_size;
         const VkBufferImageCopy region = {
             .bufferOffset      = offset,
             .bufferRowLength   = linesize,
@@ -637,9 +625,9 @@ VkResult ngli_texture_vk_upload(struct texture *s, const uint8_t *data, int line
         }
     }
 
-    struct buffer_vk *staging_buffer_vk = (struct buffer_vk *)s_priv->staging_buffer;
+    const struct buffer_vk *staging_vk = (const struct buffer_vk *)staging.buffer;
     vkCmdCopyBufferToImage(cmd_buf,
-                           staging_buffer_vk->buffer,
+                           staging_vk->buffer,
                            s_priv->image,
                            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                            ngli_darray_count(&copy_regions),
@@ -653,8 +641,10 @@ VkResult ngli_texture_vk_upload(struct texture *s, const uint8_t *data, int line
                             s_priv->image_layout,
                             &subres_range);
 
+    s->gpu_ctx->stats[NGLI_GPU_STAT_STAGING_COPIES]++;
+
     if (!gpu_ctx_vk->cur_cmd) {
-        VkResult res = ngli_cmd_vk_execute_transient(&cmd_vk);
+        res = ngli_cmd_vk_execute_transient(&cmd_vk);
         if (res != VK_SUCCESS)
             return res;
     }
@@ -854,9 +844,5 @@ void ngli_texture_vk_freep(struct texture **sp)
         vkDestroyImage(vk->device, s_priv->image, NULL);
     vkFreeMemory(vk->device, s_priv->image_memory, NULL);
 
-    if (s_priv->staging_buffer_ptr)
-        ngli_buffer_vk_unmap(s_priv->staging_buffer);
-    ngli_buffer_freep(&s_priv->staging_buffer);
-
     ngli_freep(sp);
 }
@@ -40,6 +40,7 @@ struct texture_vk_wrap_params {
 
 struct texture_vk {
     struct texture parent;
+    uint64_t id;
     VkFormat format;
     int bytes_per_pixel;
     int array_layers;
@@ -55,9 +56,6 @@ struct texture_vk {
     int wrapped_sampler;
     int use_ycbcr_sampler;
     struct ycbcr_sampler_vk *ycbcr_sampler;
-    struct buffer *staging_buffer;
-    VkDeviceSize staging_buffer_row_length;
-    void *staging_buffer_ptr;
 };
 
 struct texture *ngli_texture_vk_create(struct gpu_ctx *gpu_ctx);
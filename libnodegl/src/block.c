@@ -188,6 +188,44 @@ void ngli_block_field_copy(const struct block_field *fi, uint8_t *dst, const uin
     }
 }
 
+int ngli_block_field_update(const struct block_field *fi, uint8_t *data, const uint8_t *src,
+                            int (*add_range)(void *user_arg, int start, int end), void *user_arg)
+{
+    int dst_stride = fi->stride;
+    int src_stride = sizes_map[fi->type];
+    int count = NGLI_MAX(fi->count, 1);
+
+    if (fi->type == NGLI_TYPE_MAT3) {
+        dst_stride = fi->stride / 3;
+        src_stride = sizes_map[NGLI_TYPE_VEC3];
+        count *= 3;
+    }
+
+    uint8_t *dst = data + fi->offset;
+    int run_start = -1;
+    for (int i = 0; i < count; i++) {
+        uint8_t *dstp = dst + i * dst_stride;
+        const uint8_t *srcp = src + i * src_stride;
+        if (!memcmp(dstp, srcp, src_stride)) {
+            if (run_start >= 0) {
+                const int run_end = fi->offset + (i - 1) * dst_stride + src_stride;
+                int ret = add_range(user_arg, run_start, run_end);
+                if (ret < 0)
+                    return ret;
+                run_start = -1;
+            }
+            continue;
+        }
+        memcpy(dstp, srcp, src_stride);
+        if (run_start < 0)
+            run_start = fi->offset + i * dst_stride;
+    }
+
+    if (run_start >= 0)
+        return add_range(user_arg, run_start, fi->offset + (count - 1) * dst_stride + src_stride);
+    return 0;
+}
+
 void ngli_block_reset(struct block *s)
 {
     ngli_darray_reset(&s->fields);
@@ -46,6 +46,15 @@ struct block_field {
 
 void ngli_block_field_copy(const struct block_field *fi, uint8_t *dst, const uint8_t *src);
 
+/*
+ * Same as ngli_block_field_copy() but only write the elements which differ
+ * from the current content of the block data. The byte range [start, end)
+ * (relative to data) of every run of consecutive changed elements is passed
+ * to add_range(), whose errors are forwarded.
+ */
+int ngli_block_field_update(const struct block_field *fi, uint8_t *data, const uint8_t *src,
+                            int (*add_range)(void *user_arg, int start, int end), void *user_arg);
+
 struct block {
     enum block_layout layout;
     struct darray fields; // block_field
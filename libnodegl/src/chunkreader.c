@@ -0,0 +1,269 @@
+/*
+ * Copyright 2023 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "config.h"
+
+#ifndef TARGET_MINGW_W64
+#define _POSIX_C_SOURCE 200809L // pread()
+#endif
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <string.h>
+
+#include "chunkreader.h"
+#include "log.h"
+#include "memory.h"
+#include "nodegl.h"
+#include "utils.h"
+
+static int open_file(struct chunkreader *s, const char *filename)
+{
+#ifdef _WIN32
+    HANDLE handle = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL,
+                                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle == INVALID_HANDLE_VALUE) {
+        LOG(ERROR, "could not open '%s'", filename);
+        return NGL_ERROR_IO;
+    }
+    s->file_handle = handle;
+#else
+    s->fd = open(filename, O_RDONLY);
+    if (s->fd == -1) {
+        LOG(ERROR, "could not open '%s': %s", filename, strerror(errno));
+        return NGL_ERROR_IO;
+    }
+#endif
+    return 0;
+}
+
+static void close_file(struct chunkreader *s)
+{
+#ifdef _WIN32
+    if (s->file_handle)
+        CloseHandle(s->file_handle);
+    s->file_handle = NULL;
+#else
+    if (s->fd != -1)
+        close(s->fd);
+    s->fd = -1;
+#endif
+}
+
+/* Read a chunk into the specified slot, may be called from any thread */
+static int read_chunk(const struct chunkreader *s, int index, int slot)
+{
+    uint8_t *dst = s->slots + slot * s->chunk_size;
+    const uint64_t offset = (uint64_t)index * s->chunk_size;
+
+    size_t pos = 0;
+    while (pos < s->chunk_size) {
+#ifdef _WIN32
+        const uint64_t read_offset = offset + pos;
+        OVERLAPPED overlapped = {
+            .Offset     = (DWORD)read_offset,
+            .OffsetHigh = (DWORD)(read_offset >> 32),
+        };
+        const DWORD size = (DWORD)NGLI_MIN(s->chunk_size - pos, 1 << 30);
+        DWORD n;
+        if (!ReadFile(s->file_handle, dst + pos, size, &n, &overlapped) || !n) {
+            LOG(ERROR, "could not read chunk %d", index);
+            return NGL_ERROR_IO;
+        }
+#else
+        const ssize_t n = pread(s->fd, dst + pos, s->chunk_size - pos, offset + pos);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0) {
+            LOG(ERROR, "could not read chunk %d: %s", index, n < 0 ? strerror(errno) : "end of file");
+            return NGL_ERROR_IO;
+        }
+#endif
+        pos += n;
+    }
+    return 0;
+}
+
+/* Return the next chunk to read ahead of the current one, or -1 if none */
+static int get_next_chunk(const struct chunkreader *s)
+{
+    const int end = NGLI_MIN(s->cur_chunk + s->window, s->nb_chunks);
+    for (int i = s->cur_chunk + 1; i < end; i++) {
+        if (s->slot_chunks[i % s->window] != i)
+            return i;
+    }
+    return -1;
+}
+
+static void *io_thread(void *arg)
+{
+    struct chunkreader *s = arg;
+
+    ngli_thread_set_name("ngl-chunkio");
+
+    pthread_mutex_lock(&s->lock);
+    for (;;) {
+        int index = -1;
+        while (!s->stop && (s->io_error || (index = get_next_chunk(s)) < 0))
+            pthread_cond_wait(&s->cond_io, &s->lock);
+        if (s->stop)
+            break;
+
+        const int slot = index % s->window;
+        s->slot_chunks[slot] = -1;
+        s->loading_slot = slot;
+        pthread_mutex_unlock(&s->lock);
+
+        const int ret = read_chunk(s, index, slot);
+
+        pthread_mutex_lock(&s->lock);
+        if (ret < 0)
+            s->io_error = ret;
+        else
+            s->slot_chunks[slot] = index;
+        s->loading_slot = -1;
+        pthread_cond_signal(&s->cond_ctl);
+    }
+    pthread_mutex_unlock(&s->lock);
+
+    return NULL;
+}
+
+int ngli_chunkreader_init(struct chunkreader *s, const char *filename,
+                          size_t chunk_size, int nb_chunks, int window)
+{
+    memset(s, 0, sizeof(*s));
+#ifndef _WIN32
+    s->fd = -1;
+#endif
+
+    ngli_assert(chunk_size > 0 && nb_chunks > 0 && window > 0);
+
+    int ret = open_file(s, filename);
+    if (ret < 0)
+        return ret;
+
+    if (pthread_mutex_init(&s->lock, NULL) ||
+        pthread_cond_init(&s->cond_io, NULL) ||
+        pthread_cond_init(&s->cond_ctl, NULL)) {
+        pthread_cond_destroy(&s->cond_ctl);
+        pthread_cond_destroy(&s->cond_io);
+        pthread_mutex_destroy(&s->lock);
+        close_file(s);
+        return NGL_ERROR_EXTERNAL;
+    }
+
+    s->chunk_size = chunk_size;
+    s->nb_chunks = nb_chunks;
+    s->window = NGLI_MIN(window, nb_chunks);
+    s->cur_chunk = -1;
+    s->loading_slot = -1;
+
+    s->slot_chunks = ngli_calloc(s->window, sizeof(*s->slot_chunks));
+    s->slots = ngli_calloc(s->window, s->chunk_size);
+    if (!s->slot_chunks || !s->slots) {
+        ret = NGL_ERROR_MEMORY;
+        goto fail;
+    }
+    for (int i = 0; i < s->window; i++)
+        s->slot_chunks[i] = -1;
+
+    /* A window of a single chunk has nothing to read ahead */
+    if (s->window > 1) {
+        if (pthread_create(&s->thread, NULL, io_thread, s)) {
+            ret = NGL_ERROR_EXTERNAL;
+            goto fail;
+        }
+        s->has_thread = 1;
+    }
+
+    return 0;
+
+fail:
+    ngli_chunkreader_reset(s);
+    return ret;
+}
+
+int ngli_chunkreader_get(struct chunkreader *s, int index, const uint8_t **datap)
+{
+    ngli_assert(index >= 0 && index < s->nb_chunks);
+
+    const int slot = index % s->window;
+
+    pthread_mutex_lock(&s->lock);
+    s->cur_chunk = index;
+    while (s->loading_slot == slot)
+        pthread_cond_wait(&s->cond_ctl, &s->lock);
+    const int hit = s->slot_chunks[slot] == index;
+    if (hit) {
+        s->nb_hits++;
+    } else {
+        s->nb_misses++;
+        s->slot_chunks[slot] = -1;
+    }
+    pthread_cond_signal(&s->cond_io);
+    pthread_mutex_unlock(&s->lock);
+
+    /*
+     * The slot of the current chunk is excluded from the read-ahead range so
+     * it can be filled without holding the lock.
+     */
+    if (!hit) {
+        int ret = read_chunk(s, index, slot);
+        if (ret < 0)
+            return ret;
+        pthread_mutex_lock(&s->lock);
+        s->slot_chunks[slot] = index;
+        pthread_mutex_unlock(&s->lock);
+    }
+
+    *datap = s->slots + slot * s->chunk_size;
+    return 0;
+}
+
+void ngli_chunkreader_reset(struct chunkreader *s)
+{
+    if (!s->window)
+        return;
+
+    if (s->has_thread) {
+        pthread_mutex_lock(&s->lock);
+        s->stop = 1;
+        pthread_cond_signal(&s->cond_io);
+        pthread_mutex_unlock(&s->lock);
+        pthread_join(s->thread, NULL);
+    }
+
+    pthread_cond_destroy(&s->cond_ctl);
+    pthread_cond_destroy(&s->cond_io);
+    pthread_mutex_destroy(&s->lock);
+
+    close_file(s);
+    ngli_freep(&s->slots);
+    ngli_freep(&s->slot_chunks);
+    memset(s, 0, sizeof(*s));
+}
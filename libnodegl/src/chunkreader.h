@@ -0,0 +1,77 @@
+/*
+ * Copyright 2023 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CHUNKREADER_H
+#define CHUNKREADER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pthread_compat.h"
+
+/*
+ * Windowed reader of a file made of fixed size chunks.
+ *
+ * Only a window of chunks is kept in memory: chunk i is held by slot
+ * i % window, and the chunks following the one last requested are read
+ * ahead of time by a background I/O thread. Requesting a chunk which is not
+ * (yet) available in its slot reads it synchronously from the caller thread.
+ * Since the slot of the current chunk is never part of the read-ahead range,
+ * the data returned to the caller is left untouched until the next request.
+ */
+struct chunkreader {
+#ifdef _WIN32
+    void *file_handle;
+#else
+    int fd;
+#endif
+    size_t chunk_size;
+    int nb_chunks;
+    int window;
+    uint8_t *slots;         // window * chunk_size bytes
+    int *slot_chunks;       // index of the chunk held by each slot, -1 if none
+
+    pthread_t thread;
+    int has_thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond_io;
+    pthread_cond_t cond_ctl;
+    int stop;
+    int cur_chunk;          // last chunk requested by the caller
+    int loading_slot;       // slot being filled by the I/O thread, -1 if none
+    int io_error;
+
+    int nb_hits;            // chunks found in the window
+    int nb_misses;          // chunks read synchronously
+};
+
+int ngli_chunkreader_init(struct chunkreader *s, const char *filename,
+                          size_t chunk_size, int nb_chunks, int window);
+
+/*
+ * Get the data of the chunk at the specified index. The returned pointer
+ * remains valid until the next call to this function.
+ */
+int ngli_chunkreader_get(struct chunkreader *s, int index, const uint8_t **datap);
+
+void ngli_chunkreader_reset(struct chunkreader *s);
+
+#endif
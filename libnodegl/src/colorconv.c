@@ -187,6 +187,18 @@ void ngli_colorconv_linear2srgb(float *dst, const float *rgb)
     memcpy(dst, srgb, sizeof(srgb));
 }
 
+void ngli_colorconv_srgb2linear_f32_c(float *dst, const float *src, int n)
+{
+    for (int i = 0; i < n; i++)
+        dst[i] = srgb2linear(src[i]);
+}
+
+void ngli_colorconv_linear2srgb_f32_c(float *dst, const float *src, int n)
+{
+    for (int i = 0; i < n; i++)
+        dst[i] = linear2srgb(src[i]);
+}
+
 static inline float sat(float x)
 {
     return NGLI_CLAMP(x, 0.f, 1.f);
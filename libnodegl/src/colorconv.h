@@ -43,4 +43,7 @@ void ngli_colorconv_hsv2srgb(float *dst, const float *hsv);
 
 void ngli_colorconv_linear2srgb(float *dst, const float *rgb);
 
+void ngli_colorconv_srgb2linear_f32_c(float *dst, const float *src, int n);
+void ngli_colorconv_linear2srgb_f32_c(float *dst, const float *src, int n);
+
 #endif
@@ -20,6 +20,7 @@
  */
 
 #include <inttypes.h>
+#include <limits.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -29,6 +30,10 @@
 #include "nodegl.h"
 #include "internal.h"
 #include "params.h"
+#include "serialize.h"
+#include "utils.h"
+
+extern const struct param_specs ngli_params_specs[];
 
 static int parse_int(const char *s, int *valp)
 {
@@ -586,3 +591,337 @@ end:
     ngli_free(sstart);
     return node;
 }
+
+struct binary_reader {
+    const uint8_t *params;
+    const uint8_t *data;
+    struct ngli_binary_header header;
+    struct darray nodes_array;
+};
+
+static struct ngl_node *get_binary_node(const struct binary_reader *s, uint32_t id)
+{
+    if (id >= (uint32_t)ngli_darray_count(&s->nodes_array))
+        return NULL;
+    struct ngl_node **nodes = ngli_darray_data(&s->nodes_array);
+    return nodes[id];
+}
+
+static char *dup_binary_str(const uint8_t *payload, uint32_t size)
+{
+    char *str = ngli_malloc(size + 1);
+    if (!str)
+        return NULL;
+    memcpy(str, payload, size);
+    str[size] = 0;
+    return str;
+}
+
+static int set_binary_str_param(uint8_t *dstp, const struct node_param *par,
+                                const uint8_t *payload, uint32_t size)
+{
+    char *str = dup_binary_str(payload, size);
+    if (!str)
+        return NGL_ERROR_MEMORY;
+
+    int ret;
+    switch (par->type) {
+    case NGLI_PARAM_TYPE_SELECT: ret = ngli_params_set_select(dstp, par, str); break;
+    case NGLI_PARAM_TYPE_FLAGS:  ret = ngli_params_set_flags(dstp, par, str);  break;
+    default:                     ret = ngli_params_set_str(dstp, par, str);    break;
+    }
+    ngli_free(str);
+    return ret;
+}
+
+static int set_binary_data_param(const struct binary_reader *s, uint8_t *dstp,
+                                 const struct node_param *par,
+                                 const uint8_t *payload, uint32_t size)
+{
+    struct ngli_binary_data ref;
+    if (size != sizeof(ref))
+        return NGL_ERROR_INVALID_DATA;
+    memcpy(&ref, payload, sizeof(ref));
+    if (ref.offset > s->header.data_size ||
+        ref.size > s->header.data_size - ref.offset ||
+        ref.size > INT_MAX)
+        return NGL_ERROR_INVALID_DATA;
+    return ngli_params_set_data(dstp, par, (int)ref.size, s->data + ref.offset);
+}
+
+static int set_binary_nodelist_param(const struct binary_reader *s, uint8_t *dstp,
+                                     const struct node_param *par,
+                                     const uint8_t *payload, uint32_t size)
+{
+    if (size % sizeof(uint32_t))
+        return NGL_ERROR_INVALID_DATA;
+    for (uint32_t i = 0; i < size / sizeof(uint32_t); i++) {
+        uint32_t node_id;
+        memcpy(&node_id, payload + i * sizeof(node_id), sizeof(node_id));
+        struct ngl_node *node = get_binary_node(s, node_id);
+        if (!node)
+            return NGL_ERROR_INVALID_DATA;
+        int ret = ngli_params_add_nodes(dstp, par, 1, &node);
+        if (ret < 0)
+            return ret;
+    }
+    return 0;
+}
+
+static int set_binary_f64list_param(uint8_t *dstp, const struct node_param *par,
+                                    const uint8_t *payload, uint32_t size)
+{
+    if (size % sizeof(double))
+        return NGL_ERROR_INVALID_DATA;
+    const int nb_dbls = size / sizeof(double);
+    double *dbls = ngli_memdup(payload, size);
+    if (nb_dbls && !dbls)
+        return NGL_ERROR_MEMORY;
+    int ret = ngli_params_add_f64s(dstp, par, nb_dbls, dbls);
+    ngli_free(dbls);
+    return ret;
+}
+
+static int set_binary_nodedict_param(const struct binary_reader *s, uint8_t *dstp,
+                                     const struct node_param *par,
+                                     const uint8_t *payload, uint32_t size)
+{
+    const uint8_t *cur = payload;
+    const uint8_t *end = payload + size;
+    while (cur < end) {
+        uint32_t node_id, key_size;
+        if (end - cur < 2 * sizeof(uint32_t))
+            return NGL_ERROR_INVALID_DATA;
+        memcpy(&node_id, cur, sizeof(node_id));
+        memcpy(&key_size, cur + sizeof(node_id), sizeof(key_size));
+        cur += 2 * sizeof(uint32_t);
+        if ((size_t)(end - cur) < key_size)
+            return NGL_ERROR_INVALID_DATA;
+
+        struct ngl_node *node = get_binary_node(s, node_id);
+        if (!node)
+            return NGL_ERROR_INVALID_DATA;
+        char *key = dup_binary_str(cur, key_size);
+        if (!key)
+            return NGL_ERROR_MEMORY;
+        int ret = ngli_params_set_dict(dstp, par, key, node);
+        ngli_free(key);
+        if (ret < 0)
+            return ret;
+
+        cur += NGLI_ALIGN(key_size, sizeof(uint32_t));
+    }
+    return 0;
+}
+
+static int set_binary_value_param(uint8_t *dstp, const struct node_param *par,
+                                  const uint8_t *payload, uint32_t size)
+{
+    union {
+        int i32;
+        unsigned u32;
+        float f32;
+        double f64;
+        int ivec[4];
+        unsigned uvec[4];
+        float vec[16];
+    } v;
+
+    if (size != ngli_params_specs[par->type].size || size > sizeof(v))
+        return NGL_ERROR_INVALID_DATA;
+    memcpy(&v, payload, size);
+
+    switch (par->type) {
+    case NGLI_PARAM_TYPE_I32:      return ngli_params_set_i32(dstp, par, v.i32);
+    case NGLI_PARAM_TYPE_U32:      return ngli_params_set_u32(dstp, par, v.u32);
+    case NGLI_PARAM_TYPE_BOOL:     return ngli_params_set_bool(dstp, par, v.i32);
+    case NGLI_PARAM_TYPE_F32:      return ngli_params_set_f32(dstp, par, v.f32);
+    case NGLI_PARAM_TYPE_F64:      return ngli_params_set_f64(dstp, par, v.f64);
+    case NGLI_PARAM_TYPE_RATIONAL: return ngli_params_set_rational(dstp, par, v.ivec[0], v.ivec[1]);
+    case NGLI_PARAM_TYPE_IVEC2:    return ngli_params_set_ivec2(dstp, par, v.ivec);
+    case NGLI_PARAM_TYPE_IVEC3:    return ngli_params_set_ivec3(dstp, par, v.ivec);
+    case NGLI_PARAM_TYPE_IVEC4:    return ngli_params_set_ivec4(dstp, par, v.ivec);
+    case NGLI_PARAM_TYPE_UVEC2:    return ngli_params_set_uvec2(dstp, par, v.uvec);
+    case NGLI_PARAM_TYPE_UVEC3:    return ngli_params_set_uvec3(dstp, par, v.uvec);
+    case NGLI_PARAM_TYPE_UVEC4:    return ngli_params_set_uvec4(dstp, par, v.uvec);
+    case NGLI_PARAM_TYPE_VEC2:     return ngli_params_set_vec2(dstp, par, v.vec);
+    case NGLI_PARAM_TYPE_VEC3:     return ngli_params_set_vec3(dstp, par, v.vec);
+    case NGLI_PARAM_TYPE_VEC4:     return ngli_params_set_vec4(dstp, par, v.vec);
+    case NGLI_PARAM_TYPE_MAT4:     return ngli_params_set_mat4(dstp, par, v.vec);
+    }
+    return NGL_ERROR_BUG;
+}
+
+static int set_binary_param(const struct binary_reader *s, uint8_t *base_ptr,
+                            const struct node_param *par, uint32_t flags,
+                            const uint8_t *payload, uint32_t size)
+{
+    uint8_t *dstp = base_ptr + par->offset;
+
+    if ((flags & NGLI_BINARY_PARAM_FLAG_NODE_REF) || par->type == NGLI_PARAM_TYPE_NODE) {
+        uint32_t node_id;
+        if (size != sizeof(node_id))
+            return NGL_ERROR_INVALID_DATA;
+        memcpy(&node_id, payload, sizeof(node_id));
+        struct ngl_node *node = get_binary_node(s, node_id);
+        if (!node)
+            return NGL_ERROR_INVALID_DATA;
+        return ngli_params_set_node(dstp, par, node);
+    }
+
+    switch (par->type) {
+    case NGLI_PARAM_TYPE_SELECT:
+    case NGLI_PARAM_TYPE_FLAGS:
+    case NGLI_PARAM_TYPE_STR:      return set_binary_str_param(dstp, par, payload, size);
+    case NGLI_PARAM_TYPE_DATA:     return set_binary_data_param(s, dstp, par, payload, size);
+    case NGLI_PARAM_TYPE_NODELIST: return set_binary_nodelist_param(s, dstp, par, payload, size);
+    case NGLI_PARAM_TYPE_F64LIST:  return set_binary_f64list_param(dstp, par, payload, size);
+    case NGLI_PARAM_TYPE_NODEDICT: return set_binary_nodedict_param(s, dstp, par, payload, size);
+    case NGLI_PARAM_TYPE_I32:
+    case NGLI_PARAM_TYPE_U32:
+    case NGLI_PARAM_TYPE_BOOL:
+    case NGLI_PARAM_TYPE_F32:
+    case NGLI_PARAM_TYPE_F64:
+    case NGLI_PARAM_TYPE_RATIONAL:
+    case NGLI_PARAM_TYPE_IVEC2:
+    case NGLI_PARAM_TYPE_IVEC3:
+    case NGLI_PARAM_TYPE_IVEC4:
+    case NGLI_PARAM_TYPE_UVEC2:
+    case NGLI_PARAM_TYPE_UVEC3:
+    case NGLI_PARAM_TYPE_UVEC4:
+    case NGLI_PARAM_TYPE_VEC2:
+    case NGLI_PARAM_TYPE_VEC3:
+    case NGLI_PARAM_TYPE_VEC4:
+    case NGLI_PARAM_TYPE_MAT4:     return set_binary_value_param(dstp, par, payload, size);
+    default:
+        LOG(ERROR, "cannot deserialize %s: unsupported parameter type", par->key);
+    }
+    return NGL_ERROR_INVALID_DATA;
+}
+
+static int set_binary_node_params(const struct binary_reader *s,
+                                  const struct ngli_binary_node *entry,
+                                  struct ngl_node *node)
+{
+    const uint64_t params_size = s->header.params_size;
+    uint64_t pos = entry->params_offset;
+
+    for (uint32_t i = 0; i < entry->nb_params; i++) {
+        struct ngli_binary_param rec;
+        if (pos > params_size || params_size - pos < sizeof(rec))
+            return NGL_ERROR_INVALID_DATA;
+        memcpy(&rec, s->params + pos, sizeof(rec));
+        pos += sizeof(rec);
+
+        const uint64_t key_size = NGLI_ALIGN((uint64_t)rec.key_size, NGLI_BINARY_RECORD_ALIGN);
+        const uint64_t payload_size = NGLI_ALIGN((uint64_t)rec.size, NGLI_BINARY_RECORD_ALIGN);
+        if (params_size - pos < key_size || params_size - pos - key_size < payload_size)
+            return NGL_ERROR_INVALID_DATA;
+
+        char *key = dup_binary_str(s->params + pos, rec.key_size);
+        if (!key)
+            return NGL_ERROR_MEMORY;
+        pos += key_size;
+
+        uint8_t *base_ptr;
+        const struct node_param *par = ngli_node_param_find(node, key, &base_ptr);
+        if (!par || par->type != rec.type) {
+            LOG(ERROR, "unable to find parameter %s.%s", node->cls->name, key);
+            ngli_free(key);
+            return NGL_ERROR_INVALID_DATA;
+        }
+        ngli_free(key);
+
+        int ret = set_binary_param(s, base_ptr, par, rec.flags, s->params + pos, rec.size);
+        if (ret < 0) {
+            LOG(ERROR, "unable to set node param %s.%s: %s",
+                node->cls->name, par->key, NGLI_RET_STR(ret));
+            return ret;
+        }
+        pos += payload_size;
+    }
+
+    return 0;
+}
+
+static int check_binary_section(size_t size, uint64_t offset, uint64_t section_size)
+{
+    return offset <= size && section_size <= size - offset;
+}
+
+struct ngl_node *ngl_node_deserialize_binary(const void *data, size_t size)
+{
+    struct ngl_node *node = NULL;
+    struct binary_reader s = {0};
+
+    ngli_darray_init(&s.nodes_array, sizeof(struct ngl_node *), 0);
+
+    if (size < sizeof(s.header)) {
+        LOG(ERROR, "invalid serialized scene");
+        goto end;
+    }
+    memcpy(&s.header, data, sizeof(s.header));
+
+    const struct ngli_binary_header *header = &s.header;
+    if (memcmp(header->magic, NGLI_BINARY_MAGIC, sizeof(header->magic))) {
+        LOG(ERROR, "invalid serialized scene");
+        goto end;
+    }
+    if (header->byte_order != NGLI_BINARY_BYTE_ORDER) {
+        LOG(ERROR, "serialized scene byte order does not match the host");
+        goto end;
+    }
+    if (header->version != NGLI_BINARY_VERSION) {
+        LOG(ERROR, "unsupported binary format version %u", header->version);
+        goto end;
+    }
+    if (header->ngl_version != NGL_VERSION_INT) {
+        LOG(ERROR, "mismatching version: %d.%d.%d != %d.%d.%d",
+            header->ngl_version >> 16, header->ngl_version >> 8 & 0xff, header->ngl_version & 0xff,
+            NGL_VERSION_MAJOR, NGL_VERSION_MINOR, NGL_VERSION_MICRO);
+        goto end;
+    }
+    if (!header->nb_nodes ||
+        header->nb_nodes > SIZE_MAX / sizeof(struct ngli_binary_node) ||
+        !check_binary_section(size, header->nodes_offset, header->nb_nodes * sizeof(struct ngli_binary_node)) ||
+        !check_binary_section(size, header->params_offset, header->params_size) ||
+        !check_binary_section(size, header->data_offset, header->data_size)) {
+        LOG(ERROR, "invalid serialized scene sections");
+        goto end;
+    }
+
+    s.params = (const uint8_t *)data + header->params_offset;
+    s.data   = (const uint8_t *)data + header->data_offset;
+
+    const uint8_t *entries = (const uint8_t *)data + header->nodes_offset;
+    for (uint32_t i = 0; i < header->nb_nodes; i++) {
+        struct ngli_binary_node entry;
+        memcpy(&entry, entries + i * sizeof(entry), sizeof(entry));
+
+        node = ngl_node_create(entry.type);
+        if (!node)
+            break;
+
+        if (!ngli_darray_push(&s.nodes_array, &node)) {
+            ngl_node_unrefp(&node);
+            break;
+        }
+
+        int ret = set_binary_node_params(&s, &entry, node);
+        if (ret < 0) {
+            node = NULL;
+            break;
+        }
+    }
+
+    if (node)
+        ngl_node_ref(node);
+
+    struct ngl_node **nodes = ngli_darray_data(&s.nodes_array);
+    for (int i = 0; i < ngli_darray_count(&s.nodes_array); i++)
+        ngl_node_unrefp(&nodes[i]);
+
+end:
+    ngli_darray_reset(&s.nodes_array);
+    return node;
+}
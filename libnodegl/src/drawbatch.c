@@ -0,0 +1,138 @@
+/*
+ * Copyright 2023 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "drawbatch.h"
+#include "gpu_ctx.h"
+#include "internal.h"
+#include "log.h"
+#include "pipeline_compat.h"
+
+struct draw_packet {
+    struct ngl_node *node;
+    struct rnode *rnode;
+    float modelview_matrix[16];
+    float projection_matrix[16];
+    int scissor[4];
+    uint64_t program_id;
+    uint64_t texture_id;
+    int order;
+};
+
+void ngli_drawbatch_init(struct drawbatch *s)
+{
+    ngli_darray_init(&s->packets, sizeof(struct draw_packet), 0);
+    s->recording = 0;
+}
+
+int ngli_drawbatch_record(struct drawbatch *s, struct ngl_node *node, const struct pipeline_compat *pipeline_compat)
+{
+    if (!s->recording)
+        return 0;
+
+    /*
+     * The creation order identifiers are used as sort keys rather than the
+     * addresses so that the draw order is the same from one run to another
+     */
+    struct ngl_ctx *ctx = node->ctx;
+    const struct program *program = ngli_pipeline_compat_get_program(pipeline_compat);
+    const struct texture *texture = ngli_pipeline_compat_get_texture(pipeline_compat);
+    struct draw_packet packet = {
+        .node       = node,
+        .rnode      = ctx->rnode_pos,
+        .program_id = program ? program->id : 0,
+        .texture_id = texture ? texture->id : 0,
+        .order      = ngli_darray_count(&s->packets),
+    };
+    memcpy(packet.modelview_matrix, ngli_darray_tail(&ctx->modelview_matrix_stack), sizeof(packet.modelview_matrix));
+    memcpy(packet.projection_matrix, ngli_darray_tail(&ctx->projection_matrix_stack), sizeof(packet.projection_matrix));
+    ngli_gpu_ctx_get_scissor(ctx->gpu_ctx, packet.scissor);
+
+    if (!ngli_darray_push(&s->packets, &packet)) {
+        LOG(ERROR, "could not record draw packet, drawing immediately");
+        return 0;
+    }
+
+    return 1;
+}
+
+static int compare_packets(const void *a, const void *b)
+{
+    const struct draw_packet *p0 = a;
+    const struct draw_packet *p1 = b;
+
+    if (p0->program_id != p1->program_id)
+        return p0->program_id < p1->program_id ? -1 : 1;
+    if (p0->texture_id != p1->texture_id)
+        return p0->texture_id < p1->texture_id ? -1 : 1;
+    /* Keep the declaration order of packets sharing the same states */
+    return p0->order - p1->order;
+}
+
+void ngli_drawbatch_flush(struct drawbatch *s, int start)
+{
+    const int nb_packets = ngli_darray_count(&s->packets) - start;
+    if (nb_packets <= 0)
+        return;
+
+    struct draw_packet *packets = ngli_darray_get(&s->packets, start);
+    qsort(packets, nb_packets, sizeof(*packets), compare_packets);
+
+    struct ngl_ctx *ctx = packets[0].node->ctx;
+    struct gpu_ctx *gpu_ctx = ctx->gpu_ctx;
+    struct rnode *rnode_pos = ctx->rnode_pos;
+
+    int prev_scissor[4];
+    ngli_gpu_ctx_get_scissor(gpu_ctx, prev_scissor);
+
+    const int recording = s->recording;
+    s->recording = 0;
+
+    for (int i = 0; i < nb_packets; i++) {
+        /* Packets may be reallocated by a nested flush, never keep a pointer */
+        struct draw_packet *packet = ngli_darray_get(&s->packets, start + i);
+        ctx->rnode_pos = packet->rnode;
+        ngli_gpu_ctx_set_scissor(gpu_ctx, packet->scissor);
+        if (!ngli_darray_push(&ctx->modelview_matrix_stack, packet->modelview_matrix) ||
+            !ngli_darray_push(&ctx->projection_matrix_stack, packet->projection_matrix)) {
+            LOG(ERROR, "could not push matrices, skipping draw");
+            continue;
+        }
+        /* The draw count has already been incremented when it was recorded */
+        ngli_node_draw_profiled(packet->node);
+        ngli_darray_pop(&ctx->modelview_matrix_stack);
+        ngli_darray_pop(&ctx->projection_matrix_stack);
+    }
+
+    s->recording = recording;
+    ctx->rnode_pos = rnode_pos;
+    ngli_gpu_ctx_set_scissor(gpu_ctx, prev_scissor);
+    ngli_darray_remove_range(&s->packets, start, nb_packets);
+}
+
+void ngli_drawbatch_reset(struct drawbatch *s)
+{
+    ngli_darray_reset(&s->packets);
+    s->recording = 0;
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2023 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#ifndef DRAWBATCH_H
+#define DRAWBATCH_H
+
+#include "darray.h"
+
+struct ngl_node;
+struct pipeline_compat;
+
+/*
+ * Deferred submission of the draw calls of an order-independent subtree.
+ *
+ * While recording, render nodes do not draw but push a packet holding
+ * everything their draw depends on in the context (render path, matrices and
+ * scissor) along with a sort key made of the program and first texture
+ * bound to their pipeline. Flushing sorts the recorded packets by key and
+ * draws them again in that order so that consecutive draw calls share as
+ * much GPU state as possible.
+ */
+struct drawbatch {
+    struct darray packets; // array of struct draw_packet
+    int recording;
+};
+
+void ngli_drawbatch_init(struct drawbatch *s);
+
+/*
+ * Record the draw of a render node if the batch is recording. Returns 1 if
+ * the draw has been deferred, 0 if it must be executed immediately.
+ */
+int ngli_drawbatch_record(struct drawbatch *s, struct ngl_node *node, const struct pipeline_compat *pipeline_compat);
+
+/*
+ * Sort and draw the packets recorded since index start, then remove them
+ * from the batch.
+ */
+void ngli_drawbatch_flush(struct drawbatch *s, int start);
+
+void ngli_drawbatch_reset(struct drawbatch *s);
+
+#endif
@@ -217,13 +217,104 @@ struct token {
     int nb_args;
 };
 
+/*
+ * Known functions and operators are executed inline by the interpreter instead
+ * of being called through a function pointer
+ */
+enum opcode {
+    OP_CALL1,
+    OP_CALL2,
+    OP_CALL3,
+    OP_NEG,
+    OP_ADD,
+    OP_SUB,
+    OP_MUL,
+    OP_DIV,
+    OP_ABS,
+    OP_SQR,
+    OP_CUBE,
+    OP_FRACT,
+    OP_MIN,
+    OP_MAX,
+    OP_SAT,
+    OP_CLAMP,
+    OP_MIX,
+    OP_MLA,
+};
+
+static const struct {
+    void *func;
+    enum opcode op;
+} inline_ops[] = {
+    {f_negate, OP_NEG},
+    {f_add,    OP_ADD},
+    {f_sub,    OP_SUB},
+    {f_mul,    OP_MUL},
+    {f_div,    OP_DIV},
+    {fabsf,    OP_ABS},
+    {f_sqr,    OP_SQR},
+    {f_cube,   OP_CUBE},
+    {f_fract,  OP_FRACT},
+    {f_min,    OP_MIN},
+    {f_max,    OP_MAX},
+    {f_sat,    OP_SAT},
+    {f_clamp,  OP_CLAMP},
+    {f_mix,    OP_MIX},
+    {f_mla,    OP_MLA},
+};
+
+/*
+ * A single instruction of the compiled program: dst and src are indexes in
+ * the register file, which is laid out as follow:
+ *   [ variables | constants | temporaries ]
+ */
+struct insn {
+    enum opcode op;
+    int dst;
+    int src[3];
+    union {
+        void *f;
+        float (*f1)(float a);
+        float (*f2)(float a, float b);
+        float (*f3)(float a, float b, float c);
+    } func; // OP_CALL*
+};
+
+/* Operand of the compilation stack */
+struct operand {
+    int is_const;
+    float value;        // constant operand
+    int reg;            // register operand (encoded, see REG())
+};
+
+/*
+ * During compilation the register indexes are tagged with their kind since
+ * the final position of each bank is only known once all the expressions are
+ * compiled
+ */
+#define REG_VAR   0
+#define REG_CONST 1
+#define REG_TMP   2
+#define REG(kind, index) ((kind) << 24 | (index))
+#define REG_KIND(reg)    ((reg) >> 24)
+#define REG_INDEX(reg)   ((reg) & 0xffffff)
+
 struct eval {
     struct darray tokens;       // user input, infix notation
     struct darray tmp_stack;    // temporary token stack
     struct darray output;       // tokens in in RPN
+    struct darray operands;     // compilation stack of struct operand
     struct hmap *funcs;         // hash map of functions_map
     struct hmap *consts;        // hash map of constants_map
     const struct hmap *vars;    // hash map of user variables
+
+    /* Compiled program */
+    struct darray insns;        // struct insn
+    struct darray var_ptrs;     // pointers to the user variables data, loaded at every run
+    struct darray const_values; // constant pool
+    struct darray results;      // register index of each expression result
+    int nb_tmps;
+    float *regs;
 };
 
 struct eval *ngli_eval_create(void)
@@ -234,6 +325,11 @@ struct eval *ngli_eval_create(void)
     ngli_darray_init(&s->tokens, sizeof(struct token), 0);
     ngli_darray_init(&s->tmp_stack, sizeof(struct token), 0);
     ngli_darray_init(&s->output, sizeof(struct token), 0);
+    ngli_darray_init(&s->operands, sizeof(struct operand), 0);
+    ngli_darray_init(&s->insns, sizeof(struct insn), 0);
+    ngli_darray_init(&s->var_ptrs, sizeof(const float *), 0);
+    ngli_darray_init(&s->const_values, sizeof(float), 0);
+    ngli_darray_init(&s->results, sizeof(int), 0);
     return s;
 }
 
@@ -407,10 +503,9 @@ static int parse_post_subexpr(struct eval *s, const char *expr, const char *p)
     return NGL_ERROR_INVALID_DATA;
 }
 
-/* Tokenization pass: build a list of tokens */
-static int tokenize(struct eval *s, const char *expr)
+/* Build temporary hash maps for fast function and constant lookups */
+static int create_lookup_maps(struct eval *s)
 {
-    /* Build temporary hash map for fast function lookups */
     s->funcs = ngli_hmap_create();
     if (!s->funcs)
         return NGL_ERROR_MEMORY;
@@ -420,7 +515,6 @@ static int tokenize(struct eval *s, const char *expr)
             return ret;
     }
 
-    /* Build temporary hash map for fast constant lookups */
     s->consts = ngli_hmap_create();
     if (!s->consts)
         return NGL_ERROR_MEMORY;
@@ -430,19 +524,16 @@ static int tokenize(struct eval *s, const char *expr)
             return ret;
     }
 
-    /* Parse the full expression */
-    int ret = parse_subexpr(s, expr, expr);
-    if (ret < 0)
-        return ret;
-
-    /* Pointers and values have been transfered into the tokens so we don't
-     * need them anymore */
-    ngli_hmap_freep(&s->funcs);
-    ngli_hmap_freep(&s->consts);
-
     return 0;
 }
 
+/* Tokenization pass: build a list of tokens */
+static int tokenize(struct eval *s, const char *expr)
+{
+    ngli_darray_clear(&s->tokens);
+    return parse_subexpr(s, expr, expr);
+}
+
 static int missing_argument(const struct token *token, int got)
 {
     if (token->type == TOKEN_UNARY_OPERATOR || token->type == TOKEN_BINARY_OPERATOR)
@@ -456,69 +547,136 @@ static int missing_argument(const struct token *token, int got)
     return NGL_ERROR_INVALID_DATA;
 }
 
-/*
- * Check that the operator has the expected number of arguments by consuming
- * the stack.
- */
-static int check_operator_pop(struct darray *stack, const struct token *token)
+static int get_var_reg(struct eval *s, const float *ptr)
 {
-    const struct token *o1 = ngli_darray_pop(stack);
-    if (!o1)
-        return missing_argument(token, 0);
-    if (token->nb_args == 1)
-        return 0;
+    const float **ptrs = ngli_darray_data(&s->var_ptrs);
+    for (int i = 0; i < ngli_darray_count(&s->var_ptrs); i++)
+        if (ptrs[i] == ptr)
+            return REG(REG_VAR, i);
+    if (!ngli_darray_push(&s->var_ptrs, &ptr))
+        return NGL_ERROR_MEMORY;
+    return REG(REG_VAR, ngli_darray_count(&s->var_ptrs) - 1);
+}
 
-    const struct token *o2 = ngli_darray_pop(stack);
-    if (!o2)
-        return missing_argument(token, 1);
-    if (token->nb_args == 2)
-        return 0;
+static int get_const_reg(struct eval *s, float value)
+{
+    const float *values = ngli_darray_data(&s->const_values);
+    for (int i = 0; i < ngli_darray_count(&s->const_values); i++)
+        if (!memcmp(&values[i], &value, sizeof(value)))
+            return REG(REG_CONST, i);
+    if (!ngli_darray_push(&s->const_values, &value))
+        return NGL_ERROR_MEMORY;
+    return REG(REG_CONST, ngli_darray_count(&s->const_values) - 1);
+}
 
-    const struct token *o3 = ngli_darray_pop(stack);
-    if (!o3)
-        return missing_argument(token, 2);
-    if (token->nb_args == 3)
-        return 0;
+static int get_operand_reg(struct eval *s, const struct operand *operand)
+{
+    return operand->is_const ? get_const_reg(s, operand->value) : operand->reg;
+}
 
+static enum opcode get_opcode(const struct token *token)
+{
+    for (int i = 0; i < NGLI_ARRAY_NB(inline_ops); i++)
+        if (inline_ops[i].func == token->func.f)
+            return inline_ops[i].op;
+    return OP_CALL1 + token->nb_args - 1;
+}
+
+static float fold_operator(const struct token *token, const struct operand *args)
+{
+    switch (token->nb_args) {
+    case 1: return token->func.f1(args[0].value);
+    case 2: return token->func.f2(args[0].value, args[1].value);
+    case 3: return token->func.f3(args[0].value, args[1].value, args[2].value);
+    }
     ngli_assert(0);
 }
 
 /*
- * This function has multiple purposes:
+ * Compilation pass: simulate the evaluation of the RPN tokens to translate
+ * them into register based instructions. This pass also checks that the
+ * expression is valid (which would have been redundant if done at every run)
+ * and folds all the operations for which the operands are known.
  *
- * - check if the expression is valid by simulating a simplified evaluation of
- *   the expression with extra checks (which would have been redundant if
- *   called for every eval_run call).
- * - make sure the temporary stack is pre-allocated with enough space so that
- *   eval_run calls do not trigger any heap re-alloc
+ * Temporaries are allocated according to their depth in the evaluation stack
+ * starting at tmp_base, so that the results of the expressions compiled
+ * before are never overwritten.
  */
-static int prepare_eval_run(struct eval *s)
+static int compile(struct eval *s, int tmp_base)
 {
-    struct darray *stack = &s->tmp_stack;
+    struct darray *operands = &s->operands;
 
-    ngli_darray_clear(stack);
+    ngli_darray_clear(operands);
 
     const struct token *tokens = ngli_darray_data(&s->output);
     for (int i = 0; i < ngli_darray_count(&s->output); i++) {
         const struct token *token = &tokens[i];
 
-        if (token->type == TOKEN_CONSTANT || token->type == TOKEN_VARIABLE) {
-            PUSH(stack, token);
+        if (token->type == TOKEN_CONSTANT) {
+            const struct operand operand = {.is_const=1, .value=token->value};
+            PUSH(operands, &operand);
+            continue;
+        }
+
+        if (token->type == TOKEN_VARIABLE) {
+            const int reg = get_var_reg(s, token->ptr);
+            if (reg < 0)
+                return reg;
+            const struct operand operand = {.reg=reg};
+            PUSH(operands, &operand);
+            continue;
+        }
+
+        const int count = ngli_darray_count(operands);
+        if (count < token->nb_args)
+            return missing_argument(token, count);
+
+        if (token->func.f == f_noop)
+            continue;
+
+        const int pos = count - token->nb_args;
+        const struct operand *args = ngli_darray_get(operands, pos);
+
+        int is_const = token->func.f != f_print;
+        for (int j = 0; j < token->nb_args; j++)
+            is_const &= args[j].is_const;
+
+        struct operand result = {0};
+        if (is_const) {
+            result.is_const = 1;
+            result.value = fold_operator(token, args);
         } else {
-            int ret = check_operator_pop(stack, token);
-            if (ret < 0)
-                return ret;
-            const struct token r = {.type=TOKEN_CONSTANT}; /* fake result */
-            PUSH(stack, &r);
+            struct insn insn = {
+                .op     = get_opcode(token),
+                .dst    = REG(REG_TMP, tmp_base + pos),
+                .func.f = token->func.f,
+            };
+            for (int j = 0; j < token->nb_args; j++) {
+                insn.src[j] = get_operand_reg(s, &args[j]);
+                if (insn.src[j] < 0)
+                    return insn.src[j];
+            }
+            PUSH(&s->insns, &insn);
+            s->nb_tmps = NGLI_MAX(s->nb_tmps, tmp_base + pos + 1);
+            result.reg = insn.dst;
         }
+
+        ngli_darray_remove_range(operands, pos, token->nb_args);
+        PUSH(operands, &result);
     }
 
-    const int n = ngli_darray_count(stack);
+    const int n = ngli_darray_count(operands);
     if (n > 1) {
         LOG(ERROR, "detected %d dangling expressions without operators between them", n);
         return NGL_ERROR_INVALID_DATA;
     }
 
+    const struct operand *res = ngli_darray_tail(operands);
+    const int reg = res ? get_operand_reg(s, res) : get_const_reg(s, 0.f);
+    if (reg < 0)
+        return reg;
+    PUSH(&s->results, &reg);
+
     return 0;
 }
 
@@ -540,6 +698,9 @@ static int must_be_processed_first(const struct token *op, const struct token *c
  */
 static int infix_to_rpn(struct eval *s, const char *expr)
 {
+    ngli_darray_clear(&s->output);
+    ngli_darray_clear(&s->tmp_stack);
+
     struct darray *operators = &s->tmp_stack;
     const struct token *tokens = ngli_darray_data(&s->tokens);
     for (int i = 0; i < ngli_darray_count(&s->tokens); i++) {
@@ -606,69 +767,138 @@ static int infix_to_rpn(struct eval *s, const char *expr)
         PUSH(&s->output, token);
     }
 
-    /* Output has been generated so we don't need the input tokens anymore */
-    ngli_darray_reset(&s->tokens);
+    return 0;
+}
 
-    return prepare_eval_run(s);
+static int resolve_reg(const struct eval *s, int reg)
+{
+    const int nb_vars = ngli_darray_count(&s->var_ptrs);
+    const int nb_consts = ngli_darray_count(&s->const_values);
+    switch (REG_KIND(reg)) {
+    case REG_VAR:   return REG_INDEX(reg);
+    case REG_CONST: return nb_vars + REG_INDEX(reg);
+    case REG_TMP:   return nb_vars + nb_consts + REG_INDEX(reg);
+    }
+    ngli_assert(0);
 }
 
-int ngli_eval_init(struct eval *s, const char *expr, const struct hmap *vars)
+/*
+ * Relocate the register indexes into the final register file and load the
+ * constant pool into it
+ */
+static int link_program(struct eval *s)
 {
-    if (!expr)
-        return NGL_ERROR_INVALID_DATA;
+    const int nb_vars = ngli_darray_count(&s->var_ptrs);
+    const int nb_consts = ngli_darray_count(&s->const_values);
 
-    s->vars = vars;
+    s->regs = ngli_calloc(nb_vars + nb_consts + s->nb_tmps + 1, sizeof(*s->regs));
+    if (!s->regs)
+        return NGL_ERROR_MEMORY;
 
-    int ret;
-    if ((ret = tokenize(s, expr)) < 0 ||
-        (ret = infix_to_rpn(s, expr)) < 0)
-        return ret;
+    const float *values = ngli_darray_data(&s->const_values);
+    for (int i = 0; i < nb_consts; i++)
+        s->regs[nb_vars + i] = values[i];
+
+    struct insn *insns = ngli_darray_data(&s->insns);
+    for (int i = 0; i < ngli_darray_count(&s->insns); i++) {
+        struct insn *insn = &insns[i];
+        insn->dst = resolve_reg(s, insn->dst);
+        for (int j = 0; j < NGLI_ARRAY_NB(insn->src); j++)
+            insn->src[j] = resolve_reg(s, insn->src[j]);
+    }
+
+    int *results = ngli_darray_data(&s->results);
+    for (int i = 0; i < ngli_darray_count(&s->results); i++)
+        results[i] = resolve_reg(s, results[i]);
 
     return 0;
 }
 
-/*
- * Evaluate the operator by consuming the stack.
- */
-static float eval_operator_pop(struct darray *stack, const struct token *token)
+int ngli_eval_init_multi(struct eval *s, const char * const *exprs, int nb_exprs, const struct hmap *vars)
 {
-    const struct token *o1 = ngli_darray_pop_unsafe(stack);
-    if (token->nb_args == 1)
-        return token->func.f1(o1->value);
+    if (nb_exprs < 1 || !exprs[0])
+        return NGL_ERROR_INVALID_DATA;
 
-    const struct token *o2 = ngli_darray_pop_unsafe(stack);
-    if (token->nb_args == 2)
-        return token->func.f2(o2->value, o1->value);
+    s->vars = vars;
 
-    const struct token *o3 = ngli_darray_pop_unsafe(stack);
-    if (token->nb_args == 3)
-        return token->func.f3(o3->value, o2->value, o1->value);
+    int ret = create_lookup_maps(s);
+    if (ret < 0)
+        return ret;
 
-    ngli_assert(0);
+    for (int i = 0; i < nb_exprs; i++) {
+        const char *expr = exprs[i];
+
+        /* A missing expression repeats the previous result */
+        if (!expr) {
+            const int reg = *(int *)ngli_darray_tail(&s->results);
+            PUSH(&s->results, &reg);
+            continue;
+        }
+
+        if ((ret = tokenize(s, expr)) < 0 ||
+            (ret = infix_to_rpn(s, expr)) < 0 ||
+            (ret = compile(s, i)) < 0)
+            return ret;
+    }
+
+    /* Pointers and values have been transfered into the program so we don't
+     * need the intermediate representations anymore */
+    ngli_hmap_freep(&s->funcs);
+    ngli_hmap_freep(&s->consts);
+    ngli_darray_reset(&s->tokens);
+    ngli_darray_reset(&s->tmp_stack);
+    ngli_darray_reset(&s->output);
+    ngli_darray_reset(&s->operands);
+
+    return link_program(s);
 }
 
-int ngli_eval_run(struct eval *s, float *dst)
+int ngli_eval_init(struct eval *s, const char *expr, const struct hmap *vars)
 {
-    struct darray *stack = &s->tmp_stack;
+    return ngli_eval_init_multi(s, &expr, 1, vars);
+}
 
-    ngli_darray_clear(stack);
+#define R(i) regs[insn->src[i]]
 
-    const struct token *tokens = ngli_darray_data(&s->output);
-    for (int i = 0; i < ngli_darray_count(&s->output); i++) {
-        const struct token *token = &tokens[i];
-        if (token->type == TOKEN_VARIABLE) {
-            const struct token r = {.type=TOKEN_CONSTANT, .value=*token->ptr};
-            PUSH(stack, &r);
-        } else if (token->type == TOKEN_CONSTANT) {
-            PUSH(stack, token);
-        } else {
-            const struct token r = {.type=TOKEN_CONSTANT, .value=eval_operator_pop(stack, token)};
-            PUSH(stack, &r);
+int ngli_eval_run(struct eval *s, float *dst)
+{
+    float *regs = s->regs;
+
+    const float **var_ptrs = ngli_darray_data(&s->var_ptrs);
+    for (int i = 0; i < ngli_darray_count(&s->var_ptrs); i++)
+        regs[i] = *var_ptrs[i];
+
+    const struct insn *insn = ngli_darray_data(&s->insns);
+    const struct insn *end = insn + ngli_darray_count(&s->insns);
+    for (; insn < end; insn++) {
+        float r;
+        switch (insn->op) {
+        case OP_CALL1: r = insn->func.f1(R(0));             break;
+        case OP_CALL2: r = insn->func.f2(R(0), R(1));       break;
+        case OP_CALL3: r = insn->func.f3(R(0), R(1), R(2)); break;
+        case OP_NEG:   r = -R(0);                           break;
+        case OP_ADD:   r = R(0) + R(1);                     break;
+        case OP_SUB:   r = R(0) - R(1);                     break;
+        case OP_MUL:   r = R(0) * R(1);                     break;
+        case OP_DIV:   r = R(0) / R(1);                     break;
+        case OP_ABS:   r = fabsf(R(0));                     break;
+        case OP_SQR:   r = R(0) * R(0);                     break;
+        case OP_CUBE:  r = R(0) * R(0) * R(0);              break;
+        case OP_FRACT: r = R(0) - truncf(R(0));             break;
+        case OP_MIN:   r = NGLI_MIN(R(0), R(1));            break;
+        case OP_MAX:   r = NGLI_MAX(R(0), R(1));            break;
+        case OP_SAT:   r = NGLI_CLAMP(R(0), 0.f, 1.f);      break;
+        case OP_CLAMP: r = NGLI_CLAMP(R(0), R(1), R(2));    break;
+        case OP_MIX:   r = NGLI_MIX(R(0), R(1), R(2));      break;
+        case OP_MLA:   r = R(0) * R(1) + R(2);              break;
+        default:       ngli_assert(0);
         }
+        regs[insn->dst] = r;
     }
 
-    const struct token *res = ngli_darray_pop(stack);
-    *dst = res ? res->value : 0.0;
+    const int *results = ngli_darray_data(&s->results);
+    for (int i = 0; i < ngli_darray_count(&s->results); i++)
+        dst[i] = regs[results[i]];
     return 0;
 }
 
@@ -680,6 +910,12 @@ void ngli_eval_freep(struct eval **sp)
     ngli_darray_reset(&s->tokens);
     ngli_darray_reset(&s->tmp_stack);
     ngli_darray_reset(&s->output);
+    ngli_darray_reset(&s->operands);
+    ngli_darray_reset(&s->insns);
+    ngli_darray_reset(&s->var_ptrs);
+    ngli_darray_reset(&s->const_values);
+    ngli_darray_reset(&s->results);
+    ngli_freep(&s->regs);
     ngli_hmap_freep(&s->funcs);
     ngli_hmap_freep(&s->consts);
     ngli_freep(sp);
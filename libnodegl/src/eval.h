@@ -29,6 +29,15 @@ struct eval;
 
 struct eval *ngli_eval_create(void);
 int ngli_eval_init(struct eval *s, const char *expr, const struct hmap *vars);
+
+/*
+ * Compile nb_exprs expressions into a single program evaluating all of them
+ * in one pass. A NULL expression (except the first one) repeats the result of
+ * the previous one.
+ */
+int ngli_eval_init_multi(struct eval *s, const char * const *exprs, int nb_exprs, const struct hmap *vars);
+
+/* Write one float per expression into dst */
 int ngli_eval_run(struct eval *s, float *dst);
 void ngli_eval_freep(struct eval **sp);
 
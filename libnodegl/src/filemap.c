@@ -0,0 +1,164 @@
+/*
+ * Copyright 2023 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "config.h"
+
+#ifndef TARGET_MINGW_W64
+#define _POSIX_C_SOURCE 200809L // posix_madvise()
+#endif
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <stdint.h>
+
+#include "filemap.h"
+#include "log.h"
+#include "nodegl.h"
+
+#ifdef _WIN32
+int ngli_filemap_init(struct filemap *s, const char *filename)
+{
+    *s = (struct filemap){0};
+
+    s->file_handle = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL,
+                                 OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (s->file_handle == INVALID_HANDLE_VALUE) {
+        s->file_handle = NULL;
+        LOG(ERROR, "could not open '%s'", filename);
+        return NGL_ERROR_IO;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(s->file_handle, &file_size)) {
+        LOG(ERROR, "could not get '%s' size", filename);
+        goto fail;
+    }
+
+    if ((uint64_t)file_size.QuadPart > SIZE_MAX) {
+        LOG(ERROR, "'%s' is too large to be mapped", filename);
+        ngli_filemap_reset(s);
+        return NGL_ERROR_UNSUPPORTED;
+    }
+    s->size = (size_t)file_size.QuadPart;
+
+    /* Empty files can not be mapped */
+    if (!s->size)
+        return 0;
+
+    s->map_handle = CreateFileMappingA(s->file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!s->map_handle) {
+        LOG(ERROR, "could not create a mapping of '%s'", filename);
+        goto fail;
+    }
+
+    s->data = MapViewOfFile(s->map_handle, FILE_MAP_READ, 0, 0, 0);
+    if (!s->data) {
+        LOG(ERROR, "could not map '%s'", filename);
+        goto fail;
+    }
+
+    return 0;
+
+fail:
+    ngli_filemap_reset(s);
+    return NGL_ERROR_IO;
+}
+
+void ngli_filemap_reset(struct filemap *s)
+{
+    if (s->data)
+        UnmapViewOfFile(s->data);
+    if (s->map_handle)
+        CloseHandle(s->map_handle);
+    if (s->file_handle)
+        CloseHandle(s->file_handle);
+    *s = (struct filemap){0};
+}
+#else
+int ngli_filemap_init(struct filemap *s, const char *filename)
+{
+    *s = (struct filemap){0};
+
+    const int fd = open(filename, O_RDONLY);
+    if (fd == -1) {
+        LOG(ERROR, "could not open '%s': %s", filename, strerror(errno));
+        return NGL_ERROR_IO;
+    }
+
+    int ret = 0;
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        LOG(ERROR, "could not stat '%s': %s", filename, strerror(errno));
+        ret = NGL_ERROR_IO;
+        goto end;
+    }
+
+    if ((uint64_t)st.st_size > SIZE_MAX) {
+        LOG(ERROR, "'%s' is too large to be mapped", filename);
+        ret = NGL_ERROR_UNSUPPORTED;
+        goto end;
+    }
+    s->size = (size_t)st.st_size;
+
+    /* Empty files can not be mapped */
+    if (!s->size)
+        goto end;
+
+    /* The mapping holds its own reference on the file, fd can be closed */
+    void *data = mmap(NULL, s->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+        LOG(ERROR, "could not map '%s': %s", filename, strerror(errno));
+        s->size = 0;
+        ret = NGL_ERROR_IO;
+        goto end;
+    }
+    s->data = data;
+
+    /*
+     * The whole mapping is expected to be read once from start to end: this
+     * allows the system to read ahead aggressively and to drop the pages
+     * early once they have been consumed. The hints are not critical so
+     * their failure is ignored.
+     */
+    posix_madvise(data, s->size, POSIX_MADV_SEQUENTIAL);
+    posix_madvise(data, s->size, POSIX_MADV_WILLNEED);
+
+end:
+    close(fd);
+    return ret;
+}
+
+void ngli_filemap_reset(struct filemap *s)
+{
+    if (s->data)
+        munmap((void *)s->data, s->size);
+    *s = (struct filemap){0};
+}
+#endif
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2023 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FILEMAP_H
+#define FILEMAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Read-only memory mapping of a whole file.
+ *
+ * The pages are loaded lazily by the system as they are accessed, and the
+ * mapping is hinted for a sequential read so that the data can be copied
+ * straight from the page cache to its destination (typically a GPU buffer)
+ * without ever being duplicated on the heap.
+ */
+struct filemap {
+    const uint8_t *data;
+    size_t size;
+#ifdef _WIN32
+    void *file_handle;
+    void *map_handle;
+#endif
+};
+
+int ngli_filemap_init(struct filemap *s, const char *filename);
+void ngli_filemap_reset(struct filemap *s);
+
+#endif
@@ -83,6 +83,19 @@ struct gpu_ctx *ngli_gpu_ctx_create(const struct ngl_config *config)
 
 int ngli_gpu_ctx_init(struct gpu_ctx *s)
 {
+    const struct ngl_config *config = &s->config;
+
+    if (config->capture_async_depth < 0) {
+        LOG(ERROR, "invalid capture async depth: %d", config->capture_async_depth);
+        return NGL_ERROR_INVALID_ARG;
+    }
+
+    if (config->capture_async_depth &&
+        (!config->offscreen || config->capture_buffer_type != NGL_CAPTURE_BUFFER_TYPE_CPU)) {
+        LOG(ERROR, "asynchronous capture is only supported by offscreen contexts with a CPU capture buffer");
+        return NGL_ERROR_INVALID_ARG;
+    }
+
     return s->cls->init(s);
 }
 
@@ -98,6 +111,16 @@ int ngli_gpu_ctx_set_capture_buffer(struct gpu_ctx *s, void *capture_buffer)
     return cls->set_capture_buffer(s, capture_buffer);
 }
 
+int ngli_gpu_ctx_capture_acquire(struct gpu_ctx *s, double *t)
+{
+    const struct gpu_ctx_class *cls = s->cls;
+    if (!cls->capture_acquire || !s->config.capture_async_depth) {
+        LOG(ERROR, "asynchronous capture is not enabled");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+    return cls->capture_acquire(s, t);
+}
+
 int ngli_gpu_ctx_begin_update(struct gpu_ctx *s, double t)
 {
     return s->cls->begin_update(s, t);
@@ -123,11 +146,32 @@ int ngli_gpu_ctx_query_draw_time(struct gpu_ctx *s, int64_t *time)
     return s->cls->query_draw_time(s, time);
 }
 
+int ngli_gpu_ctx_write_timestamp(struct gpu_ctx *s, int index)
+{
+    ngli_assert(index >= 0 && index < NGLI_GPU_MAX_TIMESTAMPS);
+    return s->cls->write_timestamp(s, index);
+}
+
+int ngli_gpu_ctx_get_timestamps(struct gpu_ctx *s, int latency, int64_t *timestamps, int nb_timestamps)
+{
+    ngli_assert(latency >= 0 && latency < NGLI_GPU_NB_QUERY_FRAMES);
+    ngli_assert(nb_timestamps <= NGLI_GPU_MAX_TIMESTAMPS);
+    return s->cls->get_timestamps(s, latency, timestamps, nb_timestamps);
+}
+
 void ngli_gpu_ctx_wait_idle(struct gpu_ctx *s)
 {
     s->cls->wait_idle(s);
 }
 
+int ngli_gpu_ctx_alloc_uniform_data(struct gpu_ctx *s, size_t size, struct buffer **bufferp, size_t *offsetp, void **datap)
+{
+    const struct gpu_ctx_class *cls = s->cls;
+    if (!cls->alloc_uniform_data)
+        return NGL_ERROR_UNSUPPORTED;
+    return cls->alloc_uniform_data(s, size, bufferp, offsetp, datap);
+}
+
 void ngli_gpu_ctx_freep(struct gpu_ctx **sp)
 {
     if (!*sp)
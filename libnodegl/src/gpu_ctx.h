@@ -47,6 +47,34 @@
 #define NGLI_FEATURE_TEXTURE_HALF_FLOAT_RENDERABLE     (1 << 13)
 #define NGLI_FEATURE_BUFFER_MAP                        (1 << 14)
 
+/* Maximum number of GPU timestamps written per frame for the profiler */
+#define NGLI_GPU_MAX_TIMESTAMPS 512
+
+/*
+ * The GPU timing queries (draw time and profiler timestamps) are allocated for
+ * a ring of frames: their results are read back without waiting, up to
+ * NGLI_GPU_NB_QUERY_FRAMES - 1 frames after being written.
+ */
+#define NGLI_GPU_NB_QUERY_FRAMES 4
+
+/*
+ * Backend counters reported by the HUD. Counters flagged as cumulative in the
+ * HUD only ever grow and are reported as per-frame deltas.
+ */
+enum {
+    NGLI_GPU_STAT_DESC_POOLS,           /* number of descriptor pools */
+    NGLI_GPU_STAT_DESC_SETS,            /* number of live descriptor sets */
+    NGLI_GPU_STAT_DESC_WRITES,          /* cumulative descriptor writes */
+    NGLI_GPU_STAT_DESC_WRITES_SKIPPED,  /* cumulative redundant binding updates */
+    NGLI_GPU_STAT_STAGING_CHUNKS,       /* number of staging and uniform memory chunks */
+    NGLI_GPU_STAT_STAGING_COPIES,       /* cumulative copies from staging memory */
+    NGLI_GPU_STAT_GL_BINDS,             /* cumulative binding calls issued to OpenGL */
+    NGLI_GPU_STAT_GL_BINDS_SKIPPED,     /* cumulative redundant binding calls skipped */
+    NGLI_GPU_STAT_PGCACHE_HITS,         /* cumulative programs loaded from the disk cache */
+    NGLI_GPU_STAT_PGCACHE_MISSES,       /* cumulative programs missing from the disk cache */
+    NGLI_GPU_STAT_NB
+};
+
 struct gpu_ctx_class {
     const char *name;
 
@@ -54,14 +82,19 @@ struct gpu_ctx_class {
     int (*init)(struct gpu_ctx *s);
     int (*resize)(struct gpu_ctx *s, int width, int height, const int *viewport);
     int (*set_capture_buffer)(struct gpu_ctx *s, void *capture_buffer);
+    int (*capture_acquire)(struct gpu_ctx *s, double *t);
     int (*begin_update)(struct gpu_ctx *s, double t);
     int (*end_update)(struct gpu_ctx *s, double t);
     int (*begin_draw)(struct gpu_ctx *s, double t);
     int (*end_draw)(struct gpu_ctx *s, double t);
     int (*query_draw_time)(struct gpu_ctx *s, int64_t *time);
+    int (*write_timestamp)(struct gpu_ctx *s, int index);
+    int (*get_timestamps)(struct gpu_ctx *s, int latency, int64_t *timestamps, int nb_timestamps);
     void (*wait_idle)(struct gpu_ctx *s);
     void (*destroy)(struct gpu_ctx *s);
 
+    int (*alloc_uniform_data)(struct gpu_ctx *s, size_t size, struct buffer **bufferp, size_t *offsetp, void **datap);
+
     int (*transform_cull_mode)(struct gpu_ctx *s, int cull_mode);
     void (*transform_projection_matrix)(struct gpu_ctx *s, float *dst);
     void (*get_rendertarget_uvcoord_matrix)(struct gpu_ctx *s, float *dst);
@@ -80,9 +113,9 @@ struct gpu_ctx_class {
     int (*get_preferred_depth_stencil_format)(struct gpu_ctx *s);
 
     struct buffer *(*buffer_create)(struct gpu_ctx *ctx);
-    int (*buffer_init)(struct buffer *s, int size, int usage);
-    int (*buffer_upload)(struct buffer *s, const void *data, int size, int offset);
-    int (*buffer_map)(struct buffer *s, int size, int offset, void **datap);
+    int (*buffer_init)(struct buffer *s, size_t size, int usage);
+    int (*buffer_upload)(struct buffer *s, const void *data, size_t size, size_t offset);
+    int (*buffer_map)(struct buffer *s, size_t size, size_t offset, void **datap);
     void (*buffer_unmap)(struct buffer *s);
     void (*buffer_freep)(struct buffer **sp);
 
@@ -93,6 +126,7 @@ struct gpu_ctx_class {
     int (*pipeline_update_uniform)(struct pipeline *s, int index, const void *value);
     int (*pipeline_update_texture)(struct pipeline *s, int index, const struct texture *texture);
     int (*pipeline_update_buffer)(struct pipeline *s, int index, const struct buffer *buffer, int offset, int size);
+    int (*pipeline_update_dynamic_offsets)(struct pipeline *s, const uint32_t *offsets, int nb_offsets);
     void (*pipeline_draw)(struct pipeline *s, int nb_vertices, int nb_instances);
     void (*pipeline_draw_indexed)(struct pipeline *s, const struct buffer *indices, int indices_format, int nb_indices, int nb_instances);
     void (*pipeline_dispatch)(struct pipeline *s, int nb_group_x, int nb_group_y, int nb_group_z);
@@ -100,6 +134,8 @@ struct gpu_ctx_class {
 
     struct program *(*program_create)(struct gpu_ctx *ctx);
     int (*program_init)(struct program *s, const struct program_params *params);
+    int (*program_init_from_binary)(struct program *s, const struct program_params *params, const void *data, size_t size);
+    int (*program_get_binary)(struct program *s, void **datap, size_t *sizep);
     void (*program_freep)(struct program **sp);
 
     struct rendertarget *(*rendertarget_create)(struct gpu_ctx *ctx);
@@ -121,6 +157,8 @@ struct gpu_ctx {
     int language_version;
     uint64_t features;
     struct gpu_limits limits;
+    uint64_t stats[NGLI_GPU_STAT_NB];
+    uint64_t object_id; /* last creation order identifier given to a program or a texture */
 #if DEBUG_GPU_CAPTURE
     struct gpu_capture_ctx *gpu_capture_ctx;
     int gpu_capture;
@@ -131,14 +169,38 @@ struct gpu_ctx *ngli_gpu_ctx_create(const struct ngl_config *config);
 int ngli_gpu_ctx_init(struct gpu_ctx *s);
 int ngli_gpu_ctx_resize(struct gpu_ctx *s, int width, int height, const int *viewport);
 int ngli_gpu_ctx_set_capture_buffer(struct gpu_ctx *s, void *capture_buffer);
+int ngli_gpu_ctx_capture_acquire(struct gpu_ctx *s, double *t);
 int ngli_gpu_ctx_begin_update(struct gpu_ctx *s, double t);
 int ngli_gpu_ctx_end_update(struct gpu_ctx *s, double t);
 int ngli_gpu_ctx_begin_draw(struct gpu_ctx *s, double t);
+
+/*
+ * Non-blocking GPU timing queries.
+ *
+ * ngli_gpu_ctx_query_draw_time() ends the draw time measurement of the current
+ * frame and returns the latency (in frames) of the most recent measurement
+ * available, which is then written in time, or 0 if none is available yet.
+ *
+ * ngli_gpu_ctx_get_timestamps() reads the timestamps written by the frame
+ * drawn latency frames ago (0 being the last frame, once ended) and returns 1,
+ * or 0 if the results are not available yet.
+ */
 int ngli_gpu_ctx_query_draw_time(struct gpu_ctx *s, int64_t *time);
+int ngli_gpu_ctx_write_timestamp(struct gpu_ctx *s, int index);
+int ngli_gpu_ctx_get_timestamps(struct gpu_ctx *s, int latency, int64_t *timestamps, int nb_timestamps);
 int ngli_gpu_ctx_end_draw(struct gpu_ctx *s, double t);
 void ngli_gpu_ctx_wait_idle(struct gpu_ctx *s);
 void ngli_gpu_ctx_freep(struct gpu_ctx **sp);
 
+/*
+ * Allocate size bytes of transient uniform data, valid until the end of the
+ * current frame. The data is written through datap and is located at offsetp
+ * in bufferp, to be bound as a dynamic uniform buffer. The buffer backing the
+ * allocations is shared by all the frames in flight, so that a binding made
+ * in a previous frame usually remains valid and only the offset changes.
+ */
+int ngli_gpu_ctx_alloc_uniform_data(struct gpu_ctx *s, size_t size, struct buffer **bufferp, size_t *offsetp, void **datap);
+
 int ngli_gpu_ctx_transform_cull_mode(struct gpu_ctx *s, int cull_mode);
 void ngli_gpu_ctx_transform_projection_matrix(struct gpu_ctx *s, float *dst);
 void ngli_gpu_ctx_get_rendertarget_uvcoord_matrix(struct gpu_ctx *s, float *dst);
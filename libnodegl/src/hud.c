@@ -74,6 +74,7 @@ struct hud {
 #define MEMORY_WIDGET_TEXT_LEN      25
 #define ACTIVITY_WIDGET_TEXT_LEN    12
 #define DRAWCALL_WIDGET_TEXT_LEN    12
+#define GPUSTATS_WIDGET_TEXT_LEN    25
 #define GLOBALINFOS_WIDGET_TEXT_LEN 25
 
 enum {
@@ -89,7 +90,10 @@ enum {
     MEMORY_BUFFERS_GPU,
     MEMORY_BLOCKS_CPU,
     MEMORY_BLOCKS_GPU,
+    MEMORY_BLOCKS_UPLOAD,
     MEMORY_TEXTURES,
+    MEMORY_RTPOOL,
+    MEMORY_RTPOOL_PEAK,
     NB_MEMORY
 };
 
@@ -161,6 +165,7 @@ enum {
 #define VIVID_CYAN_LIME_GREEN   0x32FF84FF
 #define VIVID_YELLOW            0xD6FF32FF
 #define VIVID_RED               0xFF3232FF
+#define VIVID_ORANGE            0xFF9632FF
 
 static const struct {
     const char *label;
@@ -198,11 +203,26 @@ static const struct {
         .node_types=(const int[]){NGL_NODE_BLOCK, -1},
         .color= VIVID_YELLOW,
     },
+    [MEMORY_BLOCKS_UPLOAD] = {
+        .label="Blocks upld",
+        .node_types=(const int[]){NGL_NODE_BLOCK, -1},
+        .color= VIVID_ORANGE,
+    },
     [MEMORY_TEXTURES] = {
         .label="Textures",
         .node_types=(const int[]){NGL_NODE_TEXTURE2D, NGL_NODE_TEXTURE3D, -1},
         .color= VIVID_RED,
     },
+    [MEMORY_RTPOOL] = {
+        .label="RT pool",
+        .node_types=(const int[]){-1},
+        .color= BRIGHT_MAGENTA,
+    },
+    [MEMORY_RTPOOL_PEAK] = {
+        .label="RT pool max",
+        .node_types=(const int[]){-1},
+        .color= BRIGHT_CYAN,
+    },
 };
 
 static const struct activity_spec {
@@ -256,6 +276,23 @@ static const struct drawcall_spec {
     },
 };
 
+static const struct {
+    const char *label;
+    uint32_t color;
+    int cumulative;
+} gpustats_specs[] = {
+    [NGLI_GPU_STAT_DESC_POOLS]          = {"Desc pools",   BRIGHT_MAGENTA,        0},
+    [NGLI_GPU_STAT_DESC_SETS]           = {"Desc sets",    BRIGHT_CYAN,           0},
+    [NGLI_GPU_STAT_DESC_WRITES]         = {"Desc writes",  BRIGHT_YELLOW,         1},
+    [NGLI_GPU_STAT_DESC_WRITES_SKIPPED] = {"Desc skipped", BRIGHT_LIME_GREEN,     1},
+    [NGLI_GPU_STAT_STAGING_CHUNKS]      = {"Ring chunks",  VIVID_BLUE,            0},
+    [NGLI_GPU_STAT_STAGING_COPIES]      = {"Stage copies", VIVID_RED,             1},
+    [NGLI_GPU_STAT_GL_BINDS]            = {"GL binds",     VIVID_ORANGE,          1},
+    [NGLI_GPU_STAT_GL_BINDS_SKIPPED]    = {"GL skipped",   VIVID_YELLOW,          1},
+    [NGLI_GPU_STAT_PGCACHE_HITS]        = {"Prog hits",    VIVID_MAGENTA,         1},
+    [NGLI_GPU_STAT_PGCACHE_MISSES]      = {"Prog misses",  VIVID_CYAN_LIME_GREEN, 1},
+};
+
 static const struct globalinfos_spec {
     const char* label;
     const uint32_t color;
@@ -268,6 +305,7 @@ NGLI_STATIC_ASSERT(hud_nb_latency,      NGLI_ARRAY_NB(latency_specs)     == NB_L
 NGLI_STATIC_ASSERT(hud_nb_memory,       NGLI_ARRAY_NB(memory_specs)      == NB_MEMORY);
 NGLI_STATIC_ASSERT(hud_nb_activity,     NGLI_ARRAY_NB(activity_specs)    == NB_ACTIVITY);
 NGLI_STATIC_ASSERT(hud_nb_drawcall,     NGLI_ARRAY_NB(drawcall_specs)    == NB_DRAWCALL);
+NGLI_STATIC_ASSERT(hud_nb_gpustats,     NGLI_ARRAY_NB(gpustats_specs)    == NGLI_GPU_STAT_NB);
 NGLI_STATIC_ASSERT(hud_nb_globalinfos,  NGLI_ARRAY_NB(globalinfos_specs) == NB_GLOBALINFOS);
 
 enum widget_type {
@@ -275,6 +313,7 @@ enum widget_type {
     WIDGET_MEMORY,
     WIDGET_ACTIVITY,
     WIDGET_DRAWCALL,
+    WIDGET_GPUSTATS,
     WIDGET_GLOBALINFOS,
     NB_WIDGET
 };
@@ -299,11 +338,13 @@ struct latency_measure {
 
 struct widget_latency {
     struct latency_measure measures[NB_LATENCY];
+    int gpu_latency; /* frame latency of the last GPU measurement */
 };
 
 struct widget_memory {
     struct darray nodes[NB_MEMORY];
     uint64_t sizes[NB_MEMORY];
+    uint64_t blocks_uploaded_size;
 };
 
 struct widget_activity {
@@ -316,6 +357,11 @@ struct widget_drawcall {
     int nb_draws;
 };
 
+struct widget_gpustats {
+    uint64_t values[NGLI_GPU_STAT_NB];
+    uint64_t last_stats[NGLI_GPU_STAT_NB];
+};
+
 struct widget {
     enum widget_type type;
     struct rect rect;
@@ -424,6 +470,12 @@ static int widget_memory_init(struct hud *s, struct widget *widget)
         if (ret < 0)
             return ret;
     }
+
+    struct darray *nodes_blk_array = &priv->nodes[MEMORY_BLOCKS_UPLOAD];
+    struct ngl_node **nodes_blk = ngli_darray_data(nodes_blk_array);
+    for (int i = 0; i < ngli_darray_count(nodes_blk_array); i++)
+        priv->blocks_uploaded_size += ngli_node_block_get_uploaded_size(nodes_blk[i]);
+
     return 0;
 }
 
@@ -447,6 +499,14 @@ static int widget_drawcall_init(struct hud *s, struct widget *widget)
     return make_nodes_set(scene, &priv->nodes, node_types);
 }
 
+static int widget_gpustats_init(struct hud *s, struct widget *widget)
+{
+    const struct gpu_ctx *gpu_ctx = s->ctx->gpu_ctx;
+    struct widget_gpustats *priv = widget->priv_data;
+    memcpy(priv->last_stats, gpu_ctx->stats, sizeof(priv->last_stats));
+    return 0;
+}
+
 /* Widget update */
 
 static void register_time(struct hud *s, struct latency_measure *m, int64_t t)
@@ -467,7 +527,12 @@ static void widget_latency_make_stats(struct hud *s, struct widget *widget)
     register_time(s, &priv->measures[LATENCY_UPDATE_CPU], ctx->cpu_update_time);
     register_time(s, &priv->measures[LATENCY_DRAW_CPU],   ctx->cpu_draw_time);
     register_time(s, &priv->measures[LATENCY_TOTAL_CPU],  ctx->cpu_update_time + ctx->cpu_draw_time);
-    register_time(s, &priv->measures[LATENCY_DRAW_GPU],   ctx->gpu_draw_time);
+
+    /* GPU timings are collected asynchronously, some frames later */
+    if (ctx->gpu_draw_time_latency) {
+        register_time(s, &priv->measures[LATENCY_DRAW_GPU], ctx->gpu_draw_time);
+        priv->gpu_latency = ctx->gpu_draw_time_latency;
+    }
 }
 
 static void widget_memory_make_stats(struct hud *s, struct widget *widget)
@@ -498,6 +563,15 @@ static void widget_memory_make_stats(struct hud *s, struct widget *widget)
     for (int i = 0; i < ngli_darray_count(nodes_blk_array_gpu); i++)
         priv->sizes[MEMORY_BLOCKS_GPU] += ngli_node_block_get_gpu_size(nodes_blk_gpu[i]);
 
+    /* Blocks keep a running total: report what was uploaded since the last frame */
+    struct darray *nodes_blk_array_upload = &priv->nodes[MEMORY_BLOCKS_UPLOAD];
+    struct ngl_node **nodes_blk_upload = ngli_darray_data(nodes_blk_array_upload);
+    uint64_t blocks_uploaded_size = 0;
+    for (int i = 0; i < ngli_darray_count(nodes_blk_array_upload); i++)
+        blocks_uploaded_size += ngli_node_block_get_uploaded_size(nodes_blk_upload[i]);
+    priv->sizes[MEMORY_BLOCKS_UPLOAD] = blocks_uploaded_size - priv->blocks_uploaded_size;
+    priv->blocks_uploaded_size = blocks_uploaded_size;
+
     struct darray *nodes_tex_array = &priv->nodes[MEMORY_TEXTURES];
     struct ngl_node **nodes_tex = ngli_darray_data(nodes_tex_array);
     priv->sizes[MEMORY_TEXTURES] = 0;
@@ -507,6 +581,10 @@ static void widget_memory_make_stats(struct hud *s, struct widget *widget)
         priv->sizes[MEMORY_TEXTURES] += ngli_image_get_memory_size(&texture->image)
                                       * tex_node->is_active;
     }
+
+    const struct rtpool *rtpool = &s->ctx->rtpool;
+    priv->sizes[MEMORY_RTPOOL] = rtpool->size;
+    priv->sizes[MEMORY_RTPOOL_PEAK] = rtpool->peak_size;
 }
 
 static void widget_activity_make_stats(struct hud *s, struct widget *widget)
@@ -529,6 +607,19 @@ static void widget_drawcall_make_stats(struct hud *s, struct widget *widget)
         priv->nb_draws += nodes[i]->draw_count;
 }
 
+static void widget_gpustats_make_stats(struct hud *s, struct widget *widget)
+{
+    const struct gpu_ctx *gpu_ctx = s->ctx->gpu_ctx;
+    struct widget_gpustats *priv = widget->priv_data;
+
+    /* Cumulative counters are reported as the difference with the last frame */
+    for (int i = 0; i < NGLI_GPU_STAT_NB; i++) {
+        const uint64_t stat = gpu_ctx->stats[i];
+        priv->values[i] = gpustats_specs[i].cumulative ? stat - priv->last_stats[i] : stat;
+        priv->last_stats[i] = stat;
+    }
+}
+
 /* Draw utils */
 
 static inline uint8_t *set_color(uint8_t *p, uint32_t rgba)
@@ -646,6 +737,8 @@ static void register_graph_value(struct data_graph *d, int64_t v)
 static int64_t get_latency_avg(const struct widget_latency *priv, int id)
 {
     const struct latency_measure *m = &priv->measures[id];
+    if (!m->count)
+        return 0;
     return m->total_times / m->count / (latency_specs[id].unit == 'u' ? 1 : 1000);
 }
 
@@ -744,6 +837,34 @@ static void widget_drawcall_draw(struct hud *s, struct widget *widget)
     draw_block_graph(s, d, &widget->graph_rect, d->amin, d->amax, BRIGHT_LIME_GREEN);
 }
 
+static void widget_gpustats_draw(struct hud *s, struct widget *widget)
+{
+    struct widget_gpustats *priv = widget->priv_data;
+    char buf[GPUSTATS_WIDGET_TEXT_LEN + 1];
+
+    for (int i = 0; i < NGLI_GPU_STAT_NB; i++) {
+        const uint64_t value = priv->values[i];
+        const uint32_t color = gpustats_specs[i].color;
+        snprintf(buf, sizeof(buf), "%-12s %"PRIu64, gpustats_specs[i].label, value);
+        print_text(s, widget->text_x, widget->text_y + i * NGLI_FONT_H, buf, color);
+        register_graph_value(&widget->data_graph[i], value);
+    }
+
+    int64_t graph_min = widget->data_graph[0].min;
+    int64_t graph_max = widget->data_graph[0].max;
+    for (int i = 1; i < NGLI_GPU_STAT_NB; i++) {
+        graph_min = NGLI_MIN(graph_min, widget->data_graph[i].min);
+        graph_max = NGLI_MAX(graph_max, widget->data_graph[i].max);
+    }
+
+    const int64_t graph_h = graph_max - graph_min;
+    if (graph_h) {
+        for (int i = 0; i < NGLI_GPU_STAT_NB; i++)
+            draw_line_graph(s, &widget->data_graph[i], &widget->graph_rect,
+                            graph_min, graph_max, gpustats_specs[i].color);
+    }
+}
+
 static void widget_globalinfos_draw(struct hud* s, struct widget* widget)
 {
     char buf[GLOBALINFOS_WIDGET_TEXT_LEN + 1];
@@ -761,6 +882,7 @@ static void widget_latency_csv_header(struct hud *s, struct widget *widget, stru
 {
     for (int i = 0; i < NB_LATENCY; i++)
         ngli_bstr_printf(dst, "%s%s", i ? "," : "", latency_specs[i].label);
+    ngli_bstr_print(dst, ",draw   GPU latency");
 }
 
 static void widget_memory_csv_header(struct hud *s, struct widget *widget, struct bstr *dst)
@@ -781,6 +903,12 @@ static void widget_drawcall_csv_header(struct hud *s, struct widget *widget, str
     ngli_bstr_print(dst, spec->label);
 }
 
+static void widget_gpustats_csv_header(struct hud *s, struct widget *widget, struct bstr *dst)
+{
+    for (int i = 0; i < NGLI_GPU_STAT_NB; i++)
+        ngli_bstr_printf(dst, "%s%s", i ? "," : "", gpustats_specs[i].label);
+}
+
 /* Widget CSV report */
 
 static void widget_latency_csv_report(struct hud *s, struct widget *widget, struct bstr *dst)
@@ -790,6 +918,7 @@ static void widget_latency_csv_report(struct hud *s, struct widget *widget, stru
         const int64_t t = get_latency_avg(priv, i);
         ngli_bstr_printf(dst, "%s%"PRId64, i ? "," : "", t);
     }
+    ngli_bstr_printf(dst, ",%d", priv->gpu_latency);
 }
 
 static void widget_memory_csv_report(struct hud *s, struct widget *widget, struct bstr *dst)
@@ -813,6 +942,13 @@ static void widget_drawcall_csv_report(struct hud *s, struct widget *widget, str
     ngli_bstr_printf(dst, "%d", priv->nb_draws);
 }
 
+static void widget_gpustats_csv_report(struct hud *s, struct widget *widget, struct bstr *dst)
+{
+    const struct widget_gpustats *priv = widget->priv_data;
+    for (int i = 0; i < NGLI_GPU_STAT_NB; i++)
+        ngli_bstr_printf(dst, "%s%"PRIu64, i ? "," : "", priv->values[i]);
+}
+
 /* Widget uninit */
 
 static void widget_latency_uninit(struct hud *s, struct widget *widget)
@@ -894,6 +1030,19 @@ static const struct widget_spec widget_specs[] = {
         .csv_report    = widget_drawcall_csv_report,
         .uninit        = widget_drawcall_uninit,
     },
+    [WIDGET_GPUSTATS] = {
+        .text_cols     = GPUSTATS_WIDGET_TEXT_LEN,
+        .text_rows     = NGLI_GPU_STAT_NB,
+        .graph_w       = 285,
+        .nb_data_graph = NGLI_GPU_STAT_NB,
+        .priv_size     = sizeof(struct widget_gpustats),
+        .init          = widget_gpustats_init,
+        .make_stats    = widget_gpustats_make_stats,
+        .draw          = widget_gpustats_draw,
+        .csv_header    = widget_gpustats_csv_header,
+        .csv_report    = widget_gpustats_csv_report,
+        .uninit        = NULL,
+    },
     [WIDGET_GLOBALINFOS] = {
         .text_cols     = GLOBALINFOS_WIDGET_TEXT_LEN,
         .text_rows     = NB_GLOBALINFOS,
@@ -995,16 +1144,18 @@ static int widgets_init(struct hud *s)
     const int memory_width      = get_widget_width(WIDGET_MEMORY);
     const int activity_width    = get_widget_width(WIDGET_ACTIVITY) * NB_ACTIVITY + WIDGET_MARGIN * (NB_ACTIVITY - 1);
     const int drawcall_width    = get_widget_width(WIDGET_DRAWCALL) * NB_DRAWCALL + WIDGET_MARGIN * (NB_DRAWCALL - 1);
+    const int gpustats_width    = get_widget_width(WIDGET_GPUSTATS);
     const int globalinfos_width = get_widget_width(WIDGET_GLOBALINFOS);
 
     s->canvas.w = WIDGET_MARGIN * 2
-                + NGLI_MAX(NGLI_MAX(NGLI_MAX(NGLI_MAX(latency_width, memory_width), activity_width), drawcall_width), globalinfos_width);
+                + NGLI_MAX(NGLI_MAX(NGLI_MAX(NGLI_MAX(NGLI_MAX(latency_width, memory_width), activity_width), drawcall_width), gpustats_width), globalinfos_width);
 
     s->canvas.h = WIDGET_MARGIN * NB_WIDGET
                 + get_widget_height(WIDGET_LATENCY)
                 + get_widget_height(WIDGET_MEMORY)
                 + get_widget_height(WIDGET_ACTIVITY)
                 + get_widget_height(WIDGET_DRAWCALL)
+                + get_widget_height(WIDGET_GPUSTATS)
                 + get_widget_height(WIDGET_GLOBALINFOS);
 
     /* Latency widget in the top-left */
@@ -1043,9 +1194,16 @@ static int widgets_init(struct hud *s)
         x_drawcall += x_drawcall_step;
     }
 
+    /* GPU backend counters widget below the draw-calls */
+    const int x_gpustats = WIDGET_MARGIN;
+    const int y_gpustats = WIDGET_MARGIN + y_drawcall + get_widget_height(WIDGET_DRAWCALL);
+    ret = create_widget(s, WIDGET_GPUSTATS, NULL, x_gpustats, y_gpustats);
+    if (ret < 0)
+        return ret;
+
     /* Globalinfos widget in the bottom-left */
     const int x_globalinfos = WIDGET_MARGIN;
-    const int y_globalinfos = WIDGET_MARGIN + y_drawcall + get_widget_height(WIDGET_DRAWCALL);
+    const int y_globalinfos = WIDGET_MARGIN + y_gpustats + get_widget_height(WIDGET_GPUSTATS);
     ret = create_widget(s, WIDGET_GLOBALINFOS, NULL, x_globalinfos, y_globalinfos);
     if (ret < 0)
         return ret;
@@ -211,7 +211,7 @@ static int common_init(struct hwmap *hwmap, struct sxplayer_frame *frame)
             .mipmap_filter = desc->layout == NGLI_IMAGE_LAYOUT_DEFAULT ? params->texture_mipmap_filter : NGLI_MIPMAP_FILTER_NONE,
             .wrap_s        = params->texture_wrap_s,
             .wrap_t        = params->texture_wrap_t,
-            .usage         = params->texture_usage,
+            .usage         = params->texture_usage | NGLI_TEXTURE_USAGE_DYNAMIC_BIT,
         };
 
         common->planes[i] = ngli_texture_create(gpu_ctx);
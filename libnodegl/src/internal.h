@@ -40,6 +40,7 @@
 
 #include "animation.h"
 #include "block.h"
+#include "drawbatch.h"
 #include "drawutils.h"
 #include "graphicstate.h"
 #include "hmap.h"
@@ -50,6 +51,7 @@
 #include "nodegl.h"
 #include "params.h"
 #include "pgcache.h"
+#include "profiler.h"
 #include "program.h"
 #include "pthread_compat.h"
 #include "darray.h"
@@ -57,7 +59,10 @@
 #include "format.h"
 #include "rendertarget.h"
 #include "rnode.h"
+#include "rtpool.h"
+#include "simd.h"
 #include "texture.h"
+#include "updatesched.h"
 
 struct node_class;
 
@@ -67,9 +72,11 @@ struct api_impl {
     int (*configure)(struct ngl_ctx *s, const struct ngl_config *config);
     int (*resize)(struct ngl_ctx *s, int width, int height, const int *viewport);
     int (*set_capture_buffer)(struct ngl_ctx *s, void *capture_buffer);
+    int (*capture_acquire)(struct ngl_ctx *s, double *t);
     int (*set_scene)(struct ngl_ctx *s, struct ngl_node *scene);
     int (*prepare_draw)(struct ngl_ctx *s, double t);
     int (*draw)(struct ngl_ctx *s, double t);
+    int (*draw_async)(struct ngl_ctx *s, double t);
     void (*reset)(struct ngl_ctx *s, int action);
 
     /* OpenGL */
@@ -93,6 +100,9 @@ struct ngl_ctx {
     struct rendertarget *available_rendertargets[2];
     struct rendertarget *current_rendertarget;
     int render_pass_started;
+    int rtt_level; // nesting level of the RenderToTexture being prepared
+    double visit_prefetch_lookahead; // time in which the branch being visited is prefetched ahead of its use, set by the TimeRangeFilter nodes
+    double visit_idle_lookahead; // time in which the branch being visited is kept alive ahead of its use, set by the TimeRangeFilter nodes
     struct darray modelview_matrix_stack;
     struct darray projection_matrix_stack;
 
@@ -104,7 +114,12 @@ struct ngl_ctx {
     struct darray activitycheck_nodes;
 
     struct texture *font_atlas;
+    struct simd_funcs simd;
     struct pgcache pgcache;
+    struct rtpool rtpool;
+    struct drawbatch drawbatch;
+    struct updatesched updatesched;
+    struct profiler profiler;
 #if defined(HAVE_VAAPI)
     struct vaapi_ctx vaapi_ctx;
 #endif
@@ -115,6 +130,7 @@ struct ngl_ctx {
     int64_t cpu_update_time;
     int64_t cpu_draw_time;
     int64_t gpu_draw_time;
+    int gpu_draw_time_latency; /* frames elapsed since the gpu_draw_time measurement, 0 if not updated */
 
     /* Shared fields */
     pthread_mutex_t lock;
@@ -123,6 +139,16 @@ struct ngl_ctx {
     cmd_func_type cmd_func;
     void *cmd_arg;
     int cmd_ret;
+
+    /*
+     * Ring of the draws queued by ngl_draw_async(), executed by the worker
+     * before any command. A queued draw leaves the ring once complete.
+     */
+    double draw_queue[NGL_MAX_DRAW_QUEUE_DEPTH];
+    int draw_queue_depth;
+    int draw_queue_head;
+    int nb_queued_draws;
+    int draw_ret;
 };
 
 #define NGLI_ACTION_KEEP_SCENE  0
@@ -132,9 +158,12 @@ int ngli_ctx_dispatch_cmd(struct ngl_ctx *s, cmd_func_type cmd_func, void *arg);
 int ngli_ctx_configure(struct ngl_ctx *s, const struct ngl_config *config);
 int ngli_ctx_resize(struct ngl_ctx *s, int width, int height, const int *viewport);
 int ngli_ctx_set_capture_buffer(struct ngl_ctx *s, void *capture_buffer);
+int ngli_ctx_capture_acquire(struct ngl_ctx *s, double *t);
 int ngli_ctx_set_scene(struct ngl_ctx *s, struct ngl_node *node);
 int ngli_ctx_prepare_draw(struct ngl_ctx *s, double t);
 int ngli_ctx_draw(struct ngl_ctx *s, double t);
+int ngli_ctx_queue_draw(struct ngl_ctx *s, double t);
+void ngli_ctx_wait_draws(struct ngl_ctx *s);
 void ngli_ctx_reset(struct ngl_ctx *s, int action);
 
 struct ngl_node {
@@ -188,7 +217,7 @@ struct buffer_info {
     struct buffer_layout layout;
 
     uint8_t *data;          // buffer of <count> elements
-    int data_size;          // total buffer data size in bytes
+    size_t data_size;       // total buffer data size in bytes
 
     struct ngl_node *block;
     int usage;              // flags defining buffer use
@@ -199,8 +228,8 @@ struct buffer_info {
 };
 
 void ngli_node_buffer_extend_usage(struct ngl_node *node, int usage);
-int ngli_node_buffer_get_cpu_size(struct ngl_node *node);
-int ngli_node_buffer_get_gpu_size(struct ngl_node *node);
+size_t ngli_node_buffer_get_cpu_size(struct ngl_node *node);
+size_t ngli_node_buffer_get_gpu_size(struct ngl_node *node);
 
 struct livectl {
     union ngl_livectl_data val;
@@ -240,11 +269,13 @@ struct block_info {
     int usage;
 
     struct buffer *buffer;
+    uint64_t uploaded_size; // total number of bytes uploaded to the GPU
 };
 
 void ngli_node_block_extend_usage(struct ngl_node *node, int usage);
 int ngli_node_block_get_cpu_size(struct ngl_node *node);
 int ngli_node_block_get_gpu_size(struct ngl_node *node);
+uint64_t ngli_node_block_get_uploaded_size(struct ngl_node *node);
 
 struct program_opts {
     const char *vertex;
@@ -443,6 +474,16 @@ enum {
  */
 #define NGLI_NODE_FLAG_LIVECTL (1 << 0)
 
+/*
+ * Node update can run on a worker thread (see updatesched.h).
+ *
+ * The update callback of such node must only perform CPU work, write nothing
+ * but its own private data, and must not update anything but its children
+ * (the node is only scheduled asynchronously if all of them are flagged as
+ * well or have no update callback).
+ */
+#define NGLI_NODE_FLAG_UPDATE_ASYNC (1 << 1)
+
 /*
  * Specifications of a node.
  *
@@ -619,6 +660,7 @@ int ngli_node_update_children(struct ngl_node *node, double t);
 void *ngli_node_get_data_ptr(struct ngl_node *var_node, void *data_fallback);
 int ngli_prepare_draw(struct ngl_ctx *s, double t);
 void ngli_node_draw(struct ngl_node *node);
+void ngli_node_draw_profiled(struct ngl_node *node);
 
 int ngli_node_attach_ctx(struct ngl_node *node, struct ngl_ctx *ctx);
 void ngli_node_detach_ctx(struct ngl_node *node, struct ngl_ctx *ctx);
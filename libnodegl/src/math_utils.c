@@ -26,6 +26,11 @@
 #include "math_utils.h"
 #include "utils.h"
 
+/* Scalar reference of the SIMD mix kernels, see simd.c */
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
+
 static const float zvec[4];
 
 #define DECLARE_BASE_VEC_FUNCS(n)                                       \
@@ -230,6 +235,12 @@ void ngli_mat4_mul_vec4_c(float *dst, const float *m, const float *v)
     memcpy(dst, tmp, sizeof(tmp));
 }
 
+void ngli_mix_f32_c(float *dst, const float *a, const float *b, double t, int n)
+{
+    for (int i = 0; i < n; i++)
+        dst[i] = NGLI_MIX(a[i], b[i], t);
+}
+
 void ngli_mat4_look_at(float * restrict dst, float *eye, float *center, float *up)
 {
     float f[3] = NGLI_VEC3_SUB(center, eye);
@@ -107,6 +107,8 @@ void ngli_mat4_translate(float * restrict dst, float x, float y, float z);
 void ngli_mat4_scale(float * restrict dst, float x, float y, float z, const float *anchor);
 void ngli_mat4_skew(float * restrict dst, float x, float y, float z, const float *axis, const float *anchor);
 
+void ngli_mix_f32_c(float *dst, const float *a, const float *b, double t, int n);
+
 /* Arch specific versions */
 
 #ifdef ARCH_AARCH64
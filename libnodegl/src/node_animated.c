@@ -321,6 +321,38 @@ int ngl_anim_evaluate(struct ngl_node *node, void *dst, double t)
     return ngli_animation_evaluate(&s->anim_eval, dst, t);
 }
 
+static int get_nb_components(int node_class)
+{
+    switch (node_class) {
+        case NGL_NODE_ANIMATEDFLOAT: return 1;
+        case NGL_NODE_ANIMATEDVEC2:  return 2;
+        case NGL_NODE_ANIMATEDVEC3:  return 3;
+        case NGL_NODE_ANIMATEDVEC4:
+        case NGL_NODE_ANIMATEDQUAT:  return 4;
+    }
+    return 0;
+}
+
+int ngl_anim_evaluate_batch(struct ngl_node *node, void *dst, const double *times, int nb_times)
+{
+    const int nb_comps = get_nb_components(node->cls->id);
+    if (!nb_comps)
+        return NGL_ERROR_INVALID_ARG;
+
+    /*
+     * Sorted times only hit the cached key frame fast path of the lookup, so
+     * the whole batch is evaluated in linear time.
+     */
+    float *dstp = dst;
+    for (int i = 0; i < nb_times; i++) {
+        int ret = ngl_anim_evaluate(node, dstp, times[i]);
+        if (ret < 0)
+            return ret;
+        dstp += nb_comps;
+    }
+    return 0;
+}
+
 static int animation_init(struct ngl_node *node)
 {
     struct animated_priv *s = node->priv_data;
@@ -427,24 +459,25 @@ static int animatedquat_update(struct ngl_node *node, double t)
     return 0;
 }
 
-#define DEFINE_ANIMATED_CLASS(class_id, class_name, type)       \
-const struct node_class ngli_animated##type##_class = {         \
-    .id        = class_id,                                      \
-    .category  = NGLI_NODE_CATEGORY_VARIABLE,                   \
-    .name      = class_name,                                    \
-    .init      = animated##type##_init,                         \
-    .update    = animated##type##_update,                       \
-    .opts_size = sizeof(struct variable_opts),                  \
-    .priv_size = sizeof(struct animated_priv),                  \
-    .params    = animated##type##_params,                       \
-    .file      = __FILE__,                                      \
+#define DEFINE_ANIMATED_CLASS(class_id, class_name, type, cls_flags) \
+const struct node_class ngli_animated##type##_class = {              \
+    .id        = class_id,                                           \
+    .category  = NGLI_NODE_CATEGORY_VARIABLE,                        \
+    .name      = class_name,                                         \
+    .init      = animated##type##_init,                              \
+    .update    = animated##type##_update,                            \
+    .opts_size = sizeof(struct variable_opts),                       \
+    .priv_size = sizeof(struct animated_priv),                       \
+    .params    = animated##type##_params,                            \
+    .flags     = cls_flags,                                          \
+    .file      = __FILE__,                                           \
 };
 
-DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDTIME,  "AnimatedTime",  time)
-DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDFLOAT, "AnimatedFloat", float)
-DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDVEC2,  "AnimatedVec2",  vec2)
-DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDVEC3,  "AnimatedVec3",  vec3)
-DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDVEC4,  "AnimatedVec4",  vec4)
-DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDQUAT,  "AnimatedQuat",  quat)
-DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDPATH,  "AnimatedPath",  path)
-DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDCOLOR, "AnimatedColor", color)
+DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDTIME,  "AnimatedTime",  time,  NGLI_NODE_FLAG_UPDATE_ASYNC)
+DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDFLOAT, "AnimatedFloat", float, NGLI_NODE_FLAG_UPDATE_ASYNC)
+DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDVEC2,  "AnimatedVec2",  vec2,  NGLI_NODE_FLAG_UPDATE_ASYNC)
+DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDVEC3,  "AnimatedVec3",  vec3,  NGLI_NODE_FLAG_UPDATE_ASYNC)
+DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDVEC4,  "AnimatedVec4",  vec4,  NGLI_NODE_FLAG_UPDATE_ASYNC)
+DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDQUAT,  "AnimatedQuat",  quat,  NGLI_NODE_FLAG_UPDATE_ASYNC)
+DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDPATH,  "AnimatedPath",  path,  0)
+DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDCOLOR, "AnimatedColor", color, NGLI_NODE_FLAG_UPDATE_ASYNC)
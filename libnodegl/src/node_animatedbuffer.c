@@ -20,24 +20,45 @@
  */
 
 #include <float.h>
+#include <limits.h>
 #include <stddef.h>
 #include <string.h>
 #include "animation.h"
+#include "gpu_ctx.h"
 #include "log.h"
 #include "math_utils.h"
 #include "memory.h"
 #include "nodegl.h"
 #include "internal.h"
+#include "pgcraft.h"
+#include "pipeline_compat.h"
 #include "type.h"
 
+#define MIX_WORKGROUP_SIZE 64
+
 struct animatedbuffer_opts {
     struct ngl_node **animkf;
     int nb_animkf;
+    int gpu_interpolation;
 };
 
 struct animatedbuffer_priv {
     struct buffer_info buf;
     struct animation anim;
+    const struct simd_funcs *simd;
+
+    /* GPU interpolation */
+    struct animation gpu_anim;
+    struct buffer *kfs_buffer;
+    struct block kfs_block;
+    struct block dst_block;
+    struct pgcraft *crafter;
+    struct pipeline_compat *pipeline_compat;
+    int ratio_index;
+    int kf_offsets_index;
+    int workgroup_count[3];
+    float ratio;
+    int kf_offsets[2];
 };
 
 NGLI_STATIC_ASSERT(buffer_info_is_first, offsetof(struct animatedbuffer_priv, buf) == 0);
@@ -48,6 +69,9 @@ static const struct node_param animatedbuffer_params[] = {
                   .node_types=(const int[]){NGL_NODE_ANIMKEYFRAMEBUFFER, -1},
                   .flags=NGLI_PARAM_FLAG_DOT_DISPLAY_PACKED,
                   .desc=NGLI_DOCSTRING("key frame buffers to interpolate from")},
+    {"gpu_interpolation", NGLI_PARAM_TYPE_BOOL, OFFSET(gpu_interpolation), {.i32=0},
+                          .desc=NGLI_DOCSTRING("upload all the key frame buffers once and interpolate them on the GPU "
+                                               "with a compute pass; the CPU copy of the data is not updated")},
     {NULL}
 };
 
@@ -56,16 +80,10 @@ static void mix_buffer(void *user_arg, void *dst,
                        const struct animkeyframe_opts *kf1,
                        double ratio)
 {
-    float *dstf = dst;
     const struct animatedbuffer_priv *s = user_arg;
-    const struct buffer_info *info = &s->buf;
-    const float *d0 = (const float *)kf0->data;
-    const float *d1 = (const float *)kf1->data;
-    const struct buffer_layout *layout = &info->layout;
-    const int comp = layout->comp;
-    for (int k = 0; k < layout->count; k++)
-        for (int i = 0; i < comp; i++)
-            dstf[k*comp + i] = NGLI_MIX(d0[k*comp + i], d1[k*comp + i], ratio);
+    const struct buffer_layout *layout = &s->buf.layout;
+    s->simd->mix_f32(dst, (const float *)kf0->data, (const float *)kf1->data,
+                     ratio, layout->count * layout->comp);
 }
 
 static void cpy_buffer(void *user_arg, void *dst,
@@ -76,10 +94,56 @@ static void cpy_buffer(void *user_arg, void *dst,
     memcpy(dst, kf->data, info->data_size);
 }
 
+/*
+ * The GPU variants of the animation callbacks only record which key frames
+ * are blended and with which ratio, the actual mix is done by the compute
+ * pass reading from the key frames buffer.
+ */
+static void mix_buffer_gpu(void *user_arg, void *dst,
+                           const struct animkeyframe_opts *kf0,
+                           const struct animkeyframe_opts *kf1,
+                           double ratio)
+{
+    struct animatedbuffer_priv *s = user_arg;
+    const int count = s->buf.layout.count * s->buf.layout.comp;
+    s->ratio = ratio;
+    s->kf_offsets[0] = s->gpu_anim.current_kf * count;
+    s->kf_offsets[1] = s->kf_offsets[0] + count;
+}
+
+static void cpy_buffer_gpu(void *user_arg, void *dst,
+                           const struct animkeyframe_opts *kf)
+{
+    struct animatedbuffer_priv *s = user_arg;
+    const struct animation *anim = &s->gpu_anim;
+    const int count = s->buf.layout.count * s->buf.layout.comp;
+    const int kf_index = kf == anim->kfs[0]->opts ? 0 : anim->nb_kfs - 1;
+    s->ratio = 0.f;
+    s->kf_offsets[0] = kf_index * count;
+    s->kf_offsets[1] = s->kf_offsets[0];
+}
+
+static int update_gpu(struct ngl_node *node, double t)
+{
+    struct animatedbuffer_priv *s = node->priv_data;
+    int ret = ngli_animation_evaluate(&s->gpu_anim, NULL, t);
+    if (ret < 0)
+        return ret;
+
+    ngli_pipeline_compat_update_uniform(s->pipeline_compat, s->ratio_index, &s->ratio);
+    ngli_pipeline_compat_update_uniform(s->pipeline_compat, s->kf_offsets_index, s->kf_offsets);
+    ngli_pipeline_compat_dispatch(s->pipeline_compat, NGLI_ARG_VEC3(s->workgroup_count));
+    return 0;
+}
+
 static int animatedbuffer_update(struct ngl_node *node, double t)
 {
     struct animatedbuffer_priv *s = node->priv_data;
     struct buffer_info *info = &s->buf;
+
+    if (s->pipeline_compat)
+        return update_gpu(node, t);
+
     int ret = ngli_animation_evaluate(&s->anim, info->data, t);
     if (ret < 0)
         return ret;
@@ -97,6 +161,8 @@ static int animatedbuffer_init(struct ngl_node *node)
     struct buffer_info *info = &s->buf;
     struct buffer_layout *layout = &info->layout;
 
+    s->simd = &node->ctx->simd;
+
     info->flags |= NGLI_BUFFER_INFO_FLAG_DYNAMIC;
     info->usage = NGLI_BUFFER_USAGE_DYNAMIC_BIT | NGLI_BUFFER_USAGE_TRANSFER_DST_BIT;
     layout->comp = ngli_format_get_nb_comp(layout->format);
@@ -108,6 +174,15 @@ static int animatedbuffer_init(struct ngl_node *node)
     if (ret < 0)
         return ret;
 
+    if (o->gpu_interpolation) {
+        ret = ngli_animation_init(&s->gpu_anim, s,
+                                  o->animkf, o->nb_animkf,
+                                  mix_buffer_gpu, cpy_buffer_gpu);
+        if (ret < 0)
+            return ret;
+        info->usage |= NGLI_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    }
+
     for (int i = 0; i < o->nb_animkf; i++) {
         const struct animkeyframe_opts *kf = o->animkf[i]->opts;
         const int data_count = kf->data_size / layout->stride;
@@ -133,7 +208,7 @@ static int animatedbuffer_init(struct ngl_node *node)
     info->data = ngli_calloc(layout->count, layout->stride);
     if (!info->data)
         return NGL_ERROR_MEMORY;
-    info->data_size = layout->count * layout->stride;
+    info->data_size = (size_t)layout->count * layout->stride;
 
     info->buffer = ngli_buffer_create(node->ctx->gpu_ctx);
     if (!info->buffer)
@@ -142,9 +217,165 @@ static int animatedbuffer_init(struct ngl_node *node)
     return 0;
 }
 
+static const char * const mix_comp =
+    "void main()"                                                                           "\n"
+    "{"                                                                                     "\n"
+    "    uint i = gl_GlobalInvocationID.y * gl_NumWorkGroups.x * gl_WorkGroupSize.x"       "\n"
+    "           + gl_GlobalInvocationID.x;"                                                 "\n"
+    "    if (i >= uint(dst.data.length()))"                                                 "\n"
+    "        return;"                                                                       "\n"
+    "    float v0 = kfs.data[uint(kf_offsets.x) + i];"                                      "\n"
+    "    float v1 = kfs.data[uint(kf_offsets.y) + i];"                                      "\n"
+    "    dst.data[i] = mix(v0, v1, ratio);"                                                 "\n"
+    "}"                                                                                     "\n";
+
+static int can_interpolate_on_gpu(struct ngl_node *node, int nb_groups)
+{
+    struct gpu_ctx *gpu_ctx = node->ctx->gpu_ctx;
+    const struct gpu_limits *limits = &gpu_ctx->limits;
+    const struct animatedbuffer_priv *s = node->priv_data;
+    const struct animatedbuffer_opts *o = node->opts;
+
+    if (!(gpu_ctx->features & NGLI_FEATURE_COMPUTE)) {
+        LOG(WARNING, "compute is not supported, %s will be interpolated on the CPU", node->label);
+        return 0;
+    }
+
+    const int64_t max_groups = (int64_t)limits->max_compute_work_group_count[0] *
+                                        limits->max_compute_work_group_count[1];
+    if (limits->max_compute_work_group_size[0] < MIX_WORKGROUP_SIZE || nb_groups > max_groups ||
+        (int64_t)o->nb_animkf * s->buf.data_size > INT_MAX) {
+        LOG(WARNING, "%s exceeds the compute limits, it will be interpolated on the CPU", node->label);
+        return 0;
+    }
+
+    /* All the key frames are bound as a single storage block */
+    if ((uint64_t)o->nb_animkf * s->buf.data_size > limits->max_storage_block_size) {
+        LOG(WARNING, "%s key frames exceed the maximum storage block size (%u), it will be interpolated on the CPU",
+            node->label, limits->max_storage_block_size);
+        return 0;
+    }
+
+    return 1;
+}
+
+static int init_gpu_interpolation(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct gpu_ctx *gpu_ctx = ctx->gpu_ctx;
+    struct animatedbuffer_priv *s = node->priv_data;
+    const struct animatedbuffer_opts *o = node->opts;
+    struct buffer_info *info = &s->buf;
+
+    const int count = info->layout.count * info->layout.comp;
+    const int nb_groups = (count + MIX_WORKGROUP_SIZE - 1) / MIX_WORKGROUP_SIZE;
+    if (!can_interpolate_on_gpu(node, nb_groups))
+        return 0;
+
+    const int max_groups_x = gpu_ctx->limits.max_compute_work_group_count[0];
+    s->workgroup_count[0] = NGLI_MIN(nb_groups, max_groups_x);
+    s->workgroup_count[1] = (nb_groups + max_groups_x - 1) / max_groups_x;
+    s->workgroup_count[2] = 1;
+
+    /* All the key frames are uploaded once, back to back */
+    s->kfs_buffer = ngli_buffer_create(gpu_ctx);
+    if (!s->kfs_buffer)
+        return NGL_ERROR_MEMORY;
+
+    int ret = ngli_buffer_init(s->kfs_buffer, o->nb_animkf * info->data_size,
+                               NGLI_BUFFER_USAGE_STORAGE_BUFFER_BIT | NGLI_BUFFER_USAGE_TRANSFER_DST_BIT);
+    if (ret < 0)
+        return ret;
+
+    for (int i = 0; i < o->nb_animkf; i++) {
+        const struct animkeyframe_opts *kf = o->animkf[i]->opts;
+        ret = ngli_buffer_upload(s->kfs_buffer, kf->data, info->data_size, i * info->data_size);
+        if (ret < 0)
+            return ret;
+    }
+
+    ngli_block_init(&s->kfs_block, NGLI_BLOCK_LAYOUT_STD430);
+    ngli_block_init(&s->dst_block, NGLI_BLOCK_LAYOUT_STD430);
+    if ((ret = ngli_block_add_field(&s->kfs_block, "data", NGLI_TYPE_FLOAT, o->nb_animkf * count)) < 0 ||
+        (ret = ngli_block_add_field(&s->dst_block, "data", NGLI_TYPE_FLOAT, count)) < 0)
+        return ret;
+
+    const struct pgcraft_uniform uniforms[] = {
+        {.name = "ratio",      .type = NGLI_TYPE_FLOAT, .stage = NGLI_PROGRAM_SHADER_COMP, .precision = NGLI_PRECISION_HIGH},
+        {.name = "kf_offsets", .type = NGLI_TYPE_IVEC2, .stage = NGLI_PROGRAM_SHADER_COMP, .precision = NGLI_PRECISION_HIGH},
+    };
+
+    const struct pgcraft_block blocks[] = {
+        {
+            .name     = "kfs",
+            .type     = NGLI_TYPE_STORAGE_BUFFER,
+            .stage    = NGLI_PROGRAM_SHADER_COMP,
+            .block    = &s->kfs_block,
+            .buffer   = s->kfs_buffer,
+        }, {
+            .name     = "dst",
+            .type     = NGLI_TYPE_STORAGE_BUFFER,
+            .stage    = NGLI_PROGRAM_SHADER_COMP,
+            .writable = 1,
+            .block    = &s->dst_block,
+            .buffer   = info->buffer,
+        },
+    };
+
+    const struct pgcraft_params crafter_params = {
+        .program_label  = "nodegl/animatedbuffer",
+        .comp_base      = mix_comp,
+        .uniforms       = uniforms,
+        .nb_uniforms    = NGLI_ARRAY_NB(uniforms),
+        .blocks         = blocks,
+        .nb_blocks      = NGLI_ARRAY_NB(blocks),
+        .workgroup_size = {MIX_WORKGROUP_SIZE, 1, 1},
+    };
+
+    s->crafter = ngli_pgcraft_create(ctx);
+    if (!s->crafter)
+        return NGL_ERROR_MEMORY;
+
+    ret = ngli_pgcraft_craft(s->crafter, &crafter_params);
+    if (ret < 0)
+        return ret;
+
+    s->ratio_index = ngli_pgcraft_get_uniform_index(s->crafter, "ratio", NGLI_PROGRAM_SHADER_COMP);
+    s->kf_offsets_index = ngli_pgcraft_get_uniform_index(s->crafter, "kf_offsets", NGLI_PROGRAM_SHADER_COMP);
+
+    struct pipeline_compat *pipeline_compat = ngli_pipeline_compat_create(gpu_ctx);
+    if (!pipeline_compat)
+        return NGL_ERROR_MEMORY;
+
+    const struct pipeline_params pipeline_params = {
+        .type    = NGLI_PIPELINE_TYPE_COMPUTE,
+        .program = ngli_pgcraft_get_program(s->crafter),
+        .layout  = ngli_pgcraft_get_pipeline_layout(s->crafter),
+    };
+
+    const struct pipeline_resources pipeline_resources = ngli_pgcraft_get_pipeline_resources(s->crafter);
+    const struct pgcraft_compat_info *compat_info = ngli_pgcraft_get_compat_info(s->crafter);
+
+    const struct pipeline_compat_params params = {
+        .params      = &pipeline_params,
+        .resources   = &pipeline_resources,
+        .compat_info = compat_info,
+    };
+
+    ret = ngli_pipeline_compat_init(pipeline_compat, &params);
+    if (ret < 0) {
+        ngli_pipeline_compat_freep(&pipeline_compat);
+        return ret;
+    }
+
+    s->pipeline_compat = pipeline_compat;
+    return 0;
+}
+
 static int animatedbuffer_prepare(struct ngl_node *node)
 {
     struct animatedbuffer_priv *s = node->priv_data;
+    const struct animatedbuffer_opts *o = node->opts;
     struct buffer_info *info = &s->buf;
 
     if (!(info->flags & NGLI_BUFFER_INFO_FLAG_GPU_UPLOAD))
@@ -157,6 +388,12 @@ static int animatedbuffer_prepare(struct ngl_node *node)
     if (ret < 0)
         return ret;
 
+    if (o->gpu_interpolation) {
+        ret = init_gpu_interpolation(node);
+        if (ret < 0)
+            return ret;
+    }
+
     return ngli_node_prepare_children(node);
 }
 
@@ -165,6 +402,11 @@ static void animatedbuffer_uninit(struct ngl_node *node)
     struct animatedbuffer_priv *s = node->priv_data;
     struct buffer_info *info = &s->buf;
 
+    ngli_pipeline_compat_freep(&s->pipeline_compat);
+    ngli_pgcraft_freep(&s->crafter);
+    ngli_block_reset(&s->kfs_block);
+    ngli_block_reset(&s->dst_block);
+    ngli_buffer_freep(&s->kfs_buffer);
     ngli_buffer_freep(&info->buffer);
     ngli_freep(&info->data);
 }
@@ -106,9 +106,15 @@ static const struct param_choices layout_choices = {
                                        NGL_NODE_TIME,                   \
                                        -1}
 
+struct upload_range {
+    int start;
+    int end;
+};
+
 struct block_priv {
     struct block_info blk;
     int force_update;
+    struct darray upload_ranges; // upload_range
 };
 
 struct block_opts {
@@ -148,6 +154,12 @@ int ngli_node_block_get_gpu_size(struct ngl_node *node)
     return s->data_size;
 }
 
+uint64_t ngli_node_block_get_uploaded_size(struct ngl_node *node)
+{
+    struct block_info *s = node->priv_data;
+    return s->uploaded_size;
+}
+
 static int get_node_data_type(const struct ngl_node *node)
 {
     if (node->cls->category == NGLI_NODE_CATEGORY_VARIABLE) {
@@ -207,23 +219,60 @@ static const uint8_t *get_data_ptr(const struct ngl_node *node, const struct blo
     return fi->count ? get_buffer_data_ptr(node) : get_variable_data_ptr(node);
 }
 
+/*
+ * Changed byte ranges separated by less than this gap are merged into a single
+ * upload: re-sending a few unchanged bytes is cheaper than an extra transfer.
+ */
+#define UPLOAD_MERGE_GAP 256
+
+static int add_upload_range(void *user_arg, int start, int end)
+{
+    struct darray *ranges = user_arg;
+    struct upload_range *last = ngli_darray_tail(ranges);
+    if (last && start - last->end <= UPLOAD_MERGE_GAP) {
+        last->end = NGLI_MAX(last->end, end);
+        return 0;
+    }
+    const struct upload_range range = {.start = start, .end = end};
+    if (!ngli_darray_push(ranges, &range))
+        return NGL_ERROR_MEMORY;
+    return 0;
+}
+
 static int update_block_data(struct ngl_node *node, int forced)
 {
-    int has_changed = 0;
     struct block_priv *s = node->priv_data;
     struct block_info *info = &s->blk;
     const struct block_opts *o = node->opts;
     const struct block_field *field_info = ngli_darray_data(&info->block.fields);
+
+    ngli_darray_clear(&s->upload_ranges);
+
+    if (forced) {
+        for (int i = 0; i < o->nb_fields; i++) {
+            const struct block_field *fi = &field_info[i];
+            const uint8_t *src = get_data_ptr(o->fields[i], fi);
+            ngli_block_field_copy(fi, info->data + fi->offset, src);
+        }
+        return add_upload_range(&s->upload_ranges, 0, info->data_size);
+    }
+
+    /*
+     * The block data always reflects the last uploaded content, so only the
+     * bytes differing from it need to be transferred. The fields are sorted
+     * by offset, which keeps the ranges ordered and makes merging trivial.
+     */
     for (int i = 0; i < o->nb_fields; i++) {
         const struct ngl_node *field_node = o->fields[i];
         const struct block_field *fi = &field_info[i];
-        if (!forced && !field_is_dynamic(field_node, fi))
+        if (!field_is_dynamic(field_node, fi))
             continue;
         const uint8_t *src = get_data_ptr(field_node, fi);
-        ngli_block_field_copy(fi, info->data + fi->offset, src);
-        has_changed = 1; // TODO: only re-upload the changing data segments
+        int ret = ngli_block_field_update(fi, info->data, src, add_upload_range, &s->upload_ranges);
+        if (ret < 0)
+            return ret;
     }
-    return has_changed;
+    return 0;
 }
 
 static int cmp_str(const void *a, const void *b)
@@ -289,6 +338,7 @@ static int block_init(struct ngl_node *node)
         return ret;
 
     ngli_block_init(&info->block, o->layout);
+    ngli_darray_init(&s->upload_ranges, sizeof(struct upload_range), 0);
 
     info->usage = NGLI_BUFFER_USAGE_TRANSFER_DST_BIT;
 
@@ -325,7 +375,9 @@ static int block_init(struct ngl_node *node)
     if (!info->data)
         return NGL_ERROR_MEMORY;
 
-    update_block_data(node, 1);
+    ret = update_block_data(node, 1);
+    if (ret < 0)
+        return ret;
     s->force_update = 1; /* First update will need an upload */
 
     info->buffer = ngli_buffer_create(gpu_ctx);
@@ -370,13 +422,19 @@ static int block_update(struct ngl_node *node, double t)
     if (ret < 0)
         return ret;
 
-    const int has_changed = update_block_data(node, s->force_update);
+    ret = update_block_data(node, s->force_update);
+    if (ret < 0)
+        return ret;
     s->force_update = 0;
 
-    if (has_changed) {
-        ret = ngli_buffer_upload(info->buffer, info->data, info->data_size, 0);
+    const struct upload_range *ranges = ngli_darray_data(&s->upload_ranges);
+    for (int i = 0; i < ngli_darray_count(&s->upload_ranges); i++) {
+        const struct upload_range *range = &ranges[i];
+        const int size = range->end - range->start;
+        ret = ngli_buffer_upload(info->buffer, info->data + range->start, size, range->start);
         if (ret < 0)
             return ret;
+        info->uploaded_size += size;
     }
 
     return 0;
@@ -389,6 +447,7 @@ static void block_uninit(struct ngl_node *node)
 
     ngli_buffer_freep(&info->buffer);
     ngli_block_reset(&info->block);
+    ngli_darray_reset(&s->upload_ranges);
     ngli_free(info->data);
 }
 
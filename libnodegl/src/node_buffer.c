@@ -19,15 +19,13 @@
  * under the License.
  */
 
-#include <inttypes.h>
 #include <limits.h>
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
-#include <sys/types.h>
-#include <sys/stat.h>
 
 #include "buffer.h"
+#include "filemap.h"
 #include "log.h"
 #include "memory.h"
 #include "nodegl.h"
@@ -46,7 +44,7 @@ struct buffer_opts {
 
 struct buffer_priv {
     struct buffer_info buf;
-    FILE *fp;
+    struct filemap filemap;
 };
 
 NGLI_STATIC_ASSERT(buffer_info_is_first, offsetof(struct buffer_priv, buf) == 0);
@@ -78,13 +76,13 @@ void ngli_node_buffer_extend_usage(struct ngl_node *node, int usage)
     s->usage |= usage;
 }
 
-int ngli_node_buffer_get_cpu_size(struct ngl_node *node)
+size_t ngli_node_buffer_get_cpu_size(struct ngl_node *node)
 {
     struct buffer_info *s = node->priv_data;
     return s->block ? 0 : s->data_size;
 }
 
-int ngli_node_buffer_get_gpu_size(struct ngl_node *node)
+size_t ngli_node_buffer_get_gpu_size(struct ngl_node *node)
 {
     struct buffer_info *s = node->priv_data;
     return s->block || !(s->flags & NGLI_BUFFER_INFO_FLAG_GPU_UPLOAD) ? 0 : s->data_size;
@@ -117,49 +115,37 @@ static int buffer_init_from_filename(struct ngl_node *node)
     const struct buffer_opts *o = node->opts;
     struct buffer_layout *layout = &s->buf.layout;
 
-    int64_t size;
-    int ret = ngli_get_filesize(o->filename, &size);
+    /*
+     * The file is mapped read-only instead of being read into a heap copy:
+     * the pages are faulted in while the data is uploaded to the GPU, and
+     * can be reclaimed by the system at any time since they remain backed
+     * by the file.
+     */
+    int ret = ngli_filemap_init(&s->filemap, o->filename);
     if (ret < 0)
         return ret;
 
-    if (size > INT_MAX) {
-        LOG(ERROR, "'%s' size (%" PRId64 ") exceeds supported limit (%d)", o->filename, size, INT_MAX);
-        return NGL_ERROR_UNSUPPORTED;
+    const size_t size = s->filemap.size;
+    if (!layout->count) {
+        if (size / layout->stride > INT_MAX) {
+            LOG(ERROR, "'%s' element count (%zu) exceeds supported limit (%d)",
+                o->filename, size / layout->stride, INT_MAX);
+            return NGL_ERROR_UNSUPPORTED;
+        }
+        layout->count = (int)(size / layout->stride);
     }
 
-    s->buf.data_size = size;
-    layout->count = layout->count ? layout->count : s->buf.data_size / layout->stride;
-
-    if (s->buf.data_size != layout->count * layout->stride) {
+    if (size != (size_t)layout->count * layout->stride) {
         LOG(ERROR,
-            "element count (%d) and data stride (%d) does not match data size (%d)",
+            "element count (%d) and data stride (%d) does not match data size (%zu)",
             layout->count,
             layout->stride,
-            s->buf.data_size);
+            size);
         return NGL_ERROR_INVALID_DATA;
     }
 
-    s->buf.data = ngli_calloc(layout->count, layout->stride);
-    if (!s->buf.data)
-        return NGL_ERROR_MEMORY;
-
-    s->fp = fopen(o->filename, "rb");
-    if (!s->fp) {
-        LOG(ERROR, "could not open '%s'", o->filename);
-        return NGL_ERROR_IO;
-    }
-
-    size_t n = fread(s->buf.data, 1, s->buf.data_size, s->fp);
-    if (n != s->buf.data_size) {
-        LOG(ERROR, "could not read '%s'", o->filename);
-        return NGL_ERROR_IO;
-    }
-
-    if (n != s->buf.data_size) {
-        LOG(ERROR, "read %zd bytes does not match expected size of %d bytes", n, s->buf.data_size);
-        return NGL_ERROR_IO;
-    }
-
+    s->buf.data      = (uint8_t *)s->filemap.data;
+    s->buf.data_size = size;
     return 0;
 }
 
@@ -169,7 +155,7 @@ static int buffer_init_from_count(struct ngl_node *node)
     struct buffer_layout *layout = &s->buf.layout;
 
     layout->count = layout->count ? layout->count : 1;
-    s->buf.data_size = layout->count * layout->stride;
+    s->buf.data_size = (size_t)layout->count * layout->stride;
     s->buf.data = ngli_calloc(layout->count, layout->stride);
     if (!s->buf.data)
         return NGL_ERROR_MEMORY;
@@ -223,7 +209,7 @@ static int buffer_init_from_block(struct ngl_node *node)
     s->buf.data = block_info->data + fi->offset;
     layout->stride = fi->stride;
     layout->offset = fi->offset;
-    s->buf.data_size = layout->count * layout->stride;
+    s->buf.data_size = (size_t)layout->count * layout->stride;
 
     return 0;
 }
@@ -324,18 +310,12 @@ static void buffer_uninit(struct ngl_node *node)
     else
         ngli_buffer_freep(&s->buf.buffer);
 
-    if (!o->data && !o->block)
-        ngli_freep(&s->buf.data);
-
     if (o->filename) {
+        ngli_filemap_reset(&s->filemap);
+        s->buf.data = NULL;
         s->buf.data_size = 0;
-
-        if (s->fp) {
-            int ret = fclose(s->fp);
-            if (ret < 0) {
-                LOG(ERROR, "could not properly close '%s'", o->filename);
-            }
-        }
+    } else if (!o->data && !o->block) {
+        ngli_freep(&s->buf.data);
     }
 }
 
@@ -360,6 +340,7 @@ const struct node_class ngli_buffer##type_name##_class = {      \
     .priv_size = sizeof(struct buffer_priv),                    \
     .params    = buffer_params,                                 \
     .params_id = "Buffer",                                      \
+    .flags     = NGLI_NODE_FLAG_UPDATE_ASYNC,                   \
     .file      = __FILE__,                                      \
 };
 
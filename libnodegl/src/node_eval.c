@@ -39,7 +39,7 @@ struct eval_priv {
     float vector[4];
     int nb_expr;
     struct hmap *vars;
-    struct eval *eval[4];
+    struct eval *eval;
 };
 
 #define INPUT_TYPES_LIST    (const int[]){NGL_NODE_NOISEFLOAT,      \
@@ -128,18 +128,10 @@ static int eval_init(struct ngl_node *node)
         }
     }
 
-    for (int i = 0; i < s->nb_expr; i++) {
-        if (!o->expr[i])
-            continue;
-        s->eval[i] = ngli_eval_create();
-        if (!s->eval[i])
-            return NGL_ERROR_MEMORY;
-        int ret = ngli_eval_init(s->eval[i], o->expr[i], s->vars);
-        if (ret < 0)
-            return ret;
-    }
-
-    return 0;
+    s->eval = ngli_eval_create();
+    if (!s->eval)
+        return NGL_ERROR_MEMORY;
+    return ngli_eval_init_multi(s->eval, (const char * const *)o->expr, s->nb_expr, s->vars);
 }
 
 static int eval_update(struct ngl_node *node, double t)
@@ -156,25 +148,14 @@ static int eval_update(struct ngl_node *node, double t)
         }
     }
 
-    for (int i = 0; i < s->nb_expr; i++) {
-        if (!s->eval[i]) {
-            s->vector[i] = s->vector[i - 1];
-            continue;
-        }
-        int ret = ngli_eval_run(s->eval[i], &s->vector[i]);
-        if (ret < 0)
-            return ret;
-    }
-
-    return 0;
+    return ngli_eval_run(s->eval, s->vector);
 }
 
 static void eval_uninit(struct ngl_node *node)
 {
     struct eval_priv *s = node->priv_data;
 
-    for (int i = 0; i < s->nb_expr; i++)
-        ngli_eval_freep(&s->eval[i]);
+    ngli_eval_freep(&s->eval);
     ngli_hmap_freep(&s->vars);
 }
 
@@ -200,6 +181,7 @@ const struct node_class ngli_eval##type##_class = {                 \
     .opts_size = sizeof(struct eval_opts),                          \
     .priv_size = sizeof(struct eval_priv),                          \
     .params    = eval_##type##_params,                              \
+    .flags     = NGLI_NODE_FLAG_UPDATE_ASYNC,                       \
     .file      = __FILE__,                                          \
 };
 
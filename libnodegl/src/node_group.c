@@ -28,12 +28,17 @@
 struct group_opts {
     struct ngl_node **children;
     int nb_children;
+    int sort_draws;
 };
 
 #define OFFSET(x) offsetof(struct group_opts, x)
 static const struct node_param group_params[] = {
     {"children", NGLI_PARAM_TYPE_NODELIST, OFFSET(children),
                  .desc=NGLI_DOCSTRING("a set of scenes")},
+    {"sort_draws", NGLI_PARAM_TYPE_BOOL, OFFSET(sort_draws), {.i32=0},
+                   .desc=NGLI_DOCSTRING("submit the draws of the children sorted by program and texture instead of "
+                                        "following their declaration order; only suitable when the rendering does "
+                                        "not depend on the order, such as opaque geometries with depth testing")},
     {NULL}
 };
 
@@ -66,6 +71,16 @@ static void group_draw(struct ngl_node *node)
     struct ngl_ctx *ctx = node->ctx;
     const struct group_opts *o = node->opts;
 
+    /*
+     * When already recording (nested sorted groups), the draws of the
+     * children are sorted along with the ones of the recording group
+     */
+    struct drawbatch *drawbatch = &ctx->drawbatch;
+    const int record = o->sort_draws && !drawbatch->recording;
+    const int start = ngli_darray_count(&drawbatch->packets);
+    if (record)
+        drawbatch->recording = 1;
+
     struct rnode *rnode_pos = ctx->rnode_pos;
     struct rnode *rnodes = ngli_darray_data(&rnode_pos->children);
     for (int i = 0; i < o->nb_children; i++) {
@@ -74,6 +89,11 @@ static void group_draw(struct ngl_node *node)
         ngli_node_draw(child);
     }
     ctx->rnode_pos = rnode_pos;
+
+    if (record) {
+        drawbatch->recording = 0;
+        ngli_drawbatch_flush(drawbatch, start);
+    }
 }
 
 const struct node_class ngli_group_class = {
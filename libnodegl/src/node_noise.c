@@ -35,7 +35,9 @@ struct noise_opts {
 struct noise_priv {
     struct variable_info var;
     float vector[4];
-    struct noise generator[4];
+    struct noise_params generator_params;
+    uint32_t seeds[4];
+    const struct simd_funcs *simd;
 };
 
 const struct param_choices noise_func_choices = {
@@ -80,8 +82,8 @@ static int noisevec_update(struct ngl_node *node, double t, int n)
     struct noise_priv *s = node->priv_data;
     const struct noise_opts *o = node->opts;
     const float v = t * o->frequency;
-    for (int i = 0; i < n; i++)
-        s->vector[i] = ngli_noise_get(&s->generator[i], v);
+    const float times[4] = {v, v, v, v};
+    s->simd->noise_fbm_f32(s->vector, times, s->seeds, n, &s->generator_params);
     return 0;
 }
 
@@ -110,18 +112,16 @@ static int init_noise_generators(struct noise_priv *s, const struct noise_opts *
     /*
      * Every generator is instanciated the same, except for the seed: the seed
      * offset is defined to create a large gap between every components to keep
-     * the overlap to the minimum possible
+     * the overlap to the minimum possible. All the components are evaluated
+     * at once by the batch noise function.
      */
     const uint32_t seed_offset = UINT32_MAX / n;
     uint32_t seed = o->generator_params.seed;
     for (int i = 0; i < n; i++) {
-        struct noise_params np = o->generator_params;
-        np.seed = seed;
-        int ret = ngli_noise_init(&s->generator[i], &np);
-        if (ret < 0)
-            return ret;
+        s->seeds[i] = seed;
         seed += seed_offset;
     }
+    s->generator_params = o->generator_params;
     return 0;
 }
 
@@ -130,6 +130,7 @@ static int noise##type##_init(struct ngl_node *node)                        \
 {                                                                           \
     struct noise_priv *s = node->priv_data;                                 \
     const struct noise_opts *o = node->opts;                                \
+    s->simd = &node->ctx->simd;                                             \
     s->var.data = s->vector;                                                \
     s->var.data_size = count * sizeof(float);                               \
     s->var.data_type = dtype;                                               \
@@ -147,6 +148,7 @@ const struct node_class ngli_noise##type##_class = {                        \
     .priv_size = sizeof(struct noise_priv),                                 \
     .params    = noise_params,                                              \
     .params_id = "Noise",                                                   \
+    .flags     = NGLI_NODE_FLAG_UPDATE_ASYNC,                               \
     .file      = __FILE__,                                                  \
 };
 
@@ -215,7 +215,10 @@ static void render_uninit(struct ngl_node *node)
 
 static void render_draw(struct ngl_node *node)
 {
+    struct ngl_ctx *ctx = node->ctx;
     struct render_priv *s = node->priv_data;
+    if (ngli_drawbatch_record(&ctx->drawbatch, node, ngli_pass_get_pipeline_compat(&s->pass)))
+        return;
     ngli_pass_exec(&s->pass);
 }
 
@@ -786,6 +786,9 @@ static void renderother_draw(struct ngl_node *node, struct render_common *s, con
     struct pipeline_desc *desc = &descs[ctx->rnode_pos->id];
     struct pipeline_compat *pl_compat = desc->pipeline_compat;
 
+    if (ngli_drawbatch_record(&ctx->drawbatch, node, pl_compat))
+        return;
+
     const float *modelview_matrix  = ngli_darray_tail(&ctx->modelview_matrix_stack);
     const float *projection_matrix = ngli_darray_tail(&ctx->projection_matrix_stack);
 
@@ -48,6 +48,7 @@ struct rtt_opts {
 
 struct rtt_priv {
     struct renderpass_info renderpass_info;
+    int level;
     int width;
     int height;
 
@@ -223,7 +224,34 @@ static int rtt_prepare(struct ngl_node *node)
     }
     rnode->rendertarget_desc = desc;
 
-    return ngli_node_prepare_children(node);
+    /*
+     * The nesting level is the deepest one this node is reached at, so that
+     * it is always strictly greater than the level of any RenderToTexture
+     * which may be drawing while this one is
+     */
+    s->level = NGLI_MAX(s->level, ctx->rtt_level);
+
+    ctx->rtt_level++;
+    int ret = ngli_node_prepare_children(node);
+    ctx->rtt_level--;
+
+    return ret;
+}
+
+/*
+ * Transient attachments are shared between the RenderToTexture of the same
+ * nesting level, so their slot in the pool is defined by the level and the
+ * attachment index (the depth attachment being the last one)
+ */
+#define DEPTH_ATTACHMENT_INDEX NGLI_MAX_COLOR_ATTACHMENTS
+
+static int acquire_attachment(struct ngl_node *node, const struct texture_params *params,
+                              int index, struct texture **texturep)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    const struct rtt_priv *s = node->priv_data;
+    const int slot = s->level * (NGLI_MAX_COLOR_ATTACHMENTS + 1) + index;
+    return ngli_rtpool_acquire(&ctx->rtpool, params, slot, texturep);
 }
 
 static int rtt_prefetch(struct ngl_node *node)
@@ -298,11 +326,7 @@ static int rtt_prefetch(struct ngl_node *node)
         const int layer_end = info.layer_base + info.layer_count;
         for (int j = info.layer_base; j < layer_end; j++) {
             if (o->samples) {
-                struct texture *ms_texture = ngli_texture_create(gpu_ctx);
-                if (!ms_texture)
-                    return NGL_ERROR_MEMORY;
-                s->ms_colors[s->nb_ms_colors++] = ms_texture;
-                struct texture_params attachment_params = {
+                const struct texture_params attachment_params = {
                     .type    = NGLI_TEXTURE_TYPE_2D,
                     .format  = params->format,
                     .width   = s->width,
@@ -310,9 +334,10 @@ static int rtt_prefetch(struct ngl_node *node)
                     .samples = o->samples,
                     .usage   = NGLI_TEXTURE_USAGE_COLOR_ATTACHMENT_BIT | transient_usage,
                 };
-                ret = ngli_texture_init(ms_texture, &attachment_params);
+                ret = acquire_attachment(node, &attachment_params, s->nb_ms_colors, &s->ms_colors[s->nb_ms_colors]);
                 if (ret < 0)
                     return ret;
+                struct texture *ms_texture = s->ms_colors[s->nb_ms_colors++];
                 rt_params.colors[rt_params.nb_colors].attachment = ms_texture;
                 rt_params.colors[rt_params.nb_colors].attachment_layer = 0;
                 rt_params.colors[rt_params.nb_colors].resolve_target = texture;
@@ -342,11 +367,7 @@ static int rtt_prefetch(struct ngl_node *node)
         struct texture_params *params = &texture->params;
 
         if (o->samples) {
-            struct texture *ms_texture = ngli_texture_create(gpu_ctx);
-            if (!ms_texture)
-                return NGL_ERROR_MEMORY;
-            s->ms_depth = ms_texture;
-            struct texture_params attachment_params = {
+            const struct texture_params attachment_params = {
                 .type    = NGLI_TEXTURE_TYPE_2D,
                 .format  = params->format,
                 .width   = s->width,
@@ -354,10 +375,10 @@ static int rtt_prefetch(struct ngl_node *node)
                 .samples = o->samples,
                 .usage   = NGLI_TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | transient_usage,
             };
-            ret = ngli_texture_init(ms_texture, &attachment_params);
+            ret = acquire_attachment(node, &attachment_params, DEPTH_ATTACHMENT_INDEX, &s->ms_depth);
             if (ret < 0)
                 return ret;
-            rt_params.depth_stencil.attachment = ms_texture;
+            rt_params.depth_stencil.attachment = s->ms_depth;
             rt_params.depth_stencil.attachment_layer = 0;
             rt_params.depth_stencil.resolve_target = texture;
             rt_params.depth_stencil.resolve_target_layer = info.layer_base;
@@ -377,11 +398,7 @@ static int rtt_prefetch(struct ngl_node *node)
             depth_format = ngli_gpu_ctx_get_preferred_depth_format(gpu_ctx);
 
         if (depth_format != NGLI_FORMAT_UNDEFINED) {
-            struct texture *depth = ngli_texture_create(gpu_ctx);
-            if (!depth)
-                return NGL_ERROR_MEMORY;
-            s->depth = depth;
-            struct texture_params attachment_params = {
+            const struct texture_params attachment_params = {
                 .type    = NGLI_TEXTURE_TYPE_2D,
                 .format  = depth_format,
                 .width   = s->width,
@@ -389,10 +406,10 @@ static int rtt_prefetch(struct ngl_node *node)
                 .samples = o->samples,
                 .usage   = NGLI_TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | transient_usage,
             };
-            ret = ngli_texture_init(depth, &attachment_params);
+            ret = acquire_attachment(node, &attachment_params, DEPTH_ATTACHMENT_INDEX, &s->depth);
             if (ret < 0)
                 return ret;
-            rt_params.depth_stencil.attachment = depth;
+            rt_params.depth_stencil.attachment = s->depth;
             rt_params.depth_stencil.load_op = NGLI_LOAD_OP_CLEAR;
             /*
              * For the first rendertarget with load operations set to clear, if
@@ -499,7 +516,11 @@ static void rtt_draw(struct ngl_node *node)
     ctx->available_rendertargets[1] = s->available_rendertargets[1];
     ctx->current_rendertarget = s->available_rendertargets[0];
 
+    /* The draws of the child must not be deferred outside the render target */
+    const int recording = ctx->drawbatch.recording;
+    ctx->drawbatch.recording = 0;
     ngli_node_draw(o->child);
+    ctx->drawbatch.recording = recording;
 
     if (!ctx->render_pass_started) {
         ngli_gpu_ctx_begin_render_pass(gpu_ctx, ctx->current_rendertarget);
@@ -527,6 +548,7 @@ static void rtt_draw(struct ngl_node *node)
 
 static void rtt_release(struct ngl_node *node)
 {
+    struct ngl_ctx *ctx = node->ctx;
     struct rtt_priv *s = node->priv_data;
 
     s->available_rendertargets[0] = NULL;
@@ -534,12 +556,12 @@ static void rtt_release(struct ngl_node *node)
 
     ngli_rendertarget_freep(&s->rt);
     ngli_rendertarget_freep(&s->rt_resume);
-    ngli_texture_freep(&s->depth);
+    ngli_rtpool_releasep(&ctx->rtpool, &s->depth);
 
     for (int i = 0; i < s->nb_ms_colors; i++)
-        ngli_texture_freep(&s->ms_colors[i]);
+        ngli_rtpool_releasep(&ctx->rtpool, &s->ms_colors[i]);
     s->nb_ms_colors = 0;
-    ngli_texture_freep(&s->ms_depth);
+    ngli_rtpool_releasep(&ctx->rtpool, &s->ms_depth);
 }
 
 const struct node_class ngli_rtt_class = {
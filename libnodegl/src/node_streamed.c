@@ -85,15 +85,7 @@ static int get_data_index(const struct ngl_node *node, int start, int64_t t64)
     const struct buffer_info *timestamps_priv = o->timestamps->priv_data;
     const int64_t *timestamps = (int64_t *)timestamps_priv->data;
     const int nb_timestamps = timestamps_priv->layout.count;
-
-    int ret = -1;
-    for (int i = start; i < nb_timestamps; i++) {
-        const int64_t ts = timestamps[i];
-        if (ts > t64)
-            break;
-        ret = i;
-    }
-    return ret;
+    return ngli_animation_find_index_i64(timestamps, nb_timestamps, start, t64);
 }
 
 static int streamed_update(struct ngl_node *node, double t)
@@ -120,11 +112,8 @@ static int streamed_update(struct ngl_node *node, double t)
 
     const int64_t t64 = llrint(rt * o->timebase[1] / (double)o->timebase[0]);
     int index = get_data_index(node, s->last_index, t64);
-    if (index < 0) {
-        index = get_data_index(node, 0, t64);
-        if (index < 0) // the requested time `t` is before the first user timestamp
-            index = 0;
-    }
+    if (index < 0) // the requested time `t` is before the first user timestamp
+        index = 0;
     s->last_index = index;
 
     const struct buffer_info *buffer_info = o->buffer->priv_data;
@@ -216,6 +205,7 @@ const struct node_class ngli_streamed##class_suffix##_class = {             \
     .opts_size = sizeof(struct streamed_opts),                              \
     .priv_size = sizeof(struct streamed_priv),                              \
     .params    = streamed##class_suffix##_params,                           \
+    .flags     = NGLI_NODE_FLAG_UPDATE_ASYNC,                               \
     .file      = __FILE__,                                                  \
 };                                                                          \
 
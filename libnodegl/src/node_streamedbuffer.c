@@ -20,10 +20,14 @@
  */
 
 #include <inttypes.h>
+#include <limits.h>
 #include <math.h>
 #include <stdint.h>
 #include <stddef.h>
 #include <string.h>
+
+#include "chunkreader.h"
+#include "format.h"
 #include "log.h"
 #include "nodegl.h"
 #include "internal.h"
@@ -35,11 +39,15 @@ struct streamedbuffer_opts {
     struct ngl_node *buffer_node;
     int timebase[2];
     struct ngl_node *time_anim;
+    char *filename;
+    int window;
 };
 
 struct streamedbuffer_priv {
     struct buffer_info buf;
     int last_index;
+    int nb_chunks;
+    struct chunkreader reader;
 };
 
 NGLI_STATIC_ASSERT(buffer_info_is_first, offsetof(struct streamedbuffer_priv, buf) == 0);
@@ -53,7 +61,7 @@ static const struct node_param streamedbuffer##name##_params[] = {
     {"timestamps", NGLI_PARAM_TYPE_NODE, OFFSET(timestamps), .flags=NGLI_PARAM_FLAG_NON_NULL,             \
                    .node_types=(const int[]){NGL_NODE_BUFFERINT64, -1},                                   \
                    .desc=NGLI_DOCSTRING("timestamps associated with each chunk of data to stream")},      \
-    {"buffer",     NGLI_PARAM_TYPE_NODE, OFFSET(buffer_node), .flags=NGLI_PARAM_FLAG_NON_NULL,            \
+    {"buffer",     NGLI_PARAM_TYPE_NODE, OFFSET(buffer_node),                                             \
                    .node_types=(const int[]){allowed_node, -1},                                           \
                    .desc=NGLI_DOCSTRING("buffer containing the data to stream")},                         \
     {"timebase",   NGLI_PARAM_TYPE_RATIONAL, OFFSET(timebase), {.r={1, 1000000}},                         \
@@ -61,6 +69,13 @@ static const struct node_param streamedbuffer##name##_params[] = {
     {"time_anim",  NGLI_PARAM_TYPE_NODE, OFFSET(time_anim),                                               \
                    .node_types=(const int[]){NGL_NODE_ANIMATEDTIME, -1},                                  \
                    .desc=NGLI_DOCSTRING("time remapping animation (must use a `linear` interpolation)")}, \
+    {"filename",   NGLI_PARAM_TYPE_STR, OFFSET(filename),                                                 \
+                   .desc=NGLI_DOCSTRING("file containing the chunks of data to stream, read "             \
+                                        "progressively, cannot be used with `buffer`")},                  \
+    {"window",     NGLI_PARAM_TYPE_I32, OFFSET(window), {.i32=16},                                        \
+                   .desc=NGLI_DOCSTRING("number of chunks kept in memory when streaming from "            \
+                                        "`filename`, the chunks following the current one are "           \
+                                        "read ahead of time by a background thread")},                    \
     {NULL}                                                                                                \
 };
 
@@ -84,15 +99,7 @@ static int get_data_index(const struct ngl_node *node, int start, int64_t t64)
     const struct buffer_info *timestamps_priv = o->timestamps->priv_data;
     const int64_t *timestamps = (int64_t *)timestamps_priv->data;
     const int nb_timestamps = timestamps_priv->layout.count;
-
-    int ret = -1;
-    for (int i = start; i < nb_timestamps; i++) {
-        const int64_t ts = timestamps[i];
-        if (ts > t64)
-            break;
-        ret = i;
-    }
-    return ret;
+    return ngli_animation_find_index_i64(timestamps, nb_timestamps, start, t64);
 }
 
 static int streamedbuffer_update(struct ngl_node *node, double t)
@@ -120,16 +127,20 @@ static int streamedbuffer_update(struct ngl_node *node, double t)
 
     const int64_t t64 = llrint(rt * o->timebase[1] / (double)o->timebase[0]);
     int index = get_data_index(node, s->last_index, t64);
-    if (index < 0) {
-        index = get_data_index(node, 0, t64);
-        if (index < 0) // the requested time `t` is before the first user timestamp
-            index = 0;
-    }
+    if (index < 0) // the requested time `t` is before the first user timestamp
+        index = 0;
     s->last_index = index;
 
-    const struct buffer_info *buffer_info = o->buffer_node->priv_data;
-    const struct buffer_layout *layout = &info->layout;
-    info->data = buffer_info->data + layout->stride * layout->count * index;
+    if (o->filename) {
+        const uint8_t *data;
+        int ret = ngli_chunkreader_get(&s->reader, index, &data);
+        if (ret < 0)
+            return ret;
+        info->data = (uint8_t *)data;
+    } else {
+        const struct buffer_info *buffer_info = o->buffer_node->priv_data;
+        info->data = buffer_info->data + info->data_size * index;
+    }
 
     if (!(info->flags & NGLI_BUFFER_INFO_FLAG_GPU_UPLOAD))
         return 0;
@@ -141,7 +152,6 @@ static int check_timestamps_buffer(const struct ngl_node *node)
 {
     const struct streamedbuffer_priv *s = node->priv_data;
     const struct streamedbuffer_opts *o = node->opts;
-    const struct buffer_info *info = &s->buf;
     const struct buffer_info *timestamps_priv = o->timestamps->priv_data;
     const int64_t *timestamps = (int64_t *)timestamps_priv->data;
     const int nb_timestamps = timestamps_priv->layout.count;
@@ -151,10 +161,8 @@ static int check_timestamps_buffer(const struct ngl_node *node)
         return NGL_ERROR_INVALID_ARG;
     }
 
-    const struct buffer_info *buffer_info = o->buffer_node->priv_data;
-    const int count = buffer_info->layout.count / info->layout.count;
-    if (nb_timestamps != count) {
-        LOG(ERROR, "timestamps count must match buffer chunk count: %d != %d", nb_timestamps, count);
+    if (nb_timestamps != s->nb_chunks) {
+        LOG(ERROR, "timestamps count must match buffer chunk count: %d != %d", nb_timestamps, s->nb_chunks);
         return NGL_ERROR_INVALID_ARG;
     }
 
@@ -175,7 +183,7 @@ static int check_timestamps_buffer(const struct ngl_node *node)
     return 0;
 }
 
-static int streamedbuffer_init(struct ngl_node *node)
+static int init_from_buffer(struct ngl_node *node)
 {
     struct streamedbuffer_priv *s = node->priv_data;
     const struct streamedbuffer_opts *o = node->opts;
@@ -197,9 +205,95 @@ static int streamedbuffer_init(struct ngl_node *node)
         return NGL_ERROR_INVALID_ARG;
     }
 
+    s->nb_chunks = buffer_info->layout.count / layout->count;
     info->data = buffer_info->data;
-    info->data_size = buffer_info->data_size / layout->count;
+    info->data_size = (size_t)layout->count * layout->stride;
     info->usage = buffer_info->usage;
+    return 0;
+}
+
+static int init_from_filename(struct ngl_node *node)
+{
+    struct streamedbuffer_priv *s = node->priv_data;
+    const struct streamedbuffer_opts *o = node->opts;
+    struct buffer_info *info = &s->buf;
+    struct buffer_layout *layout = &info->layout;
+
+    if (node->cls->id == NGL_NODE_STREAMEDBUFFERMAT4) {
+        layout->comp = 4 * 4;
+        layout->stride = layout->comp * sizeof(float);
+    } else {
+        layout->comp = ngli_format_get_nb_comp(layout->format);
+        layout->stride = ngli_format_get_bytes_per_pixel(layout->format);
+    }
+    layout->count = o->count;
+
+    if (layout->count <= 0) {
+        LOG(ERROR, "invalid number of elements (%d <= 0)", layout->count);
+        return NGL_ERROR_INVALID_ARG;
+    }
+
+    if (o->window <= 0) {
+        LOG(ERROR, "invalid window size (%d <= 0)", o->window);
+        return NGL_ERROR_INVALID_ARG;
+    }
+
+    int64_t size;
+    int ret = ngli_get_filesize(o->filename, &size);
+    if (ret < 0)
+        return ret;
+
+    info->data_size = (size_t)layout->count * layout->stride;
+    if (size % info->data_size || size / info->data_size > INT_MAX) {
+        LOG(ERROR, "'%s' size (%" PRId64 ") is not a multiple of the chunk size (%zu)",
+            o->filename, size, info->data_size);
+        return NGL_ERROR_INVALID_DATA;
+    }
+    s->nb_chunks = (int)(size / info->data_size);
+    info->usage = NGLI_BUFFER_USAGE_TRANSFER_DST_BIT;
+    return 0;
+}
+
+static int start_reader(struct ngl_node *node)
+{
+    struct streamedbuffer_priv *s = node->priv_data;
+    const struct streamedbuffer_opts *o = node->opts;
+    struct buffer_info *info = &s->buf;
+
+    int ret = ngli_chunkreader_init(&s->reader, o->filename, info->data_size, s->nb_chunks, o->window);
+    if (ret < 0)
+        return ret;
+
+    /* Make the first chunk available to the users of the data before any update */
+    const uint8_t *data;
+    ret = ngli_chunkreader_get(&s->reader, 0, &data);
+    if (ret < 0)
+        return ret;
+    info->data = (uint8_t *)data;
+
+    return 0;
+}
+
+static int streamedbuffer_init(struct ngl_node *node)
+{
+    struct streamedbuffer_priv *s = node->priv_data;
+    const struct streamedbuffer_opts *o = node->opts;
+    struct buffer_info *info = &s->buf;
+
+    if (o->buffer_node && o->filename) {
+        LOG(ERROR, "buffer and filename option cannot be set at the same time");
+        return NGL_ERROR_INVALID_ARG;
+    }
+
+    if (!o->buffer_node && !o->filename) {
+        LOG(ERROR, "either buffer or filename option must be set");
+        return NGL_ERROR_INVALID_ARG;
+    }
+
+    int ret = o->filename ? init_from_filename(node) : init_from_buffer(node);
+    if (ret < 0)
+        return ret;
+
     info->flags |= NGLI_BUFFER_INFO_FLAG_DYNAMIC;
 
     if (!o->timebase[1]) {
@@ -207,10 +301,16 @@ static int streamedbuffer_init(struct ngl_node *node)
         return NGL_ERROR_INVALID_ARG;
     }
 
-    int ret = check_timestamps_buffer(node);
+    ret = check_timestamps_buffer(node);
     if (ret < 0)
         return ret;
 
+    if (o->filename) {
+        ret = start_reader(node);
+        if (ret < 0)
+            return ret;
+    }
+
     info->buffer = ngli_buffer_create(node->ctx->gpu_ctx);
     if (!info->buffer)
         return NGL_ERROR_MEMORY;
@@ -242,14 +342,28 @@ static void streamedbuffer_uninit(struct ngl_node *node)
     struct buffer_info *info = &s->buf;
 
     ngli_buffer_freep(&info->buffer);
+
+    if (s->reader.window)
+        LOG(DEBUG, "%s: %d chunks read ahead of time, %d chunks read on demand",
+            node->label, s->reader.nb_hits, s->reader.nb_misses);
+    ngli_chunkreader_reset(&s->reader);
+    info->data = NULL;
 }
 
-#define DECLARE_STREAMED_CLASS(class_id, class_name, class_suffix)          \
+#define DECLARE_STREAMED_CLASS(class_id, class_name, class_suffix, dformat, dtype) \
+static int streamedbuffer##class_suffix##_init(struct ngl_node *node)       \
+{                                                                           \
+    struct streamedbuffer_priv *s = node->priv_data;                        \
+    s->buf.layout.format = dformat;                                         \
+    s->buf.layout.type = dtype;                                             \
+    return streamedbuffer_init(node);                                       \
+}                                                                           \
+                                                                            \
 const struct node_class ngli_streamedbuffer##class_suffix##_class = {       \
     .id        = class_id,                                                  \
     .category  = NGLI_NODE_CATEGORY_BUFFER,                                 \
     .name      = class_name,                                                \
-    .init      = streamedbuffer_init,                                       \
+    .init      = streamedbuffer##class_suffix##_init,                       \
     .prepare   = streamedbuffer_prepare,                                    \
     .update    = streamedbuffer_update,                                     \
     .uninit    = streamedbuffer_uninit,                                     \
@@ -259,16 +373,16 @@ const struct node_class ngli_streamedbuffer##class_suffix##_class = {       \
     .file      = __FILE__,                                                  \
 };                                                                          \
 
-DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERINT,    "StreamedBufferInt",    int)
-DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERIVEC2,  "StreamedBufferIVec2",  ivec2)
-DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERIVEC3,  "StreamedBufferIVec3",  ivec3)
-DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERIVEC4,  "StreamedBufferIVec4",  ivec4)
-DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERUINT,   "StreamedBufferUInt",   uint)
-DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERUIVEC2, "StreamedBufferUIVec2", uivec2)
-DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERUIVEC3, "StreamedBufferUIVec3", uivec3)
-DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERUIVEC4, "StreamedBufferUIVec4", uivec4)
-DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERFLOAT,  "StreamedBufferFloat",  float)
-DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERVEC2,   "StreamedBufferVec2",   vec2)
-DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERVEC3,   "StreamedBufferVec3",   vec3)
-DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERVEC4,   "StreamedBufferVec4",   vec4)
-DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERMAT4,   "StreamedBufferMat4",   mat4)
+DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERINT,    "StreamedBufferInt",    int,    NGLI_FORMAT_R32_SINT,            NGLI_TYPE_INT)
+DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERIVEC2,  "StreamedBufferIVec2",  ivec2,  NGLI_FORMAT_R32G32_SINT,         NGLI_TYPE_IVEC2)
+DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERIVEC3,  "StreamedBufferIVec3",  ivec3,  NGLI_FORMAT_R32G32B32_SINT,      NGLI_TYPE_IVEC3)
+DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERIVEC4,  "StreamedBufferIVec4",  ivec4,  NGLI_FORMAT_R32G32B32A32_SINT,   NGLI_TYPE_IVEC4)
+DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERUINT,   "StreamedBufferUInt",   uint,   NGLI_FORMAT_R32_UINT,            NGLI_TYPE_UINT)
+DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERUIVEC2, "StreamedBufferUIVec2", uivec2, NGLI_FORMAT_R32G32_UINT,         NGLI_TYPE_UIVEC2)
+DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERUIVEC3, "StreamedBufferUIVec3", uivec3, NGLI_FORMAT_R32G32B32_UINT,      NGLI_TYPE_UIVEC3)
+DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERUIVEC4, "StreamedBufferUIVec4", uivec4, NGLI_FORMAT_R32G32B32A32_UINT,   NGLI_TYPE_UIVEC4)
+DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERFLOAT,  "StreamedBufferFloat",  float,  NGLI_FORMAT_R32_SFLOAT,          NGLI_TYPE_FLOAT)
+DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERVEC2,   "StreamedBufferVec2",   vec2,   NGLI_FORMAT_R32G32_SFLOAT,       NGLI_TYPE_VEC2)
+DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERVEC3,   "StreamedBufferVec3",   vec3,   NGLI_FORMAT_R32G32B32_SFLOAT,    NGLI_TYPE_VEC3)
+DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERVEC4,   "StreamedBufferVec4",   vec4,   NGLI_FORMAT_R32G32B32A32_SFLOAT, NGLI_TYPE_VEC4)
+DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERMAT4,   "StreamedBufferMat4",   mat4,   NGLI_FORMAT_R32G32B32A32_SFLOAT, NGLI_TYPE_MAT4)
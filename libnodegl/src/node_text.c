@@ -44,7 +44,6 @@
                            NGLI_BUFFER_USAGE_INDEX_BUFFER_BIT)  \
 
 #define DYNAMIC_VERTEX_USAGE_FLAGS (NGLI_BUFFER_USAGE_DYNAMIC_BIT | VERTEX_USAGE_FLAGS)
-#define DYNAMIC_INDEX_USAGE_FLAGS  (NGLI_BUFFER_USAGE_DYNAMIC_BIT | INDEX_USAGE_FLAGS)
 
 struct pipeline_subdesc {
     struct pgcraft *crafter;
@@ -53,6 +52,8 @@ struct pipeline_subdesc {
     int projection_matrix_index;
     int color_index;
     int opacity_index;
+    int chr_width_index;
+    int chr_height_index;
 };
 
 struct pipeline_desc {
@@ -75,11 +76,24 @@ struct text_opts {
     int aspect_ratio[2];
 };
 
+/* Per-character instance data: quad origin and atlas cell */
+struct glyph {
+    float corner[3];
+    float uvs[4];
+};
+
 struct text_priv {
-    struct buffer *vertices;
-    struct buffer *uvcoords;
-    struct buffer *indices;
-    int nb_indices;
+    int instanced;
+    int verts_per_glyph;
+    struct buffer *quad;    /* quad coordinates, replicated per character in the non-instanced path */
+    struct buffer *glyphs;  /* glyph instances, replicated per vertex in the non-instanced path */
+    struct buffer *indices; /* non-instanced path only */
+    struct glyph *glyphs_data; /* CPU copy of the glyphs buffer content */
+    int glyphs_cap;
+    int nb_glyphs_uploaded; /* number of leading glyphs matching the GPU buffer content */
+    int nb_glyphs;
+    float chr_width[3];
+    float chr_height[3];
 
     struct buffer *bg_vertices;
 
@@ -180,8 +194,9 @@ static const char * const bg_fragment_data =
 static const char * const vertex_data =
     "void main()"                                                                       "\n"
     "{"                                                                                 "\n"
+    "    vec3 position = chr_corner + chr_height * quad_coord.y + chr_width * quad_coord.x;" "\n"
     "    ngl_out_pos = projection_matrix * modelview_matrix * vec4(position, 1.0);"     "\n"
-    "    var_tex_coord = uvcoord;"                                                      "\n"
+    "    var_tex_coord = chr_uvs.xy * (1.0 - quad_coord) + chr_uvs.zw * quad_coord;"    "\n"
     "}";
 
 static const char * const fragment_data =
@@ -199,10 +214,6 @@ static const struct pgcraft_iovar vert_out_vars[] = {
 #define BW(index) o->box_width[index]
 #define BH(index) o->box_height[index]
 
-#define C(index) chr_corner[index]
-#define W(index) chr_width[index]
-#define H(index) chr_height[index]
-
 static void get_char_box_dim(const char *s, int *wp, int *hp, int *np)
 {
     int w = 0, h = 1;
@@ -223,11 +234,114 @@ static void get_char_box_dim(const char *s, int *wp, int *hp, int *np)
     *np = n;
 }
 
-static int update_character_geometries(struct ngl_node *node)
+static const float quad_coords[] = {
+    0.f, 0.f,
+    1.f, 0.f,
+    0.f, 1.f,
+    1.f, 1.f,
+};
+
+/*
+ * Without instancing, the quad coordinates and the indices are replicated for
+ * each character; they only depend on the character position in the text.
+ */
+static int init_replicated_geometry(struct ngl_node *node, int cap)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct gpu_ctx *gpu_ctx = ctx->gpu_ctx;
+    struct text_priv *s = node->priv_data;
+
+    int ret = 0;
+    float *coords = ngli_calloc(cap * 4, 2 * sizeof(*coords));
+    short *indices = ngli_calloc(cap * 6, sizeof(*indices));
+    if (!coords || !indices) {
+        ret = NGL_ERROR_MEMORY;
+        goto end;
+    }
+
+    for (int n = 0; n < cap; n++) {
+        const short chr_indices[] = { n*4 + 0, n*4 + 1, n*4 + 2, n*4 + 1, n*4 + 3, n*4 + 2 };
+        memcpy(coords + n * NGLI_ARRAY_NB(quad_coords), quad_coords, sizeof(quad_coords));
+        memcpy(indices + n * NGLI_ARRAY_NB(chr_indices), chr_indices, sizeof(chr_indices));
+    }
+
+    ngli_buffer_freep(&s->quad);
+    ngli_buffer_freep(&s->indices);
+
+    s->quad    = ngli_buffer_create(gpu_ctx);
+    s->indices = ngli_buffer_create(gpu_ctx);
+    if (!s->quad || !s->indices) {
+        ret = NGL_ERROR_MEMORY;
+        goto end;
+    }
+
+    if ((ret = ngli_buffer_init(s->quad, cap * sizeof(quad_coords), VERTEX_USAGE_FLAGS)) < 0 ||
+        (ret = ngli_buffer_init(s->indices, cap * 6 * sizeof(*indices), INDEX_USAGE_FLAGS)) < 0 ||
+        (ret = ngli_buffer_upload(s->quad, coords, cap * sizeof(quad_coords), 0)) < 0 ||
+        (ret = ngli_buffer_upload(s->indices, indices, cap * 6 * sizeof(*indices), 0)) < 0)
+        goto end;
+
+end:
+    ngli_free(coords);
+    ngli_free(indices);
+    return ret;
+}
+
+static int grow_glyphs(struct ngl_node *node, int nb_glyphs)
 {
     struct ngl_ctx *ctx = node->ctx;
     struct gpu_ctx *gpu_ctx = ctx->gpu_ctx;
     struct text_priv *s = node->priv_data;
+
+    const int cap = NGLI_MAX(nb_glyphs, s->glyphs_cap * 2);
+    const int vpg = s->verts_per_glyph;
+
+    struct glyph *glyphs_data = ngli_realloc(s->glyphs_data, cap * vpg * sizeof(*glyphs_data));
+    if (!glyphs_data)
+        return NGL_ERROR_MEMORY;
+    s->glyphs_data = glyphs_data;
+    s->glyphs_cap = 0;
+    s->nb_glyphs_uploaded = 0;
+
+    ngli_buffer_freep(&s->glyphs);
+    s->glyphs = ngli_buffer_create(gpu_ctx);
+    if (!s->glyphs)
+        return NGL_ERROR_MEMORY;
+
+    int ret = ngli_buffer_init(s->glyphs, cap * vpg * sizeof(*glyphs_data), DYNAMIC_VERTEX_USAGE_FLAGS);
+    if (ret < 0)
+        return ret;
+
+    if (!s->instanced) {
+        ret = init_replicated_geometry(node, cap);
+        if (ret < 0)
+            return ret;
+    }
+
+    struct pipeline_desc *descs = ngli_darray_data(&s->pipeline_descs);
+    const int nb_descs = ngli_darray_count(&s->pipeline_descs);
+    for (int i = 0; i < nb_descs; i++) {
+        struct pipeline_subdesc *desc = &descs[i].fg;
+
+        ngli_pipeline_compat_update_attribute(desc->pipeline_compat, 0, s->quad);
+        ngli_pipeline_compat_update_attribute(desc->pipeline_compat, 1, s->glyphs);
+        ngli_pipeline_compat_update_attribute(desc->pipeline_compat, 2, s->glyphs);
+    }
+
+    s->glyphs_cap = cap;
+    return 0;
+}
+
+static int upload_glyphs(struct text_priv *s, int start, int end)
+{
+    const int vpg = s->verts_per_glyph;
+    const int size = sizeof(*s->glyphs_data) * vpg;
+    return ngli_buffer_upload(s->glyphs, s->glyphs_data + start * vpg, (end - start) * size, start * size);
+}
+
+static int update_character_geometries(struct ngl_node *node)
+{
+    struct text_priv *s = node->priv_data;
     struct text_opts *o = node->opts;
 
     int ret = 0;
@@ -235,23 +349,18 @@ static int update_character_geometries(struct ngl_node *node)
 
     int text_cols, text_rows, text_nbchr;
     get_char_box_dim(str, &text_cols, &text_rows, &text_nbchr);
-    if (!text_nbchr) {
-        ngli_buffer_freep(&s->vertices);
-        ngli_buffer_freep(&s->uvcoords);
-        ngli_buffer_freep(&s->indices);
-        s->nb_indices = 0;
+    s->nb_glyphs = 0;
+    if (!text_nbchr)
         return 0;
-    }
 
-    const int nb_vertices = text_nbchr * 4;
-    const int nb_uvcoords = text_nbchr * 4;
-    const int nb_indices  = text_nbchr * 6;
-    float *vertices = ngli_calloc(nb_vertices, 3 * sizeof(*vertices));
-    float *uvcoords = ngli_calloc(nb_uvcoords, 2 * sizeof(*uvcoords));
-    short *indices  = ngli_calloc(nb_indices, sizeof(*indices));
-    if (!vertices || !uvcoords || !indices) {
-        ret = NGL_ERROR_MEMORY;
-        goto end;
+    /*
+     * The GPU buffers are only re-allocated when growing, in which case their
+     * whole content needs to be uploaded again
+     */
+    if (text_nbchr > s->glyphs_cap) {
+        ret = grow_glyphs(node, text_nbchr);
+        if (ret < 0)
+            return ret;
     }
 
     /* Text/Box ratio */
@@ -287,16 +396,12 @@ static int update_character_geometries(struct ngl_node *node)
     ngli_vec3_scale(padh, height, o->padding / (float)text_height);
 
     /* Width and height of 1 character */
-    const float chr_width[3] = {
-        (width[0] - 2 * padw[0]) / (float)text_cols,
-        (width[1] - 2 * padw[1]) / (float)text_cols,
-        (width[2] - 2 * padw[2]) / (float)text_cols,
-    };
-    const float chr_height[3] = {
-        (height[0] - 2 * padh[0]) / (float)text_rows,
-        (height[1] - 2 * padh[1]) / (float)text_rows,
-        (height[2] - 2 * padh[2]) / (float)text_rows,
-    };
+    float *chr_width = s->chr_width;
+    float *chr_height = s->chr_height;
+    for (int i = 0; i < 3; i++) {
+        chr_width[i]  = (width[i]  - 2 * padw[i]) / (float)text_cols;
+        chr_height[i] = (height[i] - 2 * padh[i]) / (float)text_rows;
+    }
 
     /* Adjust text position according to alignment settings */
     const float align_padw[3] = NGLI_VEC3_SUB(o->box_width, width);
@@ -317,6 +422,7 @@ static int update_character_geometries(struct ngl_node *node)
 
     int px = 0, py = 0;
     int n = 0;
+    int dirty_start = -1;
 
     for (int i = 0; str[i]; i++) {
         if (str[i] == '\n') {
@@ -325,71 +431,46 @@ static int update_character_geometries(struct ngl_node *node)
             continue;
         }
 
-        /* quad vertices */
-        const float chr_corner[3] = {
-            corner[0] + chr_width[0] * px + chr_height[0] * (text_rows - py - 1),
-            corner[1] + chr_width[1] * px + chr_height[1] * (text_rows - py - 1),
-            corner[2] + chr_width[2] * px + chr_height[2] * (text_rows - py - 1),
-        };
-        const float chr_vertices[] = {
-            C(0),               C(1),               C(2),
-            C(0) + W(0),        C(1) + W(1),        C(2) + W(2),
-            C(0) + H(0),        C(1) + H(1),        C(2) + H(2),
-            C(0) + H(0) + W(0), C(1) + H(1) + W(1), C(2) + H(2) + W(2),
+        struct glyph glyph = {
+            .corner = {
+                corner[0] + chr_width[0] * px + chr_height[0] * (text_rows - py - 1),
+                corner[1] + chr_width[1] * px + chr_height[1] * (text_rows - py - 1),
+                corner[2] + chr_width[2] * px + chr_height[2] * (text_rows - py - 1),
+            },
         };
-        memcpy(vertices + 4 * 3 * n, chr_vertices, sizeof(chr_vertices));
 
         /* focus uvcoords on the character in the atlas texture */
-        ngli_drawutils_get_atlas_uvcoords(str[i], uvcoords + 4 * 2 * n);
-
-        /* quad for each character is made of 2 triangles */
-        const short chr_indices[] = { n*4 + 0, n*4 + 1, n*4 + 2, n*4 + 1, n*4 + 3, n*4 + 2 };
-        memcpy(indices + n * NGLI_ARRAY_NB(chr_indices), chr_indices, sizeof(chr_indices));
+        float uvs[8];
+        ngli_drawutils_get_atlas_uvcoords(str[i], uvs);
+        memcpy(glyph.uvs, uvs, 2 * sizeof(*uvs));
+        memcpy(glyph.uvs + 2, uvs + 6, 2 * sizeof(*uvs));
+
+        /*
+         * Only upload the ranges of characters that actually changed; the
+         * glyphs past the uploaded ones have an undefined content
+         */
+        struct glyph *dst = &s->glyphs_data[n * s->verts_per_glyph];
+        if (n >= s->nb_glyphs_uploaded || memcmp(dst, &glyph, sizeof(glyph))) {
+            for (int k = 0; k < s->verts_per_glyph; k++)
+                dst[k] = glyph;
+            if (dirty_start < 0)
+                dirty_start = n;
+        } else if (dirty_start >= 0) {
+            if ((ret = upload_glyphs(s, dirty_start, n)) < 0)
+                return ret;
+            dirty_start = -1;
+        }
 
         n++;
         px++;
     }
 
-    if (nb_indices > s->nb_indices) { // need re-alloc
-        ngli_buffer_freep(&s->vertices);
-        ngli_buffer_freep(&s->uvcoords);
-        ngli_buffer_freep(&s->indices);
-
-        s->vertices = ngli_buffer_create(gpu_ctx);
-        s->uvcoords = ngli_buffer_create(gpu_ctx);
-        s->indices  = ngli_buffer_create(gpu_ctx);
-        if (!s->vertices || !s->uvcoords || !s->indices) {
-            ret = NGL_ERROR_MEMORY;
-            goto end;
-        }
-
-        if ((ret = ngli_buffer_init(s->vertices, nb_vertices * 3 * sizeof(*vertices), DYNAMIC_VERTEX_USAGE_FLAGS)) < 0 ||
-            (ret = ngli_buffer_init(s->uvcoords, nb_uvcoords * 2 * sizeof(*uvcoords), DYNAMIC_VERTEX_USAGE_FLAGS)) < 0 ||
-            (ret = ngli_buffer_init(s->indices,  nb_indices  * sizeof(*indices),  DYNAMIC_INDEX_USAGE_FLAGS)) < 0)
-            goto end;
-
-        struct pipeline_desc *descs = ngli_darray_data(&s->pipeline_descs);
-        const int nb_descs = ngli_darray_count(&s->pipeline_descs);
-        for (int i = 0; i < nb_descs; i++) {
-            struct pipeline_subdesc *desc = &descs[i].fg;
-
-            ngli_pipeline_compat_update_attribute(desc->pipeline_compat, 0, s->vertices);
-            ngli_pipeline_compat_update_attribute(desc->pipeline_compat, 1, s->uvcoords);
-        }
-    }
-
-    if ((ret = ngli_buffer_upload(s->vertices, vertices, nb_vertices * 3 * sizeof(*vertices), 0)) < 0 ||
-        (ret = ngli_buffer_upload(s->uvcoords, uvcoords, nb_uvcoords * 2 * sizeof(*uvcoords), 0)) < 0 ||
-        (ret = ngli_buffer_upload(s->indices, indices, nb_indices * sizeof(*indices), 0)) < 0)
-        goto end;
-
-    s->nb_indices = nb_indices;
+    if (dirty_start >= 0 && (ret = upload_glyphs(s, dirty_start, n)) < 0)
+        return ret;
 
-end:
-    ngli_free(vertices);
-    ngli_free(uvcoords);
-    ngli_free(indices);
-    return ret;
+    s->nb_glyphs_uploaded = NGLI_MAX(s->nb_glyphs_uploaded, n);
+    s->nb_glyphs = n;
+    return 0;
 }
 
 static int init_bounding_box_geometry(struct ngl_node *node)
@@ -463,8 +544,28 @@ end:
     return ret;
 }
 
+static int init_quad_geometry(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct gpu_ctx *gpu_ctx = ctx->gpu_ctx;
+    struct text_priv *s = node->priv_data;
+
+    s->quad = ngli_buffer_create(gpu_ctx);
+    if (!s->quad)
+        return NGL_ERROR_MEMORY;
+
+    int ret;
+    if ((ret = ngli_buffer_init(s->quad, sizeof(quad_coords), VERTEX_USAGE_FLAGS)) < 0 ||
+        (ret = ngli_buffer_upload(s->quad, quad_coords, sizeof(quad_coords), 0)) < 0)
+        return ret;
+
+    return 0;
+}
+
 static int text_init(struct ngl_node *node)
 {
+    struct ngl_ctx *ctx = node->ctx;
+    struct gpu_ctx *gpu_ctx = ctx->gpu_ctx;
     struct text_priv *s = node->priv_data;
 
     int ret = atlas_create(node);
@@ -473,6 +574,19 @@ static int text_init(struct ngl_node *node)
 
     ngli_darray_init(&s->pipeline_descs, sizeof(struct pipeline_desc), 0);
 
+    /*
+     * With instanced drawing, every character is an instance of a single
+     * static quad; otherwise the glyph data is replicated on each vertex of
+     * the character quad.
+     */
+    s->instanced = !!(gpu_ctx->features & NGLI_FEATURE_INSTANCED_DRAW);
+    s->verts_per_glyph = s->instanced ? 1 : 4;
+    if (s->instanced) {
+        ret = init_quad_geometry(node);
+        if (ret < 0)
+            return ret;
+    }
+
     ret = init_bounding_box_geometry(node);
     if (ret < 0)
         return ret;
@@ -592,6 +706,8 @@ static int fg_prepare(struct ngl_node *node, struct pipeline_subdesc *desc)
     const struct pgcraft_uniform uniforms[] = {
         {.name = "modelview_matrix",  .type = NGLI_TYPE_MAT4, .stage = NGLI_PROGRAM_SHADER_VERT, .data = NULL},
         {.name = "projection_matrix", .type = NGLI_TYPE_MAT4, .stage = NGLI_PROGRAM_SHADER_VERT, .data = NULL},
+        {.name = "chr_width",         .type = NGLI_TYPE_VEC3, .stage = NGLI_PROGRAM_SHADER_VERT, .data = s->chr_width},
+        {.name = "chr_height",        .type = NGLI_TYPE_VEC3, .stage = NGLI_PROGRAM_SHADER_VERT, .data = s->chr_height},
         {.name = "color",             .type = NGLI_TYPE_VEC3, .stage = NGLI_PROGRAM_SHADER_FRAG, .data = o->fg_color},
         {.name = "opacity",           .type = NGLI_TYPE_FLOAT, .stage = NGLI_PROGRAM_SHADER_FRAG, .data = &o->fg_opacity},
     };
@@ -607,18 +723,29 @@ static int fg_prepare(struct ngl_node *node, struct pipeline_subdesc *desc)
 
     const struct pgcraft_attribute attributes[] = {
         {
-            .name     = "position",
+            .name     = "quad_coord",
+            .type     = NGLI_TYPE_VEC2,
+            .format   = NGLI_FORMAT_R32G32_SFLOAT,
+            .stride   = 2 * 4,
+            .buffer   = s->quad,
+        },
+        {
+            .name     = "chr_corner",
             .type     = NGLI_TYPE_VEC3,
             .format   = NGLI_FORMAT_R32G32B32_SFLOAT,
-            .stride   = 3 * 4,
-            .buffer   = s->vertices,
+            .stride   = sizeof(struct glyph),
+            .offset   = offsetof(struct glyph, corner),
+            .rate     = s->instanced,
+            .buffer   = s->glyphs,
         },
         {
-            .name     = "uvcoord",
-            .type     = NGLI_TYPE_VEC2,
-            .format   = NGLI_FORMAT_R32G32_SFLOAT,
-            .stride   = 2 * 4,
-            .buffer   = s->uvcoords,
+            .name     = "chr_uvs",
+            .type     = NGLI_TYPE_VEC4,
+            .format   = NGLI_FORMAT_R32G32B32A32_SFLOAT,
+            .stride   = sizeof(struct glyph),
+            .offset   = offsetof(struct glyph, uvs),
+            .rate     = s->instanced,
+            .buffer   = s->glyphs,
         },
     };
 
@@ -633,7 +760,8 @@ static int fg_prepare(struct ngl_node *node, struct pipeline_subdesc *desc)
     struct pipeline_params pipeline_params = {
         .type          = NGLI_PIPELINE_TYPE_GRAPHICS,
         .graphics      = {
-            .topology       = NGLI_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+            .topology       = s->instanced ? NGLI_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP
+                                           : NGLI_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
             .state          = state,
             .rt_desc        = rnode->rendertarget_desc,
         }
@@ -657,8 +785,12 @@ static int fg_prepare(struct ngl_node *node, struct pipeline_subdesc *desc)
     if (ret < 0)
         return ret;
 
-    ngli_assert(!strcmp("position", pipeline_params.layout.attributes_desc[0].name));
-    ngli_assert(!strcmp("uvcoord", pipeline_params.layout.attributes_desc[1].name));
+    ngli_assert(!strcmp("quad_coord", pipeline_params.layout.attributes_desc[0].name));
+    ngli_assert(!strcmp("chr_corner", pipeline_params.layout.attributes_desc[1].name));
+    ngli_assert(!strcmp("chr_uvs", pipeline_params.layout.attributes_desc[2].name));
+
+    desc->chr_width_index = ngli_pgcraft_get_uniform_index(desc->crafter, "chr_width", NGLI_PROGRAM_SHADER_VERT);
+    desc->chr_height_index = ngli_pgcraft_get_uniform_index(desc->crafter, "chr_height", NGLI_PROGRAM_SHADER_VERT);
 
     return 0;
 }
@@ -705,12 +837,15 @@ static void text_draw(struct ngl_node *node)
     struct text_priv *s = node->priv_data;
     const struct text_opts *o = node->opts;
 
-    const float *modelview_matrix  = ngli_darray_tail(&ctx->modelview_matrix_stack);
-    const float *projection_matrix = ngli_darray_tail(&ctx->projection_matrix_stack);
-
     struct pipeline_desc *descs = ngli_darray_data(&s->pipeline_descs);
     struct pipeline_desc *desc = &descs[ctx->rnode_pos->id];
 
+    if (ngli_drawbatch_record(&ctx->drawbatch, node, desc->bg.pipeline_compat))
+        return;
+
+    const float *modelview_matrix  = ngli_darray_tail(&ctx->modelview_matrix_stack);
+    const float *projection_matrix = ngli_darray_tail(&ctx->projection_matrix_stack);
+
     if (!ctx->render_pass_started) {
         struct gpu_ctx *gpu_ctx = ctx->gpu_ctx;
         ngli_gpu_ctx_begin_render_pass(gpu_ctx, ctx->current_rendertarget);
@@ -724,13 +859,18 @@ static void text_draw(struct ngl_node *node)
     ngli_pipeline_compat_update_uniform(bg_desc->pipeline_compat, bg_desc->opacity_index, &o->bg_opacity);
     ngli_pipeline_compat_draw(bg_desc->pipeline_compat, 4, 1);
 
-    if (s->nb_indices) {
+    if (s->nb_glyphs) {
         struct pipeline_subdesc *fg_desc = &desc->fg;
         ngli_pipeline_compat_update_uniform(fg_desc->pipeline_compat, fg_desc->modelview_matrix_index, modelview_matrix);
         ngli_pipeline_compat_update_uniform(fg_desc->pipeline_compat, fg_desc->projection_matrix_index, projection_matrix);
+        ngli_pipeline_compat_update_uniform(fg_desc->pipeline_compat, fg_desc->chr_width_index, s->chr_width);
+        ngli_pipeline_compat_update_uniform(fg_desc->pipeline_compat, fg_desc->chr_height_index, s->chr_height);
         ngli_pipeline_compat_update_uniform(fg_desc->pipeline_compat, fg_desc->color_index, o->fg_color);
         ngli_pipeline_compat_update_uniform(fg_desc->pipeline_compat, fg_desc->opacity_index, &o->fg_opacity);
-        ngli_pipeline_compat_draw_indexed(fg_desc->pipeline_compat, s->indices, NGLI_FORMAT_R16_UNORM, s->nb_indices, 1);
+        if (s->instanced)
+            ngli_pipeline_compat_draw(fg_desc->pipeline_compat, 4, s->nb_glyphs);
+        else
+            ngli_pipeline_compat_draw_indexed(fg_desc->pipeline_compat, s->indices, NGLI_FORMAT_R16_UNORM, s->nb_glyphs * 6, 1);
     }
 }
 
@@ -748,9 +888,10 @@ static void text_uninit(struct ngl_node *node)
     }
     ngli_darray_reset(&s->pipeline_descs);
     ngli_buffer_freep(&s->bg_vertices);
-    ngli_buffer_freep(&s->vertices);
-    ngli_buffer_freep(&s->uvcoords);
+    ngli_buffer_freep(&s->quad);
+    ngli_buffer_freep(&s->glyphs);
     ngli_buffer_freep(&s->indices);
+    ngli_freep(&s->glyphs_data);
 }
 
 const struct node_class ngli_text_class = {
@@ -90,17 +90,16 @@ static int timerangefilter_init(struct ngl_node *node)
     return 0;
 }
 
-static int get_rr_id(const struct timerangefilter_opts *o, int start, double t)
+static double get_rr_start_time(const void *user_arg, int id)
 {
-    int ret = -1;
+    const struct timerangefilter_opts *o = user_arg;
+    const struct timerangemode_opts *rr = o->ranges[id]->opts;
+    return rr->start_time;
+}
 
-    for (int i = start; i < o->nb_ranges; i++) {
-        const struct timerangemode_opts *rr = o->ranges[i]->opts;
-        if (rr->start_time > t)
-            break;
-        ret = i;
-    }
-    return ret;
+static int get_rr_id(const struct timerangefilter_opts *o, int start, double t)
+{
+    return ngli_animation_find_index(o, get_rr_start_time, o->nb_ranges, start, t);
 }
 
 static int update_rr_state(struct timerangefilter_priv *s, const struct timerangefilter_opts *o, double t)
@@ -108,13 +107,7 @@ static int update_rr_state(struct timerangefilter_priv *s, const struct timerang
     if (!o->nb_ranges)
         return NGL_ERROR_INVALID_ARG;
 
-    int rr_id = get_rr_id(o, s->current_range, t);
-    if (rr_id < 0) {
-        // range not found, probably backward in time so look from the
-        // start
-        // TODO: look for rr using bsearch?
-        rr_id = get_rr_id(o, 0, t);
-    }
+    const int rr_id = get_rr_id(o, s->current_range, t);
 
     if (rr_id >= 0) {
         if (s->current_range != rr_id) {
@@ -133,12 +126,42 @@ static int update_rr_state(struct timerangefilter_priv *s, const struct timerang
     return rr_id;
 }
 
+/*
+ * Return the delay until the first range following rr_id that requires the
+ * child (any range but NoOp), or -1 if there is none within the horizon.
+ */
+static double get_next_use_in(const struct timerangefilter_opts *o, int rr_id, double t, double horizon)
+{
+    for (int i = rr_id + 1; i < o->nb_ranges; i++) {
+        const double next_use_in = get_rr_start_time(o, i) - t;
+        if (next_use_in > horizon)
+            break;
+        if (o->ranges[i]->cls->id != NGL_NODE_TIMERANGEMODENOOP)
+            return next_use_in;
+    }
+    return -1.;
+}
+
 static int timerangefilter_visit(struct ngl_node *node, int is_active, double t)
 {
+    struct ngl_ctx *ctx = node->ctx;
     struct timerangefilter_priv *s = node->priv_data;
     const struct timerangefilter_opts *o = node->opts;
     struct ngl_node *child = o->child;
 
+    /*
+     * A parent time filter activating this branch ahead of its use extends
+     * the look-ahead of this filter up to the time the branch is needed,
+     * otherwise the subtree would be released right away if the ranges of
+     * this filter are not due yet. Only a parent prefetching the branch
+     * extends the prefetch time: a parent merely keeping the branch alive
+     * must not start the nested subtrees that were released.
+     */
+    double prefetch_lookahead = ctx->visit_prefetch_lookahead;
+    double idle_lookahead = ctx->visit_idle_lookahead;
+    const double prefetch_time = NGLI_MAX(o->prefetch_time, prefetch_lookahead);
+    const double max_idle_time = NGLI_MAX(o->max_idle_time, idle_lookahead);
+
     /*
      * The life of the parent takes over the life of its children: if the
      * parent is dead, the children are likely dead as well. However, a living
@@ -155,22 +178,22 @@ static int timerangefilter_visit(struct ngl_node *node, int is_active, double t)
             if (rr->cls->id == NGL_NODE_TIMERANGEMODENOOP) {
                 is_active = 0;
 
-                if (rr_id < o->nb_ranges - 1) {
-                    // We assume here the next range requires the node started
-                    // as the current one doesn't.
-                    const struct timerangemode_opts *next = o->ranges[rr_id + 1]->opts;
-                    const double next_use_in = next->start_time - t;
-
-                    if (next_use_in <= o->prefetch_time) {
+                // Look for the next range requiring the node, skipping the
+                // NoOp ones
+                const double next_use_in = get_next_use_in(o, rr_id, t, max_idle_time);
+                if (next_use_in >= 0) {
+                    if (next_use_in <= prefetch_time) {
                         TRACE("next use of %s in %g (< %g), mark as active",
-                              child->label, next_use_in, o->prefetch_time);
+                              child->label, next_use_in, prefetch_time);
 
                         // The node will actually be needed soon, so we need to
                         // start it if necessary.
                         is_active = 1;
-                    } else if (next_use_in <= o->max_idle_time && child->is_active) {
+                        prefetch_lookahead = NGLI_MAX(prefetch_lookahead, next_use_in);
+                        idle_lookahead = NGLI_MAX(idle_lookahead, next_use_in);
+                    } else if (child->is_active) {
                         TRACE("%s not currently needed but will be soon %g (< %g), keep as active",
-                              child->label, next_use_in, o->max_idle_time);
+                              child->label, next_use_in, max_idle_time);
 
                         // The node will be needed in a slight amount of time;
                         // a bit longer than a prefetch period so we don't need
@@ -178,6 +201,7 @@ static int timerangefilter_visit(struct ngl_node *node, int is_active, double t)
                         // already active it's not worth releasing it to start
                         // it again soon after, so we keep it active.
                         is_active = 1;
+                        idle_lookahead = NGLI_MAX(idle_lookahead, next_use_in);
                     }
                 }
             } else if (rr->cls->id == NGL_NODE_TIMERANGEMODEONCE) {
@@ -192,7 +216,14 @@ static int timerangefilter_visit(struct ngl_node *node, int is_active, double t)
         }
     }
 
-    return ngli_node_visit(child, is_active, t);
+    const double visit_prefetch_lookahead = ctx->visit_prefetch_lookahead;
+    const double visit_idle_lookahead = ctx->visit_idle_lookahead;
+    ctx->visit_prefetch_lookahead = prefetch_lookahead;
+    ctx->visit_idle_lookahead = idle_lookahead;
+    int ret = ngli_node_visit(child, is_active, t);
+    ctx->visit_prefetch_lookahead = visit_prefetch_lookahead;
+    ctx->visit_idle_lookahead = visit_idle_lookahead;
+    return ret;
 }
 
 static int timerangefilter_update(struct ngl_node *node, double t)
@@ -167,7 +167,11 @@ static void node_release(struct ngl_node *node)
     ngli_assert(node->ctx);
     if (node->cls->release) {
         TRACE("RELEASE %s @ %p", node->label, node);
+        struct profiler *profiler = &node->ctx->profiler;
+        const int64_t start_time = profiler->enabled ? ngli_gettime_relative() : 0;
         node->cls->release(node);
+        if (profiler->enabled)
+            ngli_profiler_add_event(profiler, NGLI_PROFILER_EVENT_RELEASE, node, start_time);
     }
     node->state = STATE_INITIALIZED;
     node->last_update_time = -1.;
@@ -681,7 +685,11 @@ static int node_prefetch(struct ngl_node *node)
 
     if (node->cls->prefetch) {
         TRACE("PREFETCH %s @ %p", node->label, node);
+        struct profiler *profiler = &node->ctx->profiler;
+        const int64_t start_time = profiler->enabled ? ngli_gettime_relative() : 0;
         int ret = node->cls->prefetch(node);
+        if (profiler->enabled)
+            ngli_profiler_add_event(profiler, NGLI_PROFILER_EVENT_PREFETCH, node, start_time);
         if (ret < 0) {
             LOG(ERROR, "prefetching node %s failed: %s", node->label, NGLI_RET_STR(ret));
             node->visit_time = -1.;
@@ -734,7 +742,11 @@ int ngli_node_update(struct ngl_node *node, double t)
     if (node->cls->update) {
         if (node->last_update_time != t) {
             TRACE("UPDATE %s @ %p with t=%g", node->label, node, t);
+            struct profiler *profiler = &node->ctx->profiler;
+            const int64_t start_time = profiler->enabled ? ngli_gettime_relative() : 0;
             int ret = node->cls->update(node, t);
+            if (profiler->enabled)
+                ngli_profiler_add_event(profiler, NGLI_PROFILER_EVENT_UPDATE, node, start_time);
             if (ret < 0) {
                 LOG(ERROR, "updating node %s failed: %s", node->label, NGLI_RET_STR(ret));
                 return ret;
@@ -770,11 +782,38 @@ void *ngli_node_get_data_ptr(struct ngl_node *var_node, void *data_fallback)
     return var->data;
 }
 
+/* Nodes submitting their own render or compute pass, timed on the GPU by the profiler */
+static int is_gpu_pass(const struct ngl_node *node)
+{
+    return node->cls->category == NGLI_NODE_CATEGORY_RENDER || node->cls->id == NGL_NODE_COMPUTE;
+}
+
+void ngli_node_draw_profiled(struct ngl_node *node)
+{
+    struct profiler *profiler = &node->ctx->profiler;
+    if (profiler->enabled) {
+        const int64_t start_time = ngli_gettime_relative();
+        const int query = is_gpu_pass(node) ? ngli_profiler_gpu_begin(profiler) : -1;
+        node->cls->draw(node);
+        ngli_profiler_gpu_end(profiler, node, query);
+        ngli_profiler_add_event(profiler, NGLI_PROFILER_EVENT_DRAW, node, start_time);
+    } else {
+        node->cls->draw(node);
+    }
+}
+
 void ngli_node_draw(struct ngl_node *node)
 {
     if (node->cls->draw) {
         TRACE("DRAW %s @ %p", node->label, node);
-        node->cls->draw(node);
+        /*
+         * Render nodes only record a packet in a sorted group, their actual
+         * draw is profiled when the batch is flushed
+         */
+        if (node->ctx->drawbatch.recording && node->cls->category == NGLI_NODE_CATEGORY_RENDER)
+            node->cls->draw(node);
+        else
+            ngli_node_draw_profiled(node);
         node->draw_count++;
     }
 }
@@ -808,6 +847,9 @@ static int param_add(struct ngl_node *node, const char *key, int nb_elems, void
         return NGL_ERROR_INVALID_USAGE;
     }
 
+    if (node->ctx)
+        ngli_ctx_wait_draws(node->ctx);
+
     ret = ngli_params_add(base_ptr, par, nb_elems, elems);
     if (ret < 0) {
         LOG(ERROR, "unable to add elements to %s.%s", node->label, key);
@@ -893,8 +935,12 @@ static int node_param_update(struct ngl_node *node, const struct node_param *par
     if (!par)                                                           \
         return NGL_ERROR_NOT_FOUND;                                     \
     uint8_t *dst = base_ptr + par->offset;                              \
-    if ((ret = node_param_is_value_allowed(node, key, dst, par)) < 0 || \
-        (ret = ngli_params_set_##type(dst, par, __VA_ARGS__)) < 0 ||    \
+    if ((ret = node_param_is_value_allowed(node, key, dst, par)) < 0)   \
+        return ret;                                                     \
+    /* The value must not change while a queued draw is using it */     \
+    if (node->ctx)                                                      \
+        ngli_ctx_wait_draws(node->ctx);                                 \
+    if ((ret = ngli_params_set_##type(dst, par, __VA_ARGS__)) < 0 ||    \
         (ret = node_param_update(node, par)) < 0)                       \
         return ret;                                                     \
     return 0
@@ -26,6 +26,11 @@
 #include "noise.h"
 #include "utils.h"
 
+/* Scalar reference of the SIMD noise kernels, see simd.c */
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
+
 static float curve_linear(float t)
 {
     return t;
@@ -71,11 +76,11 @@ static float u32tof32(uint32_t x)
 }
 
 /* Gradient noise, returns a value in [-.5;.5) */
-static float noise(const struct noise *s, float t)
+static float noise(interp_func_type interp_func, uint32_t seed, float t)
 {
     const float i = floorf(t);  // integer part (lattice point)
     const float f = t - i;      // fractional part: where we are between 2 lattice points
-    const uint32_t x = (uint32_t)i + s->params.seed; // seed is an offsetting on the lattice
+    const uint32_t x = (uint32_t)(int32_t)i + seed; // seed is an offsetting on the lattice
 
     /*
      * The random values correspond to the random slopes found at the 2 lattice
@@ -90,7 +95,7 @@ static float noise(const struct noise *s, float t)
     const float y1 = s1 * (f - 1.f);
 
     /* Interpolate between the 2 slope y-coordinates */
-    const float a = s->interp_func(f);
+    const float a = interp_func(f);
     const float r = NGLI_MIX(y0, y1, a);
     return r;
 }
@@ -103,16 +108,28 @@ int ngli_noise_init(struct noise *s, const struct noise_params *params)
     return 0;
 }
 
-float ngli_noise_get(const struct noise *s, float t)
+/* Fractional Brownian Motion */
+static float fbm(interp_func_type interp_func, const struct noise_params *p, uint32_t seed, float t)
 {
-    /* Fractional Brownian Motion */
-    const struct noise_params *p = &s->params;
     float sum = 0.f;
     float amp = p->amplitude;
     for (int i = 0; i < p->octaves; i++) {
-        sum += noise(s, t) * amp;
+        sum += noise(interp_func, seed, t) * amp;
         t *= p->lacunarity;
         amp *= p->gain;
     }
     return sum;
 }
+
+float ngli_noise_get(const struct noise *s, float t)
+{
+    return fbm(s->interp_func, &s->params, s->params.seed, t);
+}
+
+void ngli_noise_fbm_f32_c(float *dst, const float *t, const uint32_t *seeds, int n, const struct noise_params *p)
+{
+    ngli_assert(p->function >= 0 && p->function < NGLI_ARRAY_NB(interp_func_map));
+    const interp_func_type interp_func = interp_func_map[p->function];
+    for (int i = 0; i < n; i++)
+        dst[i] = fbm(interp_func, p, seeds[i], t[i]);
+}
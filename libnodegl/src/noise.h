@@ -51,4 +51,6 @@ struct noise {
 int ngli_noise_init(struct noise *s, const struct noise_params *params);
 float ngli_noise_get(const struct noise *s, float t);
 
+void ngli_noise_fbm_f32_c(float *dst, const float *t, const uint32_t *seeds, int n, const struct noise_params *p);
+
 #endif
@@ -608,6 +608,12 @@ void ngli_pass_uninit(struct pass *s)
     memset(s, 0, sizeof(*s));
 }
 
+struct pipeline_compat *ngli_pass_get_pipeline_compat(const struct pass *s)
+{
+    const struct pipeline_desc *descs = ngli_darray_data(&s->pipeline_descs);
+    return descs[s->ctx->rnode_pos->id].pipeline_compat;
+}
+
 int ngli_pass_exec(struct pass *s)
 {
     struct ngl_ctx *ctx = s->ctx;
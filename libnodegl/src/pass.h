@@ -82,6 +82,7 @@ int ngli_pass_init(struct pass *s, struct ngl_ctx *ctx, const struct pass_params
 int ngli_pass_prepare(struct pass *s);
 void ngli_pass_uninit(struct pass *s);
 void ngli_pass_update_texture_uniforms(struct pipeline *pipeline, const struct pgcraft_texture_info *info);
+struct pipeline_compat *ngli_pass_get_pipeline_compat(const struct pass *s);
 int ngli_pass_exec(struct pass *s);
 
 #endif
@@ -19,13 +19,37 @@
  * under the License.
  */
 
+#include <inttypes.h>
+#include <stdio.h>
 #include <string.h>
 
+#include "gpu_ctx.h"
+#include "log.h"
 #include "memory.h"
 #include "internal.h"
 #include "pgcache.h"
 #include "utils.h"
 
+#define DISK_CACHE_MAGIC   NGLI_FOURCC('N','G','L','P')
+#define DISK_CACHE_VERSION 2
+
+/*
+ * Header of the program binaries stored on disk. Any mismatch with the
+ * current context (different node.gl version, different backend, hash
+ * collision, corrupted payload, ...) is treated as a cache miss and the entry
+ * is overwritten.
+ */
+struct disk_cache_header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t ngl_version;
+    uint32_t backend;
+    uint64_t key;
+    uint64_t size;
+    uint32_t checksum;
+    uint32_t padding;
+};
+
 static void reset_cached_program(void *user_arg, void *data)
 {
     struct program *p = data;
@@ -50,6 +74,178 @@ int ngli_pgcache_init(struct pgcache *s, struct gpu_ctx *gpu_ctx)
     return 0;
 }
 
+static uint64_t fnv1a(uint64_t hash, const void *data, size_t size)
+{
+    const uint8_t *p = data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= p[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static uint64_t get_disk_key(const struct gpu_ctx *gpu_ctx, const struct program_params *params)
+{
+    const int32_t ctx_info[] = {gpu_ctx->config.backend, gpu_ctx->version, gpu_ctx->language_version};
+    const char *srcs[] = {params->vertex, params->fragment, params->compute};
+
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    hash = fnv1a(hash, ctx_info, sizeof(ctx_info));
+    for (int i = 0; i < NGLI_ARRAY_NB(srcs); i++) {
+        /* the terminating nul separates the stages and marks absent ones */
+        const char *src = srcs[i] ? srcs[i] : "";
+        hash = fnv1a(hash, src, strlen(src) + 1);
+    }
+    return hash;
+}
+
+static char *get_disk_path(const struct gpu_ctx *gpu_ctx, uint64_t key)
+{
+    return ngli_asprintf("%s/%016" PRIx64 ".bin", gpu_ctx->config.program_cache_dir, key);
+}
+
+static void *disk_cache_load(const struct gpu_ctx *gpu_ctx, uint64_t key, size_t *sizep)
+{
+    char *path = get_disk_path(gpu_ctx, key);
+    if (!path)
+        return NULL;
+
+    void *data = NULL;
+    FILE *fp = fopen(path, "rb");
+    if (!fp)
+        goto end;
+
+    struct disk_cache_header hdr;
+    if (fread(&hdr, sizeof(hdr), 1, fp) != 1 ||
+        hdr.magic != DISK_CACHE_MAGIC ||
+        hdr.version != DISK_CACHE_VERSION ||
+        hdr.ngl_version != NGL_VERSION_INT ||
+        hdr.backend != gpu_ctx->config.backend ||
+        hdr.key != key) {
+        LOG(DEBUG, "ignoring stale program cache entry %s", path);
+        goto end;
+    }
+
+    /* The payload size is checked against the file before allocating it */
+    int64_t file_size;
+    if (ngli_get_filesize(path, &file_size) < 0 ||
+        !hdr.size || hdr.size != (uint64_t)file_size - sizeof(hdr)) {
+        LOG(DEBUG, "ignoring truncated or corrupted program cache entry %s", path);
+        goto end;
+    }
+
+    data = ngli_malloc(hdr.size);
+    if (!data)
+        goto end;
+
+    if (fread(data, hdr.size, 1, fp) != 1 ||
+        ngli_crc32_data(data, hdr.size) != hdr.checksum) {
+        LOG(DEBUG, "ignoring truncated or corrupted program cache entry %s", path);
+        ngli_freep(&data);
+        goto end;
+    }
+    *sizep = hdr.size;
+
+end:
+    if (fp)
+        fclose(fp);
+    ngli_free(path);
+    return data;
+}
+
+static int disk_cache_store(const struct gpu_ctx *gpu_ctx, uint64_t key, const void *data, size_t size)
+{
+    int ret = 0;
+    char *tmp_path = NULL;
+    char *path = get_disk_path(gpu_ctx, key);
+    if (!path)
+        return NGL_ERROR_MEMORY;
+
+    /*
+     * The entry is written to a temporary file which is then renamed so that
+     * other processes sharing the same cache directory never observe a
+     * partially written entry. The temporary file name is unique to the
+     * writer so that concurrent stores of the same key do not interleave.
+     */
+    tmp_path = ngli_get_tmp_filename(path);
+    if (!tmp_path) {
+        ret = NGL_ERROR_MEMORY;
+        goto end;
+    }
+
+    FILE *fp = fopen(tmp_path, "wb");
+    if (!fp) {
+        ret = NGL_ERROR_IO;
+        goto end;
+    }
+
+    const struct disk_cache_header hdr = {
+        .magic       = DISK_CACHE_MAGIC,
+        .version     = DISK_CACHE_VERSION,
+        .ngl_version = NGL_VERSION_INT,
+        .backend     = gpu_ctx->config.backend,
+        .key         = key,
+        .size        = size,
+        .checksum    = ngli_crc32_data(data, size),
+    };
+    const int written = fwrite(&hdr, sizeof(hdr), 1, fp) == 1 &&
+                        fwrite(data, size, 1, fp) == 1;
+    if (fclose(fp) || !written || rename(tmp_path, path)) {
+        remove(tmp_path);
+        ret = NGL_ERROR_IO;
+        goto end;
+    }
+
+end:
+    ngli_free(tmp_path);
+    ngli_free(path);
+    return ret;
+}
+
+static int disk_cache_init_program(struct pgcache *s, struct program **programp,
+                                   const struct program_params *params)
+{
+    struct gpu_ctx *gpu_ctx = s->gpu_ctx;
+    const uint64_t key = get_disk_key(gpu_ctx, params);
+
+    size_t size = 0;
+    void *data = disk_cache_load(gpu_ctx, key, &size);
+    if (data) {
+        int ret = ngli_program_init_from_binary(*programp, params, data, size);
+        ngli_free(data);
+        if (ret >= 0) {
+            gpu_ctx->stats[NGLI_GPU_STAT_PGCACHE_HITS]++;
+            return 0;
+        }
+
+        /* the program may be partially initialized, start over from scratch */
+        ngli_program_freep(programp);
+        *programp = ngli_program_create(gpu_ctx);
+        if (!*programp)
+            return NGL_ERROR_MEMORY;
+    }
+
+    gpu_ctx->stats[NGLI_GPU_STAT_PGCACHE_MISSES]++;
+
+    int ret = ngli_program_init(*programp, params);
+    if (ret < 0)
+        return ret;
+
+    ret = ngli_program_get_binary(*programp, &data, &size);
+    if (ret == NGL_ERROR_GRAPHICS_UNSUPPORTED)
+        return 0;
+    if (ret < 0)
+        return ret;
+
+    ret = disk_cache_store(gpu_ctx, key, data, size);
+    if (ret < 0)
+        LOG(WARNING, "unable to store program \"%s\" in cache directory %s",
+            params->label ? params->label : "", gpu_ctx->config.program_cache_dir);
+    ngli_free(data);
+
+    return 0;
+}
+
 static int query_cache(struct pgcache *s, struct program **dstp,
                        struct hmap *cache, const char *cache_key,
                        const struct program_params *params)
@@ -70,7 +266,8 @@ static int query_cache(struct pgcache *s, struct program **dstp,
     if (!new_program)
         return NGL_ERROR_MEMORY;
 
-    int ret = ngli_program_init(new_program, params);
+    int ret = gpu_ctx->config.program_cache_dir ? disk_cache_init_program(s, &new_program, params)
+                                                : ngli_program_init(new_program, params);
     if (ret < 0) {
         ngli_program_freep(&new_program);
         return ret;
@@ -119,6 +316,9 @@ void ngli_pgcache_reset(struct pgcache *s)
 {
     if (!s->gpu_ctx)
         return;
+    if (s->gpu_ctx->config.program_cache_dir)
+        LOG(DEBUG, "program cache: %" PRIu64 " disk hits, %" PRIu64 " disk misses",
+            s->gpu_ctx->stats[NGLI_GPU_STAT_PGCACHE_HITS], s->gpu_ctx->stats[NGLI_GPU_STAT_PGCACHE_MISSES]);
     ngli_hmap_freep(&s->compute_cache);
     ngli_hmap_freep(&s->graphics_cache);
     memset(s, 0, sizeof(*s));
@@ -201,6 +201,7 @@ static const int type_flags_map[NGLI_TYPE_NB] = {
     [NGLI_TYPE_IMAGE_2D_ARRAY]              = TYPE_FLAG_HAS_PRECISION|TYPE_FLAG_IS_SAMPLER_OR_IMAGE,
     [NGLI_TYPE_IMAGE_CUBE]                  = TYPE_FLAG_HAS_PRECISION|TYPE_FLAG_IS_SAMPLER_OR_IMAGE,
     [NGLI_TYPE_UNIFORM_BUFFER]              = 0,
+    [NGLI_TYPE_UNIFORM_BUFFER_DYNAMIC]      = 0,
     [NGLI_TYPE_STORAGE_BUFFER]              = 0,
 };
 
@@ -545,7 +546,8 @@ static int inject_block(struct pgcraft *s, struct bstr *b,
                         const struct pgcraft_block *named_block)
 {
     const struct block *block = named_block->block;
-    const int binding_type = named_block->type == NGLI_TYPE_UNIFORM_BUFFER
+    const int binding_type = named_block->type == NGLI_TYPE_UNIFORM_BUFFER ||
+                             named_block->type == NGLI_TYPE_UNIFORM_BUFFER_DYNAMIC
                            ? NGLI_BINDING_TYPE_UBO : NGLI_BINDING_TYPE_SSBO;
     struct pipeline_buffer_desc pl_buffer_desc = {
         .type    = named_block->type,
@@ -682,7 +684,7 @@ static int inject_ublock(struct pgcraft *s, struct bstr *b, int stage)
     struct pgcraft_block pgcraft_block = {
         /* instance name is empty to make field accesses identical to uniform accesses */
         .instance_name = "",
-        .type          = NGLI_TYPE_UNIFORM_BUFFER,
+        .type          = NGLI_TYPE_UNIFORM_BUFFER_DYNAMIC,
         .stage         = stage,
         .block         = block,
         .buffer        = NULL,
@@ -58,6 +58,11 @@ int ngli_pipeline_update_buffer(struct pipeline *s, int index, const struct buff
     return s->gpu_ctx->cls->pipeline_update_buffer(s, index, buffer, offset, size);
 }
 
+int ngli_pipeline_update_dynamic_offsets(struct pipeline *s, const uint32_t *offsets, int nb_offsets)
+{
+    return s->gpu_ctx->cls->pipeline_update_dynamic_offsets(s, offsets, nb_offsets);
+}
+
 void ngli_pipeline_draw(struct pipeline *s, int nb_vertices, int nb_instances)
 {
     s->gpu_ctx->cls->pipeline_draw(s, nb_vertices, nb_instances);
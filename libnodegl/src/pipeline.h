@@ -130,6 +130,13 @@ int ngli_pipeline_update_attribute(struct pipeline *s, int index, const struct b
 int ngli_pipeline_update_uniform(struct pipeline *s, int index, const void *value);
 int ngli_pipeline_update_texture(struct pipeline *s, int index, const struct texture *texture);
 int ngli_pipeline_update_buffer(struct pipeline *s, int index, const struct buffer *buffer, int offset, int size);
+
+/*
+ * Set the offsets applied on top of the binding offsets of the dynamic buffers
+ * (NGLI_TYPE_*_DYNAMIC) for the subsequent draws and dispatches. The offsets
+ * are specified in the order of the dynamic buffers in the pipeline layout.
+ */
+int ngli_pipeline_update_dynamic_offsets(struct pipeline *s, const uint32_t *offsets, int nb_offsets);
 void ngli_pipeline_draw(struct pipeline *s, int nb_vertices, int nb_instances);
 void ngli_pipeline_draw_indexed(struct pipeline *s, const struct buffer *indices, int indices_format, int nb_indices, int nb_instances);
 void ngli_pipeline_dispatch(struct pipeline *s, int nb_group_x, int nb_group_y, int nb_group_z);
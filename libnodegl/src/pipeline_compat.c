@@ -19,18 +19,37 @@
  * under the License.
  */
 
+#include <string.h>
+
 #include "darray.h"
+#include "gpu_ctx.h"
+#include "log.h"
 #include "memory.h"
 #include "nodegl.h"
 #include "pipeline_compat.h"
 #include "type.h"
+#include "utils.h"
 
 struct pipeline_compat {
     struct gpu_ctx *gpu_ctx;
     struct pipeline *pipeline;
     const struct pgcraft_compat_info *compat_info;
-    struct buffer *ubuffers[NGLI_PROGRAM_SHADER_NB];
-    uint8_t *mapped_datas[NGLI_PROGRAM_SHADER_NB];
+
+    /*
+     * The uniform blocks are not backed by a buffer of their own: their
+     * content is kept on the CPU side and copied at every draw into the
+     * uniform ring of the context, which is shared by all the pipelines and
+     * bound with dynamic offsets.
+     */
+    uint8_t *ublock_datas[NGLI_PROGRAM_SHADER_NB];
+    int ubo_indices[NGLI_PROGRAM_SHADER_NB];
+    int dynamic_offset_indices[NGLI_PROGRAM_SHADER_NB];
+    uint32_t dynamic_offsets[NGLI_PROGRAM_SHADER_NB];
+    int nb_dynamic_offsets;
+
+    /* Texture bound to the lowest index, used as a draw sort key */
+    int texture_index;
+    const struct texture *texture;
 };
 
 struct pipeline_compat *ngli_pipeline_compat_create(struct gpu_ctx *gpu_ctx)
@@ -39,6 +58,7 @@ struct pipeline_compat *ngli_pipeline_compat_create(struct gpu_ctx *gpu_ctx)
     if (!s)
         return NULL;
     s->gpu_ctx = gpu_ctx;
+    s->texture_index = -1;
     return s;
 }
 
@@ -46,7 +66,7 @@ static int get_pipeline_ubo_index(const struct pipeline_params *params, int bind
 {
     const struct pipeline_layout *layout = &params->layout;
     for (int i = 0; i < layout->nb_buffers; i++) {
-        if (layout->buffers_desc[i].type == NGLI_TYPE_UNIFORM_BUFFER &&
+        if (layout->buffers_desc[i].type == NGLI_TYPE_UNIFORM_BUFFER_DYNAMIC &&
             layout->buffers_desc[i].stage == stage &&
             layout->buffers_desc[i].binding == binding) {
             return i;
@@ -57,36 +77,66 @@ static int get_pipeline_ubo_index(const struct pipeline_params *params, int bind
 
 static int init_blocks_buffers(struct pipeline_compat *s, const struct pipeline_compat_params *params)
 {
-    struct gpu_ctx *gpu_ctx = s->gpu_ctx;
+    const struct pipeline_params *pipeline_params = params->params;
+    const struct pipeline_layout *layout = &pipeline_params->layout;
 
     for (int i = 0; i < NGLI_PROGRAM_SHADER_NB; i++) {
         const struct block *block = &s->compat_info->ublocks[i];
         if (!block->size)
             continue;
 
-        struct buffer *buffer = ngli_buffer_create(gpu_ctx);
-        if (!buffer)
+        s->ublock_datas[i] = ngli_calloc(1, block->size);
+        if (!s->ublock_datas[i])
             return NGL_ERROR_MEMORY;
-        s->ubuffers[i] = buffer;
 
-        int ret = ngli_buffer_init(buffer,
-                                   block->size,
-                                   NGLI_BUFFER_USAGE_DYNAMIC_BIT |
-                                   NGLI_BUFFER_USAGE_UNIFORM_BUFFER_BIT |
-                                   NGLI_BUFFER_USAGE_MAP_WRITE);
+        const int index = get_pipeline_ubo_index(pipeline_params, s->compat_info->ubindings[i], i);
+        ngli_assert(index >= 0);
+        s->ubo_indices[i] = index;
+
+        /* Dynamic offsets are specified in the order of the layout buffers */
+        int dynamic_offset_index = 0;
+        for (int j = 0; j < index; j++) {
+            if (layout->buffers_desc[j].type == NGLI_TYPE_UNIFORM_BUFFER_DYNAMIC)
+                dynamic_offset_index++;
+        }
+        s->dynamic_offset_indices[i] = dynamic_offset_index;
+        s->nb_dynamic_offsets++;
+    }
+
+    return 0;
+}
+
+static int upload_blocks(struct pipeline_compat *s)
+{
+    if (!s->compat_info->use_ublocks)
+        return 0;
+
+    for (int i = 0; i < NGLI_PROGRAM_SHADER_NB; i++) {
+        const struct block *block = &s->compat_info->ublocks[i];
+        if (!block->size)
+            continue;
+
+        struct buffer *buffer;
+        size_t offset;
+        void *data;
+        int ret = ngli_gpu_ctx_alloc_uniform_data(s->gpu_ctx, block->size, &buffer, &offset, &data);
         if (ret < 0)
             return ret;
-
-        ret = ngli_buffer_map(buffer, buffer->size, 0, (void **)&s->mapped_datas[i]);
+        memcpy(data, s->ublock_datas[i], block->size);
+
+        /*
+         * The uniform memory is shared by all the frames, so the buffer only
+         * changes when the data spills to another chunk: redundant bindings
+         * are filtered by the pipeline and the data of the current frame is
+         * selected with the dynamic offset.
+         */
+        ret = ngli_pipeline_update_buffer(s->pipeline, s->ubo_indices[i], buffer, 0, block->size);
         if (ret < 0)
             return ret;
-
-        const struct pipeline_params *pipeline_params = params->params;
-        const int index = get_pipeline_ubo_index(pipeline_params, s->compat_info->ubindings[i], i);
-        ngli_pipeline_update_buffer(s->pipeline, index, buffer, 0, buffer->size);
+        s->dynamic_offsets[s->dynamic_offset_indices[i]] = offset;
     }
 
-    return 0;
+    return ngli_pipeline_update_dynamic_offsets(s->pipeline, s->dynamic_offsets, s->nb_dynamic_offsets);
 }
 
 int ngli_pipeline_compat_init(struct pipeline_compat *s, const struct pipeline_compat_params *params)
@@ -105,6 +155,14 @@ int ngli_pipeline_compat_init(struct pipeline_compat *s, const struct pipeline_c
         (ret = ngli_pipeline_set_resources(s->pipeline, pipeline_resources)) < 0)
         return ret;
 
+    for (int i = 0; i < pipeline_resources->nb_textures; i++) {
+        if (pipeline_resources->textures[i]) {
+            s->texture_index = i;
+            s->texture = pipeline_resources->textures[i];
+            break;
+        }
+    }
+
     s->compat_info = params->compat_info;
     if (s->compat_info->use_ublocks) {
         ret = init_blocks_buffers(s, params);
@@ -134,7 +192,7 @@ int ngli_pipeline_compat_update_uniform(struct pipeline_compat *s, int index, co
     const struct block_field *fields = ngli_darray_data(&block->fields);
     const struct block_field *field = &fields[field_index];
     if (value) {
-        uint8_t *dst = s->mapped_datas[stage] + field->offset;
+        uint8_t *dst = s->ublock_datas[stage] + field->offset;
         ngli_block_field_copy(field, dst, value);
     }
 
@@ -143,6 +201,10 @@ int ngli_pipeline_compat_update_uniform(struct pipeline_compat *s, int index, co
 
 int ngli_pipeline_compat_update_texture(struct pipeline_compat *s, int index, const struct texture *texture)
 {
+    if (index >= 0 && (s->texture_index < 0 || index <= s->texture_index)) {
+        s->texture_index = index;
+        s->texture = texture;
+    }
     return ngli_pipeline_update_texture(s->pipeline, index, texture);
 }
 
@@ -214,18 +276,43 @@ int ngli_pipeline_compat_update_buffer(struct pipeline_compat *s, int index, con
     return ngli_pipeline_update_buffer(s->pipeline, index, buffer, offset, size);
 }
 
+const struct program *ngli_pipeline_compat_get_program(const struct pipeline_compat *s)
+{
+    return s->pipeline->program;
+}
+
+const struct texture *ngli_pipeline_compat_get_texture(const struct pipeline_compat *s)
+{
+    return s->texture;
+}
+
 void ngli_pipeline_compat_draw(struct pipeline_compat *s, int nb_vertices, int nb_instances)
 {
+    int ret = upload_blocks(s);
+    if (ret < 0) {
+        LOG(ERROR, "could not upload uniform blocks");
+        return;
+    }
     ngli_pipeline_draw(s->pipeline, nb_vertices, nb_instances);
 }
 
 void ngli_pipeline_compat_draw_indexed(struct pipeline_compat *s, const struct buffer *indices, int indices_format, int nb_indices, int nb_instances)
 {
+    int ret = upload_blocks(s);
+    if (ret < 0) {
+        LOG(ERROR, "could not upload uniform blocks");
+        return;
+    }
     ngli_pipeline_draw_indexed(s->pipeline, indices, indices_format, nb_indices, nb_instances);
 }
 
 void ngli_pipeline_compat_dispatch(struct pipeline_compat *s, int nb_group_x, int nb_group_y, int nb_group_z)
 {
+    int ret = upload_blocks(s);
+    if (ret < 0) {
+        LOG(ERROR, "could not upload uniform blocks");
+        return;
+    }
     ngli_pipeline_dispatch(s->pipeline, nb_group_x, nb_group_y, nb_group_z);
 }
 
@@ -235,13 +322,7 @@ void ngli_pipeline_compat_freep(struct pipeline_compat **sp)
     if (!s)
         return;
     ngli_pipeline_freep(&s->pipeline);
-    if (s->compat_info && s->compat_info->use_ublocks) {
-        for (int i = 0; i < NGLI_PROGRAM_SHADER_NB; i++) {
-            if (s->ubuffers[i]) {
-                ngli_buffer_unmap(s->ubuffers[i]);
-                ngli_buffer_freep(&s->ubuffers[i]);
-            }
-        }
-    }
+    for (int i = 0; i < NGLI_PROGRAM_SHADER_NB; i++)
+        ngli_freep(&s->ublock_datas[i]);
     ngli_freep(sp);
 }
@@ -40,6 +40,14 @@ int ngli_pipeline_compat_update_uniform(struct pipeline_compat *s, int index, co
 int ngli_pipeline_compat_update_texture(struct pipeline_compat *s, int index, const struct texture *texture);
 void ngli_pipeline_compat_update_texture_info(struct pipeline_compat *s, const struct pgcraft_texture_info *info);
 int ngli_pipeline_compat_update_buffer(struct pipeline_compat *s, int index, const struct buffer *buffer, int offset, int size);
+
+/*
+ * Program and texture bound to the lowest index of the pipeline, giving an
+ * approximation of the GPU states switched when drawing with it
+ */
+const struct program *ngli_pipeline_compat_get_program(const struct pipeline_compat *s);
+const struct texture *ngli_pipeline_compat_get_texture(const struct pipeline_compat *s);
+
 void ngli_pipeline_compat_draw(struct pipeline_compat *s, int nb_vertices, int nb_instances);
 void ngli_pipeline_compat_draw_indexed(struct pipeline_compat *s, const struct buffer *indices, int indices_format, int nb_indices, int nb_instances);
 void ngli_pipeline_compat_dispatch(struct pipeline_compat *s, int nb_group_x, int nb_group_y, int nb_group_z);
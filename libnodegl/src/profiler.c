@@ -0,0 +1,418 @@
+/*
+ * Copyright 2023 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bstr.h"
+#include "gpu_ctx.h"
+#include "hmap.h"
+#include "internal.h"
+#include "log.h"
+#include "memory.h"
+#include "profiler.h"
+#include "utils.h"
+
+/* Upper bound on the number of recorded events (about 32MB) */
+#define MAX_EVENTS (1 << 20)
+
+/* Chrome trace thread identifier of the GPU timeline */
+#define GPU_TID 0
+
+struct profiler_event {
+    const char *name;       // interned label
+    const char *class_name;
+    int type;
+    int tid;
+    int64_t ts;             // nanoseconds
+    int64_t dur;            // nanoseconds
+};
+
+struct profiler_gpu_event {
+    const char *name;       // interned label
+    const char *class_name;
+    int index;              // index of the start timestamp, the end is at index + 1
+};
+
+static const char * const event_categories[NGLI_PROFILER_EVENT_NB] = {
+    [NGLI_PROFILER_EVENT_UPDATE]   = "update",
+    [NGLI_PROFILER_EVENT_DRAW]     = "draw",
+    [NGLI_PROFILER_EVENT_PREFETCH] = "prefetch",
+    [NGLI_PROFILER_EVENT_RELEASE]  = "release",
+    [NGLI_PROFILER_EVENT_GPU]      = "gpu",
+};
+
+static void free_label(void *user_arg, void *data)
+{
+    ngli_free(data);
+}
+
+int ngli_profiler_init(struct profiler *s, struct gpu_ctx *gpu_ctx, const struct ngl_config *config)
+{
+    memset(s, 0, sizeof(*s));
+
+    if (!config->profiler)
+        return 0;
+
+    s->gpu_ctx = gpu_ctx;
+    ngli_darray_init(&s->events, sizeof(struct profiler_event), 0);
+    for (int i = 0; i < NGLI_GPU_NB_QUERY_FRAMES; i++)
+        ngli_darray_init(&s->frames[i].gpu_events, sizeof(struct profiler_gpu_event), 0);
+
+    if (config->profiler_export_filename) {
+        s->export_filename = ngli_strdup(config->profiler_export_filename);
+        if (!s->export_filename)
+            goto fail;
+    }
+
+    s->labels = ngli_hmap_create();
+    if (!s->labels)
+        goto fail;
+    ngli_hmap_set_free(s->labels, free_label, NULL);
+
+    if (pthread_mutex_init(&s->lock, NULL))
+        goto fail;
+
+    s->gpu_timing = 1;
+    s->enabled = 1;
+
+    return 0;
+
+fail:
+    ngli_hmap_freep(&s->labels);
+    ngli_freep(&s->export_filename);
+    ngli_darray_reset(&s->events);
+    for (int i = 0; i < NGLI_GPU_NB_QUERY_FRAMES; i++)
+        ngli_darray_reset(&s->frames[i].gpu_events);
+    return NGL_ERROR_MEMORY;
+}
+
+/* Must be called with the lock held */
+static const char *intern_label(struct profiler *s, const char *label)
+{
+    char *name = ngli_hmap_get(s->labels, label);
+    if (name)
+        return name;
+
+    name = ngli_strdup(label);
+    if (!name)
+        return NULL;
+
+    if (ngli_hmap_set(s->labels, label, name) < 0) {
+        ngli_free(name);
+        return NULL;
+    }
+    return name;
+}
+
+/* Must be called with the lock held */
+static int get_thread_index(struct profiler *s)
+{
+    const uint64_t id = ngli_thread_get_id();
+    for (int i = 0; i < s->nb_threads; i++)
+        if (s->threads[i] == id)
+            return i;
+    if (s->nb_threads == NGLI_PROFILER_MAX_THREADS)
+        return NGLI_PROFILER_MAX_THREADS - 1;
+    s->threads[s->nb_threads] = id;
+    return s->nb_threads++;
+}
+
+/* Must be called with the lock held */
+static void push_event(struct profiler *s, const struct profiler_event *event)
+{
+    if (ngli_darray_count(&s->events) == MAX_EVENTS) {
+        if (!s->overflow)
+            LOG(WARNING, "profiler event limit reached, dropping the next events");
+        s->overflow = 1;
+        return;
+    }
+
+    if (!ngli_darray_push(&s->events, event))
+        s->overflow = 1;
+}
+
+void ngli_profiler_add_event(struct profiler *s, int type, const struct ngl_node *node, int64_t start_time)
+{
+    const int64_t end_time = ngli_gettime_relative();
+
+    pthread_mutex_lock(&s->lock);
+    const struct profiler_event event = {
+        .name       = intern_label(s, node->label),
+        .class_name = node->cls->name,
+        .type       = type,
+        .tid        = GPU_TID + 1 + get_thread_index(s),
+        .ts         = start_time * 1000,
+        .dur        = (end_time - start_time) * 1000,
+    };
+    if (event.name)
+        push_event(s, &event);
+    pthread_mutex_unlock(&s->lock);
+}
+
+static void drop_frame(struct profiler *s, struct profiler_frame *frame)
+{
+    if (!s->nb_dropped_frames)
+        LOG(WARNING, "GPU timestamps are not available in time, dropping the GPU timings of some frames");
+    s->nb_dropped_frames++;
+    frame->pending = 0;
+}
+
+void ngli_profiler_begin_frame(struct profiler *s)
+{
+    s->frame_index = (s->frame_index + 1) % NGLI_GPU_NB_QUERY_FRAMES;
+
+    /* The frame queries are about to be reused */
+    struct profiler_frame *frame = &s->frames[s->frame_index];
+    if (frame->pending)
+        drop_frame(s, frame);
+
+    frame->nb_timestamps = 0;
+    ngli_darray_clear(&frame->gpu_events);
+
+    if (!s->gpu_timing)
+        return;
+
+    /* The first timestamp of the frame anchors the GPU timeline on the CPU clock */
+    frame->start_time = ngli_gettime_relative();
+    int ret = ngli_gpu_ctx_write_timestamp(s->gpu_ctx, 0);
+    if (ret < 0) {
+        LOG(WARNING, "GPU timestamps are not supported, only the CPU timings will be recorded");
+        s->gpu_timing = 0;
+        return;
+    }
+    frame->nb_timestamps = 1;
+}
+
+int ngli_profiler_gpu_begin(struct profiler *s)
+{
+    struct profiler_frame *frame = &s->frames[s->frame_index];
+    if (!s->gpu_timing || frame->nb_timestamps + 2 > NGLI_GPU_MAX_TIMESTAMPS)
+        return -1;
+
+    const int index = frame->nb_timestamps;
+    int ret = ngli_gpu_ctx_write_timestamp(s->gpu_ctx, index);
+    if (ret < 0)
+        return -1;
+    frame->nb_timestamps += 2;
+    return index;
+}
+
+void ngli_profiler_gpu_end(struct profiler *s, const struct ngl_node *node, int index)
+{
+    if (index < 0)
+        return;
+
+    ngli_gpu_ctx_write_timestamp(s->gpu_ctx, index + 1);
+
+    /*
+     * The label is interned right away since the node may be released (with a
+     * scene change) before the timestamps of the frame are read back
+     */
+    pthread_mutex_lock(&s->lock);
+    const char *name = intern_label(s, node->label);
+    pthread_mutex_unlock(&s->lock);
+    if (!name)
+        return;
+
+    struct profiler_frame *frame = &s->frames[s->frame_index];
+    const struct profiler_gpu_event gpu_event = {
+        .name       = name,
+        .class_name = node->cls->name,
+        .index      = index,
+    };
+    if (!ngli_darray_push(&frame->gpu_events, &gpu_event))
+        LOG(ERROR, "could not record GPU event %s", name);
+}
+
+/*
+ * Collect the GPU events of a past frame; returns 0 if its timestamps are not
+ * available yet
+ */
+static int collect_frame(struct profiler *s, struct profiler_frame *frame, int latency)
+{
+    int64_t timestamps[NGLI_GPU_MAX_TIMESTAMPS];
+    int ret = ngli_gpu_ctx_get_timestamps(s->gpu_ctx, latency, timestamps, frame->nb_timestamps);
+    if (ret <= 0) {
+        if (ret < 0) {
+            LOG(ERROR, "could not read GPU timestamps: %s", NGLI_RET_STR(ret));
+            frame->pending = 0;
+        }
+        return ret;
+    }
+
+    const int64_t origin = frame->start_time * 1000 - timestamps[0];
+    const struct profiler_gpu_event *gpu_events = ngli_darray_data(&frame->gpu_events);
+
+    pthread_mutex_lock(&s->lock);
+    for (int i = 0; i < ngli_darray_count(&frame->gpu_events); i++) {
+        const struct profiler_gpu_event *gpu_event = &gpu_events[i];
+        const int64_t start = timestamps[gpu_event->index];
+        const int64_t end = timestamps[gpu_event->index + 1];
+        const struct profiler_event event = {
+            .name       = gpu_event->name,
+            .class_name = gpu_event->class_name,
+            .type       = NGLI_PROFILER_EVENT_GPU,
+            .tid        = GPU_TID,
+            .ts         = origin + start,
+            .dur        = NGLI_MAX(end - start, 0),
+        };
+        push_event(s, &event);
+    }
+    pthread_mutex_unlock(&s->lock);
+
+    frame->pending = 0;
+    return 1;
+}
+
+/*
+ * Collect the pending frames from the oldest to the most recent one (latency
+ * 0). The GPU completes the frames in order, so the collection stops at the
+ * first frame which is not available yet. The oldest frame is dropped if it
+ * is still not available since its queries are reused by the next frame.
+ */
+static void collect_frames(struct profiler *s)
+{
+    for (int latency = NGLI_GPU_NB_QUERY_FRAMES - 1; latency >= 0; latency--) {
+        const int index = (s->frame_index - latency + NGLI_GPU_NB_QUERY_FRAMES) % NGLI_GPU_NB_QUERY_FRAMES;
+        struct profiler_frame *frame = &s->frames[index];
+        if (!frame->pending)
+            continue;
+
+        if (collect_frame(s, frame, latency) == 0) {
+            if (latency == NGLI_GPU_NB_QUERY_FRAMES - 1)
+                drop_frame(s, frame);
+            else
+                break;
+        }
+    }
+}
+
+void ngli_profiler_end_frame(struct profiler *s)
+{
+    struct profiler_frame *frame = &s->frames[s->frame_index];
+    frame->pending = ngli_darray_count(&frame->gpu_events) > 0;
+    collect_frames(s);
+}
+
+static void print_json_string(struct bstr *b, const char *str)
+{
+    ngli_bstr_print(b, "\"");
+    for (int i = 0; str[i]; i++) {
+        const uint8_t c = str[i];
+        if (c == '"' || c == '\\')
+            ngli_bstr_printf(b, "\\%c", c);
+        else if (c < 0x20)
+            ngli_bstr_printf(b, "\\u%04x", c);
+        else
+            ngli_bstr_printf(b, "%c", c);
+    }
+    ngli_bstr_print(b, "\"");
+}
+
+static void print_thread_name(struct bstr *b, int tid, const char *name)
+{
+    ngli_bstr_printf(b, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                     "\"args\":{\"name\":\"%s\"}},\n", tid, name);
+}
+
+char *ngli_profiler_get_trace(struct profiler *s)
+{
+    struct bstr *b = ngli_bstr_create();
+    if (!b)
+        return NULL;
+
+    ngli_bstr_print(b, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    if (s->enabled) {
+        pthread_mutex_lock(&s->lock);
+
+        print_thread_name(b, GPU_TID, "GPU");
+        for (int i = 0; i < s->nb_threads; i++) {
+            char name[32];
+            snprintf(name, sizeof(name), "CPU thread %d", i);
+            print_thread_name(b, GPU_TID + 1 + i, name);
+        }
+
+        const struct profiler_event *events = ngli_darray_data(&s->events);
+        for (int i = 0; i < ngli_darray_count(&s->events); i++) {
+            const struct profiler_event *event = &events[i];
+            ngli_bstr_print(b, "{\"name\":");
+            print_json_string(b, event->name);
+            ngli_bstr_printf(b, ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                             "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"class\":\"%s\"}},\n",
+                             event_categories[event->type], event->tid,
+                             event->ts / 1000.0, event->dur / 1000.0, event->class_name);
+        }
+
+        pthread_mutex_unlock(&s->lock);
+    }
+
+    /* Terminate with a metadata event so that every event above can end with a comma */
+    ngli_bstr_print(b, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"node.gl\"}}\n]}\n");
+
+    char *ret = ngli_bstr_check(b) < 0 ? NULL : ngli_bstr_strdup(b);
+    ngli_bstr_freep(&b);
+    return ret;
+}
+
+static void export_trace(struct profiler *s)
+{
+    char *trace = ngli_profiler_get_trace(s);
+    if (!trace) {
+        LOG(ERROR, "could not serialize profiler trace");
+        return;
+    }
+
+    FILE *fp = fopen(s->export_filename, "wb");
+    if (!fp) {
+        LOG(ERROR, "could not open %s for writing", s->export_filename);
+        ngli_free(trace);
+        return;
+    }
+
+    const size_t len = strlen(trace);
+    if (fwrite(trace, 1, len, fp) != len)
+        LOG(ERROR, "could not write profiler trace to %s", s->export_filename);
+    fclose(fp);
+    ngli_free(trace);
+}
+
+void ngli_profiler_reset(struct profiler *s)
+{
+    if (!s->enabled)
+        return;
+
+    /* The GPU is idle at this point: all the pending timestamps are available */
+    collect_frames(s);
+
+    if (s->export_filename)
+        export_trace(s);
+
+    pthread_mutex_destroy(&s->lock);
+    ngli_hmap_freep(&s->labels);
+    ngli_freep(&s->export_filename);
+    ngli_darray_reset(&s->events);
+    for (int i = 0; i < NGLI_GPU_NB_QUERY_FRAMES; i++)
+        ngli_darray_reset(&s->frames[i].gpu_events);
+    memset(s, 0, sizeof(*s));
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2023 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+
+#include "darray.h"
+#include "gpu_ctx.h"
+#include "pthread_compat.h"
+
+#define NGLI_PROFILER_MAX_THREADS 16
+
+enum {
+    NGLI_PROFILER_EVENT_UPDATE,
+    NGLI_PROFILER_EVENT_DRAW,
+    NGLI_PROFILER_EVENT_PREFETCH,
+    NGLI_PROFILER_EVENT_RELEASE,
+    NGLI_PROFILER_EVENT_GPU,
+    NGLI_PROFILER_EVENT_NB
+};
+
+struct hmap;
+struct ngl_config;
+struct ngl_node;
+
+/* GPU timings of a frame, pending until its timestamps are read back */
+struct profiler_frame {
+    int pending;
+    int nb_timestamps;
+    int64_t start_time;
+    struct darray gpu_events; // array of struct profiler_gpu_event
+};
+
+/*
+ * Per-node profiler, enabled with ngl_config.profiler.
+ *
+ * The CPU time spent in the update, draw, prefetch and release callbacks of
+ * every node is recorded along with the GPU time of every render and compute
+ * pass, measured with GPU timestamp queries. The GPU timestamps are aligned on
+ * the CPU clock at the beginning of each frame and collected without waiting
+ * up to NGLI_GPU_NB_QUERY_FRAMES - 1 frames later. Events are accumulated until
+ * the context is reset and can be serialized in the Chrome trace event
+ * format (chrome://tracing, Perfetto).
+ *
+ * The callers are expected to check the enabled field before collecting any
+ * timing so that a disabled profiler costs a single branch per hook.
+ */
+struct profiler {
+    int enabled;
+    struct gpu_ctx *gpu_ctx;
+    char *export_filename;
+
+    pthread_mutex_t lock;
+    struct darray events;   // array of struct profiler_event
+    struct hmap *labels;    // interned event names
+    uint64_t threads[NGLI_PROFILER_MAX_THREADS];
+    int nb_threads;
+    int overflow;
+
+    /* GPU timings of the last frames, only accessed from the rendering thread */
+    int gpu_timing;
+    struct profiler_frame frames[NGLI_GPU_NB_QUERY_FRAMES];
+    int frame_index;        // ring index of the current frame
+    int nb_dropped_frames;
+};
+
+int ngli_profiler_init(struct profiler *s, struct gpu_ctx *gpu_ctx, const struct ngl_config *config);
+void ngli_profiler_add_event(struct profiler *s, int type, const struct ngl_node *node, int64_t start_time);
+void ngli_profiler_begin_frame(struct profiler *s);
+int ngli_profiler_gpu_begin(struct profiler *s);
+void ngli_profiler_gpu_end(struct profiler *s, const struct ngl_node *node, int index);
+void ngli_profiler_end_frame(struct profiler *s);
+char *ngli_profiler_get_trace(struct profiler *s);
+void ngli_profiler_reset(struct profiler *s);
+
+#endif
@@ -20,11 +20,16 @@
  */
 
 #include "gpu_ctx.h"
+#include "nodegl.h"
 #include "program.h"
 
 struct program *ngli_program_create(struct gpu_ctx *gpu_ctx)
 {
-    return gpu_ctx->cls->program_create(gpu_ctx);
+    struct program *s = gpu_ctx->cls->program_create(gpu_ctx);
+    if (!s)
+        return NULL;
+    s->id = ++gpu_ctx->object_id;
+    return s;
 }
 
 int ngli_program_init(struct program *s, const struct program_params *params)
@@ -32,6 +37,22 @@ int ngli_program_init(struct program *s, const struct program_params *params)
     return s->gpu_ctx->cls->program_init(s, params);
 }
 
+int ngli_program_init_from_binary(struct program *s, const struct program_params *params, const void *data, size_t size)
+{
+    const struct gpu_ctx_class *cls = s->gpu_ctx->cls;
+    if (!cls->program_init_from_binary)
+        return NGL_ERROR_GRAPHICS_UNSUPPORTED;
+    return cls->program_init_from_binary(s, params, data, size);
+}
+
+int ngli_program_get_binary(struct program *s, void **datap, size_t *sizep)
+{
+    const struct gpu_ctx_class *cls = s->gpu_ctx->cls;
+    if (!cls->program_get_binary)
+        return NGL_ERROR_GRAPHICS_UNSUPPORTED;
+    return cls->program_get_binary(s, datap, sizep);
+}
+
 void ngli_program_freep(struct program **sp)
 {
     if (!*sp)
@@ -22,6 +22,9 @@
 #ifndef PROGRAM_H
 #define PROGRAM_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include "hmap.h"
 
 struct gpu_ctx;
@@ -49,6 +52,7 @@ struct program_params {
 
 struct program {
     struct gpu_ctx *gpu_ctx;
+    uint64_t id; /* creation order identifier, stable from one run to another unlike the address */
     struct hmap *uniforms;
     struct hmap *attributes;
     struct hmap *buffer_blocks;
@@ -56,6 +60,8 @@ struct program {
 
 struct program *ngli_program_create(struct gpu_ctx *gpu_ctx);
 int ngli_program_init(struct program *s, const struct program_params *params);
+int ngli_program_init_from_binary(struct program *s, const struct program_params *params, const void *data, size_t size);
+int ngli_program_get_binary(struct program *s, void **datap, size_t *sizep);
 void ngli_program_freep(struct program **sp);
 
 #endif
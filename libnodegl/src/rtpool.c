@@ -0,0 +1,156 @@
+/*
+ * Copyright 2023 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include <string.h>
+
+#include "format.h"
+#include "gpu_ctx.h"
+#include "memory.h"
+#include "rtpool.h"
+#include "utils.h"
+
+struct rtpool_entry {
+    struct texture_params params;
+    int slot;
+    int refcount;
+    uint64_t size;
+    struct texture *texture;
+};
+
+static void free_entry(struct rtpool *s, struct rtpool_entry **entryp)
+{
+    struct rtpool_entry *entry = *entryp;
+    if (!entry)
+        return;
+    s->size -= entry->size;
+    ngli_texture_freep(&entry->texture);
+    ngli_freep(entryp);
+}
+
+int ngli_rtpool_init(struct rtpool *s, struct gpu_ctx *gpu_ctx)
+{
+    memset(s, 0, sizeof(*s));
+    s->gpu_ctx = gpu_ctx;
+    ngli_darray_init(&s->entries, sizeof(struct rtpool_entry *), 0);
+    return 0;
+}
+
+static int params_match(const struct texture_params *a, const struct texture_params *b)
+{
+    return a->type    == b->type    &&
+           a->format  == b->format  &&
+           a->width   == b->width   &&
+           a->height  == b->height  &&
+           a->depth   == b->depth   &&
+           a->samples == b->samples &&
+           a->usage   == b->usage;
+}
+
+int ngli_rtpool_acquire(struct rtpool *s, const struct texture_params *params, int slot, struct texture **texturep)
+{
+    struct rtpool_entry **entries = ngli_darray_data(&s->entries);
+    for (int i = 0; i < ngli_darray_count(&s->entries); i++) {
+        struct rtpool_entry *entry = entries[i];
+        if (entry->slot == slot && params_match(&entry->params, params)) {
+            entry->refcount++;
+            *texturep = entry->texture;
+            return 0;
+        }
+    }
+
+    struct rtpool_entry *entry = ngli_calloc(1, sizeof(*entry));
+    if (!entry)
+        return NGL_ERROR_MEMORY;
+    entry->params = *params;
+    entry->slot = slot;
+
+    entry->texture = ngli_texture_create(s->gpu_ctx);
+    if (!entry->texture) {
+        ngli_freep(&entry);
+        return NGL_ERROR_MEMORY;
+    }
+
+    int ret = ngli_texture_init(entry->texture, params);
+    if (ret < 0) {
+        free_entry(s, &entry);
+        return ret;
+    }
+
+    if (!ngli_darray_push(&s->entries, &entry)) {
+        free_entry(s, &entry);
+        return NGL_ERROR_MEMORY;
+    }
+
+    entry->size = (uint64_t)params->width
+                * params->height
+                * NGLI_MAX(params->depth, 1)
+                * NGLI_MAX(params->samples, 1)
+                * ngli_format_get_bytes_per_pixel(params->format);
+    s->size += entry->size;
+    s->peak_size = NGLI_MAX(s->peak_size, s->size);
+
+    entry->refcount = 1;
+    *texturep = entry->texture;
+    return 0;
+}
+
+void ngli_rtpool_releasep(struct rtpool *s, struct texture **texturep)
+{
+    struct texture *texture = *texturep;
+    if (!texture)
+        return;
+
+    struct rtpool_entry **entries = ngli_darray_data(&s->entries);
+    for (int i = 0; i < ngli_darray_count(&s->entries); i++) {
+        struct rtpool_entry *entry = entries[i];
+        if (entry->texture == texture) {
+            ngli_assert(entry->refcount > 0);
+            entry->refcount--;
+            *texturep = NULL;
+            return;
+        }
+    }
+
+    ngli_assert(0);
+}
+
+void ngli_rtpool_collect(struct rtpool *s)
+{
+    struct rtpool_entry **entries = ngli_darray_data(&s->entries);
+    for (int i = 0; i < ngli_darray_count(&s->entries); i++) {
+        struct rtpool_entry *entry = entries[i];
+        if (!entry->refcount) {
+            free_entry(s, &entries[i]);
+            ngli_darray_remove(&s->entries, i);
+            i--;
+        }
+    }
+}
+
+void ngli_rtpool_reset(struct rtpool *s)
+{
+    struct rtpool_entry **entries = ngli_darray_data(&s->entries);
+    for (int i = 0; i < ngli_darray_count(&s->entries); i++)
+        free_entry(s, &entries[i]);
+    ngli_darray_reset(&s->entries);
+    memset(s, 0, sizeof(*s));
+}
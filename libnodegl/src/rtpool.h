@@ -0,0 +1,58 @@
+/*
+ * Copyright 2023 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#ifndef RTPOOL_H
+#define RTPOOL_H
+
+#include <stdint.h>
+
+#include "darray.h"
+#include "texture.h"
+
+/*
+ * Pool of the transient attachments (multisample and implicit depth/stencil
+ * textures) used internally by the RenderToTexture nodes.
+ *
+ * Attachments are identified by their parameters and by a slot. RenderToTexture
+ * nodes request their attachments using their nesting level in the graph and
+ * the attachment index as slot: since two RenderToTexture at the same nesting
+ * level can never be drawn at the same time, they can safely share the same
+ * textures.
+ *
+ * Attachments which are not referenced anymore are kept until the next call
+ * to ngli_rtpool_collect() so that a RenderToTexture activated right after
+ * another one is released (typically with time ranges) reuses its textures.
+ */
+struct rtpool {
+    struct gpu_ctx *gpu_ctx;
+    struct darray entries;  // array of struct rtpool_entry *
+    uint64_t size;          // memory currently allocated by the pool
+    uint64_t peak_size;     // maximum memory ever allocated by the pool
+};
+
+int ngli_rtpool_init(struct rtpool *s, struct gpu_ctx *gpu_ctx);
+int ngli_rtpool_acquire(struct rtpool *s, const struct texture_params *params, int slot, struct texture **texturep);
+void ngli_rtpool_releasep(struct rtpool *s, struct texture **texturep);
+void ngli_rtpool_collect(struct rtpool *s);
+void ngli_rtpool_reset(struct rtpool *s);
+
+#endif
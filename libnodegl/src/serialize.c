@@ -29,9 +29,11 @@
 #include "memory.h"
 #include "internal.h"
 #include "nodegl.h"
+#include "serialize.h"
 #include "utils.h"
 
 extern const struct node_param ngli_base_node_params[];
+extern const struct param_specs ngli_params_specs[];
 
 static void free_func(void *arg, void *data)
 {
@@ -380,12 +382,11 @@ static int serialize_options(struct hmap *nlist,
     return 0;
 }
 
-static int serialize(struct hmap *nlist,
-                     struct bstr *b,
-                     const struct ngl_node *node);
+typedef int (*serialize_func_type)(struct hmap *nlist, void *arg, const struct ngl_node *node);
 
 static int serialize_children(struct hmap *nlist,
-                               struct bstr *b,
+                               void *arg,
+                               serialize_func_type serialize_func,
                                const struct ngl_node *node,
                                uint8_t *priv,
                                const struct node_param *p)
@@ -400,7 +401,7 @@ static int serialize_children(struct hmap *nlist,
             case NGLI_PARAM_TYPE_NODE: {
                 const struct ngl_node *child = *(struct ngl_node **)srcp;
                 if (child) {
-                    int ret = serialize(nlist, b, child);
+                    int ret = serialize_func(nlist, arg, child);
                     if (ret < 0)
                         return ret;
                 }
@@ -411,7 +412,7 @@ static int serialize_children(struct hmap *nlist,
                 const int nb_children = *(int *)(srcp + sizeof(struct ngl_node **));
 
                 for (int i = 0; i < nb_children; i++) {
-                    int ret = serialize(nlist, b, children[i]);
+                    int ret = serialize_func(nlist, arg, children[i]);
                     if (ret < 0)
                         return ret;
                 }
@@ -432,7 +433,7 @@ static int serialize_children(struct hmap *nlist,
                 const struct item *items = ngli_darray_data(&items_array);
                 for (int i = 0; i < ngli_darray_count(&items_array); i++) {
                     const struct item *item = &items[i];
-                    int ret = serialize(nlist, b, item->data);
+                    int ret = serialize_func(nlist, arg, item->data);
                     if (ret < 0) {
                         ngli_darray_reset(&items_array);
                         return ret;
@@ -446,7 +447,7 @@ static int serialize_children(struct hmap *nlist,
                     break;
                 struct ngl_node *child = *(struct ngl_node **)srcp;
                 if (child) {
-                    int ret = serialize(nlist, b, child);
+                    int ret = serialize_func(nlist, arg, child);
                     if (ret < 0)
                         return ret;
                 }
@@ -459,16 +460,17 @@ static int serialize_children(struct hmap *nlist,
 }
 
 static int serialize(struct hmap *nlist,
-                     struct bstr *b,
+                     void *arg,
                      const struct ngl_node *node)
 {
     if (get_node_id(nlist, node) >= 0)
         return 0;
 
+    struct bstr *b = arg;
     int ret;
 
-    if ((ret = serialize_children(nlist, b, node, (uint8_t *)node, ngli_base_node_params)) < 0 ||
-        (ret = serialize_children(nlist, b, node, node->opts, node->cls->params)) < 0)
+    if ((ret = serialize_children(nlist, b, serialize, node, (uint8_t *)node, ngli_base_node_params)) < 0 ||
+        (ret = serialize_children(nlist, b, serialize, node, node->opts, node->cls->params)) < 0)
         return ret;
 
     const uint32_t tag = node->cls->id;
@@ -506,3 +508,337 @@ end:
     ngli_bstr_freep(&b);
     return s;
 }
+
+struct bbuf {
+    uint8_t *data;
+    size_t size;
+    size_t capacity;
+};
+
+static int bbuf_write(struct bbuf *b, const void *data, size_t size)
+{
+    if (b->size + size > b->capacity) {
+        const size_t capacity = NGLI_MAX(b->size + size, b->capacity * 2);
+        uint8_t *new_data = ngli_realloc(b->data, capacity);
+        if (!new_data)
+            return NGL_ERROR_MEMORY;
+        b->data = new_data;
+        b->capacity = capacity;
+    }
+    if (data)
+        memcpy(b->data + b->size, data, size);
+    else
+        memset(b->data + b->size, 0, size);
+    b->size += size;
+    return 0;
+}
+
+static int bbuf_pad(struct bbuf *b, size_t align)
+{
+    return bbuf_write(b, NULL, NGLI_ALIGN(b->size, align) - b->size);
+}
+
+static void bbuf_reset(struct bbuf *b)
+{
+    ngli_freep(&b->data);
+    memset(b, 0, sizeof(*b));
+}
+
+struct binary_ctx {
+    struct darray nodes;  /* struct ngli_binary_node */
+    struct bbuf params;
+    struct bbuf data;
+    struct bbuf tmp;
+    uint32_t nb_params;
+};
+
+static int write_param(struct binary_ctx *s, const struct node_param *par,
+                       uint32_t flags, const void *payload, size_t size)
+{
+    const struct ngli_binary_param rec = {
+        .key_size = (uint32_t)strlen(par->key),
+        .type     = par->type,
+        .flags    = flags,
+        .size     = (uint32_t)size,
+    };
+
+    int ret;
+    if ((ret = bbuf_write(&s->params, &rec, sizeof(rec))) < 0 ||
+        (ret = bbuf_write(&s->params, par->key, rec.key_size)) < 0 ||
+        (ret = bbuf_pad(&s->params, NGLI_BINARY_RECORD_ALIGN)) < 0 ||
+        (ret = bbuf_write(&s->params, payload, size)) < 0 ||
+        (ret = bbuf_pad(&s->params, NGLI_BINARY_RECORD_ALIGN)) < 0)
+        return ret;
+
+    s->nb_params++;
+    return 0;
+}
+
+static int write_node_ref(struct binary_ctx *s, struct hmap *nlist,
+                          const struct node_param *par, uint32_t flags,
+                          const struct ngl_node *node)
+{
+    const uint32_t node_id = get_node_id(nlist, node);
+    return write_param(s, par, flags, &node_id, sizeof(node_id));
+}
+
+static int write_data(struct binary_ctx *s, const uint8_t *srcp, const struct node_param *par)
+{
+    const uint8_t *data = *(uint8_t **)srcp;
+    const int size = *(int *)(srcp + sizeof(uint8_t *));
+    if (!data || !size)
+        return 0;
+
+    int ret = bbuf_pad(&s->data, NGLI_BINARY_DATA_ALIGN);
+    if (ret < 0)
+        return ret;
+
+    const struct ngli_binary_data ref = {.offset = s->data.size, .size = size};
+    if ((ret = bbuf_write(&s->data, data, size)) < 0)
+        return ret;
+    return write_param(s, par, 0, &ref, sizeof(ref));
+}
+
+static int write_nodelist(struct binary_ctx *s, const uint8_t *srcp,
+                          const struct node_param *par, struct hmap *nlist)
+{
+    struct ngl_node **nodes = *(struct ngl_node ***)srcp;
+    const int nb_nodes = *(int *)(srcp + sizeof(struct ngl_node **));
+    if (!nb_nodes)
+        return 0;
+
+    s->tmp.size = 0;
+    for (int i = 0; i < nb_nodes; i++) {
+        const uint32_t node_id = get_node_id(nlist, nodes[i]);
+        int ret = bbuf_write(&s->tmp, &node_id, sizeof(node_id));
+        if (ret < 0)
+            return ret;
+    }
+    return write_param(s, par, 0, s->tmp.data, s->tmp.size);
+}
+
+static int write_nodedict(struct binary_ctx *s, const uint8_t *srcp,
+                          const struct node_param *par, struct hmap *nlist)
+{
+    struct hmap *hmap = *(struct hmap **)srcp;
+    if (!hmap || !ngli_hmap_count(hmap))
+        return 0;
+
+    struct darray items_array;
+    ngli_darray_init(&items_array, sizeof(struct item), 0);
+    int ret = hmap_to_sorted_items(&items_array, hmap);
+    if (ret < 0)
+        goto end;
+
+    s->tmp.size = 0;
+    const struct item *items = ngli_darray_data(&items_array);
+    for (int i = 0; i < ngli_darray_count(&items_array); i++) {
+        const struct item *item = &items[i];
+        const uint32_t node_id = get_node_id(nlist, item->data);
+        const uint32_t key_size = (uint32_t)strlen(item->key);
+        if ((ret = bbuf_write(&s->tmp, &node_id, sizeof(node_id))) < 0 ||
+            (ret = bbuf_write(&s->tmp, &key_size, sizeof(key_size))) < 0 ||
+            (ret = bbuf_write(&s->tmp, item->key, key_size)) < 0 ||
+            (ret = bbuf_pad(&s->tmp, sizeof(uint32_t))) < 0)
+            goto end;
+    }
+    ret = write_param(s, par, 0, s->tmp.data, s->tmp.size);
+
+end:
+    ngli_darray_reset(&items_array);
+    return ret;
+}
+
+static int serialize_binary_options(struct hmap *nlist,
+                                    struct binary_ctx *s,
+                                    const struct ngl_node *node,
+                                    uint8_t *priv,
+                                    const struct node_param *p)
+{
+    if (!p)
+        return 0;
+
+    const char *label = node->cls->name;
+    while (p->key) {
+        const uint8_t *srcp = priv + p->offset;
+
+        if (p->flags & NGLI_PARAM_FLAG_ALLOW_NODE) {
+            struct ngl_node *src_node = *(struct ngl_node **)srcp;
+            if (src_node) {
+                int ret = write_node_ref(s, nlist, p, NGLI_BINARY_PARAM_FLAG_NODE_REF, src_node);
+                if (ret < 0)
+                    return ret;
+                p++;
+                continue;
+            }
+            srcp += sizeof(struct ngl_node *);
+        }
+
+        int ret = 0;
+        switch (p->type) {
+        case NGLI_PARAM_TYPE_SELECT: {
+            const int v = *(int *)srcp;
+            if (v == p->def_value.i32)
+                break;
+            const char *str = ngli_params_get_select_str(p->choices->consts, v);
+            ngli_assert(str);
+            ret = write_param(s, p, 0, str, strlen(str));
+            break;
+        }
+        case NGLI_PARAM_TYPE_FLAGS: {
+            const int v = *(int *)srcp;
+            if (v == p->def_value.i32)
+                break;
+            char *str = ngli_params_get_flags_str(p->choices->consts, v);
+            if (!str)
+                return NGL_ERROR_MEMORY;
+            ret = write_param(s, p, 0, str, strlen(str));
+            ngli_free(str);
+            break;
+        }
+        case NGLI_PARAM_TYPE_STR: {
+            const char *str = *(char **)srcp;
+            if (!str || (p->def_value.str && !strcmp(str, p->def_value.str)))
+                break;
+            if (!strcmp(p->key, "label") && ngli_is_default_label(label, str))
+                break;
+            ret = write_param(s, p, 0, str, strlen(str));
+            break;
+        }
+        case NGLI_PARAM_TYPE_BOOL:
+        case NGLI_PARAM_TYPE_I32:
+        case NGLI_PARAM_TYPE_U32:
+        case NGLI_PARAM_TYPE_F32:
+        case NGLI_PARAM_TYPE_F64:
+        case NGLI_PARAM_TYPE_RATIONAL:
+        case NGLI_PARAM_TYPE_IVEC2:
+        case NGLI_PARAM_TYPE_IVEC3:
+        case NGLI_PARAM_TYPE_IVEC4:
+        case NGLI_PARAM_TYPE_UVEC2:
+        case NGLI_PARAM_TYPE_UVEC3:
+        case NGLI_PARAM_TYPE_UVEC4:
+        case NGLI_PARAM_TYPE_VEC2:
+        case NGLI_PARAM_TYPE_VEC3:
+        case NGLI_PARAM_TYPE_VEC4:
+        case NGLI_PARAM_TYPE_MAT4: {
+            /* Fixed size values are all stored at the start of the def_value union */
+            const size_t size = ngli_params_specs[p->type].size;
+            if (memcmp(srcp, &p->def_value, size))
+                ret = write_param(s, p, 0, srcp, size);
+            break;
+        }
+        case NGLI_PARAM_TYPE_DATA:
+            ret = write_data(s, srcp, p);
+            break;
+        case NGLI_PARAM_TYPE_NODE: {
+            const struct ngl_node *child = *(struct ngl_node **)srcp;
+            if (child)
+                ret = write_node_ref(s, nlist, p, 0, child);
+            break;
+        }
+        case NGLI_PARAM_TYPE_NODELIST:
+            ret = write_nodelist(s, srcp, p, nlist);
+            break;
+        case NGLI_PARAM_TYPE_F64LIST: {
+            const double *elems = *(double **)srcp;
+            const int nb_elems = *(int *)(srcp + sizeof(double *));
+            if (nb_elems)
+                ret = write_param(s, p, 0, elems, nb_elems * sizeof(*elems));
+            break;
+        }
+        case NGLI_PARAM_TYPE_NODEDICT:
+            ret = write_nodedict(s, srcp, p, nlist);
+            break;
+        default:
+            LOG(ERROR, "cannot serialize %s: unsupported parameter type", p->key);
+            return NGL_ERROR_BUG;
+        }
+        if (ret < 0)
+            return ret;
+        p++;
+    }
+    return 0;
+}
+
+static int serialize_binary(struct hmap *nlist,
+                            void *arg,
+                            const struct ngl_node *node)
+{
+    if (get_node_id(nlist, node) >= 0)
+        return 0;
+
+    struct binary_ctx *s = arg;
+    int ret;
+
+    if ((ret = serialize_children(nlist, s, serialize_binary, node, (uint8_t *)node, ngli_base_node_params)) < 0 ||
+        (ret = serialize_children(nlist, s, serialize_binary, node, node->opts, node->cls->params)) < 0)
+        return ret;
+
+    struct ngli_binary_node entry = {
+        .type          = node->cls->id,
+        .params_offset = s->params.size,
+    };
+    s->nb_params = 0;
+    if ((ret = serialize_binary_options(nlist, s, node, node->opts, node->cls->params)) < 0 ||
+        (ret = serialize_binary_options(nlist, s, node, (uint8_t *)node, ngli_base_node_params)) < 0)
+        return ret;
+    entry.nb_params = s->nb_params;
+
+    if (!ngli_darray_push(&s->nodes, &entry))
+        return NGL_ERROR_MEMORY;
+
+    return register_node(nlist, node);
+}
+
+void *ngl_node_serialize_binary(const struct ngl_node *node, size_t *sizep)
+{
+    uint8_t *buf = NULL;
+    struct binary_ctx s = {0};
+    ngli_darray_init(&s.nodes, sizeof(struct ngli_binary_node), 0);
+
+    struct hmap *nlist = ngli_hmap_create();
+    if (!nlist)
+        goto end;
+    ngli_hmap_set_free(nlist, free_func, NULL);
+
+    if (serialize_binary(nlist, &s, node) < 0)
+        goto end;
+
+    const int nb_nodes = ngli_darray_count(&s.nodes);
+    const size_t nodes_offset  = NGLI_ALIGN(sizeof(struct ngli_binary_header), NGLI_BINARY_RECORD_ALIGN);
+    const size_t params_offset = NGLI_ALIGN(nodes_offset + nb_nodes * sizeof(struct ngli_binary_node), NGLI_BINARY_RECORD_ALIGN);
+    const size_t data_offset   = NGLI_ALIGN(params_offset + s.params.size, NGLI_BINARY_DATA_ALIGN);
+    const size_t size = data_offset + s.data.size;
+
+    const struct ngli_binary_header header = {
+        .magic         = NGLI_BINARY_MAGIC,
+        .version       = NGLI_BINARY_VERSION,
+        .ngl_version   = NGL_VERSION_INT,
+        .byte_order    = NGLI_BINARY_BYTE_ORDER,
+        .nb_nodes      = nb_nodes,
+        .nodes_offset  = nodes_offset,
+        .params_offset = params_offset,
+        .params_size   = s.params.size,
+        .data_offset   = data_offset,
+        .data_size     = s.data.size,
+    };
+
+    buf = ngli_calloc(1, size);
+    if (!buf)
+        goto end;
+    memcpy(buf, &header, sizeof(header));
+    memcpy(buf + nodes_offset, ngli_darray_data(&s.nodes), nb_nodes * sizeof(struct ngli_binary_node));
+    if (s.params.size)
+        memcpy(buf + params_offset, s.params.data, s.params.size);
+    if (s.data.size)
+        memcpy(buf + data_offset, s.data.data, s.data.size);
+    *sizep = size;
+
+end:
+    ngli_hmap_freep(&nlist);
+    ngli_darray_reset(&s.nodes);
+    bbuf_reset(&s.params);
+    bbuf_reset(&s.data);
+    bbuf_reset(&s.tmp);
+    return buf;
+}
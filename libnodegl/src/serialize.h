@@ -0,0 +1,87 @@
+/*
+ * Copyright 2022 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef SERIALIZE_H
+#define SERIALIZE_H
+
+#include <stdint.h>
+
+/*
+ * Binary scene container (.nglb)
+ *
+ * All the fields are stored in host byte order, the byte_order header field
+ * is used to reject files coming from a host with a different endianness.
+ *
+ *   header | node table | param records | data section
+ *
+ * The node table contains one entry per node, children always appear before
+ * their parents and the last node is the root of the graph. Each node entry
+ * references a contiguous range of param records. A param record is a
+ * struct ngli_binary_param followed by the key (not NUL terminated) and the
+ * value payload, both padded to NGLI_BINARY_RECORD_ALIGN. Node references
+ * are absolute indexes in the node table.
+ *
+ * The data section holds the raw NGLI_PARAM_TYPE_DATA payloads, each of them
+ * aligned on NGLI_BINARY_DATA_ALIGN so they can be used in place when the
+ * container is memory mapped.
+ */
+
+#define NGLI_BINARY_MAGIC          "NGLB"
+#define NGLI_BINARY_VERSION        1
+#define NGLI_BINARY_BYTE_ORDER     0x01020304
+#define NGLI_BINARY_RECORD_ALIGN   8
+#define NGLI_BINARY_DATA_ALIGN     64
+
+#define NGLI_BINARY_PARAM_FLAG_NODE_REF (1 << 0)
+
+struct ngli_binary_header {
+    char magic[4];
+    uint32_t version;
+    uint32_t ngl_version;
+    uint32_t byte_order;
+    uint32_t nb_nodes;
+    uint32_t reserved;
+    uint64_t nodes_offset;
+    uint64_t params_offset;
+    uint64_t params_size;
+    uint64_t data_offset;
+    uint64_t data_size;
+};
+
+struct ngli_binary_node {
+    uint32_t type;
+    uint32_t nb_params;
+    uint64_t params_offset; /* relative to the param records section */
+};
+
+struct ngli_binary_param {
+    uint32_t key_size;
+    uint32_t type;
+    uint32_t flags;
+    uint32_t size;
+};
+
+struct ngli_binary_data {
+    uint64_t offset; /* relative to the data section */
+    uint64_t size;
+};
+
+#endif
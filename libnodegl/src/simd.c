@@ -0,0 +1,135 @@
+/*
+ * Copyright 2023 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "config.h"
+
+#if defined(HAVE_X86_INTR)
+# if defined(_MSC_VER)
+#  include <intrin.h>
+# else
+#  include <cpuid.h>
+# endif
+#endif
+
+#include "colorconv.h"
+#include "math_utils.h"
+#include "noise.h"
+#include "simd.h"
+
+/*
+ * The SIMD kernels must produce the exact same output as their scalar
+ * versions: prevent Clang (which contracts by default, unlike GCC in ISO C
+ * mode) from fusing the multiply-adds of one path and not the other. The
+ * same applies to every file implementing one of these paths.
+ */
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
+
+#if defined(HAVE_X86_INTR)
+static void get_cpuid(uint32_t leaf, uint32_t subleaf, uint32_t *regs)
+{
+#if defined(_MSC_VER)
+    int r[4];
+    __cpuidex(r, leaf, subleaf);
+    for (int i = 0; i < 4; i++)
+        regs[i] = r[i];
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+/* Extended states enabled by the OS, only valid when OSXSAVE is set */
+static uint64_t get_xcr0(void)
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t eax, edx;
+    __asm__ volatile ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (uint64_t)edx << 32 | eax;
+#endif
+}
+#endif
+
+int ngli_cpu_get_flags(void)
+{
+    int flags = 0;
+
+#if defined(ARCH_AARCH64)
+    flags |= NGLI_CPU_FLAG_NEON;
+#elif defined(HAVE_X86_INTR)
+    uint32_t regs[4]; // eax, ebx, ecx, edx
+
+    get_cpuid(0, 0, regs);
+    const uint32_t max_leaf = regs[0];
+    if (max_leaf < 1)
+        return 0;
+
+    get_cpuid(1, 0, regs);
+    if (regs[3] & (1 << 26))
+        flags |= NGLI_CPU_FLAG_SSE2;
+
+    /*
+     * AVX2 is only usable if the OS saves the YMM registers on context
+     * switches, in addition to the CPU supporting it
+     */
+    const int has_osxsave = regs[2] & (1 << 27);
+    const int has_avx     = regs[2] & (1 << 28);
+    if (max_leaf >= 7 && has_osxsave && has_avx && (get_xcr0() & 0x6) == 0x6) {
+        get_cpuid(7, 0, regs);
+        if (regs[1] & (1 << 5))
+            flags |= NGLI_CPU_FLAG_AVX2;
+    }
+#endif
+
+    return flags;
+}
+
+void ngli_simd_init(struct simd_funcs *s, int cpu_flags)
+{
+    s->mix_f32         = ngli_mix_f32_c;
+    s->noise_fbm_f32   = ngli_noise_fbm_f32_c;
+    s->srgb2linear_f32 = ngli_colorconv_srgb2linear_f32_c;
+    s->linear2srgb_f32 = ngli_colorconv_linear2srgb_f32_c;
+
+#if defined(HAVE_X86_INTR)
+    if (cpu_flags & NGLI_CPU_FLAG_SSE2) {
+        s->mix_f32         = ngli_mix_f32_sse2;
+        s->noise_fbm_f32   = ngli_noise_fbm_f32_sse2;
+        s->srgb2linear_f32 = ngli_colorconv_srgb2linear_f32_sse2;
+        s->linear2srgb_f32 = ngli_colorconv_linear2srgb_f32_sse2;
+    }
+    if (cpu_flags & NGLI_CPU_FLAG_AVX2) {
+        s->mix_f32         = ngli_mix_f32_avx2;
+        s->noise_fbm_f32   = ngli_noise_fbm_f32_avx2;
+        s->srgb2linear_f32 = ngli_colorconv_srgb2linear_f32_avx2;
+        s->linear2srgb_f32 = ngli_colorconv_linear2srgb_f32_avx2;
+    }
+#elif defined(ARCH_AARCH64)
+    if (cpu_flags & NGLI_CPU_FLAG_NEON) {
+        s->mix_f32         = ngli_mix_f32_neon;
+        s->noise_fbm_f32   = ngli_noise_fbm_f32_neon;
+        s->srgb2linear_f32 = ngli_colorconv_srgb2linear_f32_neon;
+        s->linear2srgb_f32 = ngli_colorconv_linear2srgb_f32_neon;
+    }
+#endif
+}
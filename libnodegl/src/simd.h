@@ -0,0 +1,72 @@
+/*
+ * Copyright 2023 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <stdint.h>
+
+#include "noise.h"
+
+#define NGLI_CPU_FLAG_SSE2 (1 << 0)
+#define NGLI_CPU_FLAG_AVX2 (1 << 1)
+#define NGLI_CPU_FLAG_NEON (1 << 2)
+
+int ngli_cpu_get_flags(void);
+
+/*
+ * Batch kernels operating on float arrays of arbitrary size (no alignment
+ * requirement). The table is filled with the best versions available for the
+ * specified CPU flags, the C versions being used as fallback.
+ *
+ * The mix and noise versions give the exact same results as the C versions:
+ * like NGLI_MIX(), they mix in double precision.
+ */
+struct simd_funcs {
+    /* dst[i] = a[i]*(1-t) + b[i]*t */
+    void (*mix_f32)(float *dst, const float *a, const float *b, double t, int n);
+    /* dst[i] = fractal noise at time t[i] with seed seeds[i] */
+    void (*noise_fbm_f32)(float *dst, const float *t, const uint32_t *seeds, int n, const struct noise_params *p);
+    void (*srgb2linear_f32)(float *dst, const float *src, int n);
+    void (*linear2srgb_f32)(float *dst, const float *src, int n);
+};
+
+void ngli_simd_init(struct simd_funcs *s, int cpu_flags);
+
+/* Arch specific versions */
+
+void ngli_mix_f32_sse2(float *dst, const float *a, const float *b, double t, int n);
+void ngli_mix_f32_avx2(float *dst, const float *a, const float *b, double t, int n);
+void ngli_mix_f32_neon(float *dst, const float *a, const float *b, double t, int n);
+
+void ngli_noise_fbm_f32_sse2(float *dst, const float *t, const uint32_t *seeds, int n, const struct noise_params *p);
+void ngli_noise_fbm_f32_avx2(float *dst, const float *t, const uint32_t *seeds, int n, const struct noise_params *p);
+void ngli_noise_fbm_f32_neon(float *dst, const float *t, const uint32_t *seeds, int n, const struct noise_params *p);
+
+void ngli_colorconv_srgb2linear_f32_sse2(float *dst, const float *src, int n);
+void ngli_colorconv_srgb2linear_f32_avx2(float *dst, const float *src, int n);
+void ngli_colorconv_srgb2linear_f32_neon(float *dst, const float *src, int n);
+
+void ngli_colorconv_linear2srgb_f32_sse2(float *dst, const float *src, int n);
+void ngli_colorconv_linear2srgb_f32_avx2(float *dst, const float *src, int n);
+void ngli_colorconv_linear2srgb_f32_neon(float *dst, const float *src, int n);
+
+#endif
@@ -0,0 +1,269 @@
+/*
+ * Copyright 2023 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <arm_neon.h>
+#include <string.h>
+
+#include "math_utils.h"
+#include "noise.h"
+#include "simd.h"
+
+/* Must match the scalar kernels bit for bit, see simd.c */
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
+
+/*
+ * Polynomial approximations of logf() and expf() for the pow() of the sRGB
+ * transfer functions, derived from the Cephes library (see simd_x86.c). The
+ * log is only valid for strictly positive normal values.
+ */
+#define LOG_P0  7.0376836292E-2f
+#define LOG_P1 -1.1514610310E-1f
+#define LOG_P2  1.1676998740E-1f
+#define LOG_P3 -1.2420140846E-1f
+#define LOG_P4  1.4249322787E-1f
+#define LOG_P5 -1.6668057665E-1f
+#define LOG_P6  2.0000714765E-1f
+#define LOG_P7 -2.4999993993E-1f
+#define LOG_P8  3.3333331174E-1f
+#define LOG_Q1 -2.12194440E-4f
+#define LOG_Q2  0.693359375f
+
+#define EXP_HI  88.3762626647949f
+#define EXP_LO -88.3762626647949f
+#define EXP_P0  1.9875691500E-4f
+#define EXP_P1  1.3981999507E-3f
+#define EXP_P2  8.3334519073E-3f
+#define EXP_P3  4.1665795894E-2f
+#define EXP_P4  1.6666665459E-1f
+#define EXP_P5  5.0000001201E-1f
+#define LOG2EF  1.44269504088896341f
+
+#define SQRTHF  0.707106781186547524f
+
+static inline float32x4_t log_neon(float32x4_t x)
+{
+    const float32x4_t one = vdupq_n_f32(1.f);
+    const int32x4_t e = vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_f32(x), 23)), vdupq_n_s32(0x7e));
+    float32x4_t fe = vcvtq_f32_s32(e);
+
+    /* Mantissa in [0.5;1), then shifted in [sqrt(1/2)-1;sqrt(2)-1) */
+    uint32x4_t bits = vandq_u32(vreinterpretq_u32_f32(x), vdupq_n_u32(0x007fffff));
+    bits = vorrq_u32(bits, vreinterpretq_u32_f32(vdupq_n_f32(.5f)));
+    x = vreinterpretq_f32_u32(bits);
+    const uint32x4_t mask = vcltq_f32(x, vdupq_n_f32(SQRTHF));
+    fe = vsubq_f32(fe, vreinterpretq_f32_u32(vandq_u32(mask, vreinterpretq_u32_f32(one))));
+    x = vaddq_f32(vsubq_f32(x, one), vreinterpretq_f32_u32(vandq_u32(mask, vreinterpretq_u32_f32(x))));
+
+    const float32x4_t z = vmulq_f32(x, x);
+    float32x4_t y = vdupq_n_f32(LOG_P0);
+    y = vaddq_f32(vmulq_f32(y, x), vdupq_n_f32(LOG_P1));
+    y = vaddq_f32(vmulq_f32(y, x), vdupq_n_f32(LOG_P2));
+    y = vaddq_f32(vmulq_f32(y, x), vdupq_n_f32(LOG_P3));
+    y = vaddq_f32(vmulq_f32(y, x), vdupq_n_f32(LOG_P4));
+    y = vaddq_f32(vmulq_f32(y, x), vdupq_n_f32(LOG_P5));
+    y = vaddq_f32(vmulq_f32(y, x), vdupq_n_f32(LOG_P6));
+    y = vaddq_f32(vmulq_f32(y, x), vdupq_n_f32(LOG_P7));
+    y = vaddq_f32(vmulq_f32(y, x), vdupq_n_f32(LOG_P8));
+    y = vmulq_f32(vmulq_f32(y, x), z);
+
+    y = vaddq_f32(y, vmulq_f32(fe, vdupq_n_f32(LOG_Q1)));
+    y = vsubq_f32(y, vmulq_f32(z, vdupq_n_f32(.5f)));
+    x = vaddq_f32(x, y);
+    return vaddq_f32(x, vmulq_f32(fe, vdupq_n_f32(LOG_Q2)));
+}
+
+static inline float32x4_t exp_neon(float32x4_t x)
+{
+    x = vminq_f32(vmaxq_f32(x, vdupq_n_f32(EXP_LO)), vdupq_n_f32(EXP_HI));
+
+    /* x = n*log(2) + r */
+    const float32x4_t fn = vrndmq_f32(vaddq_f32(vmulq_f32(x, vdupq_n_f32(LOG2EF)), vdupq_n_f32(.5f)));
+    x = vsubq_f32(x, vmulq_f32(fn, vdupq_n_f32(LOG_Q2)));
+    x = vsubq_f32(x, vmulq_f32(fn, vdupq_n_f32(LOG_Q1)));
+
+    const float32x4_t z = vmulq_f32(x, x);
+    float32x4_t y = vdupq_n_f32(EXP_P0);
+    y = vaddq_f32(vmulq_f32(y, x), vdupq_n_f32(EXP_P1));
+    y = vaddq_f32(vmulq_f32(y, x), vdupq_n_f32(EXP_P2));
+    y = vaddq_f32(vmulq_f32(y, x), vdupq_n_f32(EXP_P3));
+    y = vaddq_f32(vmulq_f32(y, x), vdupq_n_f32(EXP_P4));
+    y = vaddq_f32(vmulq_f32(y, x), vdupq_n_f32(EXP_P5));
+    y = vaddq_f32(vaddq_f32(vmulq_f32(y, z), x), vdupq_n_f32(1.f));
+
+    /* 2^n built from the exponent bits */
+    const int32x4_t n = vaddq_s32(vcvtq_s32_f32(fn), vdupq_n_s32(0x7f));
+    return vmulq_f32(y, vreinterpretq_f32_s32(vshlq_n_s32(n, 23)));
+}
+
+static inline float32x4_t pow_neon(float32x4_t x, float p)
+{
+    return exp_neon(vmulq_f32(log_neon(x), vdupq_n_f32(p)));
+}
+
+static inline uint32x4_t hash_neon(uint32x4_t x)
+{
+    x = veorq_u32(x, vshrq_n_u32(x, 16));
+    x = vmulq_u32(x, vdupq_n_u32(0x7feb352d));
+    x = veorq_u32(x, vshrq_n_u32(x, 15));
+    x = vmulq_u32(x, vdupq_n_u32(0x846ca68b));
+    x = veorq_u32(x, vshrq_n_u32(x, 16));
+    return x;
+}
+
+static inline float32x4_t u32tof32_neon(uint32x4_t x)
+{
+    const uint32x4_t bits = vorrq_u32(vdupq_n_u32(0x7f << 23), vshrq_n_u32(x, 9));
+    return vsubq_f32(vreinterpretq_f32_u32(bits), vdupq_n_f32(1.f));
+}
+
+static inline float32x4_t curve_neon(float32x4_t t, int function)
+{
+    switch (function) {
+    case NGLI_NOISE_CUBIC:
+        return vmulq_f32(vmulq_f32(vsubq_f32(vdupq_n_f32(3.f), vmulq_f32(vdupq_n_f32(2.f), t)), t), t);
+    case NGLI_NOISE_QUINTIC: {
+        float32x4_t r = vsubq_f32(vmulq_f32(vdupq_n_f32(6.f), t), vdupq_n_f32(15.f));
+        r = vaddq_f32(vmulq_f32(r, t), vdupq_n_f32(10.f));
+        return vmulq_f32(vmulq_f32(vmulq_f32(r, t), t), t);
+    }
+    default:
+        return t;
+    }
+}
+
+/*
+ * The mixes follow the evaluation of NGLI_MIX() in C, partially done in
+ * double precision, so that the results are the same as the C versions
+ */
+
+/* x*u + z with x converted to double precision, for the low and high halves */
+static inline float32x4_t madd_f64_neon(float32x4_t x, float64x2_t u_lo, float64x2_t u_hi, float64x2_t z_lo, float64x2_t z_hi)
+{
+    const float64x2_t lo = vaddq_f64(vmulq_f64(vcvt_f64_f32(vget_low_f32(x)), u_lo), z_lo);
+    const float64x2_t hi = vaddq_f64(vmulq_f64(vcvt_high_f64_f32(x), u_hi), z_hi);
+    return vcvt_high_f32_f64(vcvt_f32_f64(lo), hi);
+}
+
+/* NGLI_MIX(x, y, t) with float x and y, and a double t */
+static inline float32x4_t mix_neon(float32x4_t x, float32x4_t y, float64x2_t t)
+{
+    const float64x2_t u = vsubq_f64(vdupq_n_f64(1.), t);
+    const float64x2_t z_lo = vmulq_f64(vcvt_f64_f32(vget_low_f32(y)), t);
+    const float64x2_t z_hi = vmulq_f64(vcvt_high_f64_f32(y), t);
+    return madd_f64_neon(x, u, u, z_lo, z_hi);
+}
+
+/* NGLI_MIX(x, y, a) with float x, y and a: y*a is a single precision product */
+static inline float32x4_t mix_f32_neon(float32x4_t x, float32x4_t y, float32x4_t a)
+{
+    const float64x2_t one = vdupq_n_f64(1.);
+    const float32x4_t z = vmulq_f32(y, a);
+    return madd_f64_neon(x,
+                         vsubq_f64(one, vcvt_f64_f32(vget_low_f32(a))), vsubq_f64(one, vcvt_high_f64_f32(a)),
+                         vcvt_f64_f32(vget_low_f32(z)), vcvt_high_f64_f32(z));
+}
+
+static inline float32x4_t noise_neon(float32x4_t t, uint32x4_t seed, int function)
+{
+    const float32x4_t one = vdupq_n_f32(1.f);
+    const float32x4_t two = vdupq_n_f32(2.f);
+    const float32x4_t i = vrndmq_f32(t);
+    const float32x4_t f = vsubq_f32(t, i);
+    const uint32x4_t x = vaddq_u32(vreinterpretq_u32_s32(vcvtq_s32_f32(i)), seed);
+    const float32x4_t s0 = vsubq_f32(vmulq_f32(u32tof32_neon(hash_neon(x)), two), one);
+    const float32x4_t s1 = vsubq_f32(vmulq_f32(u32tof32_neon(hash_neon(vaddq_u32(x, vdupq_n_u32(1)))), two), one);
+    const float32x4_t y0 = vmulq_f32(s0, f);
+    const float32x4_t y1 = vmulq_f32(s1, vsubq_f32(f, one));
+    const float32x4_t a = curve_neon(f, function);
+    return mix_f32_neon(y0, y1, a);
+}
+
+static inline float32x4_t fbm_neon(float32x4_t t, uint32x4_t seed, const struct noise_params *p)
+{
+    const float32x4_t lacunarity = vdupq_n_f32(p->lacunarity);
+    float32x4_t sum = vdupq_n_f32(0.f);
+    float amp = p->amplitude;
+    for (int i = 0; i < p->octaves; i++) {
+        sum = vaddq_f32(sum, vmulq_f32(noise_neon(t, seed, p->function), vdupq_n_f32(amp)));
+        t = vmulq_f32(t, lacunarity);
+        amp *= p->gain;
+    }
+    return sum;
+}
+
+static inline float32x4_t srgb2linear_neon(float32x4_t x)
+{
+    const float32x4_t lin = vdivq_f32(x, vdupq_n_f32(12.92f));
+    const float32x4_t pw = pow_neon(vdivq_f32(vaddq_f32(x, vdupq_n_f32(.055f)), vdupq_n_f32(1.055f)), 2.4f);
+    return vbslq_f32(vcltq_f32(x, vdupq_n_f32(0.04045f)), lin, pw);
+}
+
+static inline float32x4_t linear2srgb_neon(float32x4_t x)
+{
+    const float32x4_t lin = vmulq_f32(x, vdupq_n_f32(12.92f));
+    const float32x4_t pw = vsubq_f32(pow_neon(vmulq_f32(x, vdupq_n_f32(1.055f)), 1.f/2.4f), vdupq_n_f32(.055f));
+    return vbslq_f32(vcltq_f32(x, vdupq_n_f32(0.0031308f)), lin, pw);
+}
+
+void ngli_mix_f32_neon(float *dst, const float *a, const float *b, double t, int n)
+{
+    const float64x2_t vt = vdupq_n_f64(t);
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+        vst1q_f32(dst + i, mix_neon(vld1q_f32(a + i), vld1q_f32(b + i), vt));
+    ngli_mix_f32_c(dst + i, a + i, b + i, t, n - i);
+}
+
+void ngli_noise_fbm_f32_neon(float *dst, const float *t, const uint32_t *seeds, int n, const struct noise_params *p)
+{
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+        vst1q_f32(dst + i, fbm_neon(vld1q_f32(t + i), vld1q_u32(seeds + i), p));
+    if (i == n)
+        return;
+
+    /* Remaining lanes are evaluated through zero-padded vectors */
+    float t_tail[4] = {0}, r_tail[4];
+    uint32_t seeds_tail[4] = {0};
+    memcpy(t_tail, t + i, (n - i) * sizeof(*t));
+    memcpy(seeds_tail, seeds + i, (n - i) * sizeof(*seeds));
+    vst1q_f32(r_tail, fbm_neon(vld1q_f32(t_tail), vld1q_u32(seeds_tail), p));
+    memcpy(dst + i, r_tail, (n - i) * sizeof(*dst));
+}
+
+#define DEFINE_COLORCONV_FUNC_NEON(name)                                        \
+void ngli_colorconv_##name##_f32_neon(float *dst, const float *src, int n)      \
+{                                                                               \
+    int i = 0;                                                                  \
+    for (; i + 4 <= n; i += 4)                                                  \
+        vst1q_f32(dst + i, name##_neon(vld1q_f32(src + i)));                    \
+    if (i == n)                                                                 \
+        return;                                                                 \
+    float tail[4] = {0};                                                        \
+    memcpy(tail, src + i, (n - i) * sizeof(*src));                              \
+    vst1q_f32(tail, name##_neon(vld1q_f32(tail)));                              \
+    memcpy(dst + i, tail, (n - i) * sizeof(*dst));                              \
+}
+
+DEFINE_COLORCONV_FUNC_NEON(srgb2linear)
+DEFINE_COLORCONV_FUNC_NEON(linear2srgb)
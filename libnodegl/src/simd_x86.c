@@ -21,8 +21,24 @@
  */
 
 #include <immintrin.h>
+#include <string.h>
 
 #include "math_utils.h"
+#include "noise.h"
+#include "simd.h"
+
+/* Must match the scalar kernels bit for bit, see simd.c */
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
+
+#if defined(__GNUC__)
+# define TARGET_SSE2 __attribute__((target("sse2")))
+# define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+# define TARGET_SSE2
+# define TARGET_AVX2
+#endif
 
 void ngli_mat4_mul_sse(float *dst, const float *m1, const float *m2)
 {
@@ -73,3 +89,457 @@ void ngli_mat4_mul_vec4_sse(float *dst, const float *m, const float *v)
 
     _mm_store_ps(dst, r);
 }
+
+/*
+ * Polynomial approximations of logf() and expf() for the pow() of the sRGB
+ * transfer functions, derived from the Cephes library. The log is only valid
+ * for strictly positive normal values.
+ */
+#define LOG_P0  7.0376836292E-2f
+#define LOG_P1 -1.1514610310E-1f
+#define LOG_P2  1.1676998740E-1f
+#define LOG_P3 -1.2420140846E-1f
+#define LOG_P4  1.4249322787E-1f
+#define LOG_P5 -1.6668057665E-1f
+#define LOG_P6  2.0000714765E-1f
+#define LOG_P7 -2.4999993993E-1f
+#define LOG_P8  3.3333331174E-1f
+#define LOG_Q1 -2.12194440E-4f
+#define LOG_Q2  0.693359375f
+
+#define EXP_HI  88.3762626647949f
+#define EXP_LO -88.3762626647949f
+#define EXP_P0  1.9875691500E-4f
+#define EXP_P1  1.3981999507E-3f
+#define EXP_P2  8.3334519073E-3f
+#define EXP_P3  4.1665795894E-2f
+#define EXP_P4  1.6666665459E-1f
+#define EXP_P5  5.0000001201E-1f
+#define LOG2EF  1.44269504088896341f
+
+#define SQRTHF  0.707106781186547524f
+
+/* SSE2 */
+
+static inline TARGET_SSE2 __m128 floor_sse2(__m128 x)
+{
+    /* Truncation rounds toward zero, step down negative non-integers */
+    const __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+    return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, x), _mm_set1_ps(1.f)));
+}
+
+static inline TARGET_SSE2 __m128 select_sse2(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+/* SSE2 has no 32-bit low multiply, combine the even and odd lanes products */
+static inline TARGET_SSE2 __m128i mullo_epi32_sse2(__m128i a, __m128i b)
+{
+    const __m128i even = _mm_mul_epu32(a, b);
+    const __m128i odd  = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd,  _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+static inline TARGET_SSE2 __m128 log_sse2(__m128 x)
+{
+    const __m128 one = _mm_set1_ps(1.f);
+    const __m128i e = _mm_sub_epi32(_mm_srli_epi32(_mm_castps_si128(x), 23), _mm_set1_epi32(0x7e));
+    __m128 fe = _mm_cvtepi32_ps(e);
+
+    /* Mantissa in [0.5;1), then shifted in [sqrt(1/2)-1;sqrt(2)-1) */
+    x = _mm_and_ps(x, _mm_castsi128_ps(_mm_set1_epi32(0x007fffff)));
+    x = _mm_or_ps(x, _mm_set1_ps(.5f));
+    const __m128 mask = _mm_cmplt_ps(x, _mm_set1_ps(SQRTHF));
+    fe = _mm_sub_ps(fe, _mm_and_ps(mask, one));
+    x = _mm_add_ps(_mm_sub_ps(x, one), _mm_and_ps(mask, x));
+
+    const __m128 z = _mm_mul_ps(x, x);
+    __m128 y = _mm_set1_ps(LOG_P0);
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(LOG_P1));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(LOG_P2));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(LOG_P3));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(LOG_P4));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(LOG_P5));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(LOG_P6));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(LOG_P7));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(LOG_P8));
+    y = _mm_mul_ps(_mm_mul_ps(y, x), z);
+
+    y = _mm_add_ps(y, _mm_mul_ps(fe, _mm_set1_ps(LOG_Q1)));
+    y = _mm_sub_ps(y, _mm_mul_ps(z, _mm_set1_ps(.5f)));
+    x = _mm_add_ps(x, y);
+    return _mm_add_ps(x, _mm_mul_ps(fe, _mm_set1_ps(LOG_Q2)));
+}
+
+static inline TARGET_SSE2 __m128 exp_sse2(__m128 x)
+{
+    x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(EXP_LO)), _mm_set1_ps(EXP_HI));
+
+    /* x = n*log(2) + r */
+    const __m128 fn = floor_sse2(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(LOG2EF)), _mm_set1_ps(.5f)));
+    x = _mm_sub_ps(x, _mm_mul_ps(fn, _mm_set1_ps(LOG_Q2)));
+    x = _mm_sub_ps(x, _mm_mul_ps(fn, _mm_set1_ps(LOG_Q1)));
+
+    const __m128 z = _mm_mul_ps(x, x);
+    __m128 y = _mm_set1_ps(EXP_P0);
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(EXP_P1));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(EXP_P2));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(EXP_P3));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(EXP_P4));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(EXP_P5));
+    y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(y, z), x), _mm_set1_ps(1.f));
+
+    /* 2^n built from the exponent bits */
+    const __m128i n = _mm_add_epi32(_mm_cvttps_epi32(fn), _mm_set1_epi32(0x7f));
+    return _mm_mul_ps(y, _mm_castsi128_ps(_mm_slli_epi32(n, 23)));
+}
+
+static inline TARGET_SSE2 __m128 pow_sse2(__m128 x, float p)
+{
+    return exp_sse2(_mm_mul_ps(log_sse2(x), _mm_set1_ps(p)));
+}
+
+static inline TARGET_SSE2 __m128i hash_sse2(__m128i x)
+{
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+    x = mullo_epi32_sse2(x, _mm_set1_epi32(0x7feb352d));
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 15));
+    x = mullo_epi32_sse2(x, _mm_set1_epi32((int)0x846ca68b));
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+    return x;
+}
+
+static inline TARGET_SSE2 __m128 u32tof32_sse2(__m128i x)
+{
+    const __m128i bits = _mm_or_si128(_mm_set1_epi32(0x7f << 23), _mm_srli_epi32(x, 9));
+    return _mm_sub_ps(_mm_castsi128_ps(bits), _mm_set1_ps(1.f));
+}
+
+static inline TARGET_SSE2 __m128 curve_sse2(__m128 t, int function)
+{
+    switch (function) {
+    case NGLI_NOISE_CUBIC:
+        return _mm_mul_ps(_mm_mul_ps(_mm_sub_ps(_mm_set1_ps(3.f), _mm_mul_ps(_mm_set1_ps(2.f), t)), t), t);
+    case NGLI_NOISE_QUINTIC: {
+        __m128 r = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(6.f), t), _mm_set1_ps(15.f));
+        r = _mm_add_ps(_mm_mul_ps(r, t), _mm_set1_ps(10.f));
+        return _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(r, t), t), t);
+    }
+    default:
+        return t;
+    }
+}
+
+/*
+ * The mixes follow the evaluation of NGLI_MIX() in C, partially done in
+ * double precision, so that the results are the same as the C versions
+ */
+
+/* x*u + z with x converted to double precision, for the low and high halves */
+static inline TARGET_SSE2 __m128 madd_pd_sse2(__m128 x, __m128d u_lo, __m128d u_hi, __m128d z_lo, __m128d z_hi)
+{
+    const __m128d lo = _mm_add_pd(_mm_mul_pd(_mm_cvtps_pd(x), u_lo), z_lo);
+    const __m128d hi = _mm_add_pd(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(x, x)), u_hi), z_hi);
+    return _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi));
+}
+
+/* NGLI_MIX(x, y, t) with float x and y, and a double t */
+static inline TARGET_SSE2 __m128 mix_sse2(__m128 x, __m128 y, __m128d t)
+{
+    const __m128d u = _mm_sub_pd(_mm_set1_pd(1.), t);
+    const __m128d z_lo = _mm_mul_pd(_mm_cvtps_pd(y), t);
+    const __m128d z_hi = _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(y, y)), t);
+    return madd_pd_sse2(x, u, u, z_lo, z_hi);
+}
+
+/* NGLI_MIX(x, y, a) with float x, y and a: y*a is a single precision product */
+static inline TARGET_SSE2 __m128 mix_ps_sse2(__m128 x, __m128 y, __m128 a)
+{
+    const __m128d one = _mm_set1_pd(1.);
+    const __m128 z = _mm_mul_ps(y, a);
+    return madd_pd_sse2(x,
+                        _mm_sub_pd(one, _mm_cvtps_pd(a)), _mm_sub_pd(one, _mm_cvtps_pd(_mm_movehl_ps(a, a))),
+                        _mm_cvtps_pd(z), _mm_cvtps_pd(_mm_movehl_ps(z, z)));
+}
+
+static inline TARGET_SSE2 __m128 noise_sse2(__m128 t, __m128i seed, int function)
+{
+    const __m128 one = _mm_set1_ps(1.f);
+    const __m128 two = _mm_set1_ps(2.f);
+    const __m128 i = floor_sse2(t);
+    const __m128 f = _mm_sub_ps(t, i);
+    const __m128i x = _mm_add_epi32(_mm_cvttps_epi32(i), seed);
+    const __m128 s0 = _mm_sub_ps(_mm_mul_ps(u32tof32_sse2(hash_sse2(x)), two), one);
+    const __m128 s1 = _mm_sub_ps(_mm_mul_ps(u32tof32_sse2(hash_sse2(_mm_add_epi32(x, _mm_set1_epi32(1)))), two), one);
+    const __m128 y0 = _mm_mul_ps(s0, f);
+    const __m128 y1 = _mm_mul_ps(s1, _mm_sub_ps(f, one));
+    const __m128 a = curve_sse2(f, function);
+    return mix_ps_sse2(y0, y1, a);
+}
+
+static inline TARGET_SSE2 __m128 fbm_sse2(__m128 t, __m128i seed, const struct noise_params *p)
+{
+    const __m128 lacunarity = _mm_set1_ps(p->lacunarity);
+    __m128 sum = _mm_setzero_ps();
+    float amp = p->amplitude;
+    for (int i = 0; i < p->octaves; i++) {
+        sum = _mm_add_ps(sum, _mm_mul_ps(noise_sse2(t, seed, p->function), _mm_set1_ps(amp)));
+        t = _mm_mul_ps(t, lacunarity);
+        amp *= p->gain;
+    }
+    return sum;
+}
+
+static inline TARGET_SSE2 __m128 srgb2linear_sse2(__m128 x)
+{
+    const __m128 lin = _mm_div_ps(x, _mm_set1_ps(12.92f));
+    const __m128 pw = pow_sse2(_mm_div_ps(_mm_add_ps(x, _mm_set1_ps(.055f)), _mm_set1_ps(1.055f)), 2.4f);
+    return select_sse2(_mm_cmplt_ps(x, _mm_set1_ps(0.04045f)), lin, pw);
+}
+
+static inline TARGET_SSE2 __m128 linear2srgb_sse2(__m128 x)
+{
+    const __m128 lin = _mm_mul_ps(x, _mm_set1_ps(12.92f));
+    const __m128 pw = _mm_sub_ps(pow_sse2(_mm_mul_ps(x, _mm_set1_ps(1.055f)), 1.f/2.4f), _mm_set1_ps(.055f));
+    return select_sse2(_mm_cmplt_ps(x, _mm_set1_ps(0.0031308f)), lin, pw);
+}
+
+TARGET_SSE2 void ngli_mix_f32_sse2(float *dst, const float *a, const float *b, double t, int n)
+{
+    const __m128d vt = _mm_set1_pd(t);
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+        _mm_storeu_ps(dst + i, mix_sse2(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i), vt));
+    ngli_mix_f32_c(dst + i, a + i, b + i, t, n - i);
+}
+
+TARGET_SSE2 void ngli_noise_fbm_f32_sse2(float *dst, const float *t, const uint32_t *seeds, int n, const struct noise_params *p)
+{
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128i seed = _mm_loadu_si128((const __m128i *)(seeds + i));
+        _mm_storeu_ps(dst + i, fbm_sse2(_mm_loadu_ps(t + i), seed, p));
+    }
+    if (i == n)
+        return;
+
+    /* Remaining lanes are evaluated through zero-padded vectors */
+    float t_tail[4] = {0}, r_tail[4];
+    uint32_t seeds_tail[4] = {0};
+    memcpy(t_tail, t + i, (n - i) * sizeof(*t));
+    memcpy(seeds_tail, seeds + i, (n - i) * sizeof(*seeds));
+    const __m128i seed = _mm_loadu_si128((const __m128i *)seeds_tail);
+    _mm_storeu_ps(r_tail, fbm_sse2(_mm_loadu_ps(t_tail), seed, p));
+    memcpy(dst + i, r_tail, (n - i) * sizeof(*dst));
+}
+
+#define DEFINE_COLORCONV_FUNC_SSE2(name)                                        \
+TARGET_SSE2 void ngli_colorconv_##name##_f32_sse2(float *dst, const float *src, int n) \
+{                                                                               \
+    int i = 0;                                                                  \
+    for (; i + 4 <= n; i += 4)                                                  \
+        _mm_storeu_ps(dst + i, name##_sse2(_mm_loadu_ps(src + i)));             \
+    if (i == n)                                                                 \
+        return;                                                                 \
+    float tail[4] = {0};                                                        \
+    memcpy(tail, src + i, (n - i) * sizeof(*src));                              \
+    _mm_storeu_ps(tail, name##_sse2(_mm_loadu_ps(tail)));                       \
+    memcpy(dst + i, tail, (n - i) * sizeof(*dst));                              \
+}
+
+DEFINE_COLORCONV_FUNC_SSE2(srgb2linear)
+DEFINE_COLORCONV_FUNC_SSE2(linear2srgb)
+
+/* AVX2 */
+
+static inline TARGET_AVX2 __m256 log_avx2(__m256 x)
+{
+    const __m256 one = _mm256_set1_ps(1.f);
+    const __m256i e = _mm256_sub_epi32(_mm256_srli_epi32(_mm256_castps_si256(x), 23), _mm256_set1_epi32(0x7e));
+    __m256 fe = _mm256_cvtepi32_ps(e);
+
+    /* Mantissa in [0.5;1), then shifted in [sqrt(1/2)-1;sqrt(2)-1) */
+    x = _mm256_and_ps(x, _mm256_castsi256_ps(_mm256_set1_epi32(0x007fffff)));
+    x = _mm256_or_ps(x, _mm256_set1_ps(.5f));
+    const __m256 mask = _mm256_cmp_ps(x, _mm256_set1_ps(SQRTHF), _CMP_LT_OQ);
+    fe = _mm256_sub_ps(fe, _mm256_and_ps(mask, one));
+    x = _mm256_add_ps(_mm256_sub_ps(x, one), _mm256_and_ps(mask, x));
+
+    const __m256 z = _mm256_mul_ps(x, x);
+    __m256 y = _mm256_set1_ps(LOG_P0);
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(LOG_P1));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(LOG_P2));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(LOG_P3));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(LOG_P4));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(LOG_P5));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(LOG_P6));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(LOG_P7));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(LOG_P8));
+    y = _mm256_mul_ps(_mm256_mul_ps(y, x), z);
+
+    y = _mm256_add_ps(y, _mm256_mul_ps(fe, _mm256_set1_ps(LOG_Q1)));
+    y = _mm256_sub_ps(y, _mm256_mul_ps(z, _mm256_set1_ps(.5f)));
+    x = _mm256_add_ps(x, y);
+    return _mm256_add_ps(x, _mm256_mul_ps(fe, _mm256_set1_ps(LOG_Q2)));
+}
+
+static inline TARGET_AVX2 __m256 exp_avx2(__m256 x)
+{
+    x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(EXP_LO)), _mm256_set1_ps(EXP_HI));
+
+    /* x = n*log(2) + r */
+    const __m256 fn = _mm256_floor_ps(_mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(LOG2EF)), _mm256_set1_ps(.5f)));
+    x = _mm256_sub_ps(x, _mm256_mul_ps(fn, _mm256_set1_ps(LOG_Q2)));
+    x = _mm256_sub_ps(x, _mm256_mul_ps(fn, _mm256_set1_ps(LOG_Q1)));
+
+    const __m256 z = _mm256_mul_ps(x, x);
+    __m256 y = _mm256_set1_ps(EXP_P0);
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(EXP_P1));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(EXP_P2));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(EXP_P3));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(EXP_P4));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(EXP_P5));
+    y = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(y, z), x), _mm256_set1_ps(1.f));
+
+    /* 2^n built from the exponent bits */
+    const __m256i n = _mm256_add_epi32(_mm256_cvttps_epi32(fn), _mm256_set1_epi32(0x7f));
+    return _mm256_mul_ps(y, _mm256_castsi256_ps(_mm256_slli_epi32(n, 23)));
+}
+
+static inline TARGET_AVX2 __m256 pow_avx2(__m256 x, float p)
+{
+    return exp_avx2(_mm256_mul_ps(log_avx2(x), _mm256_set1_ps(p)));
+}
+
+static inline TARGET_AVX2 __m256i hash_avx2(__m256i x)
+{
+    x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+    x = _mm256_mullo_epi32(x, _mm256_set1_epi32(0x7feb352d));
+    x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 15));
+    x = _mm256_mullo_epi32(x, _mm256_set1_epi32((int)0x846ca68b));
+    x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+    return x;
+}
+
+static inline TARGET_AVX2 __m256 u32tof32_avx2(__m256i x)
+{
+    const __m256i bits = _mm256_or_si256(_mm256_set1_epi32(0x7f << 23), _mm256_srli_epi32(x, 9));
+    return _mm256_sub_ps(_mm256_castsi256_ps(bits), _mm256_set1_ps(1.f));
+}
+
+static inline TARGET_AVX2 __m256 curve_avx2(__m256 t, int function)
+{
+    switch (function) {
+    case NGLI_NOISE_CUBIC:
+        return _mm256_mul_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(3.f), _mm256_mul_ps(_mm256_set1_ps(2.f), t)), t), t);
+    case NGLI_NOISE_QUINTIC: {
+        __m256 r = _mm256_sub_ps(_mm256_mul_ps(_mm256_set1_ps(6.f), t), _mm256_set1_ps(15.f));
+        r = _mm256_add_ps(_mm256_mul_ps(r, t), _mm256_set1_ps(10.f));
+        return _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(r, t), t), t);
+    }
+    default:
+        return t;
+    }
+}
+
+/* See the SSE2 versions */
+static inline TARGET_AVX2 __m256 madd_pd_avx2(__m256 x, __m256d u_lo, __m256d u_hi, __m256d z_lo, __m256d z_hi)
+{
+    const __m256d lo = _mm256_add_pd(_mm256_mul_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(x)), u_lo), z_lo);
+    const __m256d hi = _mm256_add_pd(_mm256_mul_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(x, 1)), u_hi), z_hi);
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(lo)), _mm256_cvtpd_ps(hi), 1);
+}
+
+static inline TARGET_AVX2 __m256 mix_avx2(__m256 x, __m256 y, __m256d t)
+{
+    const __m256d u = _mm256_sub_pd(_mm256_set1_pd(1.), t);
+    const __m256d z_lo = _mm256_mul_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(y)), t);
+    const __m256d z_hi = _mm256_mul_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(y, 1)), t);
+    return madd_pd_avx2(x, u, u, z_lo, z_hi);
+}
+
+static inline TARGET_AVX2 __m256 mix_ps_avx2(__m256 x, __m256 y, __m256 a)
+{
+    const __m256d one = _mm256_set1_pd(1.);
+    const __m256 z = _mm256_mul_ps(y, a);
+    return madd_pd_avx2(x,
+                        _mm256_sub_pd(one, _mm256_cvtps_pd(_mm256_castps256_ps128(a))),
+                        _mm256_sub_pd(one, _mm256_cvtps_pd(_mm256_extractf128_ps(a, 1))),
+                        _mm256_cvtps_pd(_mm256_castps256_ps128(z)),
+                        _mm256_cvtps_pd(_mm256_extractf128_ps(z, 1)));
+}
+
+static inline TARGET_AVX2 __m256 noise_avx2(__m256 t, __m256i seed, int function)
+{
+    const __m256 one = _mm256_set1_ps(1.f);
+    const __m256 two = _mm256_set1_ps(2.f);
+    const __m256 i = _mm256_floor_ps(t);
+    const __m256 f = _mm256_sub_ps(t, i);
+    const __m256i x = _mm256_add_epi32(_mm256_cvttps_epi32(i), seed);
+    const __m256 s0 = _mm256_sub_ps(_mm256_mul_ps(u32tof32_avx2(hash_avx2(x)), two), one);
+    const __m256 s1 = _mm256_sub_ps(_mm256_mul_ps(u32tof32_avx2(hash_avx2(_mm256_add_epi32(x, _mm256_set1_epi32(1)))), two), one);
+    const __m256 y0 = _mm256_mul_ps(s0, f);
+    const __m256 y1 = _mm256_mul_ps(s1, _mm256_sub_ps(f, one));
+    const __m256 a = curve_avx2(f, function);
+    return mix_ps_avx2(y0, y1, a);
+}
+
+static inline TARGET_AVX2 __m256 fbm_avx2(__m256 t, __m256i seed, const struct noise_params *p)
+{
+    const __m256 lacunarity = _mm256_set1_ps(p->lacunarity);
+    __m256 sum = _mm256_setzero_ps();
+    float amp = p->amplitude;
+    for (int i = 0; i < p->octaves; i++) {
+        sum = _mm256_add_ps(sum, _mm256_mul_ps(noise_avx2(t, seed, p->function), _mm256_set1_ps(amp)));
+        t = _mm256_mul_ps(t, lacunarity);
+        amp *= p->gain;
+    }
+    return sum;
+}
+
+static inline TARGET_AVX2 __m256 srgb2linear_avx2(__m256 x)
+{
+    const __m256 lin = _mm256_div_ps(x, _mm256_set1_ps(12.92f));
+    const __m256 pw = pow_avx2(_mm256_div_ps(_mm256_add_ps(x, _mm256_set1_ps(.055f)), _mm256_set1_ps(1.055f)), 2.4f);
+    return _mm256_blendv_ps(pw, lin, _mm256_cmp_ps(x, _mm256_set1_ps(0.04045f), _CMP_LT_OQ));
+}
+
+static inline TARGET_AVX2 __m256 linear2srgb_avx2(__m256 x)
+{
+    const __m256 lin = _mm256_mul_ps(x, _mm256_set1_ps(12.92f));
+    const __m256 pw = _mm256_sub_ps(pow_avx2(_mm256_mul_ps(x, _mm256_set1_ps(1.055f)), 1.f/2.4f), _mm256_set1_ps(.055f));
+    return _mm256_blendv_ps(pw, lin, _mm256_cmp_ps(x, _mm256_set1_ps(0.0031308f), _CMP_LT_OQ));
+}
+
+TARGET_AVX2 void ngli_mix_f32_avx2(float *dst, const float *a, const float *b, double t, int n)
+{
+    const __m256d vt = _mm256_set1_pd(t);
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(dst + i, mix_avx2(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), vt));
+    ngli_mix_f32_sse2(dst + i, a + i, b + i, t, n - i);
+}
+
+TARGET_AVX2 void ngli_noise_fbm_f32_avx2(float *dst, const float *t, const uint32_t *seeds, int n, const struct noise_params *p)
+{
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i seed = _mm256_loadu_si256((const __m256i *)(seeds + i));
+        _mm256_storeu_ps(dst + i, fbm_avx2(_mm256_loadu_ps(t + i), seed, p));
+    }
+    ngli_noise_fbm_f32_sse2(dst + i, t + i, seeds + i, n - i, p);
+}
+
+#define DEFINE_COLORCONV_FUNC_AVX2(name)                                        \
+TARGET_AVX2 void ngli_colorconv_##name##_f32_avx2(float *dst, const float *src, int n) \
+{                                                                               \
+    int i = 0;                                                                  \
+    for (; i + 8 <= n; i += 8)                                                  \
+        _mm256_storeu_ps(dst + i, name##_avx2(_mm256_loadu_ps(src + i)));       \
+    ngli_colorconv_##name##_f32_sse2(dst + i, src + i, n - i);                  \
+}
+
+DEFINE_COLORCONV_FUNC_AVX2(srgb2linear)
+DEFINE_COLORCONV_FUNC_AVX2(linear2srgb)
@@ -19,11 +19,18 @@
  * under the License.
  */
 
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
+#include "colorconv.h"
 #include "utils.h"
 #include "math_utils.h"
+#include "noise.h"
+#include "simd.h"
+
+#define NB_ELEMS 37 // not a multiple of any vector size to exercise the tails
 
 static void flt_diff(float *dst, const float *a, const float *b, int size)
 {
@@ -42,6 +49,118 @@ static void flt_check(const float *f, int size)
     printf("=> OK\n");
 }
 
+static void flt_check_exact(const float *a, const float *b, int size)
+{
+    for (int i = 0; i < size; i++) {
+        if (memcmp(&a[i], &b[i], sizeof(a[i]))) {
+            fprintf(stderr, "float %d/%d differs (%g vs %g)\n", i + 1, size, a[i], b[i]);
+            exit(1);
+        }
+    }
+    printf("=> OK\n");
+}
+
+static uint32_t rand_state = 0x1234;
+
+static uint32_t rand_u32(void)
+{
+    rand_state = rand_state * 1664525 + 1013904223;
+    return rand_state;
+}
+
+static float rand_f32(float min, float max)
+{
+    return min + (rand_u32() >> 8) / (float)(1 << 24) * (max - min);
+}
+
+static void test_simd_funcs(const char *name, const struct simd_funcs *ref, const struct simd_funcs *funcs)
+{
+    float a[NB_ELEMS], b[NB_ELEMS], t[NB_ELEMS];
+    float out_ref[NB_ELEMS], out[NB_ELEMS], diff[NB_ELEMS];
+    uint32_t seeds[NB_ELEMS];
+    struct noise noise;
+
+    for (int i = 0; i < NB_ELEMS; i++) {
+        a[i] = rand_f32(-10.f, 10.f);
+        b[i] = rand_f32(-10.f, 10.f);
+        t[i] = rand_f32(-50.f, 50.f);
+        seeds[i] = rand_u32();
+    }
+
+    /* The mix and noise kernels must not change the output of the nodes using them */
+    static const double ratios[] = {0., 0.25, 0.731, 1.};
+    for (int i = 0; i < NGLI_ARRAY_NB(ratios); i++) {
+        printf(":: Testing %s mix f32 %d/%d\n", name, i + 1, (int)NGLI_ARRAY_NB(ratios));
+        for (int k = 0; k < NB_ELEMS; k++)
+            out_ref[k] = NGLI_MIX(a[k], b[k], ratios[i]);
+        funcs->mix_f32(out, a, b, ratios[i], NB_ELEMS);
+        flt_check_exact(out_ref, out, NB_ELEMS);
+    }
+
+    for (int function = 0; function < NGLI_NOISE_NB; function++) {
+        const struct noise_params p = {
+            .amplitude  = 1.2f,
+            .octaves    = 6,
+            .lacunarity = 1.98f,
+            .gain       = .56f,
+            .function   = function,
+        };
+        printf(":: Testing %s noise fbm f32 %d/%d\n", name, function + 1, NGLI_NOISE_NB);
+        for (int k = 0; k < NB_ELEMS; k++) {
+            struct noise_params np = p;
+            np.seed = seeds[k];
+            ngli_noise_init(&noise, &np);
+            out_ref[k] = ngli_noise_get(&noise, t[k]);
+        }
+        funcs->noise_fbm_f32(out, t, seeds, NB_ELEMS, &p);
+        flt_check_exact(out_ref, out, NB_ELEMS);
+    }
+
+    /* Cover both segments of the transfer functions, including out of range values */
+    for (int i = 0; i < NB_ELEMS; i++)
+        a[i] = -0.1f + 1.6f * i / (NB_ELEMS - 1);
+
+    printf(":: Testing %s sRGB to linear f32\n", name);
+    ref->srgb2linear_f32(out_ref, a, NB_ELEMS);
+    funcs->srgb2linear_f32(out, a, NB_ELEMS);
+    flt_diff(diff, out_ref, out, NB_ELEMS);
+    flt_check(diff, NB_ELEMS);
+
+    printf(":: Testing %s linear to sRGB f32\n", name);
+    ref->linear2srgb_f32(out_ref, a, NB_ELEMS);
+    funcs->linear2srgb_f32(out, a, NB_ELEMS);
+    flt_diff(diff, out_ref, out, NB_ELEMS);
+    flt_check(diff, NB_ELEMS);
+}
+
+static void test_simd(void)
+{
+    static const struct {
+        const char *name;
+        int flags;
+    } isas[] = {
+        {"c",    0},
+        {"sse2", NGLI_CPU_FLAG_SSE2},
+        {"avx2", NGLI_CPU_FLAG_SSE2 | NGLI_CPU_FLAG_AVX2},
+        {"neon", NGLI_CPU_FLAG_NEON},
+    };
+
+    const int cpu_flags = ngli_cpu_get_flags();
+
+    struct simd_funcs ref;
+    ngli_simd_init(&ref, 0);
+
+    for (int i = 0; i < NGLI_ARRAY_NB(isas); i++) {
+        if ((cpu_flags & isas[i].flags) != isas[i].flags) {
+            printf(":: Skipping %s (not supported)\n", isas[i].name);
+            continue;
+        }
+        struct simd_funcs funcs;
+        ngli_simd_init(&funcs, isas[i].flags);
+        test_simd_funcs(isas[i].name, &ref, &funcs);
+    }
+}
+
 int main(void)
 {
     static const NGLI_ALIGNED_MAT(m1) = {
@@ -95,5 +214,7 @@ int main(void)
         flt_check(v_diff, 4);
     }
 
+    test_simd();
+
     return 0;
 }
@@ -151,6 +151,50 @@ end:
     return ret;
 }
 
+/*
+ * Evaluate several expressions at once, with variables changing between runs
+ * to make sure they are not folded into constants
+ */
+static int test_multi(void)
+{
+    float x = 0.5f;
+    static const char * const exprs[] = {"x*2", "1 + 2*3", NULL, "sqr(x) - x + cos(0)"};
+
+    int ret = -1;
+    struct eval *e = ngli_eval_create();
+    struct hmap *vars = ngli_hmap_create();
+    if (!e || !vars)
+        goto end;
+
+    if ((ret = ngli_hmap_set(vars, "x", &x)) < 0 ||
+        (ret = ngli_eval_init_multi(e, exprs, NGLI_ARRAY_NB(exprs), vars)) < 0)
+        goto end;
+
+    for (int i = 0; i < 3; i++) {
+        float v[4];
+        ret = ngli_eval_run(e, v);
+        if (ret < 0)
+            goto end;
+
+        const float expected[] = {x * 2.f, 7.f, 7.f, x * x - x + 1.f};
+        for (int j = 0; j < NGLI_ARRAY_NB(expected); j++) {
+            if (fabsf(expected[j] - v[j]) > 0.0001) {
+                fprintf(stderr, "E: multi[%d] = %g (x=%g) but got %g\n", j, expected[j], x, v[j]);
+                ret = -1;
+                goto end;
+            }
+        }
+        x += 1.5f;
+    }
+
+    printf("[OK] multi\n");
+
+end:
+    ngli_hmap_freep(&vars);
+    ngli_eval_freep(&e);
+    return ret;
+}
+
 int main(int ac, char **av)
 {
 
@@ -168,12 +212,13 @@ int main(int ac, char **av)
     static const int nb_expr = NGLI_ARRAY_NB(expressions);
     for (int i = 0; i < nb_expr; i++)
         failed += test_expr(vars, &expressions[i]) < 0;
+    failed += test_multi() < 0;
 
     if (failed) {
-        fprintf(stderr, "%d/%d failed test(s)\n", failed, nb_expr);
+        fprintf(stderr, "%d/%d failed test(s)\n", failed, nb_expr + 1);
         ret = 1;
     } else {
-        printf("%d/%d tests passing\n", nb_expr, nb_expr);
+        printf("%d/%d tests passing\n", nb_expr + 1, nb_expr + 1);
     }
 
 end:
@@ -24,7 +24,11 @@
 
 struct texture *ngli_texture_create(struct gpu_ctx *gpu_ctx)
 {
-    return gpu_ctx->cls->texture_create(gpu_ctx);
+    struct texture *s = gpu_ctx->cls->texture_create(gpu_ctx);
+    if (!s)
+        return NULL;
+    s->id = ++gpu_ctx->object_id;
+    return s;
 }
 
 int ngli_texture_init(struct texture *s, const struct texture_params *params)
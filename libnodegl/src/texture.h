@@ -54,6 +54,7 @@ enum {
     NGLI_TEXTURE_USAGE_COLOR_ATTACHMENT_BIT         = 1 << 4,
     NGLI_TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT = 1 << 5,
     NGLI_TEXTURE_USAGE_TRANSIENT_ATTACHMENT_BIT     = 1 << 6,
+    NGLI_TEXTURE_USAGE_DYNAMIC_BIT                  = 1 << 7, // hint: content uploaded every frame
 };
 
 enum texture_type {
@@ -87,6 +88,7 @@ struct texture_params {
 
 struct texture {
     struct gpu_ctx *gpu_ctx;
+    uint64_t id; /* creation order identifier, stable from one run to another unlike the address */
     struct texture_params params;
 };
 
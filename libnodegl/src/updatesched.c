@@ -0,0 +1,332 @@
+/*
+ * Copyright 2023 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "hmap.h"
+#include "internal.h"
+#include "log.h"
+#include "memory.h"
+#include "updatesched.h"
+#include "utils.h"
+
+/* Minimum number of asynchronous nodes in the scene to start the workers */
+#define MIN_SCENE_NODES 64
+
+/* Minimum number of nodes at a given depth to dispatch them to the workers */
+#define MIN_LEVEL_NODES 16
+
+/*
+ * Node depths stored in the visited map (offset by DEPTH_OFFSET so that the
+ * map never holds a NULL pointer)
+ */
+#define DEPTH_NO_UPDATE -2 // no update callback, never blocks its parents
+#define DEPTH_SERIAL    -1 // must be updated by the regular update pass
+#define DEPTH_OFFSET     3
+
+struct node_depth {
+    struct ngl_node *node;
+    int depth;
+};
+
+static int get_nb_cpus(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors;
+#else
+    return sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+}
+
+static int track_nodes(struct hmap *visited, struct darray *nodes, struct ngl_node *node, int *depthp)
+{
+    char key[32];
+    int ret = snprintf(key, sizeof(key), "%p", node);
+    if (ret < 0)
+        return ret;
+
+    const intptr_t visited_depth = (intptr_t)ngli_hmap_get(visited, key);
+    if (visited_depth) {
+        *depthp = visited_depth - DEPTH_OFFSET;
+        return 0;
+    }
+
+    /*
+     * A node can only be updated asynchronously if everything it updates in
+     * its update callback can be as well. Nodes without update callback are
+     * never updated by their parents and thus do not constrain them.
+     */
+    int is_async = node->cls->update && (node->cls->flags & NGLI_NODE_FLAG_UPDATE_ASYNC);
+    int depth = 0;
+
+    struct ngl_node **children = ngli_darray_data(&node->children);
+    for (int i = 0; i < ngli_darray_count(&node->children); i++) {
+        int child_depth;
+        ret = track_nodes(visited, nodes, children[i], &child_depth);
+        if (ret < 0)
+            return ret;
+        if (child_depth == DEPTH_SERIAL)
+            is_async = 0;
+        depth = NGLI_MAX(depth, child_depth + 1);
+    }
+
+    if (!node->cls->update) {
+        depth = DEPTH_NO_UPDATE;
+    } else if (!is_async) {
+        depth = DEPTH_SERIAL;
+    } else {
+        const struct node_depth node_depth = {.node = node, .depth = depth};
+        if (!ngli_darray_push(nodes, &node_depth))
+            return NGL_ERROR_MEMORY;
+    }
+
+    ret = ngli_hmap_set(visited, key, (void *)(intptr_t)(depth + DEPTH_OFFSET));
+    if (ret < 0)
+        return ret;
+
+    *depthp = depth;
+    return 0;
+}
+
+static int sort_nodes(struct updatesched *s, const struct darray *nodes)
+{
+    const struct node_depth *node_depths = ngli_darray_data(nodes);
+    const int nb_nodes = ngli_darray_count(nodes);
+
+    int max_depth = 0;
+    for (int i = 0; i < nb_nodes; i++)
+        max_depth = NGLI_MAX(max_depth, node_depths[i].depth);
+
+    for (int depth = 0; depth <= max_depth; depth++) {
+        for (int i = 0; i < nb_nodes; i++) {
+            if (node_depths[i].depth != depth)
+                continue;
+            if (!ngli_darray_push(&s->nodes, &node_depths[i].node))
+                return NGL_ERROR_MEMORY;
+        }
+        const int end = ngli_darray_count(&s->nodes);
+        if (!ngli_darray_push(&s->levels, &end))
+            return NGL_ERROR_MEMORY;
+    }
+
+    return 0;
+}
+
+static int run_job(struct updatesched *s)
+{
+    int ret = 0;
+    for (;;) {
+        const int i = ngli_atomic_fetch_add_i32(&s->job_next, 1);
+        if (i >= s->job_nb_nodes)
+            break;
+        struct ngl_node *node = s->job_nodes[i];
+        if (!node->is_active || ret < 0)
+            continue;
+        ret = ngli_node_update(node, s->job_time);
+    }
+    return ret;
+}
+
+static void *worker_thread(void *arg)
+{
+    struct updatesched *s = arg;
+
+    ngli_thread_set_name("ngl-update");
+
+    int job_id = 0;
+    pthread_mutex_lock(&s->lock);
+    for (;;) {
+        while (!s->stop && s->job_id == job_id)
+            pthread_cond_wait(&s->cond_wkr, &s->lock);
+        if (s->stop)
+            break;
+        job_id = s->job_id;
+        pthread_mutex_unlock(&s->lock);
+
+        const int ret = run_job(s);
+
+        pthread_mutex_lock(&s->lock);
+        if (ret < 0 && s->job_ret >= 0)
+            s->job_ret = ret;
+        if (--s->nb_running == 0)
+            pthread_cond_signal(&s->cond_ctl);
+    }
+    pthread_mutex_unlock(&s->lock);
+
+    return NULL;
+}
+
+static int start_workers(struct updatesched *s)
+{
+    const int nb_threads = NGLI_MIN(get_nb_cpus() - 1, NGLI_UPDATESCHED_MAX_THREADS);
+    if (nb_threads <= 0)
+        return 0;
+
+    if (pthread_mutex_init(&s->lock, NULL) ||
+        pthread_cond_init(&s->cond_wkr, NULL) ||
+        pthread_cond_init(&s->cond_ctl, NULL)) {
+        pthread_cond_destroy(&s->cond_ctl);
+        pthread_cond_destroy(&s->cond_wkr);
+        pthread_mutex_destroy(&s->lock);
+        return NGL_ERROR_EXTERNAL;
+    }
+
+    for (int i = 0; i < nb_threads; i++) {
+        if (pthread_create(&s->threads[i], NULL, worker_thread, s)) {
+            LOG(WARNING, "could not create update worker thread");
+            break;
+        }
+        s->nb_threads++;
+    }
+
+    if (!s->nb_threads) {
+        pthread_cond_destroy(&s->cond_ctl);
+        pthread_cond_destroy(&s->cond_wkr);
+        pthread_mutex_destroy(&s->lock);
+        return 0;
+    }
+
+    LOG(DEBUG, "update %d nodes using %d workers", ngli_darray_count(&s->nodes), s->nb_threads);
+
+    return 0;
+}
+
+int ngli_updatesched_init(struct updatesched *s, struct ngl_node *scene)
+{
+    memset(s, 0, sizeof(*s));
+    ngli_darray_init(&s->nodes, sizeof(struct ngl_node *), 0);
+    ngli_darray_init(&s->levels, sizeof(int), 0);
+
+    struct darray nodes;
+    ngli_darray_init(&nodes, sizeof(struct node_depth), 0);
+
+    struct hmap *visited = ngli_hmap_create();
+    if (!visited)
+        return NGL_ERROR_MEMORY;
+
+    int depth;
+    int ret = track_nodes(visited, &nodes, scene, &depth);
+    if (ret < 0)
+        goto end;
+
+    if (ngli_darray_count(&nodes) < MIN_SCENE_NODES)
+        goto end;
+
+    ret = sort_nodes(s, &nodes);
+    if (ret < 0)
+        goto end;
+
+    ret = start_workers(s);
+
+end:
+    ngli_hmap_freep(&visited);
+    ngli_darray_reset(&nodes);
+    if (ret < 0)
+        ngli_updatesched_reset(s);
+    return ret;
+}
+
+static int run_level(struct updatesched *s, struct ngl_node **nodes, int nb_nodes, double t)
+{
+    if (nb_nodes < MIN_LEVEL_NODES) {
+        for (int i = 0; i < nb_nodes; i++) {
+            if (!nodes[i]->is_active)
+                continue;
+            int ret = ngli_node_update(nodes[i], t);
+            if (ret < 0)
+                return ret;
+        }
+        return 0;
+    }
+
+    pthread_mutex_lock(&s->lock);
+    s->job_nodes = nodes;
+    s->job_nb_nodes = nb_nodes;
+    s->job_next = 0;
+    s->job_time = t;
+    s->job_ret = 0;
+    s->nb_running = s->nb_threads;
+    s->job_id++;
+    pthread_cond_broadcast(&s->cond_wkr);
+    pthread_mutex_unlock(&s->lock);
+
+    /* The render thread takes its share of the job as well */
+    int ret = run_job(s);
+
+    pthread_mutex_lock(&s->lock);
+    while (s->nb_running)
+        pthread_cond_wait(&s->cond_ctl, &s->lock);
+    if (ret >= 0)
+        ret = s->job_ret;
+    pthread_mutex_unlock(&s->lock);
+
+    return ret;
+}
+
+int ngli_updatesched_run(struct updatesched *s, double t)
+{
+    if (!s->nb_threads)
+        return 0;
+
+    struct ngl_node **nodes = ngli_darray_data(&s->nodes);
+    const int *levels = ngli_darray_data(&s->levels);
+    int start = 0;
+    for (int i = 0; i < ngli_darray_count(&s->levels); i++) {
+        const int end = levels[i];
+        int ret = run_level(s, nodes + start, end - start, t);
+        if (ret < 0)
+            return ret;
+        start = end;
+    }
+
+    return 0;
+}
+
+void ngli_updatesched_reset(struct updatesched *s)
+{
+    if (s->nb_threads) {
+        pthread_mutex_lock(&s->lock);
+        s->stop = 1;
+        pthread_cond_broadcast(&s->cond_wkr);
+        pthread_mutex_unlock(&s->lock);
+
+        for (int i = 0; i < s->nb_threads; i++)
+            pthread_join(s->threads[i], NULL);
+
+        pthread_cond_destroy(&s->cond_ctl);
+        pthread_cond_destroy(&s->cond_wkr);
+        pthread_mutex_destroy(&s->lock);
+    }
+
+    ngli_darray_reset(&s->nodes);
+    ngli_darray_reset(&s->levels);
+    memset(s, 0, sizeof(*s));
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2023 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef UPDATESCHED_H
+#define UPDATESCHED_H
+
+#include "darray.h"
+#include "pthread_compat.h"
+
+#define NGLI_UPDATESCHED_MAX_THREADS 8
+
+struct ngl_node;
+
+/*
+ * Scheduler running the update of the CPU-only nodes (flagged with
+ * NGLI_NODE_FLAG_UPDATE_ASYNC) on a pool of worker threads.
+ *
+ * When a scene is set, the nodes which can be updated asynchronously are
+ * collected and sorted by depth in the dependency graph: a node only depends
+ * on its children, so all the nodes at a given depth can be updated
+ * concurrently once the nodes of the previous depth are updated. The
+ * scheduler runs before the regular update pass, which then skips the nodes
+ * already updated for the requested time and performs the GPU uploads on the
+ * render thread.
+ *
+ * Small scenes do not benefit from the synchronization cost of the workers,
+ * so the pool is only started if the scene contains enough of these nodes.
+ */
+struct updatesched {
+    struct darray nodes;  // array of struct ngl_node *, sorted by depth
+    struct darray levels; // array of int, end index of each depth in nodes
+
+    pthread_t threads[NGLI_UPDATESCHED_MAX_THREADS];
+    int nb_threads;
+    pthread_mutex_t lock;
+    pthread_cond_t cond_wkr;
+    pthread_cond_t cond_ctl;
+    int stop;
+
+    /* Current job, shared with the workers */
+    struct ngl_node **job_nodes;
+    int job_nb_nodes;
+    int job_next;
+    double job_time;
+    int job_id;
+    int job_ret;
+    int nb_running;
+};
+
+int ngli_updatesched_init(struct updatesched *s, struct ngl_node *scene);
+int ngli_updatesched_run(struct updatesched *s, double t);
+void ngli_updatesched_reset(struct updatesched *s);
+
+#endif
@@ -34,6 +34,7 @@
 #include <errno.h>
 #endif
 
+#include <inttypes.h>
 #include <stdarg.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -171,6 +172,15 @@ uint32_t ngli_crc32(const char *s)
     return ~crc;
 }
 
+uint32_t ngli_crc32_data(const void *data, size_t size)
+{
+    const uint8_t *p = data;
+    uint32_t crc = ~0;
+    for (size_t i = 0; i < size; i++)
+        crc = (crc >> 8) ^ crc_table[(crc & 0xff) ^ p[i]];
+    return ~crc;
+}
+
 void ngli_thread_set_name(const char *name)
 {
 #if defined(__APPLE__)
@@ -180,6 +190,30 @@ void ngli_thread_set_name(const char *name)
 #endif
 }
 
+uint64_t ngli_thread_get_id(void)
+{
+#ifdef _WIN32
+    return GetCurrentThreadId();
+#else
+    return (uintptr_t)pthread_self();
+#endif
+}
+
+char *ngli_get_tmp_filename(const char *filename)
+{
+#ifdef _WIN32
+    const unsigned long pid = GetCurrentProcessId();
+#else
+    const unsigned long pid = getpid();
+#endif
+    /*
+     * The process and thread identifiers make the name unique among all the
+     * writers, which is required for the write-then-rename pattern to be safe
+     * when multiple processes or contexts target the same file
+     */
+    return ngli_asprintf("%s.%lu.%" PRIx64 ".tmp", filename, pid, ngli_thread_get_id());
+}
+
 int ngli_get_filesize(const char *filename, int64_t *size)
 {
 #ifdef _WIN32
@@ -260,10 +294,43 @@ int ngli_config_copy(struct ngl_config *dst, const struct ngl_config *src)
 {
     struct ngl_config tmp = *src;
 
+    tmp.hud_export_filename = NULL;
+    tmp.profiler_export_filename = NULL;
+    tmp.program_cache_dir = NULL;
+    tmp.pipeline_cache_filename = NULL;
+    tmp.backend_config = NULL;
+
+    int ret = 0;
     if (src->hud_export_filename) {
         tmp.hud_export_filename = ngli_strdup(src->hud_export_filename);
-        if (!tmp.hud_export_filename)
-            return NGL_ERROR_MEMORY;
+        if (!tmp.hud_export_filename) {
+            ret = NGL_ERROR_MEMORY;
+            goto fail;
+        }
+    }
+
+    if (src->profiler_export_filename) {
+        tmp.profiler_export_filename = ngli_strdup(src->profiler_export_filename);
+        if (!tmp.profiler_export_filename) {
+            ret = NGL_ERROR_MEMORY;
+            goto fail;
+        }
+    }
+
+    if (src->program_cache_dir) {
+        tmp.program_cache_dir = ngli_strdup(src->program_cache_dir);
+        if (!tmp.program_cache_dir) {
+            ret = NGL_ERROR_MEMORY;
+            goto fail;
+        }
+    }
+
+    if (src->pipeline_cache_filename) {
+        tmp.pipeline_cache_filename = ngli_strdup(src->pipeline_cache_filename);
+        if (!tmp.pipeline_cache_filename) {
+            ret = NGL_ERROR_MEMORY;
+            goto fail;
+        }
     }
 
     if (src->backend_config) {
@@ -272,26 +339,33 @@ int ngli_config_copy(struct ngl_config *dst, const struct ngl_config *src)
             const size_t size = sizeof(struct ngl_config_gl);
             tmp.backend_config = ngli_memdup(src->backend_config, size);
             if (!tmp.backend_config) {
-                ngli_freep(&tmp.hud_export_filename);
-                return NGL_ERROR_MEMORY;
+                ret = NGL_ERROR_MEMORY;
+                goto fail;
             }
         } else {
-            ngli_freep(&tmp.hud_export_filename);
             LOG(ERROR, "backend_config %p is not supported by backend %d",
                 src->backend_config, src->backend);
-            return NGL_ERROR_UNSUPPORTED;
+            ret = NGL_ERROR_UNSUPPORTED;
+            goto fail;
         }
     }
 
     *dst = tmp;
 
     return 0;
+
+fail:
+    ngli_config_reset(&tmp);
+    return ret;
 }
 
 void ngli_config_reset(struct ngl_config *config)
 {
     ngli_freep(&config->backend_config);
     ngli_freep(&config->hud_export_filename);
+    ngli_freep(&config->profiler_export_filename);
+    ngli_freep(&config->program_cache_dir);
+    ngli_freep(&config->pipeline_cache_filename);
     memset(config, 0, sizeof(*config));
 }
 
@@ -115,7 +115,10 @@ void *ngli_memdup(const void *src, size_t n);
 int64_t ngli_gettime_relative(void);
 char *ngli_asprintf(const char *fmt, ...) ngli_printf_format(1, 2);
 uint32_t ngli_crc32(const char *s);
+uint32_t ngli_crc32_data(const void *data, size_t size);
 void ngli_thread_set_name(const char *name);
+uint64_t ngli_thread_get_id(void);
+char *ngli_get_tmp_filename(const char *filename);
 int ngli_get_filesize(const char *name, int64_t *size);
 char *ngli_numbered_lines(const char *s);
 int ngli_config_copy(struct ngl_config *dst, const struct ngl_config *src);
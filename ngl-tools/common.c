@@ -109,7 +109,7 @@ void get_viewport(int width, int height, const int *aspect_ratio, int *vp)
 
 #define BUF_SIZE 1024
 
-char *get_text_file_content(const char *filename)
+char *get_file_content(const char *filename, size_t *sizep)
 {
     char *buf = NULL;
 
@@ -119,16 +119,20 @@ char *get_text_file_content(const char *filename)
         goto end;
     }
 
-    size_t pos = 0;
+    size_t pos = 0, capacity = 0;
     for (;;) {
         const size_t needed = pos + BUF_SIZE + 1;
-        void *new_buf = realloc(buf, needed);
-        if (!new_buf) {
-            free(buf);
-            buf = NULL;
-            goto end;
+        if (needed > capacity) {
+            /* Grow geometrically since binary scenes can be large */
+            capacity = needed * 2;
+            void *new_buf = realloc(buf, capacity);
+            if (!new_buf) {
+                free(buf);
+                buf = NULL;
+                goto end;
+            }
+            buf = new_buf;
         }
-        buf = new_buf;
         const size_t n = fread(buf + pos, 1, BUF_SIZE, fp);
         if (ferror(fp)) {
             free(buf);
@@ -138,6 +142,8 @@ char *get_text_file_content(const char *filename)
         pos += n;
         if (feof(fp)) {
             buf[pos] = 0;
+            if (sizep)
+                *sizep = pos;
             break;
         }
     }
@@ -147,3 +153,8 @@ end:
         fclose(fp);
     return buf;
 }
+
+char *get_text_file_content(const char *filename)
+{
+    return get_file_content(filename, NULL);
+}
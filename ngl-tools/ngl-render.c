@@ -36,22 +36,13 @@
 
 #include "common.h"
 #include "opts.h"
+#include "pthread_compat.h"
 #include "wsi.h"
 
 #ifndef O_BINARY
 #define O_BINARY 0
 #endif
 
-static struct ngl_node *get_scene(const char *filename)
-{
-    char *buf = get_text_file_content(filename);
-    if (!buf)
-        return NULL;
-    struct ngl_node *scene = ngl_node_deserialize(buf);
-    free(buf);
-    return scene;
-}
-
 struct range {
     float start;
     float duration;
@@ -68,6 +59,7 @@ struct ctx {
     struct range *ranges;
     int nb_ranges;
     int aspect[2];
+    int nb_jobs;
 };
 
 static int opt_timerange(const char *arg, void *dst)
@@ -93,6 +85,209 @@ static int opt_timerange(const char *arg, void *dst)
     return 0;
 }
 
+static int write_capture(int fd, const uint8_t *capture_buffer, size_t capture_buffer_size)
+{
+    const size_t n = write(fd, capture_buffer, capture_buffer_size);
+    if (n != capture_buffer_size) {
+        fprintf(stderr, "unable to write capture buffer to output\n");
+        return -1;
+    }
+    return 0;
+}
+
+static int acquire_capture(struct ngl_ctx *ctx, int fd, const uint8_t *capture_buffer, size_t capture_buffer_size)
+{
+    if (ngl_capture_acquire(ctx, NULL) <= 0) {
+        fprintf(stderr, "unable to acquire captured frame\n");
+        return -1;
+    }
+    return write_capture(fd, capture_buffer, capture_buffer_size);
+}
+
+static struct ngl_node *deserialize_scene(const char *data, size_t size)
+{
+    if (size >= 4 && !memcmp(data, "NGLB", 4))
+        return ngl_node_deserialize_binary(data, size);
+    return ngl_node_deserialize(data);
+}
+
+/*
+ * Frame-parallel rendering: every job owns its own node.gl context and scene
+ * instance, and renders the frames job_id, job_id + nb_jobs, ... The frames
+ * are written to the output in order: a job waits for its turn before writing
+ * its capture buffer, and only then starts rendering its next frame.
+ */
+struct jobs_ctx {
+    const struct ctx *s;
+    const char *scene_data;
+    size_t scene_size;
+    int fd;
+    size_t capture_buffer_size;
+    float *times;
+    int nb_frames;
+
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int next_frame; /* next frame to write to the output */
+    int error;
+};
+
+struct job {
+    struct jobs_ctx *jobs;
+    int id;
+    pthread_t tid;
+    int ret;
+};
+
+static int job_wait_turn(struct jobs_ctx *jobs, int frame)
+{
+    pthread_mutex_lock(&jobs->lock);
+    while (jobs->next_frame != frame && !jobs->error)
+        pthread_cond_wait(&jobs->cond, &jobs->lock);
+    const int error = jobs->error;
+    pthread_mutex_unlock(&jobs->lock);
+    return error ? -1 : 0;
+}
+
+static void job_end_turn(struct jobs_ctx *jobs, int error)
+{
+    pthread_mutex_lock(&jobs->lock);
+    if (error)
+        jobs->error = 1;
+    else
+        jobs->next_frame++;
+    pthread_cond_broadcast(&jobs->cond);
+    pthread_mutex_unlock(&jobs->lock);
+}
+
+static void *job_run(void *arg)
+{
+    struct job *job = arg;
+    struct jobs_ctx *jobs = job->jobs;
+    const struct ctx *s = jobs->s;
+
+    struct ngl_ctx *ctx = NULL;
+    struct ngl_node *scene = NULL;
+    uint8_t *capture_buffer = NULL;
+
+    job->ret = -1;
+
+    if (jobs->fd != -1) {
+        capture_buffer = calloc(1, jobs->capture_buffer_size);
+        if (!capture_buffer)
+            goto end;
+    }
+
+    scene = deserialize_scene(jobs->scene_data, jobs->scene_size);
+    ctx = ngl_create();
+    if (!scene || !ctx)
+        goto end;
+
+    struct ngl_config cfg = s->cfg;
+    cfg.capture_buffer = capture_buffer;
+    cfg.capture_async_depth = 0;
+    if (ngl_configure(ctx, &cfg) < 0 || ngl_set_scene(ctx, scene) < 0)
+        goto end;
+
+    for (int i = job->id; i < jobs->nb_frames; i += s->nb_jobs) {
+        const float t = jobs->times[i];
+        if (s->debug)
+            printf("draw @ t=%f [job %d/%d]\n", t, job->id + 1, s->nb_jobs);
+        if (ngl_draw(ctx, t) < 0) {
+            fprintf(stderr, "Unable to draw @ t=%g\n", t);
+            goto end;
+        }
+        if (job_wait_turn(jobs, i) < 0)
+            goto end;
+        const int ret = capture_buffer ? write_capture(jobs->fd, capture_buffer, jobs->capture_buffer_size) : 0;
+        job_end_turn(jobs, ret < 0);
+        if (ret < 0)
+            goto end;
+    }
+
+    job->ret = 0;
+
+end:
+    if (job->ret < 0)
+        job_end_turn(jobs, 1);
+    ngl_freep(&ctx);
+    ngl_node_unrefp(&scene);
+    free(capture_buffer);
+    return NULL;
+}
+
+static int render_jobs(const struct ctx *s, const char *scene_data, size_t scene_size,
+                       int fd, size_t capture_buffer_size)
+{
+    int ret = EXIT_FAILURE;
+    struct jobs_ctx jobs = {
+        .s                   = s,
+        .scene_data          = scene_data,
+        .scene_size          = scene_size,
+        .fd                  = fd,
+        .capture_buffer_size = capture_buffer_size,
+    };
+    struct job *job_list = NULL;
+
+    for (int i = 0; i < s->nb_ranges; i++) {
+        const struct range *r = &s->ranges[i];
+        const float t0 = r->start;
+        const float t1 = r->start + r->duration;
+        /* Same frame times as the serial rendering */
+        for (int k = 0;; k++) {
+            const float t = t0 + k*1./r->freq;
+            if (t >= t1)
+                break;
+            float *times = realloc(jobs.times, (jobs.nb_frames + 1) * sizeof(*times));
+            if (!times)
+                goto end;
+            times[jobs.nb_frames++] = t;
+            jobs.times = times;
+        }
+    }
+
+    job_list = calloc(s->nb_jobs, sizeof(*job_list));
+    if (!job_list)
+        goto end;
+
+    pthread_mutex_init(&jobs.lock, NULL);
+    pthread_cond_init(&jobs.cond, NULL);
+
+    const int64_t start = gettime_relative();
+
+    int nb_started = 0;
+    for (; nb_started < s->nb_jobs; nb_started++) {
+        struct job *job = &job_list[nb_started];
+        job->jobs = &jobs;
+        job->id = nb_started;
+        if (pthread_create(&job->tid, NULL, job_run, job)) {
+            job_end_turn(&jobs, 1);
+            break;
+        }
+    }
+
+    int failed = nb_started != s->nb_jobs;
+    for (int i = 0; i < nb_started; i++) {
+        pthread_join(job_list[i].tid, NULL);
+        failed |= job_list[i].ret < 0;
+    }
+
+    pthread_cond_destroy(&jobs.cond);
+    pthread_mutex_destroy(&jobs.lock);
+
+    if (!failed) {
+        const double tdiff = (gettime_relative() - start) / 1000000.;
+        printf("Rendered %d frames with %d jobs in %g (FPS=%g)\n",
+               jobs.nb_frames, s->nb_jobs, tdiff, jobs.nb_frames / tdiff);
+        ret = 0;
+    }
+
+end:
+    free(job_list);
+    free(jobs.times);
+    return ret;
+}
+
 #define OFFSET(x) offsetof(struct ctx, x)
 static const struct opt options[] = {
     {"-d", "--debug",         OPT_TYPE_TOGGLE,   .offset=OFFSET(debug)},
@@ -107,6 +302,11 @@ static const struct opt options[] = {
     {"-z", "--swap_interval", OPT_TYPE_INT,      .offset=OFFSET(cfg.swap_interval)},
     {"-c", "--clear_color",   OPT_TYPE_COLOR,    .offset=OFFSET(cfg.clear_color)},
     {"-m", "--samples",       OPT_TYPE_INT,      .offset=OFFSET(cfg.samples)},
+    {NULL, "--program_cache_dir", OPT_TYPE_STR,  .offset=OFFSET(cfg.program_cache_dir)},
+    {NULL, "--pipeline_cache", OPT_TYPE_STR,     .offset=OFFSET(cfg.pipeline_cache_filename)},
+    {NULL, "--capture_async_depth", OPT_TYPE_INT, .offset=OFFSET(cfg.capture_async_depth)},
+    {NULL, "--profile",       OPT_TYPE_STR,      .offset=OFFSET(cfg.profiler_export_filename)},
+    {"-j", "--jobs",          OPT_TYPE_INT,      .offset=OFFSET(nb_jobs)},
 };
 
 int main(int argc, char *argv[])
@@ -122,6 +322,7 @@ int main(int argc, char *argv[])
         .cfg.clear_color[3] = 1.f,
         .aspect[0]          = 1,
         .aspect[1]          = 1,
+        .nb_jobs            = 1,
     };
 
     SDL_Window *window = NULL;
@@ -139,6 +340,19 @@ int main(int argc, char *argv[])
         return EXIT_FAILURE;
     }
 
+    if (s.nb_jobs < 1 || (s.nb_jobs > 1 && !s.cfg.offscreen)) {
+        fprintf(stderr, "Parallel jobs are only supported with offscreen rendering\n");
+        return EXIT_FAILURE;
+    }
+
+    if (s.cfg.profiler_export_filename) {
+        if (s.nb_jobs > 1) {
+            fprintf(stderr, "Profiling is not supported with parallel jobs\n");
+            return EXIT_FAILURE;
+        }
+        s.cfg.profiler = 1;
+    }
+
     printf("%s -> %s %dx%d\n", s.input ? s.input : "<stdin>", s.output ? s.output : "-", s.cfg.width, s.cfg.height);
 
     if (!s.cfg.offscreen) {
@@ -154,11 +368,13 @@ int main(int argc, char *argv[])
 
     int fd = -1;
     struct ngl_ctx *ctx = NULL;
+    struct ngl_node *scene = NULL;
     uint8_t *capture_buffer = NULL;
     const size_t capture_buffer_size = 4 * s.cfg.width * s.cfg.height;
 
-    struct ngl_node *scene = get_scene(s.input);
-    if (!scene) {
+    size_t scene_size = 0;
+    char *scene_data = get_file_content(s.input, &scene_size);
+    if (!scene_data) {
         ret = EXIT_FAILURE;
         goto end;
     }
@@ -179,18 +395,33 @@ int main(int argc, char *argv[])
                 goto end;
             }
         }
+    }
+
+    get_viewport(s.cfg.width, s.cfg.height, s.aspect, s.cfg.viewport);
+
+    if (s.nb_jobs > 1) {
+        ret = render_jobs(&s, scene_data, scene_size, fd, capture_buffer_size);
+        goto end;
+    }
+
+    if (fd != -1) {
         capture_buffer = calloc(1, capture_buffer_size);
         if (!capture_buffer)
             goto end;
     }
 
+    scene = deserialize_scene(scene_data, scene_size);
+    if (!scene) {
+        ret = EXIT_FAILURE;
+        goto end;
+    }
+
     ctx = ngl_create();
     if (!ctx) {
         ngl_node_unrefp(&scene);
         goto end;
     }
 
-    get_viewport(s.cfg.width, s.cfg.height, s.aspect, s.cfg.viewport);
     s.cfg.capture_buffer = capture_buffer;
 
     if (!s.cfg.offscreen) {
@@ -212,6 +443,7 @@ int main(int argc, char *argv[])
     if (ret < 0)
         goto end;
 
+    int nb_pending_captures = 0;
     for (int i = 0; i < s.nb_ranges; i++) {
         int k = 0;
         const struct range *r = &s.ranges[i];
@@ -232,12 +464,16 @@ int main(int argc, char *argv[])
                 fprintf(stderr, "Unable to draw @ t=%g\n", t);
                 goto end;
             }
-            if (capture_buffer) {
-                const size_t n = write(fd, capture_buffer, capture_buffer_size);
-                if (n != capture_buffer_size) {
-                    fprintf(stderr, "unable to write capture buffer to output\n");
-                    goto end;
+            if (capture_buffer && s.cfg.capture_async_depth) {
+                /* Only retrieve a frame once the readback queue is full */
+                if (++nb_pending_captures == s.cfg.capture_async_depth) {
+                    nb_pending_captures--;
+                    if (acquire_capture(ctx, fd, capture_buffer, capture_buffer_size) < 0)
+                        goto end;
                 }
+            } else if (capture_buffer) {
+                if (write_capture(fd, capture_buffer, capture_buffer_size) < 0)
+                    goto end;
             }
             if (!s.cfg.offscreen) {
                 SDL_Event event;
@@ -248,6 +484,10 @@ int main(int argc, char *argv[])
             k++;
         }
 
+        for (; nb_pending_captures; nb_pending_captures--)
+            if (acquire_capture(ctx, fd, capture_buffer, capture_buffer_size) < 0)
+                goto end;
+
         const double tdiff = (gettime_relative() - start) / 1000000.;
         printf("Rendered %d frames in %g (FPS=%g)\n", k, tdiff, k / tdiff);
     }
@@ -259,6 +499,7 @@ end:
         close(fd);
 
     free(capture_buffer);
+    free(scene_data);
     free(s.ranges);
 
     if (!s.cfg.offscreen) {
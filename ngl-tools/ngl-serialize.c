@@ -50,12 +50,21 @@ static FILE *open_ofile(const char *output)
     return fopen(output, "wb");
 }
 
+static int has_extension(const char *filename, const char *ext)
+{
+    const size_t len = strlen(filename);
+    const size_t ext_len = strlen(ext);
+    return len >= ext_len && !strcmp(filename + len - ext_len, ext);
+}
+
 int main(int argc, char *argv[])
 {
     int ret = 0;
+    void *serialized_scene = NULL;
+    size_t size = 0;
 
     if (argc != 4) {
-        fprintf(stderr, "Usage: %s <module> <scene_func> <output.ngl>\n", argv[0]);
+        fprintf(stderr, "Usage: %s <module> <scene_func> <output.ngl|output.nglb>\n", argv[0]);
         return 0;
     }
 
@@ -69,21 +78,27 @@ int main(int argc, char *argv[])
         goto end;
     }
 
-    char *serialized_scene = ngl_node_serialize(scene);
+    if (has_extension(argv[3], ".nglb")) {
+        serialized_scene = ngl_node_serialize_binary(scene, &size);
+    } else {
+        serialized_scene = ngl_node_serialize(scene);
+        if (serialized_scene)
+            size = strlen(serialized_scene);
+    }
     ngl_node_unrefp(&scene);
     if (!serialized_scene) {
         ret = EXIT_FAILURE;
         goto end;
     }
 
-    const size_t slen = strlen(serialized_scene);
-    const size_t n = fwrite(serialized_scene, 1, slen, of);
-    if (n != slen) {
+    const size_t n = fwrite(serialized_scene, 1, size, of);
+    if (n != size) {
         ret = EXIT_FAILURE;
         goto end;
     }
 
 end:
+    free(serialized_scene);
     if (of)
         fclose(of);
 
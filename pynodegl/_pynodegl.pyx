@@ -34,6 +34,8 @@ cdef extern from "nodegl.h":
     cdef int NGL_LOG_ERROR
     cdef int NGL_LOG_QUIET
 
+    cdef int NGL_ERROR_INVALID_DATA
+
     void ngl_log_set_min_level(int level)
 
     cdef struct ngl_node
@@ -68,8 +70,11 @@ cdef extern from "nodegl.h":
     char *ngl_node_dot(const ngl_node *node)
     char *ngl_node_serialize(const ngl_node *node)
     ngl_node *ngl_node_deserialize(const char *s)
+    void *ngl_node_serialize_binary(const ngl_node *node, size_t *sizep)
+    ngl_node *ngl_node_deserialize_binary(const void *data, size_t size)
 
     int ngl_anim_evaluate(ngl_node *anim, void *dst, double t)
+    int ngl_anim_evaluate_batch(ngl_node *anim, void *dst, const double *times, int nb_times)
 
     cdef int NGL_PLATFORM_AUTO
     cdef int NGL_PLATFORM_XLIB
@@ -143,11 +148,17 @@ cdef extern from "nodegl.h":
         float clear_color[4]
         void *capture_buffer
         int capture_buffer_type
+        int capture_async_depth
+        int draw_queue_depth
         int hud
         int hud_measure_window
         int hud_refresh_rate[2]
         const char *hud_export_filename
         int hud_scale
+        int profiler
+        const char *profiler_export_filename
+        const char *program_cache_dir
+        const char *pipeline_cache_filename
 
     cdef union ngl_livectl_data:
         float f[4]
@@ -171,9 +182,13 @@ cdef extern from "nodegl.h":
     int ngl_configure(ngl_ctx *s, ngl_config *config)
     int ngl_resize(ngl_ctx *s, int width, int height, const int *viewport)
     int ngl_set_capture_buffer(ngl_ctx *s, void *capture_buffer)
+    int ngl_capture_acquire(ngl_ctx *s, double *t) nogil
     int ngl_set_scene(ngl_ctx *s, ngl_node *scene)
     int ngl_draw(ngl_ctx *s, double t) nogil
+    int ngl_draw_async(ngl_ctx *s, double t) nogil
+    int ngl_wait(ngl_ctx *s) nogil
     char *ngl_dot(ngl_ctx *s, double t) nogil
+    char *ngl_profiler_get_trace(ngl_ctx *s) nogil
     int ngl_livectls_get(ngl_node *scene, int *nb_livectlsp, ngl_livectl **livectlsp)
     void ngl_livectls_freep(ngl_livectl **livectlsp)
     void ngl_freep(ngl_ctx **ss)
@@ -263,6 +278,16 @@ cdef class _Node:
     def serialize(self):
         return _ret_pystr(ngl_node_serialize(self.ctx))
 
+    def serialize_binary(self):
+        cdef size_t size = 0
+        cdef void *data = ngl_node_serialize_binary(self.ctx, &size)
+        if data is NULL:
+            return None
+        try:
+            return (<char *>data)[:size]
+        finally:
+            free(data)
+
     def dot(self):
         return _ret_pystr(ngl_node_dot(self.ctx))
 
@@ -379,6 +404,28 @@ cdef class _Node:
         ngl_anim_evaluate(self.ctx, vec, t)
         return (vec[0], vec[1], vec[2], vec[3])
 
+    def _eval_batch(self, times, int nb_comps):
+        cdef int nb_times = len(times)
+        cdef double *c_times = <double *>calloc(nb_times, sizeof(double))
+        cdef float *c_values = <float *>calloc(nb_times * nb_comps, sizeof(float))
+        if c_times is NULL or c_values is NULL:
+            free(c_times)
+            free(c_values)
+            raise MemoryError()
+        cdef int i
+        for i, t in enumerate(times):
+            c_times[i] = t
+        ret = ngl_anim_evaluate_batch(self.ctx, c_values, c_times, nb_times)
+        if ret < 0:
+            values = None
+        elif nb_comps == 1:
+            values = [c_values[i] for i in range(nb_times)]
+        else:
+            values = [tuple(c_values[i * nb_comps + j] for j in range(nb_comps)) for i in range(nb_times)]
+        free(c_times)
+        free(c_values)
+        return values
+
     def _param_add_f64s(self, const char *key, int nb_f64s, f64s):
         f64s_c = <double *>calloc(nb_f64s, sizeof(double))
         if f64s_c is NULL:
@@ -594,6 +641,8 @@ cdef class Context:
         capture_buffer = kwargs.get('capture_buffer')
         if capture_buffer is not None:
             config.capture_buffer = <uint8_t *>capture_buffer
+        config.capture_async_depth = kwargs.get('capture_async_depth', 0)
+        config.draw_queue_depth = kwargs.get('draw_queue_depth', 0)
         config.hud = kwargs.get('hud', 0)
         config.hud_measure_window = kwargs.get('hud_measure_window', 0)
         hud_refresh_rate = kwargs.get('hud_refresh_rate', (0, 0))
@@ -603,6 +652,16 @@ cdef class Context:
         if hud_export_filename is not None:
             config.hud_export_filename = hud_export_filename
         config.hud_scale = kwargs.get('hud_scale', 0)
+        config.profiler = kwargs.get('profiler', 0)
+        profiler_export_filename = kwargs.get('profiler_export_filename')
+        if profiler_export_filename is not None:
+            config.profiler_export_filename = profiler_export_filename
+        program_cache_dir = kwargs.get('program_cache_dir')
+        if program_cache_dir is not None:
+            config.program_cache_dir = program_cache_dir
+        pipeline_cache_filename = kwargs.get('pipeline_cache_filename')
+        if pipeline_cache_filename is not None:
+            config.pipeline_cache_filename = pipeline_cache_filename
 
     def configure(self, **kwargs):
         self.capture_buffer = kwargs.get('capture_buffer')
@@ -625,6 +684,14 @@ cdef class Context:
             ptr = <uint8_t *>self.capture_buffer
         return ngl_set_capture_buffer(self.ctx, ptr)
 
+    def capture_acquire(self):
+        cdef double t = 0
+        with nogil:
+            ret = ngl_capture_acquire(self.ctx, &t)
+        if ret < 0:
+            return ret, None
+        return ret, t if ret else None
+
     def set_scene(self, _Node scene):
         return ngl_set_scene(self.ctx, NULL if scene is None else scene.ctx)
 
@@ -634,17 +701,44 @@ cdef class Context:
         ngl_node_unrefp(&scene)
         return ret
 
+    def set_scene_from_binary(self, const uint8_t[:] data):
+        cdef const uint8_t *ptr = NULL
+        if data.shape[0] > 0:
+            ptr = &data[0]
+        cdef ngl_node *scene = ngl_node_deserialize_binary(ptr, data.shape[0])
+        if scene == NULL:
+            return NGL_ERROR_INVALID_DATA
+        ret = ngl_set_scene(self.ctx, scene)
+        ngl_node_unrefp(&scene)
+        return ret
+
     def draw(self, double t):
         with nogil:
             ret = ngl_draw(self.ctx, t)
         return ret
 
+    def draw_async(self, double t):
+        with nogil:
+            ret = ngl_draw_async(self.ctx, t)
+        return ret
+
+    def wait(self):
+        with nogil:
+            ret = ngl_wait(self.ctx)
+        return ret
+
     def dot(self, double t):
         cdef char *s
         with nogil:
             s = ngl_dot(self.ctx, t)
         return _ret_pystr(s) if s else None
 
+    def profiler_get_trace(self):
+        cdef char *s
+        with nogil:
+            s = ngl_profiler_get_trace(self.ctx)
+        return _ret_pystr(s) if s else None
+
     def __dealloc__(self):
         ngl_freep(&self.ctx)
 
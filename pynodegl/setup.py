@@ -177,12 +177,21 @@ class _WrapperGenerator:
         if not eval_type:
             return ""
         ret_type = cls._TYPING_MAP[eval_type]
-        return textwrap.dedent(
+        code = textwrap.dedent(
             f"""
             def evaluate(self, t: float) -> {ret_type}:
                 return self._eval_{eval_type}(t)
             """
         )
+        if class_name.startswith("Animated"):
+            nb_comps = dict(f32=1, vec2=2, vec3=3, vec4=4)[eval_type]
+            code += textwrap.dedent(
+                f"""
+                def evaluate_batch(self, times: Sequence[float]) -> List[{ret_type}]:
+                    return self._eval_batch(times, {nb_comps})
+                """
+            )
+        return code
 
     @classmethod
     def _get_class_init(cls, parent_params, params, inherited):
@@ -122,6 +122,119 @@ def api_capture_buffer(width=16, height=16):
     del ctx
 
 
+def api_capture_async(width=16, height=16, depth=3):
+    import zlib
+
+    ctx = ngl.Context()
+    capture_buffer = bytearray(width * height * 4)
+    ret = ctx.configure(
+        offscreen=1,
+        width=width,
+        height=height,
+        backend=_backend,
+        capture_buffer=capture_buffer,
+        capture_async_depth=depth,
+    )
+    assert ret == 0
+    scene = _get_scene()
+    assert ctx.set_scene(scene) == 0
+    for i in range(depth):
+        assert ctx.draw(i) == 0
+    assert ctx.draw(depth) != 0
+    for i in range(depth):
+        assert ctx.capture_acquire() == (1, i)
+        assert zlib.crc32(capture_buffer) == 0xB4BD32FA
+    assert ctx.capture_acquire() == (0, None)
+    del ctx
+
+
+def _get_scene_crc(load_scene, width, height):
+    import zlib
+
+    ctx = ngl.Context()
+    capture_buffer = bytearray(width * height * 4)
+    ret = ctx.configure(offscreen=1, width=width, height=height, backend=_backend, capture_buffer=capture_buffer)
+    assert ret == 0
+    assert load_scene(ctx) == 0
+    assert ctx.draw(0) == 0
+    del ctx
+    return zlib.crc32(capture_buffer)
+
+
+def api_serialize_binary(width=16, height=16):
+    import array
+    import struct
+
+    vertices = array.array("f", [-1.0, -1.0, 0.0, 1.0, -1.0, 0.0, -1.0, 1.0, 0.0, 1.0, 1.0, 0.0])
+    uvcoords = array.array("f", [0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0])
+    geometry = ngl.Geometry(
+        vertices=ngl.BufferVec3(data=vertices),
+        uvcoords=ngl.BufferVec2(data=uvcoords),
+        topology="triangle_strip",
+    )
+    scene = _get_scene(geometry)
+    data = scene.serialize_binary()
+    assert data[:4] == b"NGLB"
+    crc_text = _get_scene_crc(lambda ctx: ctx.set_scene_from_string(scene.serialize()), width, height)
+    crc_binary = _get_scene_crc(lambda ctx: ctx.set_scene_from_binary(data), width, height)
+    assert crc_text == crc_binary
+
+    # Invalid serialized scenes must be rejected without reading out of the
+    # buffer: empty, truncated, and with out of bounds sections or data
+    # references (the header is made of 6 uint32 followed by the uint64
+    # nodes offset, params offset, params size, data offset and data size)
+    def _corrupt(field, value):
+        corrupted = bytearray(data)
+        struct.pack_into("=Q", corrupted, 24 + field * 8, value)
+        return corrupted
+
+    invalid_data = [
+        b"",
+        data[:-1],
+        _corrupt(0, len(data)),
+        _corrupt(1, 2**64 - 1),
+        _corrupt(2, len(data)),
+        _corrupt(3, 2**63),
+        _corrupt(4, 0),
+    ]
+    ctx = ngl.Context()
+    ret = ctx.configure(offscreen=1, width=width, height=height, backend=_backend)
+    assert ret == 0
+    for invalid in invalid_data:
+        assert ctx.set_scene_from_binary(invalid) < 0
+
+
+def api_draw_async(width=16, height=16):
+    import zlib
+
+    ctx = ngl.Context()
+    capture_buffer = bytearray(width * height * 4)
+    ret = ctx.configure(
+        offscreen=1,
+        width=width,
+        height=height,
+        backend=_backend,
+        capture_buffer=capture_buffer,
+        draw_queue_depth=2,
+    )
+    assert ret == 0
+    scene = _get_scene()
+    assert ctx.set_scene(scene) == 0
+    for i in range(5):
+        assert ctx.draw_async(i) == 0
+    assert ctx.wait() == 0
+    assert zlib.crc32(capture_buffer) == 0xB4BD32FA
+    for i in range(3):
+        assert ctx.draw_async(i) == 0
+    assert ctx.set_scene(None) == 0
+    assert ctx.draw_async(0) == 0
+    assert ctx.wait() == 0
+    ret = ctx.configure(offscreen=1, width=width, height=height, backend=_backend, draw_queue_depth=17)
+    assert ret != 0
+    assert ctx.draw_async(0) != 0
+    del ctx
+
+
 def api_ctx_ownership():
     ctx = ngl.Context()
     ctx2 = ngl.Context()
@@ -185,6 +298,161 @@ def api_hud(width=234, height=123):
     del ctx
 
 
+# The GPU draw time is collected without stalling, a few frames after being
+# measured; the frame latency is reported along with it in the CSV export.
+def api_hud_export_gpu_latency(width=16, height=16):
+    import csv
+    import json
+    import tempfile
+
+    nb_frames = 10
+    with tempfile.TemporaryDirectory() as tmpdir:
+        export_filename = os.path.join(tmpdir, "hud.csv")
+        trace_filename = os.path.join(tmpdir, "trace.json")
+        ctx = ngl.Context()
+        ret = ctx.configure(
+            offscreen=1,
+            width=width,
+            height=height,
+            backend=_backend,
+            hud=1,
+            hud_export_filename=export_filename,
+            profiler=1,
+            profiler_export_filename=trace_filename,
+        )
+        assert ret == 0
+        scene = _get_scene()
+        assert ctx.set_scene(scene) == 0
+        for i in range(nb_frames):
+            assert ctx.draw(i / 60.0) == 0
+        del ctx
+
+        with open(export_filename) as f:
+            rows = list(csv.DictReader(row for row in f if not row.startswith("#")))
+        assert len(rows) == nb_frames
+        latencies = [int(row["draw   GPU latency"]) for row in rows]
+        assert all(0 <= latency < 4 for latency in latencies)
+
+        # The GPU timings still pending when the context is released, such as
+        # the ones of the last frame, must be collected as well
+        with open(trace_filename) as f:
+            gpu_events = [event for event in json.load(f)["traceEvents"] if event.get("cat") == "gpu"]
+        if gpu_events:
+            assert len(gpu_events) == nb_frames
+
+
+def api_hud_export_program_cache(width=16, height=16):
+    import csv
+    import tempfile
+
+    def get_program_cache_stats(cache_dir, export_filename):
+        ctx = ngl.Context()
+        ret = ctx.configure(
+            offscreen=1,
+            width=width,
+            height=height,
+            backend=_backend,
+            hud=1,
+            hud_export_filename=export_filename,
+            program_cache_dir=cache_dir,
+        )
+        assert ret == 0
+        assert ctx.set_scene(_get_scene()) == 0
+        for i in range(3):
+            assert ctx.draw(i / 60.0) == 0
+        del ctx
+        with open(export_filename) as f:
+            rows = list(csv.DictReader(row for row in f if not row.startswith("#")))
+        return sum(int(row["Prog hits"]) for row in rows), sum(int(row["Prog misses"]) for row in rows)
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        cache_dir = os.path.join(tmpdir, "cache")
+        os.mkdir(cache_dir)
+        export_filename = os.path.join(tmpdir, "hud.csv")
+
+        hits, misses = get_program_cache_stats(cache_dir, export_filename)
+        assert hits == 0 and misses > 0
+
+        # The programs are only stored if the backend supports program binaries
+        hits, misses = get_program_cache_stats(cache_dir, export_filename)
+        if os.listdir(cache_dir):
+            assert hits > 0 and misses == 0
+
+
+def api_profiler(width=16, height=16):
+    import json
+    import tempfile
+
+    ctx = ngl.Context()
+    ret = ctx.configure(offscreen=1, width=width, height=height, backend=_backend)
+    assert ret == 0
+    assert ctx.profiler_get_trace() is None
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        export_filename = os.path.join(tmpdir, "trace.json")
+        ret = ctx.configure(
+            offscreen=1,
+            width=width,
+            height=height,
+            backend=_backend,
+            profiler=1,
+            profiler_export_filename=export_filename,
+        )
+        assert ret == 0
+        scene = _get_scene()
+        assert ctx.set_scene(scene) == 0
+        for i in range(3):
+            assert ctx.draw(i / 60.0) == 0
+        trace = json.loads(ctx.profiler_get_trace())
+        categories = {event.get("cat") for event in trace["traceEvents"]}
+        assert {"update", "draw"} <= categories
+        del ctx
+        with open(export_filename) as f:
+            assert len(json.load(f)["traceEvents"]) >= len(trace["traceEvents"])
+
+
+def api_profiler_sort_draws(width=256, height=256):
+    """
+    Check that the GPU time of a Render sorted by its Group is measured when
+    the draw is submitted and not when it is recorded.
+    """
+    import json
+    import tempfile
+
+    nb_frames = 5
+    with tempfile.TemporaryDirectory() as tmpdir:
+        export_filename = os.path.join(tmpdir, "trace.json")
+        ctx = ngl.Context()
+        ret = ctx.configure(
+            offscreen=1,
+            width=width,
+            height=height,
+            backend=_backend,
+            profiler=1,
+            profiler_export_filename=export_filename,
+        )
+        assert ret == 0
+        render = ngl.RenderColor(color=(1.0, 0.0, 0.0), label="sorted")
+        scene = ngl.Group(children=(render,), sort_draws=True)
+        assert ctx.set_scene(scene) == 0
+        for i in range(nb_frames):
+            assert ctx.draw(i / 60.0) == 0
+        del ctx
+
+        with open(export_filename) as f:
+            events = [event for event in json.load(f)["traceEvents"] if event.get("name") == "sorted"]
+
+    # The draw must be accounted for once per frame
+    draw_events = [event for event in events if event.get("cat") == "draw"]
+    assert len(draw_events) == nb_frames
+
+    # GPU timing is optional depending on the backend capabilities
+    gpu_events = [event for event in events if event.get("cat") == "gpu"]
+    if gpu_events:
+        assert len(gpu_events) == nb_frames
+        assert all(event["dur"] > 0 for event in gpu_events)
+
+
 def api_text_live_change(width=320, height=240):
     import zlib
 
@@ -212,6 +480,42 @@ def api_text_live_change(width=320, height=240):
         last_crc = crc
 
 
+def api_text_grow_within_capacity(width=320, height=240):
+    """
+    Check that a text growing within the capacity of the glyphs buffer,
+    previously extended by a longer text, renders the same as from scratch.
+    """
+    import zlib
+
+    def _get_text_crc(ctx, capture_buffer, text_node, text):
+        text_node.set_text(text)
+        assert ctx.draw(0) == 0
+        return zlib.crc32(capture_buffer)
+
+    # "foo" allocates 3 glyphs, "barr" grows the capacity to 6 glyphs and
+    # "bazzzz" fills it up without re-allocation
+    text_strings = ["foo", "barr", "bazzzz"]
+
+    capture_buffer = bytearray(width * height * 4)
+    ctx = ngl.Context()
+    ret = ctx.configure(offscreen=1, width=width, height=height, backend=_backend, capture_buffer=capture_buffer)
+    assert ret == 0
+    text_node = ngl.Text()
+    assert ctx.set_scene(text_node) == 0
+    for text in text_strings:
+        crc = _get_text_crc(ctx, capture_buffer, text_node, text)
+
+    ref_capture_buffer = bytearray(width * height * 4)
+    ref_ctx = ngl.Context()
+    ret = ref_ctx.configure(offscreen=1, width=width, height=height, backend=_backend, capture_buffer=ref_capture_buffer)
+    assert ret == 0
+    ref_text_node = ngl.Text()
+    assert ref_ctx.set_scene(ref_text_node) == 0
+    ref_crc = _get_text_crc(ref_ctx, ref_capture_buffer, ref_text_node, text_strings[-1])
+
+    assert crc == ref_crc
+
+
 def _ret_to_fourcc(ret):
     if ret >= 0:
         return None
@@ -249,6 +553,81 @@ def api_denied_node_live_change(width=320, height=240):
     assert scene.set_vector(ngl.UniformVec3(value=(7, 8, 9))) != 0
 
 
+def api_anim_evaluate_batch():
+    rng = random.Random(0)
+    kfs = [ngl.AnimKeyFrameVec3(i * 0.5, [rng.uniform(0, 1) for _ in range(3)]) for i in range(1000)]
+    anim = ngl.AnimatedVec3(kfs)
+    times = [rng.uniform(-1, 501) for _ in range(100)] + [i * 0.25 for i in range(100)]
+    assert anim.evaluate_batch(times) == [anim.evaluate(t) for t in times]
+    assert anim.evaluate_batch([]) == []
+
+
+def api_update_workers(width=64, height=32):
+    """
+    Check that a scene wide enough to be updated by the worker threads renders
+    the same as when its nodes are updated serially.
+    """
+    import array
+
+    cols, rows = 16, 8
+    cell_w, cell_h = width // cols, height // rows
+
+    def get_cell(i):
+        x, y = i % cols, i // cols
+        quad = ngl.Quad(
+            corner=(-1 + 2 * x / cols, -1 + 2 * y / rows, 0),
+            width=(2 / cols, 0, 0),
+            height=(0, 2 / rows, 0),
+        )
+        if i % 2:
+            noise = ngl.NoiseFloat(frequency=1.3, seed=i)
+            color = ngl.EvalVec3("n * 0.5 + 0.5", "0.5 - n * 0.5", "0.25", resources=dict(n=noise))
+        else:
+            keyframes = (
+                ngl.AnimKeyFrameColor(0, (i / (cols * rows), 0, 1)),
+                ngl.AnimKeyFrameColor(3, (1, i / (cols * rows), 0), easing="quadratic_in_out"),
+            )
+            color = ngl.AnimatedColor(keyframes)
+        return ngl.RenderColor(color=color, geometry=quad)
+
+    def render(cells):
+        capture_buffer = bytearray(width * height * 4)
+        ctx = ngl.Context()
+        ret = ctx.configure(offscreen=1, width=width, height=height, backend=_backend, capture_buffer=capture_buffer)
+        assert ret == 0
+        assert ctx.set_scene(ngl.Group(children=[get_cell(i) for i in cells])) == 0
+        captures = []
+        for t in (0.0, 0.7, 1.9, 3.5):
+            assert ctx.draw(t) == 0
+            captures.append(array.array("B", capture_buffer))
+        del ctx
+        return captures
+
+    def get_cell_pixels(capture, i):
+        # The capture rows go from top to bottom
+        x, y = i % cols, rows - 1 - i // cols
+        stride = width * 4
+        pixels = []
+        for row in range(y * cell_h, (y + 1) * cell_h):
+            start = row * stride + x * cell_w * 4
+            pixels.append(capture[start : start + cell_w * 4])
+        return pixels
+
+    # All the cells in one scene: well above the thresholds starting the
+    # update workers and dispatching a level to them
+    nb_cells = cols * rows
+    captures = render(range(nb_cells))
+
+    # Small chunks of cells, each in its own scene, updated serially
+    chunk_size = 16
+    for start in range(0, nb_cells, chunk_size):
+        cells = range(start, start + chunk_size)
+        ref_captures = render(cells)
+        for capture, ref_capture in zip(captures, ref_captures):
+            for i in cells:
+                assert get_cell_pixels(capture, i) == get_cell_pixels(ref_capture, i)
+
+
 def api_livectls():
     # Build a scene and extract its live controls
     rng = random.Random(0)
@@ -428,3 +807,212 @@ def api_trf_seek_keep_alive(width=320, height=240):
     assert ctx.draw(end) == 0
     assert ctx.draw(start) == 0
     assert ctx.draw(end) == 0
+
+
+def api_trf_prefetch_nested(width=16, height=16):
+    """
+    Check that a TimeRangeFilter prefetching its child ahead of time is not
+    overridden by the shorter prefetch time of a nested TimeRangeFilter.
+    """
+    import json
+
+    ctx = ngl.Context()
+    ret = ctx.configure(offscreen=1, width=width, height=height, backend=_backend, profiler=1)
+    assert ret == 0
+
+    texture = ngl.Texture2D(width=64, height=64)
+    rtt = ngl.RenderToTexture(ngl.Identity(), color_textures=(texture,), label="rtt")
+    group = ngl.Group(children=(rtt, ngl.RenderTexture(texture=texture)))
+    inner = _create_trf(group, 5.0, 6.0)
+    outer = _create_trf(inner, 5.0, 6.0, prefetch_time=3.0)
+    assert ctx.set_scene(outer) == 0
+
+    def rtt_prefetched():
+        trace = json.loads(ctx.profiler_get_trace())
+        return any(e.get("cat") == "prefetch" and e["name"] == "rtt" for e in trace["traceEvents"])
+
+    assert ctx.draw(1.0) == 0
+    assert not rtt_prefetched()
+    assert ctx.draw(2.5) == 0
+    assert rtt_prefetched()
+
+    # A parent keeping its active child alive (but not prefetching it) must
+    # not make the nested filter start its released child
+    ctx = ngl.Context()
+    ret = ctx.configure(offscreen=1, width=width, height=height, backend=_backend, profiler=1)
+    assert ret == 0
+
+    texture = ngl.Texture2D(width=64, height=64)
+    rtt = ngl.RenderToTexture(ngl.Identity(), color_textures=(texture,), label="rtt")
+    group = ngl.Group(children=(rtt, ngl.RenderTexture(texture=texture)))
+    inner = ngl.TimeRangeFilter(
+        group,
+        ranges=(ngl.TimeRangeModeNoop(0.0), ngl.TimeRangeModeCont(5.0)),
+        prefetch_time=0.5,
+        max_idle_time=1.0,
+    )
+    outer = ngl.TimeRangeFilter(
+        inner,
+        ranges=(ngl.TimeRangeModeCont(0.0), ngl.TimeRangeModeNoop(1.0), ngl.TimeRangeModeCont(5.0)),
+        prefetch_time=1.0,
+        max_idle_time=4.0,
+    )
+    assert ctx.set_scene(outer) == 0
+
+    assert ctx.draw(0.0) == 0
+    assert not rtt_prefetched()
+    assert ctx.draw(2.0) == 0
+    assert not rtt_prefetched()
+    assert ctx.draw(4.75) == 0
+    assert rtt_prefetched()
+
+
+def api_buffer_from_file(width=16, height=16):
+    import array
+    import tempfile
+    import zlib
+
+    vertices = array.array("f", (-1, -1, 0, 1, -1, 0, 0, 1, 0, -1, 1, 0, 0, -1, 0, 1, 1, 0))
+
+    def render(vertices_buffer, nb_vertices=len(vertices) // 3):
+        capture_buffer = bytearray(width * height * 4)
+        ctx = ngl.Context()
+        ret = ctx.configure(offscreen=1, width=width, height=height, backend=_backend, capture_buffer=capture_buffer)
+        assert ret == 0
+        uvcoords = array.array("f", [0] * nb_vertices * 2)
+        geometry = ngl.Geometry(vertices=vertices_buffer, uvcoords=ngl.BufferVec2(data=uvcoords))
+        ret = ctx.set_scene(_get_scene(geometry))
+        if ret == 0:
+            assert ctx.draw(0) == 0
+        del ctx
+        return ret, zlib.crc32(capture_buffer)
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        filename = os.path.join(tmpdir, "vertices.bin")
+        with open(filename, "wb") as f:
+            vertices.tofile(f)
+
+        ret, crc_data = render(ngl.BufferVec3(data=vertices))
+        assert ret == 0
+        ret, crc_file = render(ngl.BufferVec3(filename=filename))
+        assert ret == 0
+        assert crc_file == crc_data
+
+        # The file size must match the specified element count
+        ret, _ = render(ngl.BufferVec3(filename=filename, count=5))
+        assert ret < 0
+
+        # A file larger than a staging chunk (4MB with Vulkan) is uploaded in
+        # several pieces; the triangles are repeated so the output is the same
+        filename = os.path.join(tmpdir, "large_vertices.bin")
+        nb_repeats = 4 * 1024 * 1024 // len(vertices.tobytes()) + 1000
+        with open(filename, "wb") as f:
+            (vertices * nb_repeats).tofile(f)
+        ret, crc_file = render(ngl.BufferVec3(filename=filename), nb_vertices=len(vertices) // 3 * nb_repeats)
+        assert ret == 0
+        assert crc_file == crc_data
+
+
+def api_streamedbuffer_from_file(width=16, height=16):
+    import array
+    import tempfile
+    import zlib
+
+    count = 4
+    nb_chunks = 32
+    timestamps = array.array("q", (i * 100000 for i in range(nb_chunks)))
+    data = array.array("f", (i % 7 / 7.0 for i in range(nb_chunks * count * 4)))
+    times = (0.0, 0.1, 0.2, 0.3, 2.5, 2.6, 0.7, 3.15, 10.0)
+
+    def render(**streamed_params):
+        capture_buffer = bytearray(width * height * 4)
+        ctx = ngl.Context()
+        ret = ctx.configure(offscreen=1, width=width, height=height, backend=_backend, capture_buffer=capture_buffer)
+        assert ret == 0
+        streamed = ngl.StreamedBufferVec4(count, ngl.BufferInt64(data=timestamps), label="data", **streamed_params)
+        program = ngl.Program(
+            vertex="""
+void main()
+{
+    ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * vec4(ngl_position, 1.0);
+    var_uvcoord = ngl_uvcoord;
+}
+""",
+            fragment="""
+void main()
+{
+    uint i = clamp(uint(var_uvcoord.x * 4.0), 0U, 3U);
+    ngl_out_color = streamed.data[i];
+}
+""",
+        )
+        program.update_vert_out_vars(var_uvcoord=ngl.IOVec2())
+        render = ngl.Render(ngl.Quad(), program)
+        render.update_frag_resources(streamed=ngl.Block(fields=(streamed,), layout="std140"))
+        ret = ctx.set_scene(render)
+        if ret < 0:
+            return ret, None
+        crcs = []
+        for t in times:
+            assert ctx.draw(t) == 0
+            crcs.append(zlib.crc32(capture_buffer))
+        del ctx
+        return 0, crcs
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        filename = os.path.join(tmpdir, "data.bin")
+        with open(filename, "wb") as f:
+            data.tofile(f)
+
+        ret, crcs_ref = render(buffer=ngl.BufferVec4(data=data))
+        assert ret == 0
+        for window in (1, 4, 64):
+            ret, crcs = render(filename=filename, window=window)
+            assert ret == 0
+            assert crcs == crcs_ref
+
+        # The file must be made of as many chunks as timestamps
+        with open(filename, "ab") as f:
+            data[: count * 4].tofile(f)
+        ret, _ = render(filename=filename)
+        assert ret < 0
+
+
+def _backend_has_compute():
+    backends = ngl.probe_backends(backend=_backend, offscreen=1, width=1, height=1)
+    backend = next(b for b in backends if _backend != ngl.BACKEND_AUTO or b["is_default"])
+    return any(cap["id"] == ngl.CAP_COMPUTE and cap["value"] for cap in backend["caps"])
+
+
+def api_animatedbuffer_gpu_interpolation(width=64, height=64):
+    import array
+    import zlib
+
+    # Without compute support the GPU interpolation silently falls back on
+    # the CPU, which would make the comparison below meaningless
+    assert _backend_has_compute(), "GPU interpolation requires compute support"
+
+    nb_vertices = 64
+    times = (0.0, 1.0, 1.37, 1.74, 2.11, 2.48, 2.85, 3.5)
+
+    def render(gpu_interpolation):
+        capture_buffer = bytearray(width * height * 4)
+        ctx = ngl.Context()
+        ret = ctx.configure(offscreen=1, width=width, height=height, backend=_backend, capture_buffer=capture_buffer)
+        assert ret == 0
+        keyframes = []
+        for k in range(3):
+            data = array.array("f", (((i * 7 + k * 5) % 11) / 5.5 - 1.0 for i in range(nb_vertices * 3)))
+            keyframes.append(ngl.AnimKeyFrameBuffer(1 + k, data=data, easing="exp_in_out" if k == 2 else "linear"))
+        vertices = ngl.AnimatedBufferVec3(keyframes, gpu_interpolation=gpu_interpolation)
+        uvcoords = ngl.BufferVec2(data=array.array("f", [0.0] * nb_vertices * 2))
+        render = ngl.RenderColor(geometry=ngl.Geometry(vertices, uvcoords=uvcoords))
+        assert ctx.set_scene(render) == 0
+        crcs = []
+        for t in times:
+            assert ctx.draw(t) == 0
+            crcs.append(zlib.crc32(capture_buffer))
+        del ctx
+        return crcs
+
+    assert render(True) == render(False)
@@ -20,6 +20,7 @@
 #
 
 from pynodegl_utils.misc import SceneCfg, scene
+from pynodegl_utils.tests.cmp_cuepoints import test_cuepoints
 from pynodegl_utils.tests.cmp_fingerprint import test_fingerprint
 from pynodegl_utils.toolbox.colors import COLORS
 from pynodegl_utils.toolbox.grid import autogrid_simple
@@ -126,5 +127,21 @@ def compositing_all_operators(cfg: SceneCfg):
     return autogrid_simple(scenes)
 
 
+def _get_sort_draws_quad(x0, x1):
+    return ngl.Quad(corner=(x0, -1, 0), width=(x1 - x0, 0, 0), height=(0, 2, 0))
+
+
+@test_cuepoints(points={"A": (-0.7, 0), "B": (-0.35, 0), "C": (0, 0), "D": (0.35, 0), "E": (0.7, 0)}, tolerance=1)
+@scene()
+def compositing_sort_draws(cfg: SceneCfg):
+    # The 2 RenderColor share the same program, created before the one of the
+    # RenderGradient: once sorted, the green quad is drawn before the blue one
+    # even though it is declared after
+    red = ngl.RenderColor(COLORS.red, geometry=_get_sort_draws_quad(-1, 0.2))
+    blue = ngl.RenderGradient(color0=COLORS.blue, color1=COLORS.blue, geometry=_get_sort_draws_quad(-0.5, 0.5))
+    green = ngl.RenderColor(COLORS.green, geometry=_get_sort_draws_quad(-0.2, 1))
+    return ngl.Group(children=(red, blue, green), sort_draws=True)
+
+
 for operator in _OPERATORS:
     globals()[f"compositing_{operator}"] = _get_compositing_func(operator)